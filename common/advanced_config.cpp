@@ -114,9 +114,19 @@ static const wxChar TriangulateMinimumArea[] = wxT( "TriangulateMinimumArea" );
 static const wxChar EnableCacheFriendlyFracture[] = wxT( "EnableCacheFriendlyFracture" );
 static const wxChar EnableAPILogging[] = wxT( "EnableAPILogging" );
 static const wxChar MaxFileSystemWatchers[] = wxT( "MaxFileSystemWatchers" );
-static const wxChar MinorSchematicGraphSize[] = wxT( "MinorSchematicGraphSize" );
 static const wxChar ResolveTextRecursionDepth[] = wxT( "ResolveTextRecursionDepth" );
 static const wxChar ZoneConnectionFiller[] = wxT( "ZoneConnectionFiller" );
+static const wxChar IncrementalZoneFill[] = wxT( "IncrementalZoneFill" );
+static const wxChar ZoneFillTiling[] = wxT( "ZoneFillTiling" );
+static const wxChar DRCResultCache[] = wxT( "DRCResultCache" );
+static const wxChar ParallelBoardLoad[] = wxT( "ParallelBoardLoad" );
+static const wxChar FootprintLibrarySnapshot[] = wxT( "FootprintLibrarySnapshot" );
+static const wxChar ParallelShove[] = wxT( "ParallelShove" );
+static const wxChar PooledPolygonBooleans[] = wxT( "PooledPolygonBooleans" );
+static const wxChar SharedPolygonCacheSize[] = wxT( "SharedPolygonCacheSize" );
+static const wxChar ZoneAdjacencyIndex[] = wxT( "ZoneAdjacencyIndex" );
+static const wxChar ParallelSchematicLoad[] = wxT( "ParallelSchematicLoad" );
+static const wxChar ParallelERC[] = wxT( "ParallelERC" );
 
 } // namespace KEYS
 
@@ -276,12 +286,22 @@ ADVANCED_CFG::ADVANCED_CFG()
 
     m_MaxFilesystemWatchers = 16384;
 
-    m_MinorSchematicGraphSize = 10000;
-
     m_ResolveTextRecursionDepth = 3;
 
     m_ZoneConnectionFiller = false;
 
+    m_IncrementalZoneFill = false;
+    m_ZoneFillTiling = false;
+    m_DRCResultCache = false;
+    m_ParallelBoardLoad = false;
+    m_FootprintLibrarySnapshot = false;
+    m_ParallelShove = false;
+    m_PooledPolygonBooleans = false;
+    m_SharedPolygonCacheSize = 0;
+    m_ZoneAdjacencyIndex = false;
+    m_ParallelSchematicLoad = false;
+    m_ParallelERC = false;
+
     loadFromConfigFile();
 }
 
@@ -514,10 +534,6 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
                                                   &m_MaxFilesystemWatchers, m_MaxFilesystemWatchers,
                                                   0, 2147483647 ) );
 
-    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::MinorSchematicGraphSize,
-                                                  &m_MinorSchematicGraphSize, m_MinorSchematicGraphSize,
-                                                  0, 2147483647 ) );
-
     configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::ResolveTextRecursionDepth,
                                                   &m_ResolveTextRecursionDepth,
                                                   m_ResolveTextRecursionDepth, 0, 10 ) );
@@ -525,6 +541,43 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ZoneConnectionFiller,
                                                 &m_ZoneConnectionFiller, m_ZoneConnectionFiller ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::IncrementalZoneFill,
+                                                &m_IncrementalZoneFill, m_IncrementalZoneFill ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ZoneFillTiling,
+                                                &m_ZoneFillTiling, m_ZoneFillTiling ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::DRCResultCache,
+                                                &m_DRCResultCache, m_DRCResultCache ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelBoardLoad,
+                                                &m_ParallelBoardLoad, m_ParallelBoardLoad ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::FootprintLibrarySnapshot,
+                                                &m_FootprintLibrarySnapshot,
+                                                m_FootprintLibrarySnapshot ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelShove,
+                                                &m_ParallelShove, m_ParallelShove ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::PooledPolygonBooleans,
+                                                &m_PooledPolygonBooleans,
+                                                m_PooledPolygonBooleans ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::SharedPolygonCacheSize,
+                                               &m_SharedPolygonCacheSize,
+                                               m_SharedPolygonCacheSize, 0, 16384 ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ZoneAdjacencyIndex,
+                                                &m_ZoneAdjacencyIndex, m_ZoneAdjacencyIndex ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelSchematicLoad,
+                                                &m_ParallelSchematicLoad,
+                                                m_ParallelSchematicLoad ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelERC,
+                                                &m_ParallelERC, m_ParallelERC ) );
+
     // Special case for trace mask setting...we just grab them and set them immediately
     // Because we even use wxLogTrace inside of advanced config
     wxString traceMasks;
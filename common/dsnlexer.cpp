@@ -707,7 +707,15 @@ L_read:
                 }
 
                 else
-                    curText += *head++;
+                {
+                    // copy the whole run of plain characters up to the next escape or quote
+                    const char* run = head;
+
+                    while( head < limit && *head != '\\' && *head != '"' )
+                        ++head;
+
+                    curText.append( run, head );
+                }
 
             }   // while
 
@@ -787,14 +795,15 @@ L_read:
         }
     }           // specctraMode
 
-    // non-quoted token, read it into curText.
-    curText.clear();
-
+    // non-quoted token, find its extent and then copy it into curText in one go.
     head = cur;
+
     while( head<limit && !isSep( *head ) )
-        curText += *head++;
+        ++head;
+
+    curText.assign( cur, head );
 
-    if( isNumber( curText.c_str(), curText.c_str() + curText.size() ) )
+    if( isNumber( cur, head ) )
     {
         curTok = DSN_NUMBER;
         goto exit;
@@ -843,7 +852,7 @@ wxArrayString* DSNLEXER::ReadCommentLines()
 
 double DSNLEXER::parseDouble()
 {
-#if ( defined( __GNUC__ ) && __GNUC__ < 11 ) || ( defined( __clang__ ) && __clang_major__ < 13 )
+#ifdef DSNLEXER_PARSE_DOUBLE_USES_LOCALE
     // GCC older than 11 "supports" C++17 without supporting the C++17 std::from_chars for doubles
     // clang is similar
 
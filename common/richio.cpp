@@ -33,6 +33,7 @@
 #include <io/kicad/kicad_io_utils.h>
 
 #include <wx/file.h>
+#include <wx/ffile.h>
 #include <wx/translation.h>
 
 
@@ -275,6 +276,91 @@ char* FILE_LINE_READER::ReadLine()
 }
 
 
+STRING_VIEW_LINE_READER::STRING_VIEW_LINE_READER( std::string_view aText,
+                                                  const wxString& aSource,
+                                                  unsigned aStartingLineNumber,
+                                                  unsigned aMaxLineLength ) :
+        LINE_READER( aMaxLineLength ),
+        m_text( aText ),
+        m_ndx( 0 )
+{
+    m_source  = aSource;
+    m_lineNum = aStartingLineNumber;
+}
+
+
+char* STRING_VIEW_LINE_READER::ReadLine()
+{
+    size_t      remaining = m_text.size() - m_ndx;
+    const char* start = m_text.data() + m_ndx;
+    const char* nl = static_cast<const char*>( memchr( start, '\n', remaining ) );
+    size_t      new_length = nl ? size_t( nl - start ) + 1 : remaining;
+
+    if( new_length )
+    {
+        if( new_length >= m_maxLineLength )
+            THROW_IO_ERROR( _( "Maximum line length exceeded" ) );
+
+        if( new_length + 1 > m_capacity )   // +1 for terminating nul
+            expandCapacity( new_length + 1 );
+
+        memcpy( m_line, start, new_length );
+        m_ndx += new_length;
+    }
+
+    m_length = new_length;
+    ++m_lineNum;      // this gets incremented even if no bytes were read
+    m_line[m_length] = 0;
+
+    return m_length ? m_line : nullptr;
+}
+
+
+MAPPED_FILE_LINE_READER::MAPPED_FILE_LINE_READER( const wxString& aFileName,
+                                                  unsigned aStartingLineNumber,
+                                                  unsigned aMaxLineLength ) :
+        STRING_VIEW_LINE_READER( std::string_view(), aFileName, aStartingLineNumber,
+                                 aMaxLineLength ),
+        m_mapping( nullptr )
+{
+    const char* data = nullptr;
+    size_t      size = 0;
+
+    m_mapping = KIPLATFORM::IO::MapFile( aFileName, data, size );
+
+    if( m_mapping )
+    {
+        m_text = std::string_view( data, size );
+    }
+    else
+    {
+        wxFFile file( aFileName, wxT( "rb" ) );
+
+        if( !file.IsOpened() )
+        {
+            wxString msg = wxString::Format( _( "Unable to open %s for reading." ),
+                                             aFileName.GetData() );
+            THROW_IO_ERROR( msg );
+        }
+
+        char   block[8192];
+        size_t count;
+
+        while( ( count = file.Read( block, sizeof( block ) ) ) > 0 )
+            m_buffer.append( block, count );
+
+        m_text = m_buffer;
+    }
+}
+
+
+MAPPED_FILE_LINE_READER::~MAPPED_FILE_LINE_READER()
+{
+    if( m_mapping )
+        KIPLATFORM::IO::UnmapFile( m_mapping );
+}
+
+
 STRING_LINE_READER::STRING_LINE_READER( const std::string& aString, const wxString& aSource ):
     LINE_READER( LINE_READER_LINE_DEFAULT_MAX ),
     m_lines( aString ), m_ndx( 0 )
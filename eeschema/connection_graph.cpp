@@ -24,6 +24,7 @@
 #include <future>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <core/profile.h>
 #include <core/kicad_algo.h>
 #include <common.h>
@@ -615,34 +616,158 @@ void CONNECTION_GRAPH::Merge( CONNECTION_GRAPH& aGraph )
             aGraph.m_global_power_pins.end(),
             std::back_inserter( m_global_power_pins ) );
 
+    // The two graphs intern their names separately, so the handles must be translated
+    auto name = [&]( int aHandle ) -> int
+                {
+                    return m_net_names.Intern( aGraph.m_net_names.Name( aHandle ) );
+                };
+
+    // The parts of a net which ExtractAffectedItems() left in this graph keep their places in
+    // the lists; the rebuilt parts join them
+    auto append =
+            []( auto& aList, const auto& aMore )
+            {
+                aList.insert( aList.end(), aMore.begin(), aMore.end() );
+            };
+
     for( auto& [key, value] : aGraph.m_net_name_to_subgraphs_map )
-        m_net_name_to_subgraphs_map.insert_or_assign( key, value );
+        append( m_net_name_to_subgraphs_map[name( key )], value );
 
     for( auto& [key, value] : aGraph.m_sheet_to_subgraphs_map )
-        m_sheet_to_subgraphs_map.insert_or_assign( key, value );
+        append( m_sheet_to_subgraphs_map[key], value );
 
     for( auto& [key, value] : aGraph.m_net_name_to_code_map )
-        m_net_name_to_code_map.insert_or_assign( key, value );
+        m_net_name_to_code_map.insert_or_assign( name( key ), value );
 
     for( auto& [key, value] : aGraph.m_bus_name_to_code_map )
-        m_bus_name_to_code_map.insert_or_assign( key, value );
+        m_bus_name_to_code_map.insert_or_assign( name( key ), value );
 
     for( auto& [key, value] : aGraph.m_net_code_to_subgraphs_map )
-        m_net_code_to_subgraphs_map.insert_or_assign( key, value );
+        append( m_net_code_to_subgraphs_map[key], value );
 
     for( auto& [key, value] : aGraph.m_item_to_subgraph_map )
         m_item_to_subgraph_map.insert_or_assign( key, value );
 
     for( auto& [key, value] : aGraph.m_local_label_cache )
-        m_local_label_cache.insert_or_assign( key, value );
+        append( m_local_label_cache[std::make_pair( key.first, name( key.second ) )], value );
 
     for( auto& [key, value] : aGraph.m_global_label_cache )
-        m_global_label_cache.insert_or_assign( key, value );
+        append( m_global_label_cache[name( key )], value );
 
     m_last_bus_code = std::max( m_last_bus_code, aGraph.m_last_bus_code );
     m_last_net_code = std::max( m_last_net_code, aGraph.m_last_net_code );
     m_last_subgraph_code = std::max( m_last_subgraph_code, aGraph.m_last_subgraph_code );
 
+    pruneNetNames();
+}
+
+
+bool CONNECTION_GRAPH::CanMerge( const CONNECTION_GRAPH& aGraph ) const
+{
+    for( const CONNECTION_SUBGRAPH* subgraph : aGraph.m_driver_subgraphs )
+    {
+        if( subgraph->m_absorbed || !subgraph->m_driver_connection )
+            continue;
+
+        const wxString& netName = subgraph->m_driver_connection->Name();
+
+        // A global driver which didn't name its net renames the other parts of its own net to
+        // match, so those parts must have been rebuilt too
+        for( SCH_ITEM* driver : subgraph->m_drivers )
+        {
+            if( CONNECTION_SUBGRAPH::GetDriverPriority( driver )
+                        < CONNECTION_SUBGRAPH::PRIORITY::POWER_PIN )
+            {
+                continue;
+            }
+
+            const wxString& secondaryName = subgraph->GetNameForDriver( driver );
+
+            if( secondaryName == netName )
+                continue;
+
+            const std::vector<CONNECTION_SUBGRAPH*>* remaining =
+                    findNetNameSubgraphs( secondaryName );
+
+            if( remaining && !remaining->empty() )
+            {
+                wxLogTrace( ConnTrace, wxT( "Net %s was renamed to %s but has other parts" ),
+                            secondaryName, netName );
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+void CONNECTION_GRAPH::pruneNetNames()
+{
+    std::vector<bool> used( m_net_names.Size(), false );
+    size_t            usedCount = 0;
+
+    auto mark = [&]( int aHandle )
+                {
+                    if( !used[aHandle] )
+                    {
+                        used[aHandle] = true;
+                        usedCount++;
+                    }
+                };
+
+    for( const auto& [handle, subgraphs] : m_net_name_to_subgraphs_map )
+        mark( handle );
+
+    for( const auto& [handle, code] : m_net_name_to_code_map )
+        mark( handle );
+
+    for( const auto& [handle, code] : m_bus_name_to_code_map )
+        mark( handle );
+
+    for( const auto& [handle, subgraphs] : m_global_label_cache )
+        mark( handle );
+
+    for( const auto& [key, subgraphs] : m_local_label_cache )
+        mark( key.second );
+
+    // Rebuilding costs about as much as the merge did, so leave some slack
+    if( usedCount * 2 >= m_net_names.Size() )
+        return;
+
+    NET_NAME_TABLE   names;
+    std::vector<int> remap( m_net_names.Size(), NET_NAME_TABLE::NONE );
+
+    for( size_t ii = 0; ii < used.size(); ++ii )
+    {
+        if( used[ii] )
+            remap[ii] = names.Intern( m_net_names.Name( static_cast<int>( ii ) ) );
+    }
+
+    auto rekey = [&]( auto& aMap )
+                 {
+                     std::remove_reference_t<decltype( aMap )> rekeyed;
+
+                     for( auto& [handle, value] : aMap )
+                         rekeyed.emplace( remap[handle], std::move( value ) );
+
+                     aMap = std::move( rekeyed );
+                 };
+
+    rekey( m_net_name_to_subgraphs_map );
+    rekey( m_net_name_to_code_map );
+    rekey( m_bus_name_to_code_map );
+    rekey( m_global_label_cache );
+
+    decltype( m_local_label_cache ) localLabels;
+
+    for( auto& [key, subgraphs] : m_local_label_cache )
+        localLabels.emplace( std::make_pair( key.first, remap[key.second] ), std::move( subgraphs ) );
+
+    m_local_label_cache = std::move( localLabels );
+
+    // The new table has a new id, so handles kept on connections are re-resolved on next use
+    m_net_names = std::move( names );
 }
 
 
@@ -715,9 +840,11 @@ void CONNECTION_GRAPH::Reset()
     m_item_to_subgraph_map.clear();
     m_local_label_cache.clear();
     m_global_label_cache.clear();
+    m_net_names.Clear();
     m_last_net_code = 1;
     m_last_bus_code = 1;
     m_last_subgraph_code = 1;
+    m_code_source = nullptr;
 }
 
 
@@ -808,12 +935,17 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
             }
         }
 
-        m_items.reserve( m_items.size() + items.size() );
+        // An incremental update only has to revisit the sheets holding changed items; the
+        // connections and dangling ends of the others can't have changed.
+        if( aUnconditional || !items.empty() )
+        {
+            m_items.reserve( m_items.size() + items.size() );
 
-        updateItemConnectivity( sheet, items );
+            updateItemConnectivity( sheet, items );
 
-        // UpdateDanglingState() also adds connected items for SCH_TEXT
-        sheet.LastScreen()->TestDanglingEnds( &sheet, aChangedItemHandler );
+            // UpdateDanglingState() also adds connected items for SCH_TEXT
+            sheet.LastScreen()->TestDanglingEnds( &sheet, aChangedItemHandler );
+        }
 
         // Restore the m_unit member variables where we had to change them
         for( const auto& [ symbol, originalUnit ] : symbolsChanged )
@@ -850,6 +982,7 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
 {
     std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> retvals;
     std::set<CONNECTION_SUBGRAPH*> subgraphs;
+    std::unordered_set<SCH_ITEM*>  removed_items;
 
     auto traverse_subgraph = [&retvals, &subgraphs]( CONNECTION_SUBGRAPH* aSubgraph )
     {
@@ -871,6 +1004,84 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
         aSubgraph->getAllConnectedItems( retvals, subgraphs );
     };
 
+    std::shared_ptr<NET_SETTINGS>& netSettings = m_schematic->Prj().GetProjectFile().m_NetSettings;
+
+    // An edit to aItem can only change the part of its net on the sheet of aSubgraphs when every
+    // driver there gives the net its global name and nothing else links the net to other sheets.
+    // The edit mustn't change a driver either.
+    auto is_sheet_local_edit =
+            [&]( SCH_ITEM* aItem, const wxString& aNetName,
+                 const std::vector<CONNECTION_SUBGRAPH*>& aSubgraphs ) -> bool
+            {
+                switch( aItem->Type() )
+                {
+                case SCH_LABEL_T:
+                case SCH_GLOBAL_LABEL_T:
+                case SCH_HIER_LABEL_T:
+                case SCH_DIRECTIVE_LABEL_T:
+                case SCH_SHEET_PIN_T:
+                    return false;
+
+                case SCH_PIN_T:
+                    if( static_cast<SCH_PIN*>( aItem )->IsGlobalPower() )
+                        return false;
+
+                    break;
+
+                default:
+                    break;
+                }
+
+                // Net classes are assigned from the labels of the whole net
+                if( netSettings->HasNetclassLabelAssignment( aNetName ) )
+                    return false;
+
+                auto is_linked =
+                        [&]( const CONNECTION_SUBGRAPH* aSubgraph ) -> bool
+                        {
+                            if( aSubgraph->m_local_driver || !aSubgraph->m_driver_connection
+                                    || aSubgraph->m_driver_connection->IsBus() )
+                            {
+                                return true;
+                            }
+
+                            if( !aSubgraph->m_hier_pins.empty() || !aSubgraph->m_hier_ports.empty()
+                                    || aSubgraph->m_hier_parent
+                                    || !aSubgraph->m_hier_children.empty() )
+                            {
+                                return true;
+                            }
+
+                            if( !aSubgraph->m_bus_neighbors.empty()
+                                    || !aSubgraph->m_bus_parents.empty() )
+                            {
+                                return true;
+                            }
+
+                            for( SCH_ITEM* driver : aSubgraph->m_drivers )
+                            {
+                                if( aSubgraph->GetNameForDriver( driver ) != aNetName )
+                                    return true;
+                            }
+
+                            return false;
+                        };
+
+                for( const CONNECTION_SUBGRAPH* sg : aSubgraphs )
+                {
+                    if( is_linked( sg ) )
+                        return false;
+
+                    for( const CONNECTION_SUBGRAPH* absorbed : sg->m_absorbed_subgraphs )
+                    {
+                        if( is_linked( absorbed ) )
+                            return false;
+                    }
+                }
+
+                return true;
+            };
+
     auto extract_element = [&]( SCH_ITEM* aItem )
     {
         CONNECTION_SUBGRAPH* item_sg = GetSubgraphForItem( aItem );
@@ -880,25 +1091,56 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
             wxLogTrace( ConnTrace, wxT( "Item %s not found in connection graph" ), aItem->GetTypeDesc() );
             return;
         }
+
+        // The name the net ended up with, before the subgraph's own drivers are resolved again
+        wxString netName = item_sg->GetNetName();
+
         if( !item_sg->ResolveDrivers( true ) )
         {
             wxLogTrace( ConnTrace, wxT( "Item %s in subgraph %ld (%p) has no driver" ),
                         aItem->GetTypeDesc(), item_sg->m_code, item_sg );
         }
 
-        std::vector<CONNECTION_SUBGRAPH*> sg_to_scan = GetAllSubgraphs( item_sg->GetNetName() );
+        if( netName.IsEmpty() )
+            netName = item_sg->GetNetName();
+
+        std::vector<CONNECTION_SUBGRAPH*> sg_to_scan = GetAllSubgraphs( netName );
 
         if( sg_to_scan.empty() )
         {
             wxLogTrace( ConnTrace, wxT( "Item %s in subgraph %ld with net %s has no neighbors" ),
-                        aItem->GetTypeDesc(), item_sg->m_code, item_sg->GetNetName() );
+                        aItem->GetTypeDesc(), item_sg->m_code, netName );
             sg_to_scan.push_back( item_sg );
         }
+        else
+        {
+            CONNECTION_SUBGRAPH* root = item_sg;
+
+            while( root->m_absorbed_by )
+                root = root->m_absorbed_by;
+
+            SCH_SCREEN*                       screen = root->m_sheet.LastScreen();
+            std::vector<CONNECTION_SUBGRAPH*> on_sheet;
+
+            std::copy_if( sg_to_scan.begin(), sg_to_scan.end(), std::back_inserter( on_sheet ),
+                          [&]( const CONNECTION_SUBGRAPH* aSubgraph )
+                          {
+                              return aSubgraph->m_sheet.LastScreen() == screen;
+                          } );
+
+            if( on_sheet.size() < sg_to_scan.size() && alg::contains( on_sheet, root )
+                    && is_sheet_local_edit( aItem, netName, on_sheet ) )
+            {
+                wxLogTrace( ConnTrace, wxT( "Item %s only affects net %s on its own sheet" ),
+                            aItem->GetTypeDesc(), netName );
+                sg_to_scan = std::move( on_sheet );
+            }
+        }
 
         wxLogTrace( ConnTrace,
                     wxT( "Removing all item %s connections from subgraph %ld with net %s: Found "
                          "%zu subgraphs" ),
-                    aItem->GetTypeDesc(), item_sg->m_code, item_sg->GetNetName(),
+                    aItem->GetTypeDesc(), item_sg->m_code, netName,
                     sg_to_scan.size() );
 
         for( CONNECTION_SUBGRAPH* sg : sg_to_scan )
@@ -919,7 +1161,7 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
             }
         }
 
-        alg::delete_matching( m_items, aItem );
+        removed_items.insert( aItem );
     };
 
     for( SCH_ITEM* item : aItems )
@@ -947,7 +1189,13 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
     removeSubgraphs( subgraphs );
 
     for( const auto& [path, item] : retvals )
-        alg::delete_matching( m_items, item );
+        removed_items.insert( item );
+
+    alg::delete_if( m_items,
+                    [&]( SCH_ITEM* aItem )
+                    {
+                        return removed_items.count( aItem ) > 0;
+                    } );
 
     return retvals;
 }
@@ -974,14 +1222,15 @@ void CONNECTION_GRAPH::RemoveItem( SCH_ITEM* aItem )
 void CONNECTION_GRAPH::removeSubgraphs( std::set<CONNECTION_SUBGRAPH*>& aSubgraphs )
 {
     wxLogTrace( ConnTrace, wxT( "Removing %zu subgraphs" ), aSubgraphs.size() );
-    std::sort( m_driver_subgraphs.begin(), m_driver_subgraphs.end() );
-    std::sort( m_subgraphs.begin(), m_subgraphs.end() );
     std::set<int> codes_to_remove;
 
-    for( auto& el : m_sheet_to_subgraphs_map )
-    {
-        std::sort( el.second.begin(), el.second.end() );
-    }
+    std::unordered_set<const CONNECTION_SUBGRAPH*> removed( aSubgraphs.begin(),
+                                                            aSubgraphs.end() );
+
+    auto is_removed = [&removed]( const CONNECTION_SUBGRAPH* aSubgraph ) -> bool
+                      {
+                          return removed.count( aSubgraph ) > 0;
+                      };
 
     for( CONNECTION_SUBGRAPH* sg : aSubgraphs )
     {
@@ -1022,86 +1271,68 @@ void CONNECTION_GRAPH::removeSubgraphs( std::set<CONNECTION_SUBGRAPH*>& aSubgrap
                     parent->m_bus_neighbors.erase( it.first );
             }
         }
+    }
 
-        {
-            auto it = std::lower_bound( m_driver_subgraphs.begin(), m_driver_subgraphs.end(), sg );
-
-            while( it != m_driver_subgraphs.end() && *it == sg )
-                it = m_driver_subgraphs.erase( it );
-        }
-
-        {
-            auto it = std::lower_bound( m_subgraphs.begin(), m_subgraphs.end(), sg );
-
-            while( it != m_subgraphs.end() && *it == sg )
-                it = m_subgraphs.erase( it );
-        }
-
-        for( auto& el : m_sheet_to_subgraphs_map )
-        {
-            auto it = std::lower_bound( el.second.begin(), el.second.end(), sg );
+    // Sweep each of the lists and caches once for the whole set, rather than once per removed
+    // subgraph, so that the cost of an edit doesn't grow with the size of the whole schematic
+    // times the size of the edit.
+    alg::delete_if( m_driver_subgraphs, is_removed );
+    alg::delete_if( m_subgraphs, is_removed );
 
-            while( it != el.second.end() && *it == sg )
-                it = el.second.erase( it );
-        }
+    for( auto& el : m_sheet_to_subgraphs_map )
+        alg::delete_if( el.second, is_removed );
 
-        auto remove_sg = [sg]( auto it ) -> bool
+    // ExtractAffectedItems() may leave parts of a net behind, so drop only the removed subgraphs
+    // from each list, and the list itself once it is empty
+    auto drop_removed = [&is_removed]( auto it ) -> bool
                         {
-                            for( const CONNECTION_SUBGRAPH* test_sg : it->second )
-                            {
-                                if( sg == test_sg )
-                                    return true;
-                            }
-
-                            return false;
+                            alg::delete_if( it->second, is_removed );
+                            return it->second.empty();
                         };
 
-        for( auto it = m_global_label_cache.begin(); it != m_global_label_cache.end(); )
-        {
-            if( remove_sg( it ) )
-                it = m_global_label_cache.erase( it );
-            else
-                ++it;
-        }
-
-        for( auto it = m_local_label_cache.begin(); it != m_local_label_cache.end(); )
-        {
-            if( remove_sg( it ) )
-                it = m_local_label_cache.erase( it );
-            else
-                ++it;
-        }
+    for( auto it = m_global_label_cache.begin(); it != m_global_label_cache.end(); )
+    {
+        if( drop_removed( it ) )
+            it = m_global_label_cache.erase( it );
+        else
+            ++it;
+    }
 
-        for( auto it = m_net_code_to_subgraphs_map.begin();
-             it != m_net_code_to_subgraphs_map.end(); )
-        {
-            if( remove_sg( it ) )
-            {
-                codes_to_remove.insert( it->first.Netcode );
-                it = m_net_code_to_subgraphs_map.erase( it );
-            }
-            else
-                ++it;
-        }
+    for( auto it = m_local_label_cache.begin(); it != m_local_label_cache.end(); )
+    {
+        if( drop_removed( it ) )
+            it = m_local_label_cache.erase( it );
+        else
+            ++it;
+    }
 
-        for( auto it = m_net_name_to_subgraphs_map.begin();
-             it != m_net_name_to_subgraphs_map.end(); )
+    for( auto it = m_net_code_to_subgraphs_map.begin(); it != m_net_code_to_subgraphs_map.end(); )
+    {
+        if( drop_removed( it ) )
         {
-            if( remove_sg( it ) )
-                it = m_net_name_to_subgraphs_map.erase( it );
-            else
-                ++it;
+            codes_to_remove.insert( it->first.Netcode );
+            it = m_net_code_to_subgraphs_map.erase( it );
         }
-
-        for( auto it = m_item_to_subgraph_map.begin(); it != m_item_to_subgraph_map.end(); )
+        else
         {
-            if( it->second == sg )
-                it = m_item_to_subgraph_map.erase( it );
-            else
-                ++it;
+            ++it;
         }
+    }
 
+    for( auto it = m_net_name_to_subgraphs_map.begin(); it != m_net_name_to_subgraphs_map.end(); )
+    {
+        if( drop_removed( it ) )
+            it = m_net_name_to_subgraphs_map.erase( it );
+        else
+            ++it;
+    }
 
+    for( auto it = m_item_to_subgraph_map.begin(); it != m_item_to_subgraph_map.end(); )
+    {
+        if( is_removed( it->second ) )
+            it = m_item_to_subgraph_map.erase( it );
+        else
+            ++it;
     }
 
     for( auto it = m_net_name_to_code_map.begin(); it != m_net_name_to_code_map.end(); )
@@ -1528,9 +1759,8 @@ void CONNECTION_GRAPH::collectAllDriverValues()
 
     for( auto&& subgraph : m_driver_subgraphs )
     {
-        wxString full_name = subgraph->m_driver_connection->Name();
-        wxString name = subgraph->m_driver_connection->Name( true );
-        m_net_name_to_subgraphs_map[full_name].emplace_back( subgraph );
+        SCH_CONNECTION* conn = subgraph->m_driver_connection;
+        m_net_name_to_subgraphs_map[m_net_names.Intern( *conn )].emplace_back( subgraph );
 
         // For vector buses, we need to cache the prefix also, as two different instances of the
         // weakly driven pin may have the same prefix but different vector start and end.  We need
@@ -1538,8 +1768,8 @@ void CONNECTION_GRAPH::collectAllDriverValues()
         // common usage, they will be incorrectly merged.
         if( subgraph->m_driver_connection->Type() == CONNECTION_TYPE::BUS )
         {
-            wxString prefixOnly = full_name.BeforeFirst( '[' ) + wxT( "[]" );
-            m_net_name_to_subgraphs_map[prefixOnly].emplace_back( subgraph );
+            wxString prefixOnly = conn->Name().BeforeFirst( '[' ) + wxT( "[]" );
+            m_net_name_to_subgraphs_map[m_net_names.Intern( prefixOnly )].emplace_back( subgraph );
         }
 
         subgraph->m_dirty = true;
@@ -1554,19 +1784,20 @@ void CONNECTION_GRAPH::collectAllDriverValues()
             case SCH_LABEL_T:
             case SCH_HIER_LABEL_T:
             {
-                m_local_label_cache[std::make_pair( sheet, name )].push_back( subgraph );
+                m_local_label_cache[std::make_pair( sheet, m_net_names.Intern( *conn, true ) )]
+                        .push_back( subgraph );
                 break;
             }
             case SCH_GLOBAL_LABEL_T:
             {
-                m_global_label_cache[name].push_back( subgraph );
+                m_global_label_cache[m_net_names.Intern( *conn, true )].push_back( subgraph );
                 break;
             }
             case SCH_PIN_T:
             {
                 SCH_PIN* pin = static_cast<SCH_PIN*>( driver );
                 wxASSERT( pin->IsGlobalPower() );
-                m_global_label_cache[name].push_back( subgraph );
+                m_global_label_cache[m_net_names.Intern( *conn, true )].push_back( subgraph );
                 break;
             }
             default:
@@ -1631,7 +1862,7 @@ void CONNECTION_GRAPH::generateBusAliasMembers()
                 /// Need to figure out why these sgs are not getting connected to their bus parents
                 NET_NAME_CODE_CACHE_KEY key = { new_sg->GetNetName(), code };
                 m_net_code_to_subgraphs_map[ key ].push_back( new_sg );
-                m_net_name_to_subgraphs_map[ name ].push_back( new_sg );
+                m_net_name_to_subgraphs_map[ m_net_names.Intern( name ) ].push_back( new_sg );
                 m_subgraphs.push_back( new_sg );
                 new_subgraphs.push_back( new_sg );
             }
@@ -1771,8 +2002,8 @@ void CONNECTION_GRAPH::processSubGraphs()
             std::vector<CONNECTION_SUBGRAPH*> vec_empty;
             std::vector<CONNECTION_SUBGRAPH*>* vec = &vec_empty;
 
-            if( m_net_name_to_subgraphs_map.count( name ) )
-                vec = &m_net_name_to_subgraphs_map.at( name );
+            if( std::vector<CONNECTION_SUBGRAPH*>* named = findNetNameSubgraphs( name ) )
+                vec = named;
 
             // If we are a unique bus vector, check if we aren't actually unique because of another
             // subgraph with a similar bus vector
@@ -1780,15 +2011,15 @@ void CONNECTION_GRAPH::processSubGraphs()
             {
                 wxString prefixOnly = name.BeforeFirst( '[' ) + wxT( "[]" );
 
-                if( m_net_name_to_subgraphs_map.count( prefixOnly ) )
-                    vec = &m_net_name_to_subgraphs_map.at( prefixOnly );
+                if( std::vector<CONNECTION_SUBGRAPH*>* named = findNetNameSubgraphs( prefixOnly ) )
+                    vec = named;
             }
 
             if( vec->size() > 1 )
             {
                 wxString new_name = create_new_name( connection );
 
-                while( m_net_name_to_subgraphs_map.contains( new_name ) )
+                while( findNetNameSubgraphs( new_name ) )
                     new_name = create_new_name( connection );
 
                 wxLogTrace( ConnTrace,
@@ -1797,7 +2028,8 @@ void CONNECTION_GRAPH::processSubGraphs()
 
                 alg::delete_matching( *vec, subgraph );
 
-                m_net_name_to_subgraphs_map[new_name].emplace_back( subgraph );
+                m_net_name_to_subgraphs_map[m_net_names.Intern( new_name )]
+                        .emplace_back( subgraph );
 
                 name = new_name;
             }
@@ -1815,13 +2047,13 @@ void CONNECTION_GRAPH::processSubGraphs()
                 {
                     bool     conflict    = false;
                     wxString global_name = connection->Name( true );
-                    auto     kk          = m_net_name_to_subgraphs_map.find( global_name );
+                    auto     kk          = findNetNameSubgraphs( global_name );
 
-                    if( kk != m_net_name_to_subgraphs_map.end() )
+                    if( kk )
                     {
                         // A global will conflict if it is on the same sheet as this subgraph, since
                         // it would be connected by implicit local label linking
-                        std::vector<CONNECTION_SUBGRAPH*>& candidates = kk->second;
+                        std::vector<CONNECTION_SUBGRAPH*>& candidates = *kk;
 
                         for( const CONNECTION_SUBGRAPH* candidate : candidates )
                         {
@@ -1857,17 +2089,12 @@ void CONNECTION_GRAPH::processSubGraphs()
         if( connection->IsBus() )
         {
             int  code = -1;
-            auto it   = m_bus_name_to_code_map.find( name );
+            auto [it, inserted] = m_bus_name_to_code_map.try_emplace( m_net_names.Intern( name ) );
 
-            if( it != m_bus_name_to_code_map.end() )
-            {
-                code = it->second;
-            }
-            else
-            {
-                code = m_last_bus_code++;
-                m_bus_name_to_code_map[ name ] = code;
-            }
+            if( inserted )
+                it->second = m_last_bus_code++;
+
+            code = it->second;
 
             connection->SetBusCode( code );
             assignNetCodesToBus( connection );
@@ -2268,12 +2495,12 @@ void CONNECTION_GRAPH::buildConnectionGraph( std::function<void( SCH_ITEM* )>* a
 
                     match->Clone( *conn );
 
-                    auto jj = m_net_name_to_subgraphs_map.find( old_name );
+                    std::vector<CONNECTION_SUBGRAPH*>* jj = findNetNameSubgraphs( old_name );
 
-                    if( jj == m_net_name_to_subgraphs_map.end() )
+                    if( !jj )
                         continue;
 
-                    for( CONNECTION_SUBGRAPH* old_sg : jj->second )
+                    for( CONNECTION_SUBGRAPH* old_sg : *jj )
                     {
                         while( old_sg->m_absorbed )
                             old_sg = old_sg->m_absorbed_by;
@@ -2359,7 +2586,8 @@ void CONNECTION_GRAPH::buildConnectionGraph( std::function<void( SCH_ITEM* )>* a
                                         subgraph->m_driver_connection->NetCode() };
         m_net_code_to_subgraphs_map[ key ].push_back( subgraph );
 
-        m_net_name_to_subgraphs_map[subgraph->m_driver_connection->Name()].push_back( subgraph );
+        m_net_name_to_subgraphs_map[m_net_names.Intern( *subgraph->m_driver_connection )]
+                .push_back( subgraph );
     }
 
     std::shared_ptr<NET_SETTINGS>& netSettings = m_schematic->Prj().GetProjectFile().m_NetSettings;
@@ -2414,7 +2642,7 @@ void CONNECTION_GRAPH::buildConnectionGraph( std::function<void( SCH_ITEM* )>* a
                         netSettings->AppendNetclassLabelAssignment( member->Name(), netclasses );
                     }
 
-                    auto ii = m_net_name_to_subgraphs_map.find( member->Name() );
+                    std::vector<CONNECTION_SUBGRAPH*>* ii = findNetNameSubgraphs( *member );
 
                     if( oldAssignments.count( member->Name() ) )
                     {
@@ -2422,16 +2650,16 @@ void CONNECTION_GRAPH::buildConnectionGraph( std::function<void( SCH_ITEM* )>* a
                         {
                             affectedNetclassNetAssignments.insert( member->Name() );
 
-                            if( ii != m_net_name_to_subgraphs_map.end() )
-                                dirtySubgraphs( ii->second );
+                            if( ii )
+                                dirtySubgraphs( *ii );
                         }
                     }
                     else if( !netclasses.empty() )
                     {
                         affectedNetclassNetAssignments.insert( member->Name() );
 
-                        if( ii != m_net_name_to_subgraphs_map.end() )
-                            dirtySubgraphs( ii->second );
+                        if( ii )
+                            dirtySubgraphs( *ii );
                     }
                 };
 
@@ -2480,7 +2708,7 @@ void CONNECTION_GRAPH::buildConnectionGraph( std::function<void( SCH_ITEM* )>* a
 
     // Check for netclass assignments
     for( const auto& [ netname, subgraphs ] : m_net_name_to_subgraphs_map )
-        checkNetclassDrivers( netname, subgraphs );
+        checkNetclassDrivers( m_net_names.Name( netname ), subgraphs );
 
     if( !aUnconditional )
     {
@@ -2502,22 +2730,67 @@ int CONNECTION_GRAPH::getOrCreateNetCode( const wxString& aNetName )
 {
     int code;
 
-    auto it = m_net_name_to_code_map.find( aNetName );
+    auto [it, inserted] = m_net_name_to_code_map.try_emplace( m_net_names.Intern( aNetName ) );
 
-    if( it == m_net_name_to_code_map.end() )
-    {
-        code = m_last_net_code++;
-        m_net_name_to_code_map[ aNetName ] = code;
-    }
-    else
+    if( inserted )
     {
-        code = it->second;
+        // Parts of the net left in the graph this one will be merged into keep their code
+        const std::unordered_map<int, int>* sourceCodes = nullptr;
+        int                                 sourceHandle = NET_NAME_TABLE::NONE;
+
+        if( m_code_source )
+        {
+            sourceCodes = &m_code_source->m_net_name_to_code_map;
+            sourceHandle = m_code_source->m_net_names.Find( aNetName );
+        }
+
+        if( sourceHandle != NET_NAME_TABLE::NONE && sourceCodes->count( sourceHandle ) )
+            it->second = sourceCodes->at( sourceHandle );
+        else
+            it->second = m_last_net_code++;
     }
 
+    code = it->second;
+
     return code;
 }
 
 
+std::vector<CONNECTION_SUBGRAPH*>*
+CONNECTION_GRAPH::findNetNameSubgraphs( const wxString& aNetName )
+{
+    return const_cast<std::vector<CONNECTION_SUBGRAPH*>*>(
+            std::as_const( *this ).findNetNameSubgraphs( aNetName ) );
+}
+
+
+const std::vector<CONNECTION_SUBGRAPH*>*
+CONNECTION_GRAPH::findNetNameSubgraphs( const wxString& aNetName ) const
+{
+    return findNetNameSubgraphs( m_net_names.Find( aNetName ) );
+}
+
+
+std::vector<CONNECTION_SUBGRAPH*>*
+CONNECTION_GRAPH::findNetNameSubgraphs( const SCH_CONNECTION& aConnection )
+{
+    return const_cast<std::vector<CONNECTION_SUBGRAPH*>*>(
+            findNetNameSubgraphs( m_net_names.Intern( aConnection ) ) );
+}
+
+
+const std::vector<CONNECTION_SUBGRAPH*>*
+CONNECTION_GRAPH::findNetNameSubgraphs( int aHandle ) const
+{
+    if( aHandle == NET_NAME_TABLE::NONE )
+        return nullptr;
+
+    auto it = m_net_name_to_subgraphs_map.find( aHandle );
+
+    return it != m_net_name_to_subgraphs_map.end() ? &it->second : nullptr;
+}
+
+
 int CONNECTION_GRAPH::assignNewNetCode( SCH_CONNECTION& aConnection )
 {
     int code = getOrCreateNetCode( aConnection.Name() );
@@ -2967,18 +3240,14 @@ SCH_CONNECTION* CONNECTION_GRAPH::matchBusMember( SCH_CONNECTION* aBusConnection
 void CONNECTION_GRAPH::recacheSubgraphName( CONNECTION_SUBGRAPH* aSubgraph,
                                             const wxString& aOldName )
 {
-    auto it = m_net_name_to_subgraphs_map.find( aOldName );
-
-    if( it != m_net_name_to_subgraphs_map.end() )
-    {
-        std::vector<CONNECTION_SUBGRAPH*>& vec = it->second;
-        alg::delete_matching( vec, aSubgraph );
-    }
+    if( std::vector<CONNECTION_SUBGRAPH*>* vec = findNetNameSubgraphs( aOldName ) )
+        alg::delete_matching( *vec, aSubgraph );
 
     wxLogTrace( ConnTrace, wxS( "recacheSubgraphName: %s => %s" ), aOldName,
                 aSubgraph->m_driver_connection->Name() );
 
-    m_net_name_to_subgraphs_map[aSubgraph->m_driver_connection->Name()].push_back( aSubgraph );
+    m_net_name_to_subgraphs_map[m_net_names.Intern( *aSubgraph->m_driver_connection )]
+            .push_back( aSubgraph );
 }
 
 
@@ -3053,7 +3322,7 @@ wxString CONNECTION_GRAPH::GetResolvedSubgraphName( const CONNECTION_SUBGRAPH* a
         {
             if( graph == aSubGraph )
             {
-                retval = it->first;
+                retval = m_net_names.Name( it->first );
                 found = true;
                 break;
             }
@@ -3067,12 +3336,12 @@ wxString CONNECTION_GRAPH::GetResolvedSubgraphName( const CONNECTION_SUBGRAPH* a
 CONNECTION_SUBGRAPH* CONNECTION_GRAPH::FindSubgraphByName( const wxString& aNetName,
                                                            const SCH_SHEET_PATH& aPath )
 {
-    auto it = m_net_name_to_subgraphs_map.find( aNetName );
+    std::vector<CONNECTION_SUBGRAPH*>* subgraphs = findNetNameSubgraphs( aNetName );
 
-    if( it == m_net_name_to_subgraphs_map.end() )
+    if( !subgraphs )
         return nullptr;
 
-    for( CONNECTION_SUBGRAPH* sg : it->second )
+    for( CONNECTION_SUBGRAPH* sg : *subgraphs )
     {
         // Cache is supposed to be valid by now
         wxASSERT( sg && !sg->m_absorbed && sg->m_driver_connection );
@@ -3087,14 +3356,14 @@ CONNECTION_SUBGRAPH* CONNECTION_GRAPH::FindSubgraphByName( const wxString& aNetN
 
 CONNECTION_SUBGRAPH* CONNECTION_GRAPH::FindFirstSubgraphByName( const wxString& aNetName )
 {
-    auto it = m_net_name_to_subgraphs_map.find( aNetName );
+    std::vector<CONNECTION_SUBGRAPH*>* subgraphs = findNetNameSubgraphs( aNetName );
 
-    if( it == m_net_name_to_subgraphs_map.end() )
+    if( !subgraphs )
         return nullptr;
 
-    wxASSERT( !it->second.empty() );
+    wxASSERT( !subgraphs->empty() );
 
-    return it->second[0];
+    return ( *subgraphs )[0];
 }
 
 
@@ -3113,14 +3382,12 @@ CONNECTION_SUBGRAPH* CONNECTION_GRAPH::GetSubgraphForItem( SCH_ITEM* aItem ) con
 const std::vector<CONNECTION_SUBGRAPH*>
 CONNECTION_GRAPH::GetAllSubgraphs( const wxString& aNetName ) const
 {
-    std::vector<CONNECTION_SUBGRAPH*> subgraphs;
-
-    auto it = m_net_name_to_subgraphs_map.find( aNetName );
+    const std::vector<CONNECTION_SUBGRAPH*>* subgraphs = findNetNameSubgraphs( aNetName );
 
-    if( it == m_net_name_to_subgraphs_map.end() )
-        return subgraphs;
+    if( !subgraphs )
+        return {};
 
-    return it->second;
+    return *subgraphs;
 }
 
 
@@ -3565,11 +3832,9 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph
         }
     };
 
-    auto it = m_net_name_to_subgraphs_map.find( netName );
-
-    if( it != m_net_name_to_subgraphs_map.end() )
+    if( const std::vector<CONNECTION_SUBGRAPH*>* subgraphs = findNetNameSubgraphs( netName ) )
     {
-        for( const CONNECTION_SUBGRAPH* subgraph : it->second )
+        for( const CONNECTION_SUBGRAPH* subgraph : *subgraphs )
         {
             process_subgraph( subgraph );
         }
@@ -3704,11 +3969,13 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph
                 && !pin->IsGlobalPower()
                 && !pin->GetLibPin()->GetParentSymbol()->IsPower() )
         {
-            wxString name = pin->Connection( &sheet )->Name();
-            wxString local_name = pin->Connection( &sheet )->Name( true );
+            const SCH_CONNECTION* conn = pin->Connection( &sheet );
+
+            int nameHandle = m_net_names.Find( *conn );
+            int localNameHandle = m_net_names.Find( *conn, true );
 
-            if( m_global_label_cache.count( name )
-                    || m_local_label_cache.count( std::make_pair( sheet, local_name ) ) )
+            if( m_global_label_cache.count( nameHandle )
+                    || m_local_label_cache.count( std::make_pair( sheet, localNameHandle ) ) )
             {
                 has_other_connections = true;
             }
@@ -3981,11 +4248,10 @@ bool CONNECTION_GRAPH::ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph )
         {
             size_t allPins = pinCount;
 
-            auto it = m_net_name_to_subgraphs_map.find( netName );
-
-            if( it != m_net_name_to_subgraphs_map.end() )
+            if( const std::vector<CONNECTION_SUBGRAPH*>* neighbors =
+                        findNetNameSubgraphs( netName ) )
             {
-                for( const CONNECTION_SUBGRAPH* neighbor : it->second )
+                for( const CONNECTION_SUBGRAPH* neighbor : *neighbors )
                 {
                     if( neighbor == aSubgraph )
                         continue;
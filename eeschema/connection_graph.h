@@ -22,7 +22,9 @@
 #ifndef _CONNECTION_GRAPH_H
 #define _CONNECTION_GRAPH_H
 
+#include <atomic>
 #include <mutex>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -343,6 +345,104 @@ namespace std
 /// Associate a #NET_CODE_NAME with all the subgraphs in that net.
 typedef std::unordered_map<NET_NAME_CODE_CACHE_KEY, std::vector<CONNECTION_SUBGRAPH*>> NET_MAP;
 
+/**
+ * Interns the net names used inside a #CONNECTION_GRAPH, so that its caches can be keyed on
+ * small integer handles rather than on the names themselves.
+ *
+ * Each name is stored (and hashed) once.  The handle of a connection's name is kept on the
+ * SCH_CONNECTION (see SCH_CONNECTION::GetNameHandle()), so looking up a cache entry for a
+ * connection only hashes its name again once the name has changed.
+ *
+ * Names aren't removed one at a time, so a handle stays valid until the table is cleared or
+ * replaced; CONNECTION_GRAPH rebuilds it from the names still in use when most are not.  Each
+ * table (and each Clear()) gets a new Id(), which stale handles kept on connections are checked
+ * against.
+ */
+class NET_NAME_TABLE
+{
+public:
+    /// The handle returned by Find() for a name which isn't in the table.
+    static constexpr int NONE = -1;
+
+    NET_NAME_TABLE() :
+            m_id( nextId() )
+    {
+    }
+
+    // m_names points into m_handles, which a move keeps but a copy wouldn't
+    NET_NAME_TABLE( const NET_NAME_TABLE& ) = delete;
+    NET_NAME_TABLE& operator=( const NET_NAME_TABLE& ) = delete;
+    NET_NAME_TABLE( NET_NAME_TABLE&& ) = default;
+    NET_NAME_TABLE& operator=( NET_NAME_TABLE&& ) = default;
+
+    /// @return the handle of \a aName, adding it to the table if need be.
+    int Intern( const wxString& aName )
+    {
+        auto [it, inserted] = m_handles.try_emplace( aName, static_cast<int>( m_names.size() ) );
+
+        if( inserted )
+            m_names.push_back( &it->first );
+
+        return it->second;
+    }
+
+    /// @return the handle of the name of \a aConnection, adding it to the table if need be.
+    int Intern( const SCH_CONNECTION& aConnection, bool aIgnoreSheet = false )
+    {
+        int handle = aConnection.GetNameHandle( m_id, aIgnoreSheet );
+
+        if( handle == NONE )
+        {
+            handle = Intern( aConnection.Name( aIgnoreSheet ) );
+            aConnection.SetNameHandle( m_id, aIgnoreSheet, handle );
+        }
+
+        return handle;
+    }
+
+    /// @return the handle of \a aName, or #NONE if it was never interned.
+    int Find( const wxString& aName ) const
+    {
+        auto it = m_handles.find( aName );
+        return it != m_handles.end() ? it->second : NONE;
+    }
+
+    /**
+     * @return the handle of the name of \a aConnection, or #NONE if it was never interned.
+     *         Unlike Intern(), this doesn't change \a aConnection, so it is safe on const paths.
+     */
+    int Find( const SCH_CONNECTION& aConnection, bool aIgnoreSheet = false ) const
+    {
+        int handle = aConnection.GetNameHandle( m_id, aIgnoreSheet );
+        return handle != NONE ? handle : Find( aConnection.Name( aIgnoreSheet ) );
+    }
+
+    const wxString& Name( int aHandle ) const { return *m_names[aHandle]; }
+
+    size_t Size() const { return m_names.size(); }
+
+    uint64_t Id() const { return m_id; }
+
+    void Clear()
+    {
+        m_names.clear();
+        m_handles.clear();
+        m_id = nextId();
+    }
+
+private:
+    static uint64_t nextId()
+    {
+        static std::atomic<uint64_t> s_next( 1 );
+        return s_next++;
+    }
+
+    uint64_t                          m_id;
+    std::unordered_map<wxString, int> m_handles;
+    std::vector<const wxString*>      m_names;      ///< Keys of m_handles, by handle
+};
+
+
 /**
  * Calculate the connectivity of a schematic and generates netlists.
  */
@@ -353,6 +453,7 @@ public:
               m_last_net_code( 1 ),
               m_last_bus_code( 1 ),
               m_last_subgraph_code( 1 ),
+              m_code_source( nullptr ),
               m_schematic( aSchematic )
     {}
 
@@ -368,11 +469,16 @@ public:
         m_schematic = aSchematic;
     }
 
+    /**
+     * Continue the code numbering of \a aOther, and give nets which it still holds subgraphs
+     * for the codes they have there, so that this graph can be merged into it.
+     */
     void SetLastCodes( const CONNECTION_GRAPH* aOther )
     {
         m_last_net_code = aOther->m_last_net_code;
         m_last_bus_code = aOther->m_last_bus_code;
         m_last_subgraph_code = aOther->m_last_subgraph_code;
+        m_code_source = aOther;
     }
 
     /**
@@ -449,6 +555,10 @@ public:
      * For a set of items, this will remove the connected items and their
      * associated data including subgraphs and generated codes from the connection graph.
      *
+     * An item on a net named by a single global label or power pin name, with no hierarchical
+     * or bus links, only takes the part of the net on its own sheet with it: the edit can't
+     * change the name of the parts on other sheets.  Otherwise the whole net is removed.
+     *
      * @param aItems A vector of items whose presence should be removed from the graph.
      * @return The full set of all items associated with the input items that were removed.
      */
@@ -464,6 +574,17 @@ public:
      */
     void Merge( CONNECTION_GRAPH& aGraph );
 
+    /**
+     * Check that \a aGraph, built for an edit, can be merged into this graph.
+     *
+     * ExtractAffectedItems() leaves the parts of a global net on other sheets in this graph when
+     * the edit can't rename the net.  If the edit joined the net to another global one after
+     * all, the parts left behind would keep a stale name.
+     *
+     * @return false if \a aGraph renamed a net which still has subgraphs in this graph.
+     */
+    bool CanMerge( const CONNECTION_GRAPH& aGraph ) const;
+
     void RemoveItem( SCH_ITEM* aItem );
 
     /**
@@ -471,18 +592,8 @@ public:
     */
     void ExchangeItem( SCH_ITEM* aOldItem, SCH_ITEM* aNewItem );
 
-    /**
-     * We modify how we handle the connectivity graph for small graphs vs large
-     * graphs.  Partially this is to avoid unneeded complexity for small graphs,
-     * where the performance of the graph is not a concern.  This is considered
-     * a temporary solution until the connectivity graph is refactored with an
-     * eye toward partial updates
-    */
-    bool IsMinor() const
-    {
-        return static_cast<ssize_t>( m_items.size() )
-               < ADVANCED_CFG::GetCfg().m_MinorSchematicGraphSize;
-    }
+    /// @return the number of distinct net names the graph's caches are keyed on.
+    size_t GetNetNameCount() const { return m_net_names.Size(); }
 
 private:
     /**
@@ -578,6 +689,26 @@ private:
      */
     int getOrCreateNetCode( const wxString& aNetName );
 
+    /**
+     * @return the subgraphs in #m_net_name_to_subgraphs_map under \a aNetName, or nullptr if
+     *         the name has no entry.
+     */
+    std::vector<CONNECTION_SUBGRAPH*>* findNetNameSubgraphs( const wxString& aNetName );
+
+    const std::vector<CONNECTION_SUBGRAPH*>* findNetNameSubgraphs( const wxString& aNetName ) const;
+
+    /// As above, for the (full) name of \a aConnection, keeping its handle on \a aConnection.
+    std::vector<CONNECTION_SUBGRAPH*>* findNetNameSubgraphs( const SCH_CONNECTION& aConnection );
+
+    const std::vector<CONNECTION_SUBGRAPH*>* findNetNameSubgraphs( int aHandle ) const;
+
+    /**
+     * Rebuild #m_net_names from the names still used as keys by the caches, once most of
+     * the names in it are no longer used.  Called after Merge(), which is where names of
+     * edited nets would otherwise pile up.
+     */
+    void pruneNetNames();
+
     /**
      * Ensure all members of the bus connection have a valid net code assigned.
      *
@@ -761,16 +892,19 @@ private:
 
     std::unordered_map<wxString, std::shared_ptr<BUS_ALIAS>> m_bus_alias_cache;
 
-    std::unordered_map<wxString, int> m_net_name_to_code_map;
+    /// The names used as keys by the caches below.
+    NET_NAME_TABLE m_net_names;
 
-    std::unordered_map<wxString, int> m_bus_name_to_code_map;
+    std::unordered_map<int, int> m_net_name_to_code_map;
 
-    std::unordered_map<wxString, std::vector<const CONNECTION_SUBGRAPH*>> m_global_label_cache;
+    std::unordered_map<int, int> m_bus_name_to_code_map;
 
-    std::map< std::pair<SCH_SHEET_PATH, wxString>,
+    std::unordered_map<int, std::vector<const CONNECTION_SUBGRAPH*>> m_global_label_cache;
+
+    std::map< std::pair<SCH_SHEET_PATH, int>,
               std::vector<const CONNECTION_SUBGRAPH*> > m_local_label_cache;
 
-    std::unordered_map<wxString, std::vector<CONNECTION_SUBGRAPH*>> m_net_name_to_subgraphs_map;
+    std::unordered_map<int, std::vector<CONNECTION_SUBGRAPH*>> m_net_name_to_subgraphs_map;
 
     std::unordered_map<SCH_ITEM*, CONNECTION_SUBGRAPH*> m_item_to_subgraph_map;
 
@@ -782,6 +916,9 @@ private:
 
     int m_last_subgraph_code;
 
+    /// The graph this one will be merged into, whose net codes it reuses.
+    const CONNECTION_GRAPH* m_code_source;
+
     SCHEMATIC* m_schematic;     ///< The schematic this graph represents.
 };
 
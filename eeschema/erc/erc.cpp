@@ -24,12 +24,15 @@
  */
 
 #include <algorithm>
+#include <functional>
+#include <future>
 #include <numeric>
 
 #include "connection_graph.h"
 #include "kiface_ids.h"
 #include <advanced_config.h>
 #include <common.h>     // for ExpandEnvVarSubstitutions
+#include <core/thread_pool.h>
 #include <erc/erc.h>
 #include <erc/erc_sch_pin_context.h>
 #include <gal/graphics_abstraction_layer.h>
@@ -135,6 +138,34 @@ const std::set<ELECTRICAL_PINTYPE> DrivenPinTypes =
 extern void CheckDuplicatePins( LIB_SYMBOL* aSymbol, std::vector<wxString>& aMessages,
                                 UNITS_PROVIDER* aUnitsProvider );
 
+
+thread_local ERC_MARKER_BUFFER* ERC_MARKER_BUFFER::s_current = nullptr;
+
+
+ERC_MARKER_BUFFER::~ERC_MARKER_BUFFER()
+{
+    for( const auto& [screen, marker] : m_markers )
+        delete marker;
+}
+
+
+void ERC_MARKER_BUFFER::Add( SCH_SCREEN* aScreen, SCH_MARKER* aMarker )
+{
+    if( s_current )
+        s_current->m_markers.emplace_back( aScreen, aMarker );
+    else
+        aScreen->Append( aMarker );
+}
+
+
+void ERC_MARKER_BUFFER::Commit()
+{
+    for( const auto& [screen, marker] : m_markers )
+        screen->Append( marker );
+
+    m_markers.clear();
+}
+
 int ERC_TESTER::TestDuplicateSheetNames( bool aCreateMarker )
 {
     int err_count = 0;
@@ -165,7 +196,7 @@ int ERC_TESTER::TestDuplicateSheetNames( bool aCreateMarker )
                         ercItem->SetItems( sheet, test_item );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, sheet->GetPosition() );
-                        screen->Append( marker );
+                        ERC_MARKER_BUFFER::Add( screen, marker );
                     }
 
                     err_count++;
@@ -205,7 +236,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetErrorMessage( warningExpr.GetMatch( text, 1 ) );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, item->GetPosition() );
-                    screen->Append( marker );
+                    ERC_MARKER_BUFFER::Add( screen, marker );
                 }
 
                 if( errorExpr.Matches( text ) )
@@ -217,7 +248,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetErrorMessage( errorExpr.GetMatch( text, 1 ) );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, item->GetPosition() );
-                    screen->Append( marker );
+                    ERC_MARKER_BUFFER::Add( screen, marker );
                 }
             };
 
@@ -251,7 +282,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, field.GetPosition() );
-                        screen->Append( marker );
+                        ERC_MARKER_BUFFER::Add( screen, marker );
                     }
 
                     testAssertion( &field, sheet, screen, field.GetText() );
@@ -279,7 +310,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                                     VECTOR2I pos = bbox.Centre() + symbol->GetPosition();
 
                                     SCH_MARKER* marker = new SCH_MARKER( ercItem, pos );
-                                    screen->Append( marker );
+                                    ERC_MARKER_BUFFER::Add( screen, marker );
                                 }
 
                                testAssertion( symbol, sheet, screen, textItem->GetText() );
@@ -299,7 +330,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                                     VECTOR2I pos = bbox.Centre() + symbol->GetPosition();
 
                                     SCH_MARKER* marker = new SCH_MARKER( ercItem, pos );
-                                    screen->Append( marker );
+                                    ERC_MARKER_BUFFER::Add( screen, marker );
                                 }
 
                                testAssertion( symbol, sheet, screen, textboxItem->GetText() );
@@ -317,7 +348,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, field.GetPosition() );
-                        screen->Append( marker );
+                        ERC_MARKER_BUFFER::Add( screen, marker );
                     }
 
                     testAssertion( &field, sheet, screen, field.GetText() );
@@ -336,7 +367,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, field.GetPosition() );
-                        screen->Append( marker );
+                        ERC_MARKER_BUFFER::Add( screen, marker );
                     }
 
                     testAssertion( &field, sheet, screen, field.GetText() );
@@ -354,7 +385,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, pin->GetPosition() );
-                        screen->Append( marker );
+                        ERC_MARKER_BUFFER::Add( screen, marker );
                     }
                 }
             }
@@ -367,7 +398,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetSheetSpecificPath( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, text->GetPosition() );
-                    screen->Append( marker );
+                    ERC_MARKER_BUFFER::Add( screen, marker );
                 }
 
                 testAssertion( text, sheet, screen, text->GetText() );
@@ -381,7 +412,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetSheetSpecificPath( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, textBox->GetPosition() );
-                    screen->Append( marker );
+                    ERC_MARKER_BUFFER::Add( screen, marker );
                 }
 
                 testAssertion( textBox, sheet, screen, textBox->GetText() );
@@ -399,7 +430,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     erc->SetSheetSpecificPath( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( erc, text->GetPosition() );
-                    screen->Append( marker );
+                    ERC_MARKER_BUFFER::Add( screen, marker );
                 }
             }
         }
@@ -438,7 +469,7 @@ int ERC_TESTER::TestConflictingBusAliases()
                     ercItem->SetErrorMessage( msg );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, VECTOR2I() );
-                    test->GetParent()->Append( marker );
+                    ERC_MARKER_BUFFER::Add( test->GetParent(), marker );
 
                     ++err_count;
                 }
@@ -502,7 +533,7 @@ int ERC_TESTER::TestMultiunitFootprints()
                 ercItem->SetItems( unit, secondUnit );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, secondUnit->GetPosition() );
-                secondRef.GetSheetPath().LastScreen()->Append( marker );
+                ERC_MARKER_BUFFER::Add( secondRef.GetSheetPath().LastScreen(), marker );
 
                 ++errors;
             }
@@ -565,7 +596,7 @@ int ERC_TESTER::TestMissingUnits()
                     ercItem->SetItemsSheetPaths( base_ref.GetSheetPath() );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, unit->GetPosition() );
-                    base_ref.GetSheetPath().LastScreen()->Append( marker );
+                    ERC_MARKER_BUFFER::Add( base_ref.GetSheetPath().LastScreen(), marker );
 
                     ++errors;
                 };
@@ -668,7 +699,7 @@ int ERC_TESTER::TestMissingNetclasses()
                                                             netclass ) );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, item->GetPosition() );
-                sheet.LastScreen()->Append( marker );
+                ERC_MARKER_BUFFER::Add( sheet.LastScreen(), marker );
             };
 
     for( const SCH_SHEET_PATH& sheet : m_sheetList )
@@ -749,7 +780,7 @@ int ERC_TESTER::TestLabelMultipleWires()
                 ercItem->SetSheetSpecificPath( sheet );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, pair.first );
-                sheet.LastScreen()->Append( marker );
+                ERC_MARKER_BUFFER::Add( sheet.LastScreen(), marker );
             }
         }
     }
@@ -803,7 +834,7 @@ int ERC_TESTER::TestFourWayJunction()
                 ercItem->SetSheetSpecificPath( sheet );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, pair.first );
-                sheet.LastScreen()->Append( marker );
+                ERC_MARKER_BUFFER::Add( sheet.LastScreen(), marker );
             }
         }
     }
@@ -872,7 +903,7 @@ int ERC_TESTER::TestNoConnectPins()
                 ercItem->SetSheetSpecificPath( sheet );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, pair.first );
-                sheet.LastScreen()->Append( marker );
+                ERC_MARKER_BUFFER::Add( sheet.LastScreen(), marker );
             }
         }
     }
@@ -998,7 +1029,7 @@ int ERC_TESTER::TestPinToPin()
                                               ElectricalPinTypeGetText( testType ) ) );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, refPin.Pin()->GetPosition() );
-                    pinToScreenMap[refPin.Pin()]->Append( marker );
+                    ERC_MARKER_BUFFER::Add( pinToScreenMap[refPin.Pin()], marker );
                     errors++;
                 }
             }
@@ -1017,7 +1048,7 @@ int ERC_TESTER::TestPinToPin()
                 ercItem->SetItemsSheetPaths( needsDriver.Sheet() );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, needsDriver.Pin()->GetPosition() );
-                pinToScreenMap[needsDriver.Pin()]->Append( marker );
+                ERC_MARKER_BUFFER::Add( pinToScreenMap[needsDriver.Pin()], marker );
                 errors++;
             }
         }
@@ -1072,7 +1103,7 @@ int ERC_TESTER::TestMultUnitPinConflicts()
                         ercItem->SetItemsSheetPaths( sheet, sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, pin->GetPosition() );
-                        sheet.LastScreen()->Append( marker );
+                        ERC_MARKER_BUFFER::Add( sheet.LastScreen(), marker );
                         errors += 1;
                     }
                 }
@@ -1091,9 +1122,9 @@ int ERC_TESTER::TestSameLocalGlobalLabel()
     std::unordered_map<wxString, std::pair<SCH_ITEM*, SCH_SHEET_PATH>> globalLabels;
     std::unordered_map<wxString, std::pair<SCH_ITEM*, SCH_SHEET_PATH>> localLabels;
 
-    for( const std::pair<NET_NAME_CODE_CACHE_KEY, std::vector<CONNECTION_SUBGRAPH*>> net : m_nets )
+    for( const auto& [key, subgraphs] : m_nets )
     {
-        for( CONNECTION_SUBGRAPH* subgraph : net.second )
+        for( CONNECTION_SUBGRAPH* subgraph : subgraphs )
         {
             const SCH_SHEET_PATH& sheet = subgraph->GetSheet();
 
@@ -1117,21 +1148,21 @@ int ERC_TESTER::TestSameLocalGlobalLabel()
 
     for( auto& [globalText, globalItem] : globalLabels )
     {
-        for( auto& [localText, localItem] : localLabels )
+        auto localIt = localLabels.find( globalText );
+
+        if( localIt != localLabels.end() )
         {
-            if( globalText == localText )
-            {
-                std::shared_ptr<ERC_ITEM> ercItem =
-                        ERC_ITEM::Create( ERCE_SAME_LOCAL_GLOBAL_LABEL );
-                ercItem->SetItems( globalItem.first, localItem.first );
-                ercItem->SetSheetSpecificPath( globalItem.second );
-                ercItem->SetItemsSheetPaths( globalItem.second, localItem.second );
+            auto& [localText, localItem] = *localIt;
 
-                SCH_MARKER* marker = new SCH_MARKER( ercItem, globalItem.first->GetPosition() );
-                globalItem.second.LastScreen()->Append( marker );
+            std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_SAME_LOCAL_GLOBAL_LABEL );
+            ercItem->SetItems( globalItem.first, localItem.first );
+            ercItem->SetSheetSpecificPath( globalItem.second );
+            ercItem->SetItemsSheetPaths( globalItem.second, localItem.second );
 
-                errCount++;
-            }
+            SCH_MARKER* marker = new SCH_MARKER( ercItem, globalItem.first->GetPosition() );
+            ERC_MARKER_BUFFER::Add( globalItem.second.LastScreen(), marker );
+
+            errCount++;
         }
     }
 
@@ -1141,20 +1172,28 @@ int ERC_TESTER::TestSameLocalGlobalLabel()
 
 int ERC_TESTER::TestSimilarLabels()
 {
+    // The first item seen with each lower-cased name.  Every other item with that name is only
+    // compared with this one, so each item costs a single lookup.
+    struct FIRST_SEEN
+    {
+        wxString              m_text;
+        SCH_ITEM*             m_item;
+        const SCH_SHEET_PATH* m_sheet;     ///< Held by the subgraph, which outlives the map
+    };
+
     int errors = 0;
-    std::unordered_map<wxString, std::tuple<wxString, SCH_ITEM*, SCH_SHEET_PATH>> generalMap;
+    std::unordered_map<wxString, FIRST_SEEN> generalMap;
 
-    auto logError = [&]( const wxString& normalized, SCH_ITEM* item, const SCH_SHEET_PATH& sheet )
+    auto logError = [&]( const FIRST_SEEN& other, SCH_ITEM* item, const SCH_SHEET_PATH& sheet )
     {
-        auto& [otherText, otherItem, otherSheet] = generalMap.at( normalized );
         ERCE_T typeOfWarning = ERCE_SIMILAR_LABELS;
 
-        if( item->Type() == SCH_PIN_T && otherItem->Type() == SCH_PIN_T )
+        if( item->Type() == SCH_PIN_T && other.m_item->Type() == SCH_PIN_T )
         {
             //Two Pins
             typeOfWarning = ERCE_SIMILAR_POWER;
         }
-        else if( item->Type() == SCH_PIN_T || otherItem->Type() == SCH_PIN_T )
+        else if( item->Type() == SCH_PIN_T || other.m_item->Type() == SCH_PIN_T )
         {
             //Pin and Label
             typeOfWarning = ERCE_SIMILAR_LABEL_AND_POWER;
@@ -1166,17 +1205,30 @@ int ERC_TESTER::TestSimilarLabels()
         }
 
         std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( typeOfWarning );
-        ercItem->SetItems( item, otherItem );
+        ercItem->SetItems( item, other.m_item );
         ercItem->SetSheetSpecificPath( sheet );
-        ercItem->SetItemsSheetPaths( sheet, otherSheet );
+        ercItem->SetItemsSheetPaths( sheet, *other.m_sheet );
 
         SCH_MARKER* marker = new SCH_MARKER( ercItem, item->GetPosition() );
-        sheet.LastScreen()->Append( marker );
+        ERC_MARKER_BUFFER::Add( sheet.LastScreen(), marker );
     };
 
-    for( const std::pair<NET_NAME_CODE_CACHE_KEY, std::vector<CONNECTION_SUBGRAPH*>> net : m_nets )
+    auto checkName = [&]( const wxString& unnormalized, SCH_ITEM* item,
+                          const SCH_SHEET_PATH& sheet )
     {
-        for( CONNECTION_SUBGRAPH* subgraph : net.second )
+        auto [it, inserted] = generalMap.try_emplace( unnormalized.Lower(),
+                                                      FIRST_SEEN{ unnormalized, item, &sheet } );
+
+        if( !inserted && unnormalized != it->second.m_text )
+        {
+            logError( it->second, item, sheet );
+            errors += 1;
+        }
+    };
+
+    for( const auto& [key, subgraphs] : m_nets )
+    {
+        for( CONNECTION_SUBGRAPH* subgraph : subgraphs )
         {
             const SCH_SHEET_PATH& sheet = subgraph->GetSheet();
 
@@ -1189,22 +1241,8 @@ int ERC_TESTER::TestSimilarLabels()
                 case SCH_GLOBAL_LABEL_T:
                 {
                     SCH_LABEL_BASE* label = static_cast<SCH_LABEL_BASE*>( item );
-                    wxString        unnormalized = label->GetShownText( &sheet, false );
-                    wxString        normalized = unnormalized.Lower();
-
-                    if( !generalMap.count( normalized ) )
-                    {
-                        generalMap[normalized] = std::make_tuple( unnormalized, label, sheet );
-                    }
-
-                    auto& [otherText, otherItem, otherSheet] = generalMap.at( normalized );
-
-                    if( unnormalized != otherText )
-                    {
-                        logError( normalized, label, sheet );
-                        errors += 1;
-                    }
 
+                    checkName( label->GetShownText( &sheet, false ), label, sheet );
                     break;
                 }
                 case SCH_PIN_T:
@@ -1217,22 +1255,8 @@ int ERC_TESTER::TestSimilarLabels()
                     }
 
                     SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( pin->GetParentSymbol() );
-                    wxString    unnormalized = symbol->GetValue( true, &sheet, false );
-                    wxString    normalized = unnormalized.Lower();
-
-                    if( !generalMap.count( normalized ) )
-                    {
-                        generalMap[normalized] = std::make_tuple( unnormalized, pin, sheet );
-                    }
-
-                    auto& [otherText, otherItem, otherSheet] = generalMap.at( normalized );
-
-                    if( unnormalized != otherText )
-                    {
-                        logError( normalized, pin, sheet );
-                        errors += 1;
-                    }
 
+                    checkName( symbol->GetValue( true, &sheet, false ), pin, sheet );
                     break;
                 }
 
@@ -1355,7 +1379,7 @@ int ERC_TESTER::TestLibSymbolIssues()
 
         for( SCH_MARKER* marker : markers )
         {
-            screen->Append( marker );
+            ERC_MARKER_BUFFER::Add( screen, marker );
             err_count += 1;
         }
     }
@@ -1435,7 +1459,7 @@ int ERC_TESTER::TestFootprintLinkIssues( KIFACE* aCvPcb, PROJECT* aProject )
 
         for( SCH_MARKER* marker : markers )
         {
-            sheet.LastScreen()->Append( marker );
+            ERC_MARKER_BUFFER::Add( sheet.LastScreen(), marker );
             err_count += 1;
         }
     }
@@ -1498,7 +1522,7 @@ int ERC_TESTER::TestOffGridEndpoints()
 
         for( SCH_MARKER* marker : markers )
         {
-            screen->Append( marker );
+            ERC_MARKER_BUFFER::Add( screen, marker );
             err_count += 1;
         }
     }
@@ -1551,7 +1575,7 @@ int ERC_TESTER::TestSimModelIssues()
 
         for( SCH_MARKER* marker : markers )
         {
-            sheet.LastScreen()->Append( marker );
+            ERC_MARKER_BUFFER::Add( sheet.LastScreen(), marker );
             err_count += 1;
         }
     }
@@ -1598,16 +1622,25 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
 
     m_schematic->ConnectionGraph()->RunERC();
 
-    if( aProgressReporter )
-        aProgressReporter->AdvancePhase( _( "Checking units..." ) );
+    // The remaining tests are listed with the phase they report (if any) and whether they only
+    // read the schematic, and so can be run on the thread pool with ParallelERC.  Those that
+    // load libraries or go through the project stay on this thread.
+    struct ERC_STEP
+    {
+        wxString              m_phase;
+        std::function<void()> m_test;
+        bool                  m_threadSafe;
+    };
+
+    std::vector<ERC_STEP> steps;
+
+    steps.push_back( { _( "Checking units..." ), nullptr, true } );
 
     // Test is all units of each multiunit symbol have the same footprint assigned.
     if( m_settings.IsTestEnabled( ERCE_DIFFERENT_UNIT_FP ) )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking footprints..." ) );
-
-        TestMultiunitFootprints();
+        steps.push_back( { _( "Checking footprints..." ),
+                           [&]() { TestMultiunitFootprints(); }, true } );
     }
 
     if( m_settings.IsTestEnabled( ERCE_MISSING_UNIT )
@@ -1615,21 +1648,20 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
         || m_settings.IsTestEnabled( ERCE_MISSING_POWER_INPUT_PIN )
         || m_settings.IsTestEnabled( ERCE_MISSING_BIDI_PIN ) )
     {
-        TestMissingUnits();
+        steps.push_back( { wxEmptyString, [&]() { TestMissingUnits(); }, true } );
     }
 
-    if( aProgressReporter )
-        aProgressReporter->AdvancePhase( _( "Checking pins..." ) );
+    steps.push_back( { _( "Checking pins..." ), nullptr, true } );
 
     if( m_settings.IsTestEnabled( ERCE_DIFFERENT_UNIT_NET ) )
-        TestMultUnitPinConflicts();
+        steps.push_back( { wxEmptyString, [&]() { TestMultUnitPinConflicts(); }, true } );
 
     // Test pins on each net against the pin connection table
     if( m_settings.IsTestEnabled( ERCE_PIN_TO_PIN_ERROR )
         || m_settings.IsTestEnabled( ERCE_POWERPIN_NOT_DRIVEN )
         || m_settings.IsTestEnabled( ERCE_PIN_NOT_DRIVEN ) )
     {
-        TestPinToPin();
+        steps.push_back( { wxEmptyString, [&]() { TestPinToPin(); }, true } );
     }
 
     // Test similar labels (i;e. labels which are identical when
@@ -1639,84 +1671,137 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
         || m_settings.IsTestEnabled( ERCE_SIMILAR_LABEL_AND_POWER )
         || m_settings.IsTestEnabled( ERCE_SAME_LOCAL_GLOBAL_LABEL ) )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking labels..." ) );
-
-        TestSimilarLabels();
-        TestSameLocalGlobalLabel();
+        steps.push_back( { _( "Checking labels..." ),
+                           [&]()
+                           {
+                               TestSimilarLabels();
+                               TestSameLocalGlobalLabel();
+                           },
+                           true } );
     }
 
     if( m_settings.IsTestEnabled( ERCE_UNRESOLVED_VARIABLE ) )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for unresolved variables..." ) );
-
-        TestTextVars( aDrawingSheet );
+        steps.push_back( { _( "Checking for unresolved variables..." ),
+                           [&]() { TestTextVars( aDrawingSheet ); }, false } );
     }
 
     if( m_settings.IsTestEnabled( ERCE_SIMULATION_MODEL ) )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking SPICE models..." ) );
-
-        TestSimModelIssues();
+        steps.push_back( { _( "Checking SPICE models..." ),
+                           [&]() { TestSimModelIssues(); }, false } );
     }
 
     if( m_settings.IsTestEnabled( ERCE_NOCONNECT_CONNECTED ) )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking no connect pins for connections..." ) );
-
-        TestNoConnectPins();
+        steps.push_back( { _( "Checking no connect pins for connections..." ),
+                           [&]() { TestNoConnectPins(); }, true } );
     }
 
     if( m_settings.IsTestEnabled( ERCE_LIB_SYMBOL_ISSUES )
         || m_settings.IsTestEnabled( ERCE_LIB_SYMBOL_MISMATCH ) )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for library symbol issues..." ) );
-
-        TestLibSymbolIssues();
+        steps.push_back( { _( "Checking for library symbol issues..." ),
+                           [&]() { TestLibSymbolIssues(); }, false } );
     }
 
     if( m_settings.IsTestEnabled( ERCE_FOOTPRINT_LINK_ISSUES ) && aCvPcb )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for footprint link issues..." ) );
-
-        TestFootprintLinkIssues( aCvPcb, aProject );
+        steps.push_back( { _( "Checking for footprint link issues..." ),
+                           [&]() { TestFootprintLinkIssues( aCvPcb, aProject ); }, false } );
     }
 
     if( m_settings.IsTestEnabled( ERCE_ENDPOINT_OFF_GRID ) )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for off grid pins and wires..." ) );
-
-        TestOffGridEndpoints();
+        steps.push_back( { _( "Checking for off grid pins and wires..." ),
+                           [&]() { TestOffGridEndpoints(); }, true } );
     }
 
     if( m_settings.IsTestEnabled( ERCE_FOUR_WAY_JUNCTION ) )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for four way junctions..." ) );
-
-        TestFourWayJunction();
+        steps.push_back( { _( "Checking for four way junctions..." ),
+                           [&]() { TestFourWayJunction(); }, true } );
     }
 
     if( m_settings.IsTestEnabled( ERCE_LABEL_MULTIPLE_WIRES ) )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for labels on more than one wire..." ) );
-
-        TestLabelMultipleWires();
+        steps.push_back( { _( "Checking for labels on more than one wire..." ),
+                           [&]() { TestLabelMultipleWires(); }, true } );
     }
 
     if( m_settings.IsTestEnabled( ERCE_UNDEFINED_NETCLASS ) )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for undefined netclasses..." ) );
+        steps.push_back( { _( "Checking for undefined netclasses..." ),
+                           [&]() { TestMissingNetclasses(); }, false } );
+    }
 
-        TestMissingNetclasses();
+    if( !ADVANCED_CFG::GetCfg().m_ParallelERC )
+    {
+        for( const ERC_STEP& step : steps )
+        {
+            if( aProgressReporter && !step.m_phase.IsEmpty() )
+                aProgressReporter->AdvancePhase( step.m_phase );
+
+            if( step.m_test )
+                step.m_test();
+        }
+    }
+    else
+    {
+        // The tests which stay on this thread resolve text variables, load libraries and fill
+        // the text and netclass caches, so they are all run before the pool starts.  Of the
+        // tests on the pool only the label test resolves text, and none use the bounding box
+        // or render caches.
+        //
+        // Every test keeps its markers until all of them are done, as the tests on the pool
+        // read the screens.  Phases are reported as the tests are run or waited for.
+        thread_pool&                   tp = GetKiCadThreadPool();
+        std::vector<ERC_MARKER_BUFFER> buffers( steps.size() );
+        std::vector<std::future<void>> results( steps.size() );
+
+        for( size_t ii = 0; ii < steps.size(); ++ii )
+        {
+            if( steps[ii].m_threadSafe )
+                continue;
+
+            if( aProgressReporter && !steps[ii].m_phase.IsEmpty() )
+                aProgressReporter->AdvancePhase( steps[ii].m_phase );
+
+            ERC_MARKER_BUFFER::SCOPE scope( buffers[ii] );
+            steps[ii].m_test();
+        }
+
+        for( size_t ii = 0; ii < steps.size(); ++ii )
+        {
+            if( steps[ii].m_test && steps[ii].m_threadSafe )
+            {
+                results[ii] = tp.submit( [&steps, &buffers, ii]()
+                                         {
+                                             ERC_MARKER_BUFFER::SCOPE scope( buffers[ii] );
+                                             steps[ii].m_test();
+                                         } );
+            }
+        }
+
+        for( size_t ii = 0; ii < steps.size(); ++ii )
+        {
+            if( !steps[ii].m_threadSafe )
+                continue;
+
+            if( aProgressReporter && !steps[ii].m_phase.IsEmpty() )
+                aProgressReporter->AdvancePhase( steps[ii].m_phase );
+
+            if( results[ii].valid() )
+                results[ii].wait();
+        }
+
+        for( size_t ii = 0; ii < steps.size(); ++ii )
+        {
+            if( results[ii].valid() )
+                results[ii].get();
+
+            buffers[ii].Commit();
+        }
     }
 
     m_schematic->ResolveERCExclusionsPostUpdate();
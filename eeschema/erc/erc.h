@@ -36,6 +36,7 @@
 
 
 class SCHEMATIC;
+class SCH_MARKER;
 class DS_PROXY_VIEW_ITEM;
 class SCH_EDIT_FRAME;
 class PROGRESS_REPORTER;
@@ -48,6 +49,58 @@ extern const wxString CommentERC_H[];
 extern const wxString CommentERC_V[];
 
 
+/**
+ * Holds the markers made by ERC tests running on the thread pool until they can be added to
+ * their screens.
+ *
+ * A screen can't be changed while other tests are reading it, so while a buffer is in scope on
+ * a thread (see SCOPE) the markers made on that thread are kept in it.  Commit() adds them in
+ * the order they were made; committing the buffers of several tests in the order of the tests
+ * gives the same markers, in the same order, as running the tests one after another.
+ */
+class ERC_MARKER_BUFFER
+{
+public:
+    ERC_MARKER_BUFFER() = default;
+    ERC_MARKER_BUFFER( const ERC_MARKER_BUFFER& ) = delete;
+    ERC_MARKER_BUFFER& operator=( const ERC_MARKER_BUFFER& ) = delete;
+
+    ~ERC_MARKER_BUFFER();
+
+    /**
+     * Add \a aMarker to \a aScreen, or to the buffer in scope on this thread if there is one.
+     * ERC tests should add their markers through here rather than SCH_SCREEN::Append().
+     */
+    static void Add( SCH_SCREEN* aScreen, SCH_MARKER* aMarker );
+
+    /// Add the buffered markers to their screens.  Must only be called once the tests are done.
+    void Commit();
+
+    /**
+     * Sends the markers made on the current thread to a buffer for as long as it is in scope.
+     */
+    class SCOPE
+    {
+    public:
+        SCOPE( ERC_MARKER_BUFFER& aBuffer ) :
+                m_previous( s_current )
+        {
+            s_current = &aBuffer;
+        }
+
+        ~SCOPE() { s_current = m_previous; }
+
+    private:
+        ERC_MARKER_BUFFER* m_previous;
+    };
+
+private:
+    std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>> m_markers;
+
+    static thread_local ERC_MARKER_BUFFER* s_current;
+};
+
+
 class ERC_TESTER
 {
 public:
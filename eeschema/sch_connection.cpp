@@ -219,6 +219,7 @@ void SCH_CONNECTION::Reset()
     m_local_prefix.Empty();
     m_cached_name.Empty();
     m_cached_name_with_path.Empty();
+    m_name_table = 0;
     m_prefix.Empty();
     m_bus_prefix.Empty();
     m_suffix .Empty();
@@ -380,6 +381,8 @@ wxString SCH_CONNECTION::GetNetName() const
 
 void SCH_CONNECTION::recacheName()
 {
+    m_name_table = 0;
+
     m_cached_name = m_name.IsEmpty() ? wxString( wxT( "<NO NET>" ) )
                                      : wxString( m_prefix ) << m_name << m_suffix;
 
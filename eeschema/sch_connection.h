@@ -22,6 +22,7 @@
 #ifndef _SCH_CONNECTION_H
 #define _SCH_CONNECTION_H
 
+#include <cstdint>
 #include <memory>
 #include <unordered_set>
 
@@ -142,6 +143,27 @@ public:
 
     wxString Name( bool aIgnoreSheet = false ) const;
 
+    /**
+     * @return the handle of Name( \a aIgnoreSheet ) in the net name table \a aTable of a
+     *         CONNECTION_GRAPH, or -1 if it isn't known.  The graph keeps these so that a name is
+     *         only hashed again once it changes.
+     */
+    int GetNameHandle( uint64_t aTable, bool aIgnoreSheet ) const
+    {
+        return m_name_table == aTable ? m_name_handles[aIgnoreSheet] : -1;
+    }
+
+    void SetNameHandle( uint64_t aTable, bool aIgnoreSheet, int aHandle ) const
+    {
+        if( m_name_table != aTable )
+        {
+            m_name_table = aTable;
+            m_name_handles[0] = m_name_handles[1] = -1;
+        }
+
+        m_name_handles[aIgnoreSheet] = aHandle;
+    }
+
     wxString LocalName() const { return m_local_name; }
 
     wxString FullLocalName() const
@@ -263,6 +285,10 @@ private:
 
     wxString m_cached_name_with_path; ///< Full name including sheet path (if not global)
 
+    /// The net name table the handles of the two names are from (see GetNameHandle())
+    mutable uint64_t m_name_table = 0;
+    mutable int      m_name_handles[2] = { -1, -1 };
+
     /**
      * For bus members, we want to keep track of the "local" name of a member, that is,
      * the name it takes on from its parent bus name.  This is because we always want to use
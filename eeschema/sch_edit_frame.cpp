@@ -1768,24 +1768,11 @@ void SCH_EDIT_FRAME::RecalculateConnections( SCH_COMMIT* aCommit, SCH_CLEANUP_FL
                 }
             };
 
-    if( !ADVANCED_CFG::GetCfg().m_IncrementalConnectivity || aCleanupFlags == GLOBAL_CLEANUP
-            || m_undoList.m_CommandsList.empty()|| Schematic().ConnectionGraph()->IsMinor() )
-    {
-        // Clear all resolved netclass caches in case labels have changed
-        Prj().GetProjectFile().NetSettings()->ClearAllCaches();
-
-        // Update all rule areas so we can cascade implied connectivity changes
-        std::unordered_set<SCH_SCREEN*> all_screens;
-
-        for( const SCH_SHEET_PATH& path : list )
-            all_screens.insert( path.LastScreen() );
+    bool fullRecalculation = !ADVANCED_CFG::GetCfg().m_IncrementalConnectivity
+                             || aCleanupFlags == GLOBAL_CLEANUP
+                             || m_undoList.m_CommandsList.empty();
 
-        SCH_RULE_AREA::UpdateRuleAreasInScreens( all_screens, GetCanvas()->GetView() );
-
-        // Recalculate all connectivity
-        Schematic().ConnectionGraph()->Recalculate( list, true, &changeHandler );
-    }
-    else
+    if( !fullRecalculation )
     {
         struct CHANGED_ITEM
         {
@@ -1999,7 +1986,30 @@ void SCH_EDIT_FRAME::RecalculateConnections( SCH_COMMIT* aCommit, SCH_CLEANUP_FL
             netSettings->ClearCacheForNet( netName );
 
         new_graph.Recalculate( list, false, &changeHandler );
-        Schematic().ConnectionGraph()->Merge( new_graph );
+
+        // An edit which joined a global net to another one renames parts of them that were
+        // left out of the new graph
+        if( Schematic().ConnectionGraph()->CanMerge( new_graph ) )
+            Schematic().ConnectionGraph()->Merge( new_graph );
+        else
+            fullRecalculation = true;
+    }
+
+    if( fullRecalculation )
+    {
+        // Clear all resolved netclass caches in case labels have changed
+        Prj().GetProjectFile().NetSettings()->ClearAllCaches();
+
+        // Update all rule areas so we can cascade implied connectivity changes
+        std::unordered_set<SCH_SCREEN*> all_screens;
+
+        for( const SCH_SHEET_PATH& path : list )
+            all_screens.insert( path.LastScreen() );
+
+        SCH_RULE_AREA::UpdateRuleAreasInScreens( all_screens, GetCanvas()->GetView() );
+
+        // Recalculate all connectivity
+        Schematic().ConnectionGraph()->Recalculate( list, true, &changeHandler );
     }
 
     GetCanvas()->GetView()->UpdateAllItemsConditionally(
@@ -30,9 +30,15 @@
 #include <wx/mstream.h>
 #include <boost/algorithm/string/join.hpp>
 
+#include <condition_variable>
+#include <future>
+#include <map>
+#include <mutex>
+
 #include <advanced_config.h>
 #include <base_units.h>
 #include <build_version.h>
+#include <core/thread_pool.h>
 #include <ee_selection.h>
 #include <font/fontconfig.h>
 #include <io/kicad/kicad_io_utils.h>
@@ -93,6 +99,7 @@ void SCH_IO_KICAD_SEXPR::init( SCHEMATIC* aSchematic, const STRING_UTF8_MAP* aPr
     m_rootSheet       = nullptr;
     m_schematic       = aSchematic;
     m_cache           = nullptr;
+    m_prefetcher      = nullptr;
     m_out             = nullptr;
     m_nextFreeFieldId = 100; // number arbitrarily > MANDATORY_FIELDS or SHEET_MANDATORY_FIELDS
 }
@@ -157,7 +164,25 @@ SCH_SHEET* SCH_IO_KICAD_SEXPR::LoadSchematicFile( const wxString& aFileName, SCH
 
         newSheet->SetFileName( relPath.GetFullPath() );
         m_rootSheet = newSheet.get();
-        loadHierarchy( SCH_SHEET_PATH(), newSheet.get() );
+
+        std::unique_ptr<SCH_SHEET_PREFETCHER> prefetcher;
+
+        if( ADVANCED_CFG::GetCfg().m_ParallelSchematicLoad )
+            prefetcher = std::make_unique<SCH_SHEET_PREFETCHER>( aSchematic, m_rootSheet );
+
+        m_prefetcher = prefetcher.get();
+
+        try
+        {
+            loadHierarchy( SCH_SHEET_PATH(), newSheet.get() );
+        }
+        catch( ... )
+        {
+            m_prefetcher = nullptr;
+            throw;
+        }
+
+        m_prefetcher = nullptr;
 
         // If we got here, the schematic loaded successfully.
         sheet = newSheet.release();
@@ -179,6 +204,206 @@ SCH_SHEET* SCH_IO_KICAD_SEXPR::LoadSchematicFile( const wxString& aFileName, SCH
 }
 
 
+/**
+ * Parses the sheet files of a schematic on the thread pool, ahead of the walk of the hierarchy
+ * in SCH_IO_KICAD_SEXPR::loadHierarchy().
+ *
+ * Each file is parsed once however many sheets use it, and the sheets found in it are queued
+ * in turn, so the whole hierarchy is read without waiting for the walk.  The walk still takes
+ * the screens in its own order and does everything else (sheet sharing, ancestor checks and
+ * error reporting) as before, so the result is the same as a serial load.
+ *
+ * The parts of a parse which touch the schematic as a whole (fonts, embedded files and library
+ * symbol links) are left to SCH_IO_KICAD_SEXPR_PARSER::FinishSchematic(), which is run from the
+ * walk.  Files with embedded files are left to the walk altogether.
+ */
+class SCH_SHEET_PREFETCHER
+{
+public:
+    SCH_SHEET_PREFETCHER( SCHEMATIC* aSchematic, SCH_SHEET* aRootSheet ) :
+            m_schematic( aSchematic ),
+            m_rootSheet( aRootSheet ),
+            m_pending( 0 )
+    {
+    }
+
+    ~SCH_SHEET_PREFETCHER()
+    {
+        // Parses still running (of files the walk didn't get to) refer to this object
+        std::unique_lock<std::mutex> lock( m_mutex );
+        m_idle.wait( lock, [&]() { return m_pending == 0; } );
+    }
+
+    /**
+     * Queue the files of the sheets in \a aScreen which haven't been seen yet.
+     *
+     * @param aPath is the path of the file \a aScreen was loaded from, which relative sheet
+     *              file names are relative to.
+     */
+    void Prefetch( SCH_SCREEN* aScreen, const wxString& aPath )
+    {
+        for( SCH_ITEM* item : aScreen->Items().OfType( SCH_SHEET_T ) )
+        {
+            wxFileName fileName = static_cast<SCH_SHEET*>( item )->GetFileName();
+
+            if( !fileName.IsAbsolute() )
+                fileName.MakeAbsolute( aPath );
+
+            std::lock_guard<std::mutex> lock( m_mutex );
+
+            if( m_entries.count( fileName.GetFullPath() ) )
+                continue;
+
+            std::shared_ptr<ENTRY> entry = std::make_shared<ENTRY>();
+            entry->m_path = fileName.GetFullPath();
+
+            m_entries[entry->m_path] = entry;
+            m_pending++;
+
+            entry->m_done = GetKiCadThreadPool().submit( [this, entry]() { parse( entry ); } );
+        }
+    }
+
+    /**
+     * Give \a aSheet the screen parsed from \a aPath, waiting for the parse if need be.
+     *
+     * A file is only handed out once.  Parse errors are thrown from here, just as loading the
+     * file directly would throw them.
+     *
+     * @return false if the file wasn't parsed ahead and should be loaded directly.
+     */
+    bool Take( const wxString& aPath, SCH_SHEET* aSheet, PROGRESS_REPORTER* aReporter )
+    {
+        std::shared_ptr<ENTRY> entry;
+
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            auto it = m_entries.find( aPath );
+
+            if( it == m_entries.end() )
+            {
+                // Loaded directly; don't parse it again if another sheet turns up using it
+                entry = std::make_shared<ENTRY>();
+                entry->m_path = aPath;
+                entry->m_taken = true;
+                m_entries[aPath] = entry;
+                return false;
+            }
+
+            entry = it->second;
+
+            if( entry->m_taken )
+                return false;
+
+            entry->m_taken = true;
+        }
+
+        if( aReporter )
+            aReporter->Report( wxString::Format( _( "Loading %s..." ), aPath ) );
+
+        while( entry->m_done.wait_for( std::chrono::milliseconds( 100 ) )
+                != std::future_status::ready )
+        {
+            if( aReporter && !aReporter->KeepRefreshing() )
+                THROW_IO_ERROR( _( "Open cancelled by user." ) );
+        }
+
+        if( entry->m_fallback )
+            return false;
+
+        if( entry->m_holder )
+        {
+            SCH_SCREEN* screen = entry->m_holder->GetScreen();
+
+            // The parser parents the sub-sheets to the sheet it parses into, which is about to
+            // be deleted
+            for( SCH_ITEM* item : screen->Items() )
+            {
+                if( item->GetParent() == entry->m_holder.get() )
+                    item->SetParent( aSheet );
+            }
+
+            aSheet->SetScreen( screen );
+            entry->m_holder.reset();
+        }
+
+        if( entry->m_exception )
+        {
+            entry->m_parser.reset();
+            entry->m_reader.reset();
+            std::rethrow_exception( entry->m_exception );
+        }
+
+        entry->m_parser->FinishSchematic( aSheet );
+        entry->m_parser.reset();
+        entry->m_reader.reset();
+
+        return true;
+    }
+
+private:
+    struct ENTRY
+    {
+        wxString                                   m_path;
+        bool                                       m_taken = false;
+        bool                                       m_fallback = false;
+
+        /// Owns the parsed screen until it is taken
+        std::unique_ptr<SCH_SHEET>                 m_holder;
+        std::unique_ptr<MAPPED_FILE_LINE_READER>   m_reader;
+        std::unique_ptr<SCH_IO_KICAD_SEXPR_PARSER> m_parser;
+        std::exception_ptr                         m_exception;
+        std::future<void>                          m_done;
+    };
+
+    void parse( std::shared_ptr<ENTRY> aEntry )
+    {
+        try
+        {
+            aEntry->m_reader = std::make_unique<MAPPED_FILE_LINE_READER>( aEntry->m_path );
+
+            std::string_view text( aEntry->m_reader->Data(), aEntry->m_reader->Size() );
+
+            if( text.find( "(embedded_" ) != std::string_view::npos )
+            {
+                aEntry->m_fallback = true;
+            }
+            else
+            {
+                aEntry->m_holder = std::make_unique<SCH_SHEET>( m_schematic );
+                aEntry->m_holder->SetScreen( new SCH_SCREEN( m_schematic ) );
+                aEntry->m_holder->GetScreen()->SetFileName( aEntry->m_path );
+
+                aEntry->m_parser = std::make_unique<SCH_IO_KICAD_SEXPR_PARSER>(
+                        aEntry->m_reader.get(), nullptr, 0, m_rootSheet, false );
+                aEntry->m_parser->SetDeferFinish( true );
+                aEntry->m_parser->ParseSchematic( aEntry->m_holder.get() );
+            }
+        }
+        catch( ... )
+        {
+            aEntry->m_exception = std::current_exception();
+        }
+
+        // As in loadHierarchy(), sheets parsed before an error are still loaded
+        if( aEntry->m_holder )
+            Prefetch( aEntry->m_holder->GetScreen(), wxFileName( aEntry->m_path ).GetPath() );
+
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_pending--;
+        m_idle.notify_all();
+    }
+
+    SCHEMATIC*                                     m_schematic;
+    SCH_SHEET*                                     m_rootSheet;
+
+    std::mutex                                     m_mutex;
+    std::condition_variable                        m_idle;
+    int                                            m_pending;   ///< Parses not yet finished
+    std::map<wxString, std::shared_ptr<ENTRY>>     m_entries;   ///< By full file path
+};
+
+
 // Everything below this comment is recursive.  Modify with care.
 
 void SCH_IO_KICAD_SEXPR::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath, SCH_SHEET* aSheet )
@@ -248,7 +473,12 @@ void SCH_IO_KICAD_SEXPR::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath,
 
             try
             {
-                loadFile( fileName.GetFullPath(), aSheet );
+                if( !m_prefetcher
+                        || !m_prefetcher->Take( fileName.GetFullPath(), aSheet,
+                                                m_progressReporter ) )
+                {
+                    loadFile( fileName.GetFullPath(), aSheet );
+                }
             }
             catch( const IO_ERROR& ioe )
             {
@@ -274,6 +504,10 @@ void SCH_IO_KICAD_SEXPR::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath,
                 aSheet->GetScreen()->SetFileExists( false );
             }
 
+            // Start on the files of the sub-sheets while this one is walked
+            if( m_prefetcher )
+                m_prefetcher->Prefetch( aSheet->GetScreen(), fileName.GetPath() );
+
             SCH_SHEET_PATH currentSheetPath = aParentSheetPath;
             currentSheetPath.push_back( aSheet );
 
@@ -299,7 +533,7 @@ void SCH_IO_KICAD_SEXPR::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath,
 
 void SCH_IO_KICAD_SEXPR::loadFile( const wxString& aFileName, SCH_SHEET* aSheet )
 {
-    FILE_LINE_READER reader( aFileName );
+    MAPPED_FILE_LINE_READER reader( aFileName );
 
     size_t lineCount = 0;
 
@@ -310,10 +544,7 @@ void SCH_IO_KICAD_SEXPR::loadFile( const wxString& aFileName, SCH_SHEET* aSheet
         if( !m_progressReporter->KeepRefreshing() )
             THROW_IO_ERROR( _( "Open cancelled by user." ) );
 
-        while( reader.ReadLine() )
-            lineCount++;
-
-        reader.Rewind();
+        lineCount = std::count( reader.Data(), reader.Data() + reader.Size(), '\n' );
     }
 
     SCH_IO_KICAD_SEXPR_PARSER parser( &reader, m_progressReporter, lineCount, m_rootSheet,
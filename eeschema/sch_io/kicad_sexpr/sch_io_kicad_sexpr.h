@@ -54,6 +54,7 @@ struct SCH_SYMBOL_INSTANCE;
 class STRING_UTF8_MAP;
 class EE_SELECTION;
 class SCH_IO_KICAD_SEXPR_LIB_CACHE;
+class SCH_SHEET_PREFETCHER;
 class LIB_SYMBOL;
 class SYMBOL_LIB;
 class BUS_ALIAS;
@@ -177,6 +178,8 @@ protected:
     SCHEMATIC*              m_schematic;
     OUTPUTFORMATTER*        m_out;              ///< The formatter for saving SCH_SCREEN objects.
     SCH_IO_KICAD_SEXPR_LIB_CACHE* m_cache;
+    SCH_SHEET_PREFETCHER*   m_prefetcher;       ///< Parses sheet files ahead of loadHierarchy(),
+                                                ///<  or null.
 
     /// initialize PLUGIN like a constructor would.
     void init( SCHEMATIC* aSchematic, const STRING_UTF8_MAP* aProperties = nullptr );
@@ -66,7 +66,7 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::Load()
     wxLogTrace( traceSchLegacyPlugin, "Loading sexpr symbol library file '%s'",
                 m_libFileName.GetFullPath() );
 
-    FILE_LINE_READER reader( m_libFileName.GetFullPath() );
+    MAPPED_FILE_LINE_READER reader( m_libFileName.GetFullPath() );
 
     SCH_IO_KICAD_SEXPR_PARSER parser( &reader );
 
@@ -78,6 +78,7 @@ SCH_IO_KICAD_SEXPR_PARSER::SCH_IO_KICAD_SEXPR_PARSER( LINE_READER* aLineReader,
         m_unit( 1 ),
         m_bodyStyle( 1 ),
         m_appending( aIsAppending ),
+        m_deferFinish( false ),
         m_progressReporter( aProgressReporter ),
         m_lineReader( aLineReader ),
         m_lastProgressLine( 0 ),
@@ -2843,6 +2844,17 @@ void SCH_IO_KICAD_SEXPR_PARSER::ParseSchematic( SCH_SHEET* aSheet, bool aIsCopya
         m_rootUuid = screen->GetUuid();
     }
 
+    if( !m_deferFinish )
+        FinishSchematic( aSheet );
+}
+
+
+void SCH_IO_KICAD_SEXPR_PARSER::FinishSchematic( SCH_SHEET* aSheet )
+{
+    wxCHECK( aSheet && aSheet->GetScreen(), /* void */ );
+
+    SCH_SCREEN* screen = aSheet->GetScreen();
+
     screen->UpdateLocalLibSymbolLinks();
     screen->FixupEmbeddedData();
 
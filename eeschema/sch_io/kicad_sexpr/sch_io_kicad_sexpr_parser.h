@@ -36,6 +36,8 @@
 #include <sch_file_versions.h>
 #include <default_values.h>    // For some default values
 
+#include <charconv>
+
 
 class SCH_PIN;
 class PAGE_INFO;
@@ -110,6 +112,20 @@ public:
     void ParseSchematic( SCH_SHEET* aSheet, bool aIsCopyablyOnly = false,
                          int aFileVersion = SEXPR_SCHEMATIC_FILE_VERSION );
 
+    /**
+     * Leave the parts of ParseSchematic() which touch state shared by the whole schematic
+     * (fonts, embedded files and library symbol links) for a later call to FinishSchematic().
+     *
+     * This allows sheet files to be parsed on worker threads; FinishSchematic() must then be
+     * called on the main thread.  Files with embedded files can't be parsed this way.
+     */
+    void SetDeferFinish( bool aDefer ) { m_deferFinish = aDefer; }
+
+    /**
+     * Complete a schematic parsed with SetDeferFinish( true ).
+     */
+    void FinishSchematic( SCH_SHEET* aSheet );
+
     int GetParsedRequiredVersion() const { return m_requiredVersion; }
 
 private:
@@ -127,7 +143,18 @@ private:
 
     inline int parseInt()
     {
-        return (int)strtol( CurText(), nullptr, 10 );
+        // std::from_chars() is locale independent and doesn't need a nul terminated string,
+        // but unlike strtol() doesn't accept a leading '+'
+        const std::string& text = CurStr();
+        const char*        begin = text.data();
+        const char*        end = begin + text.size();
+        int                value = 0;
+
+        if( begin < end && *begin == '+' )
+            ++begin;
+
+        std::from_chars( begin, end, value );
+        return value;
     }
 
     inline int parseInt( const char* aExpected )
@@ -238,6 +265,7 @@ private:
     int      m_bodyStyle;         ///< The current body style being parsed.
     wxString m_symbolName;        ///< The current symbol name.
     bool     m_appending;         ///< Appending load status.
+    bool     m_deferFinish;       ///< See SetDeferFinish().
 
     /// Field IDs that have been read so far for the current symbol.
     std::set<int>      m_fieldIDsRead;
@@ -449,11 +449,12 @@ public:
     bool m_Use3DConnexionDriver;
 
     /**
-     * Use the new incremental netlister for realtime jobs.
+     * Use the new incremental netlister for realtime jobs, and update only the changed copper
+     * clusters when the board's connectivity is recalculated.
      *
      * Setting name: "IncrementalConnectivity"
      * Valid values: 0 or 1
-     * Default value: 0
+     * Default value: 1
      */
     bool m_IncrementalConnectivity;
 
@@ -617,15 +618,6 @@ public:
      */
     int m_MaxFilesystemWatchers;
 
-    /**
-     * Set the number of items in a schematic graph for it to be considered "minor"
-     *
-     * Setting name: "MinorSchematicGraphSize"
-     * Valid values: 0 to 2147483647
-     * Default value: 10000
-     */
-    int m_MinorSchematicGraphSize;
-
     /**
      * The number of recursions to resolve text variables.
      *
@@ -644,6 +636,119 @@ public:
      */
     bool m_ZoneConnectionFiller;
 
+    /**
+     * Refill zones incrementally after edits, only recomputing the fill around the items
+     * which changed.  Costs a second copy of each zone's fill in memory.
+     *
+     * Setting name: "IncrementalZoneFill"
+     * Valid values: true or false
+     * Default value: false
+     */
+    bool m_IncrementalZoneFill;
+
+    /**
+     * When there are fewer zone layers to fill than threads, split large copper zones into
+     * tiles which are filled in parallel and then stitched back together.
+     *
+     * Setting name: "ZoneFillTiling"
+     * Valid values: true or false
+     * Default value: false
+     */
+    bool m_ZoneFillTiling;
+
+    /**
+     * Keep a record of the item pairs which passed DRC alongside the board, and skip
+     * re-testing them in later runs if they haven't changed.
+     *
+     * Setting name: "DRCResultCache"
+     * Valid values: true or false
+     * Default value: false
+     */
+    bool m_DRCResultCache;
+
+    /**
+     * Parse the footprints, tracks, vias and zones of a board file on worker threads while
+     * the rest of the board is parsed.
+     *
+     * Setting name: "ParallelBoardLoad"
+     * Valid values: true or false
+     * Default value: false
+     */
+    bool m_ParallelBoardLoad;
+
+    /**
+     * Keep a single-file snapshot of each footprint library in the user cache directory, and
+     * load footprints from it instead of from the individual footprint files when they haven't
+     * changed.
+     *
+     * Setting name: "FootprintLibrarySnapshot"
+     * Valid values: true or false
+     * Default value: false
+     */
+    bool m_FootprintLibrarySnapshot;
+
+    /**
+     * Walk shoved lines around their obstacles in all four directions at once on worker
+     * threads, rather than trying one direction after another.
+     *
+     * Setting name: "ParallelShove"
+     * Valid values: true or false
+     * Default value: false
+     */
+    bool m_ParallelShove;
+
+    /**
+     * Keep the temporary paths and buffers of polygon boolean operations per thread and reuse
+     * them for the next operation, rather than allocating them for each one.
+     *
+     * Setting name: "PooledPolygonBooleans"
+     * Valid values: true or false
+     * Default value: false
+     */
+    bool m_PooledPolygonBooleans;
+
+    /**
+     * The memory budget, in MB, of the cache of polygon fracture and triangulation results
+     * shared by the views, plotters and exporters.  Zero disables the cache.
+     *
+     * Setting name: "SharedPolygonCacheSize"
+     * Valid values: 0 to 16384
+     * Default value: 0
+     */
+    int m_SharedPolygonCacheSize;
+
+    /**
+     * Build an index of the fill outlines of each zone layer, with their bounding boxes and the
+     * items each one touches, in the connectivity pass which finds isolated islands.  Island
+     * removal, the single-connection island check and the thermal spoke DRC then read it rather
+     * than intersecting every outline with the board outline or with every pad.
+     *
+     * Setting name: "ZoneAdjacencyIndex"
+     * Valid values: true or false
+     * Default value: false
+     */
+    bool m_ZoneAdjacencyIndex;
+
+    /**
+     * Parse the sheet files of a schematic on the thread pool while the hierarchy is loaded,
+     * rather than one at a time as each sheet is reached.
+     *
+     * Setting name: "ParallelSchematicLoad"
+     * Valid values: true or false
+     * Default value: false
+     */
+    bool m_ParallelSchematicLoad;
+
+    /**
+     * Run the ERC tests which only read the schematic on the thread pool, alongside each
+     * other, rather than one after another.
+     *
+     * Setting name: "ParallelERC"
+     * Valid values: true or false
+     * Default value: false
+     */
+    bool m_ParallelERC;
+
 ///@}
 
 private:
@@ -33,6 +33,15 @@
 
 #include <richio.h>
 
+/**
+ * DSNLEXER::parseDouble() uses the locale independent std::from_chars() where the compiler
+ * supports it for floating point.  Older compilers fall back to strtod(), in which case the
+ * caller must still hold a LOCALE_IO while parsing.
+ */
+#if ( defined( __GNUC__ ) && __GNUC__ < 11 ) || ( defined( __clang__ ) && __clang_major__ < 13 )
+#define DSNLEXER_PARSE_DOUBLE_USES_LOCALE
+#endif
+
 #ifndef SWIG
 /**
  * Hold a keyword string and its unique integer token.
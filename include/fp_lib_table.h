@@ -147,6 +147,19 @@ public:
     void FootprintEnumerate( wxArrayString& aFootprintNames, const wxString& aNickname,
                              bool aBestEfforts );
 
+    /**
+     * Return the chooser summary of every footprint in the library given by \a aNickname,
+     * without fully loading the footprints where the library's plugin supports it.
+     *
+     * @param aSummaries is filled in with the summaries of the footprints which could be read.
+     * @param aNickname is a locator for the "library", it is a "name" in LIB_TABLE_ROW.
+     * @param aBestEfforts if true, don't throw on errors.
+     *
+     * @throw IO_ERROR if the library cannot be found, or a footprint cannot be read.
+     */
+    void FootprintEnumerateSummaries( std::vector<FOOTPRINT_SUMMARY>& aSummaries,
+                                      const wxString& aNickname, bool aBestEfforts );
+
     /**
      * Generate a hashed timestamp representing the last-mod-times of the library indicated
      * by \a aNickname, or all libraries if \a aNickname is NULL.
@@ -29,6 +29,8 @@
 // "richio" after its author, Richard Hollenbeck, aka Dick Hollenbeck.
 
 
+#include <string>
+#include <string_view>
 #include <vector>
 #include <core/utf8.h>
 
@@ -246,6 +248,81 @@ protected:
 };
 
 
+/**
+ * A #LINE_READER that reads from text owned by someone else, which must outlive the reader.
+ *
+ * Unlike #STRING_LINE_READER the text is not copied, which makes this the cheaper choice for
+ * parsing pieces of a larger buffer.
+ */
+class KICOMMON_API STRING_VIEW_LINE_READER : public LINE_READER
+{
+public:
+    /**
+     * @param aText is the text to read, consisting of one or more lines separated with '\n'.
+     * @param aSource describes the source of @a aText for error reporting purposes.
+     * @param aStartingLineNumber is the initial line number to report on error.
+     * @param aMaxLineLength is the maximum number of bytes allowed in a line.
+     */
+    STRING_VIEW_LINE_READER( std::string_view aText, const wxString& aSource,
+                             unsigned aStartingLineNumber = 0,
+                             unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    char* ReadLine() override;
+
+    /**
+     * Rewind to the start of the text and reset the line number back to zero.
+     */
+    void Rewind()
+    {
+        m_ndx = 0;
+        m_lineNum = 0;
+    }
+
+    /**
+     * @return the whole of the text being read.  Not nul terminated.
+     */
+    const char* Data() const { return m_text.data(); }
+    size_t Size() const { return m_text.size(); }
+
+protected:
+    std::string_view m_text;
+    size_t           m_ndx;         ///< offset of the next line to read
+};
+
+
+/**
+ * A #LINE_READER that maps a whole file into memory and hands it out a line at a time.
+ *
+ * This avoids the per-character stdio reads of #FILE_LINE_READER, and also gives callers
+ * which want to scan the file themselves (e.g. to count lines for a progress reporter, or
+ * to split it up for parallel parsing) direct access to the contents through Data() and
+ * Size().  If the file can't be mapped (e.g. it is empty or not a regular file) it is read
+ * into memory instead.
+ *
+ * Unlike #FILE_LINE_READER the file is read in binary mode, so lines keep any "\r\n" line
+ * endings.  DSNLEXER treats '\r' as whitespace, so this makes no difference to it.
+ */
+class KICOMMON_API MAPPED_FILE_LINE_READER : public STRING_VIEW_LINE_READER
+{
+public:
+    /**
+     * @param aFileName is the name of the file to map and to use for error reporting purposes.
+     * @param aStartingLineNumber is the initial line number to report on error.
+     * @param aMaxLineLength is the maximum number of bytes allowed in a line.
+     *
+     * @throw IO_ERROR if @a aFileName cannot be opened.
+     */
+    MAPPED_FILE_LINE_READER( const wxString& aFileName, unsigned aStartingLineNumber = 0,
+                             unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    ~MAPPED_FILE_LINE_READER();
+
+protected:
+    void*       m_mapping;      ///< platform handle of the mapping, or nullptr if not mapped
+    std::string m_buffer;       ///< file contents when the file couldn't be mapped
+};
+
+
 /**
  * Is a #LINE_READER that reads from a multiline 8 bit wide std::string
  */
@@ -0,0 +1,415 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef PACKED_RTREE_H
+#define PACKED_RTREE_H
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+#define PACKED_RTREE_USE_SSE2
+#endif
+
+
+/**
+ * A static, bulk-loaded R-tree for read-mostly 2D indexes.
+ *
+ * Items are added with Add() and the tree is then packed with Build(); it can't be modified
+ * afterwards (other than by clearing it and starting again).
+ *
+ * Items are ordered along a Hilbert curve through their centres and packed bottom-up into
+ * nodes of NODE_SIZE children.  Each level of the tree is stored contiguously, and node boxes
+ * are stored as a structure of arrays so that a node's children can be tested against a query
+ * box several at a time (4-wide with SSE2, with a scalar fallback elsewhere).
+ *
+ * Compared to the dynamic RTree this has no per-node allocations, no pointer chasing and a
+ * much smaller memory footprint.  Boxes are inclusive, as with RTree.
+ */
+template <class T, int NODE_SIZE = 16>
+class PACKED_RTREE
+{
+    static_assert( NODE_SIZE % 4 == 0 && NODE_SIZE <= 32,
+                   "NODE_SIZE must be a multiple of 4 and no greater than 32" );
+
+public:
+    PACKED_RTREE() = default;
+
+    /**
+     * Queue an item for inclusion in the tree.  Has no effect on queries until Build() is
+     * called.
+     */
+    void Add( const int aMin[2], const int aMax[2], const T& aItem )
+    {
+        m_minX.push_back( aMin[0] );
+        m_minY.push_back( aMin[1] );
+        m_maxX.push_back( aMax[0] );
+        m_maxY.push_back( aMax[1] );
+        m_items.push_back( aItem );
+    }
+
+    /**
+     * Pack all added items into the tree.  Must only be called once (use clear() to start
+     * again).
+     */
+    void Build()
+    {
+        size_t count = m_items.size();
+
+        m_levels.clear();
+
+        if( count == 0 )
+            return;
+
+        sortItems();
+
+        // Level 0 holds the items themselves; each further level holds one box per group of
+        // NODE_SIZE boxes in the level below.  Levels are padded out to a whole number of
+        // groups so that a group can always be read NODE_SIZE boxes at a time.
+        m_levels.push_back( { 0, count } );
+        pad( count );
+
+        while( m_levels.back().count > NODE_SIZE )
+        {
+            const LEVEL& child = m_levels.back();
+            size_t       parentCount = ( child.count + NODE_SIZE - 1 ) / NODE_SIZE;
+            size_t       parentOffset = m_minX.size();
+
+            for( size_t group = 0; group < parentCount; ++group )
+            {
+                size_t first = child.offset + group * NODE_SIZE;
+                size_t last = child.offset + std::min( child.count, ( group + 1 ) * NODE_SIZE );
+
+                int minX = INT_MAX, minY = INT_MAX;
+                int maxX = INT_MIN, maxY = INT_MIN;
+
+                for( size_t ii = first; ii < last; ++ii )
+                {
+                    minX = std::min( minX, m_minX[ii] );
+                    minY = std::min( minY, m_minY[ii] );
+                    maxX = std::max( maxX, m_maxX[ii] );
+                    maxY = std::max( maxY, m_maxY[ii] );
+                }
+
+                m_minX.push_back( minX );
+                m_minY.push_back( minY );
+                m_maxX.push_back( maxX );
+                m_maxY.push_back( maxY );
+            }
+
+            m_levels.push_back( { parentOffset, parentCount } );
+            pad( parentCount );
+        }
+
+        m_minX.shrink_to_fit();
+        m_minY.shrink_to_fit();
+        m_maxX.shrink_to_fit();
+        m_maxY.shrink_to_fit();
+        m_items.shrink_to_fit();
+    }
+
+    /**
+     * Remove all items from the tree.
+     */
+    void clear()
+    {
+        m_minX.clear();
+        m_minY.clear();
+        m_maxX.clear();
+        m_maxY.clear();
+        m_items.clear();
+        m_levels.clear();
+    }
+
+    /**
+     * @return the number of items in the tree (after Build()).
+     */
+    size_t size() const
+    {
+        return m_levels.empty() ? 0 : m_levels[0].count;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * Call \a aVisitor for each item whose box overlaps the given box.  The visitor returns
+     * false to end the search early.
+     *
+     * @return the number of items visited.
+     */
+    template <class VISITOR>
+    int Search( const int aMin[2], const int aMax[2], VISITOR& aVisitor ) const
+    {
+        if( m_levels.empty() )
+            return 0;
+
+        // Pending (level, group) pairs.  At most NODE_SIZE are pushed per level.
+        std::pair<int, size_t> stack[32 * NODE_SIZE];
+        int                    top = 0;
+        int                    found = 0;
+
+        stack[top++] = { (int) m_levels.size() - 1, 0 };
+
+        while( top > 0 )
+        {
+            auto [level, group] = stack[--top];
+
+            const LEVEL& lvl = m_levels[level];
+            size_t       first = group * NODE_SIZE;
+            uint32_t     mask = overlapMask( lvl.offset + first, aMin, aMax );
+
+            // Drop the padding at the end of the level
+            if( lvl.count - first < NODE_SIZE )
+                mask &= ( 1u << ( lvl.count - first ) ) - 1;
+
+            if( level == 0 )
+            {
+                for( ; mask; mask &= mask - 1 )
+                {
+                    found++;
+
+                    if( !aVisitor( m_items[first + countTrailingZeros( mask )] ) )
+                        return found;
+                }
+            }
+            else
+            {
+                // Push in reverse so that children are visited in curve order
+                for( int ii = NODE_SIZE - 1; ii >= 0; --ii )
+                {
+                    if( mask & ( 1u << ii ) )
+                        stack[top++] = { level - 1, first + ii };
+                }
+            }
+        }
+
+        return found;
+    }
+
+private:
+    struct LEVEL
+    {
+        size_t offset;      ///< index of the level's first box
+        size_t count;       ///< number of (unpadded) boxes in the level
+    };
+
+    /**
+     * @return a bit per box in the group of NODE_SIZE boxes starting at \a aFirst, set if the
+     *         box overlaps the query box.
+     */
+    uint32_t overlapMask( size_t aFirst, const int aMin[2], const int aMax[2] ) const
+    {
+        const int* minX = m_minX.data() + aFirst;
+        const int* minY = m_minY.data() + aFirst;
+        const int* maxX = m_maxX.data() + aFirst;
+        const int* maxY = m_maxY.data() + aFirst;
+        uint32_t   mask = 0;
+
+#ifdef PACKED_RTREE_USE_SSE2
+        const __m128i qMinX = _mm_set1_epi32( aMin[0] );
+        const __m128i qMinY = _mm_set1_epi32( aMin[1] );
+        const __m128i qMaxX = _mm_set1_epi32( aMax[0] );
+        const __m128i qMaxY = _mm_set1_epi32( aMax[1] );
+
+        for( int ii = 0; ii < NODE_SIZE; ii += 4 )
+        {
+            __m128i bMinX = _mm_loadu_si128( reinterpret_cast<const __m128i*>( minX + ii ) );
+            __m128i bMinY = _mm_loadu_si128( reinterpret_cast<const __m128i*>( minY + ii ) );
+            __m128i bMaxX = _mm_loadu_si128( reinterpret_cast<const __m128i*>( maxX + ii ) );
+            __m128i bMaxY = _mm_loadu_si128( reinterpret_cast<const __m128i*>( maxY + ii ) );
+
+            // A box misses if it lies entirely to one side of the query box
+            __m128i miss = _mm_or_si128(
+                    _mm_or_si128( _mm_cmpgt_epi32( bMinX, qMaxX ), _mm_cmpgt_epi32( qMinX, bMaxX ) ),
+                    _mm_or_si128( _mm_cmpgt_epi32( bMinY, qMaxY ), _mm_cmpgt_epi32( qMinY, bMaxY ) ) );
+
+            uint32_t missBits = _mm_movemask_ps( _mm_castsi128_ps( miss ) );
+
+            mask |= ( ~missBits & 0xF ) << ii;
+        }
+#else
+        for( int ii = 0; ii < NODE_SIZE; ++ii )
+        {
+            uint32_t hit = ( minX[ii] <= aMax[0] ) & ( maxX[ii] >= aMin[0] )
+                         & ( minY[ii] <= aMax[1] ) & ( maxY[ii] >= aMin[1] );
+
+            mask |= hit << ii;
+        }
+#endif
+
+        return mask;
+    }
+
+    static int countTrailingZeros( uint32_t aValue )
+    {
+        int n = 0;
+
+        while( !( aValue & 1 ) )
+        {
+            aValue >>= 1;
+            n++;
+        }
+
+        return n;
+    }
+
+    /**
+     * Pad the most recently built level out to a whole number of groups with empty boxes.
+     */
+    void pad( size_t aCount )
+    {
+        size_t padding = ( NODE_SIZE - aCount % NODE_SIZE ) % NODE_SIZE;
+
+        m_minX.insert( m_minX.end(), padding, INT_MAX );
+        m_minY.insert( m_minY.end(), padding, INT_MAX );
+        m_maxX.insert( m_maxX.end(), padding, INT_MIN );
+        m_maxY.insert( m_maxY.end(), padding, INT_MIN );
+
+        if( m_levels.size() == 1 )
+            m_items.resize( m_items.size() + padding );
+    }
+
+    /**
+     * Sort the items along a Hilbert curve through their centres.
+     */
+    void sortItems()
+    {
+        size_t  count = m_items.size();
+        int64_t extentsMinX = INT64_MAX, extentsMinY = INT64_MAX;
+        int64_t extentsMaxX = INT64_MIN, extentsMaxY = INT64_MIN;
+
+        for( size_t ii = 0; ii < count; ++ii )
+        {
+            extentsMinX = std::min( extentsMinX, centre( m_minX[ii], m_maxX[ii] ) );
+            extentsMinY = std::min( extentsMinY, centre( m_minY[ii], m_maxY[ii] ) );
+            extentsMaxX = std::max( extentsMaxX, centre( m_minX[ii], m_maxX[ii] ) );
+            extentsMaxY = std::max( extentsMaxY, centre( m_minY[ii], m_maxY[ii] ) );
+        }
+
+        double scaleX = 0xFFFF / (double) std::max<int64_t>( 1, extentsMaxX - extentsMinX );
+        double scaleY = 0xFFFF / (double) std::max<int64_t>( 1, extentsMaxY - extentsMinY );
+
+        std::vector<std::pair<uint32_t, size_t>> order( count );
+
+        for( size_t ii = 0; ii < count; ++ii )
+        {
+            uint32_t x = ( centre( m_minX[ii], m_maxX[ii] ) - extentsMinX ) * scaleX;
+            uint32_t y = ( centre( m_minY[ii], m_maxY[ii] ) - extentsMinY ) * scaleY;
+
+            order[ii] = { hilbertIndex( x, y ), ii };
+        }
+
+        std::sort( order.begin(), order.end() );
+
+        auto permute =
+                [&]( auto& aValues )
+                {
+                    std::remove_reference_t<decltype( aValues )> sorted;
+                    sorted.reserve( count );
+
+                    for( const std::pair<uint32_t, size_t>& entry : order )
+                        sorted.push_back( aValues[entry.second] );
+
+                    aValues = std::move( sorted );
+                };
+
+        permute( m_minX );
+        permute( m_minY );
+        permute( m_maxX );
+        permute( m_maxY );
+        permute( m_items );
+    }
+
+    static int64_t centre( int aMin, int aMax )
+    {
+        return ( (int64_t) aMin + aMax ) / 2;
+    }
+
+    /**
+     * @return the position of (\a aX, \a aY) along a Hilbert curve filling a 65536x65536 grid.
+     *
+     * This is the well-known branch-free construction by rawrunprotected (public domain).
+     */
+    static uint32_t hilbertIndex( uint32_t aX, uint32_t aY )
+    {
+        uint32_t a = aX ^ aY;
+        uint32_t b = 0xFFFF ^ a;
+        uint32_t c = 0xFFFF ^ ( aX | aY );
+        uint32_t d = aX & ( aY ^ 0xFFFF );
+
+        uint32_t A = a | ( b >> 1 );
+        uint32_t B = ( a >> 1 ) ^ a;
+        uint32_t C = ( ( c >> 1 ) ^ ( b & ( d >> 1 ) ) ) ^ c;
+        uint32_t D = ( ( a & ( c >> 1 ) ) ^ ( d >> 1 ) ) ^ d;
+
+        a = A; b = B; c = C; d = D;
+        A = ( a & ( a >> 2 ) ) ^ ( b & ( b >> 2 ) );
+        B = ( a & ( b >> 2 ) ) ^ ( b & ( ( a ^ b ) >> 2 ) );
+        C ^= ( a & ( c >> 2 ) ) ^ ( b & ( d >> 2 ) );
+        D ^= ( b & ( c >> 2 ) ) ^ ( ( a ^ b ) & ( d >> 2 ) );
+
+        a = A; b = B; c = C; d = D;
+        A = ( a & ( a >> 4 ) ) ^ ( b & ( b >> 4 ) );
+        B = ( a & ( b >> 4 ) ) ^ ( b & ( ( a ^ b ) >> 4 ) );
+        C ^= ( a & ( c >> 4 ) ) ^ ( b & ( d >> 4 ) );
+        D ^= ( b & ( c >> 4 ) ) ^ ( ( a ^ b ) & ( d >> 4 ) );
+
+        a = A; b = B; c = C; d = D;
+        C ^= ( a & ( c >> 8 ) ) ^ ( b & ( d >> 8 ) );
+        D ^= ( b & ( c >> 8 ) ) ^ ( ( a ^ b ) & ( d >> 8 ) );
+
+        a = C ^ ( C >> 1 );
+        b = D ^ ( D >> 1 );
+
+        uint32_t i0 = aX ^ aY;
+        uint32_t i1 = b | ( 0xFFFF ^ ( i0 | a ) );
+
+        return ( interleave( i1 ) << 1 ) | interleave( i0 );
+    }
+
+    static uint32_t interleave( uint32_t aValue )
+    {
+        aValue = ( aValue | ( aValue << 8 ) ) & 0x00FF00FF;
+        aValue = ( aValue | ( aValue << 4 ) ) & 0x0F0F0F0F;
+        aValue = ( aValue | ( aValue << 2 ) ) & 0x33333333;
+        aValue = ( aValue | ( aValue << 1 ) ) & 0x55555555;
+        return aValue;
+    }
+
+private:
+    std::vector<int>   m_minX;
+    std::vector<int>   m_minY;
+    std::vector<int>   m_maxX;
+    std::vector<int>   m_maxY;
+    std::vector<T>     m_items;
+    std::vector<LEVEL> m_levels;
+};
+
+#endif // PACKED_RTREE_H
@@ -0,0 +1,456 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef PERSISTENT_RTREE_H
+#define PERSISTENT_RTREE_H
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+
+/**
+ * A dynamic 2D R-tree whose copies share their structure.
+ *
+ * Nodes are reference counted and never modified while shared: a change copies just the
+ * nodes on the path from the root to the entry it touches (nodes that aren't shared are
+ * changed in place).  So copying a tree costs O(1), and each insertion or removal costs
+ * O(log n) whatever the number of copies, which suits keeping many slightly different
+ * versions of one index alive at the same time.
+ *
+ * Overflowing nodes are split in half along the axis in which their entries' centres are
+ * most spread out.  Removal drops nodes which become empty but doesn't merge underfull
+ * ones, which only costs some search time after a long series of removals.
+ *
+ * Boxes are inclusive, as with RTree.  Different copies may be searched concurrently, but a
+ * tree must not be modified while it is being copied or searched.
+ */
+template <class T, int MAXNODES = 8>
+class PERSISTENT_RTREE
+{
+    static_assert( MAXNODES >= 4, "MAXNODES must be at least 4" );
+
+public:
+    PERSISTENT_RTREE() :
+            m_count( 0 )
+    {
+    }
+
+    /**
+     * Add \a aItem with the given bounding box.
+     */
+    void Insert( const int aMin[2], const int aMax[2], const T& aItem )
+    {
+        RECT rect( aMin, aMax );
+
+        if( !m_root )
+            m_root = std::make_shared<NODE>();
+
+        std::shared_ptr<NODE> sibling = insert( m_root, rect, aItem );
+
+        // The root was split: grow the tree by a level
+        if( sibling )
+        {
+            std::shared_ptr<NODE> root = std::make_shared<NODE>();
+
+            root->m_level = m_root->m_level + 1;
+            root->add( ENTRY( m_root->cover(), m_root ) );
+            root->add( ENTRY( sibling->cover(), sibling ) );
+
+            m_root = std::move( root );
+        }
+
+        m_count++;
+    }
+
+    /**
+     * Remove \a aItem, which must have been inserted with the same bounding box.
+     *
+     * @return false if the item wasn't found.
+     */
+    bool Remove( const int aMin[2], const int aMax[2], const T& aItem )
+    {
+        RECT                       rect( aMin, aMax );
+        std::array<int, MAX_DEPTH> path;
+
+        if( !m_root || !find( m_root.get(), rect, aItem, path.data() ) )
+            return false;
+
+        remove( m_root, path.data() );
+
+        // Shrink the tree while the root has just one child
+        while( m_root->m_level > 0 && m_root->m_count == 1 )
+        {
+            std::shared_ptr<NODE> child = m_root->m_entries[0].m_child;
+            m_root = std::move( child );
+        }
+
+        if( m_root->m_count == 0 )
+            m_root.reset();
+
+        m_count--;
+        return true;
+    }
+
+    /**
+     * Remove all items.  Other copies of the tree are unaffected.
+     */
+    void RemoveAll()
+    {
+        m_root.reset();
+        m_count = 0;
+    }
+
+    /**
+     * Call \a aVisitor for each item whose box overlaps the given box.  The visitor returns
+     * false to end the search early.
+     *
+     * @return the number of items visited.
+     */
+    template <class VISITOR>
+    int Search( const int aMin[2], const int aMax[2], VISITOR& aVisitor ) const
+    {
+        int found = 0;
+
+        if( m_root )
+            search( m_root.get(), RECT( aMin, aMax ), aVisitor, found );
+
+        return found;
+    }
+
+    size_t size() const
+    {
+        return m_count;
+    }
+
+    bool empty() const
+    {
+        return m_count == 0;
+    }
+
+private:
+    // Enough for any tree that fits in memory, as every node but the root is at least half full
+    // when it is created.
+    static const int MAX_DEPTH = 64;
+
+    struct NODE;
+
+    struct RECT
+    {
+        RECT()
+        {
+            m_min[0] = m_min[1] = INT_MAX;
+            m_max[0] = m_max[1] = INT_MIN;
+        }
+
+        RECT( const int aMin[2], const int aMax[2] )
+        {
+            m_min[0] = aMin[0];
+            m_min[1] = aMin[1];
+            m_max[0] = aMax[0];
+            m_max[1] = aMax[1];
+        }
+
+        bool Overlaps( const RECT& aOther ) const
+        {
+            return m_min[0] <= aOther.m_max[0] && aOther.m_min[0] <= m_max[0]
+                   && m_min[1] <= aOther.m_max[1] && aOther.m_min[1] <= m_max[1];
+        }
+
+        void Merge( const RECT& aOther )
+        {
+            m_min[0] = std::min( m_min[0], aOther.m_min[0] );
+            m_min[1] = std::min( m_min[1], aOther.m_min[1] );
+            m_max[0] = std::max( m_max[0], aOther.m_max[0] );
+            m_max[1] = std::max( m_max[1], aOther.m_max[1] );
+        }
+
+        double Area() const
+        {
+            return ( (double) m_max[0] - m_min[0] ) * ( (double) m_max[1] - m_min[1] );
+        }
+
+        double Centre( int aAxis ) const
+        {
+            return ( (double) m_min[aAxis] + m_max[aAxis] ) / 2.0;
+        }
+
+        int m_min[2];
+        int m_max[2];
+    };
+
+    struct ENTRY
+    {
+        ENTRY() :
+                m_item()
+        {
+        }
+
+        ENTRY( const RECT& aRect, const T& aItem ) :
+                m_rect( aRect ),
+                m_item( aItem )
+        {
+        }
+
+        ENTRY( const RECT& aRect, std::shared_ptr<NODE> aChild ) :
+                m_rect( aRect ),
+                m_child( std::move( aChild ) ),
+                m_item()
+        {
+        }
+
+        RECT                  m_rect;
+        std::shared_ptr<NODE> m_child;  ///< for internal nodes
+        T                     m_item;   ///< for leaves
+    };
+
+    struct NODE
+    {
+        NODE() :
+                m_level( 0 ),
+                m_count( 0 )
+        {
+        }
+
+        void add( ENTRY&& aEntry )
+        {
+            m_entries[m_count++] = std::move( aEntry );
+        }
+
+        void erase( int aIndex )
+        {
+            m_entries[aIndex] = std::move( m_entries[m_count - 1] );
+            m_entries[--m_count] = ENTRY();
+        }
+
+        RECT cover() const
+        {
+            RECT rect;
+
+            for( int ii = 0; ii < m_count; ++ii )
+                rect.Merge( m_entries[ii].m_rect );
+
+            return rect;
+        }
+
+        int m_level;                                    ///< 0 for leaves
+        int m_count;
+        std::array<ENTRY, MAXNODES + 1> m_entries;      ///< one spare to split from
+    };
+
+    /**
+     * @return \a aNode, first replacing it with a copy if it is shared.
+     */
+    static NODE& mutableNode( std::shared_ptr<NODE>& aNode )
+    {
+        if( aNode.use_count() > 1 )
+            aNode = std::make_shared<NODE>( *aNode );
+
+        return *aNode;
+    }
+
+    /**
+     * Insert into the subtree at \a aNode.
+     *
+     * @return the new sibling of \a aNode if it had to be split.
+     */
+    std::shared_ptr<NODE> insert( std::shared_ptr<NODE>& aNode, const RECT& aRect,
+                                  const T& aItem )
+    {
+        NODE& node = mutableNode( aNode );
+
+        if( node.m_level == 0 )
+        {
+            node.add( ENTRY( aRect, aItem ) );
+        }
+        else
+        {
+            // Choose the child needing the least enlargement, then the smallest
+            int    best = 0;
+            double bestGrowth = 0.0;
+            double bestArea = 0.0;
+
+            for( int ii = 0; ii < node.m_count; ++ii )
+            {
+                RECT merged = node.m_entries[ii].m_rect;
+                merged.Merge( aRect );
+
+                double area = node.m_entries[ii].m_rect.Area();
+                double growth = merged.Area() - area;
+
+                if( ii == 0 || growth < bestGrowth || ( growth == bestGrowth && area < bestArea ) )
+                {
+                    best = ii;
+                    bestGrowth = growth;
+                    bestArea = area;
+                }
+            }
+
+            ENTRY&                entry = node.m_entries[best];
+            std::shared_ptr<NODE> sibling = insert( entry.m_child, aRect, aItem );
+
+            if( sibling )
+            {
+                RECT siblingRect = sibling->cover();
+
+                entry.m_rect = entry.m_child->cover();
+                node.add( ENTRY( siblingRect, std::move( sibling ) ) );
+            }
+            else
+            {
+                entry.m_rect.Merge( aRect );
+            }
+        }
+
+        if( node.m_count <= MAXNODES )
+            return nullptr;
+
+        return split( node );
+    }
+
+    /**
+     * Move the upper half of \a aNode's entries, along its longer axis, to a new node.
+     */
+    static std::shared_ptr<NODE> split( NODE& aNode )
+    {
+        double lo[2] = { (double) INT_MAX, (double) INT_MAX };
+        double hi[2] = { (double) INT_MIN, (double) INT_MIN };
+
+        for( int ii = 0; ii < aNode.m_count; ++ii )
+        {
+            for( int axis = 0; axis < 2; ++axis )
+            {
+                lo[axis] = std::min( lo[axis], aNode.m_entries[ii].m_rect.Centre( axis ) );
+                hi[axis] = std::max( hi[axis], aNode.m_entries[ii].m_rect.Centre( axis ) );
+            }
+        }
+
+        int axis = ( hi[0] - lo[0] >= hi[1] - lo[1] ) ? 0 : 1;
+
+        std::sort( aNode.m_entries.begin(), aNode.m_entries.begin() + aNode.m_count,
+                   [axis]( const ENTRY& aLhs, const ENTRY& aRhs )
+                   {
+                       return aLhs.m_rect.Centre( axis ) < aRhs.m_rect.Centre( axis );
+                   } );
+
+        std::shared_ptr<NODE> sibling = std::make_shared<NODE>();
+        int                   keep = aNode.m_count / 2;
+
+        sibling->m_level = aNode.m_level;
+
+        while( aNode.m_count > keep )
+        {
+            sibling->add( std::move( aNode.m_entries[aNode.m_count - 1] ) );
+            aNode.m_entries[--aNode.m_count] = ENTRY();
+        }
+
+        return sibling;
+    }
+
+    /**
+     * Find the leaf entry holding \a aItem, recording the entry index at each level in
+     * \a aPath.
+     */
+    static bool find( const NODE* aNode, const RECT& aRect, const T& aItem, int* aPath )
+    {
+        for( int ii = 0; ii < aNode->m_count; ++ii )
+        {
+            const ENTRY& entry = aNode->m_entries[ii];
+
+            if( !entry.m_rect.Overlaps( aRect ) )
+                continue;
+
+            *aPath = ii;
+
+            if( aNode->m_level == 0 )
+            {
+                if( entry.m_item == aItem )
+                    return true;
+            }
+            else if( find( entry.m_child.get(), aRect, aItem, aPath + 1 ) )
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Remove the entry found by find(), copying shared nodes along the way.
+     */
+    static void remove( std::shared_ptr<NODE>& aNode, const int* aPath )
+    {
+        NODE& node = mutableNode( aNode );
+
+        if( node.m_level == 0 )
+        {
+            node.erase( *aPath );
+            return;
+        }
+
+        ENTRY& entry = node.m_entries[*aPath];
+
+        remove( entry.m_child, aPath + 1 );
+
+        if( entry.m_child->m_count == 0 )
+            node.erase( *aPath );
+        else
+            entry.m_rect = entry.m_child->cover();
+    }
+
+    template <class VISITOR>
+    static bool search( const NODE* aNode, const RECT& aRect, VISITOR& aVisitor, int& aFound )
+    {
+        for( int ii = 0; ii < aNode->m_count; ++ii )
+        {
+            const ENTRY& entry = aNode->m_entries[ii];
+
+            if( !entry.m_rect.Overlaps( aRect ) )
+                continue;
+
+            if( aNode->m_level == 0 )
+            {
+                aFound++;
+
+                if( !aVisitor( entry.m_item ) )
+                    return false;
+            }
+            else if( !search( entry.m_child.get(), aRect, aVisitor, aFound ) )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    std::shared_ptr<NODE> m_root;
+    size_t                m_count;
+};
+
+
+#endif // PERSISTENT_RTREE_H
@@ -0,0 +1,239 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef SEG_BATCH_H
+#define SEG_BATCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <geometry/seg.h>
+#include <math/vector2d.h>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+#define SEG_BATCH_USE_SSE2
+#endif
+
+
+/**
+ * The number of segments tested by each call to SegmentsNearBox() from ForEachSegmentNearBox().
+ */
+static constexpr int SEG_BATCH_SIZE = 16;
+
+
+/**
+ * Find which of a run of polyline segments may lie within a given distance of a box.
+ *
+ * The segments are (aPoints[i], aPoints[i + 1]) for i < aCount, so aPoints must hold
+ * aCount + 1 points.  Each segment is tested through its bounding box, two segments at a time
+ * with SSE2 (with a scalar fallback elsewhere), in double precision.
+ *
+ * This is a conservative filter for the exact integer tests: the bound is widened enough to
+ * cover both the floating point error here and the rounding in SEG::NearestPoint() and
+ * SEG::SquaredDistance().  A segment which isn't reported is therefore certainly further than
+ * \a aDistSq from the box by any of those measures, and near-ties are always left to the exact
+ * test.
+ *
+ * @param aCount is the number of segments, at most 32.
+ * @return a bit per segment, set if the segment may be within \a aDistSq of the box.
+ */
+inline uint32_t SegmentsNearBox( const VECTOR2I* aPoints, int aCount, const VECTOR2I& aMin,
+                                 const VECTOR2I& aMax, SEG::ecoord aDistSq )
+{
+    const double limit = std::sqrt( (double) aDistSq ) + 2.0;
+    uint32_t     mask = 0;
+    int          ii = 0;
+
+#ifdef SEG_BATCH_USE_SSE2
+    static_assert( sizeof( VECTOR2I ) == 2 * sizeof( int ), "VECTOR2I must be two packed ints" );
+
+    const __m128d qMinX = _mm_set1_pd( aMin.x );
+    const __m128d qMinY = _mm_set1_pd( aMin.y );
+    const __m128d qMaxX = _mm_set1_pd( aMax.x );
+    const __m128d qMaxY = _mm_set1_pd( aMax.y );
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d vLimit = _mm_set1_pd( limit );
+    const __m128d vSlack = _mm_set1_pd( 1e-6 );
+
+    for( ; ii + 2 <= aCount; ii += 2 )
+    {
+        // Points ii, ii+1 and ii+1, ii+2 as [x y x y]
+        __m128i p0 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( aPoints + ii ) );
+        __m128i p1 = _mm_loadu_si128( reinterpret_cast<const __m128i*>( aPoints + ii + 1 ) );
+
+        // One lane per segment
+        __m128d ax = _mm_cvtepi32_pd( _mm_shuffle_epi32( p0, _MM_SHUFFLE( 3, 1, 2, 0 ) ) );
+        __m128d ay = _mm_cvtepi32_pd( _mm_shuffle_epi32( p0, _MM_SHUFFLE( 2, 0, 3, 1 ) ) );
+        __m128d bx = _mm_cvtepi32_pd( _mm_shuffle_epi32( p1, _MM_SHUFFLE( 3, 1, 2, 0 ) ) );
+        __m128d by = _mm_cvtepi32_pd( _mm_shuffle_epi32( p1, _MM_SHUFFLE( 2, 0, 3, 1 ) ) );
+
+        __m128d sMinX = _mm_min_pd( ax, bx );
+        __m128d sMaxX = _mm_max_pd( ax, bx );
+        __m128d sMinY = _mm_min_pd( ay, by );
+        __m128d sMaxY = _mm_max_pd( ay, by );
+
+        // Gap between the boxes (a lower bound on the distance)...
+        __m128d dx = _mm_max_pd( _mm_max_pd( _mm_sub_pd( qMinX, sMaxX ),
+                                             _mm_sub_pd( sMinX, qMaxX ) ), zero );
+        __m128d dy = _mm_max_pd( _mm_max_pd( _mm_sub_pd( qMinY, sMaxY ),
+                                             _mm_sub_pd( sMinY, qMaxY ) ), zero );
+
+        // ...and their furthest extent, which scales the rounding error of the exact tests.
+        // The extent is taken as |fx| + |fy|, which is never less than the true distance and
+        // saves a square root.
+        __m128d fx = _mm_max_pd( _mm_sub_pd( qMaxX, sMinX ), _mm_sub_pd( sMaxX, qMinX ) );
+        __m128d fy = _mm_max_pd( _mm_sub_pd( qMaxY, sMinY ), _mm_sub_pd( sMaxY, qMinY ) );
+
+        __m128d gapSq = _mm_add_pd( _mm_mul_pd( dx, dx ), _mm_mul_pd( dy, dy ) );
+        __m128d bound = _mm_add_pd( vLimit, _mm_mul_pd( _mm_add_pd( fx, fy ), vSlack ) );
+        __m128d nearby = _mm_cmple_pd( gapSq, _mm_mul_pd( bound, bound ) );
+
+        mask |= (uint32_t) _mm_movemask_pd( nearby ) << ii;
+    }
+#endif
+
+    for( ; ii < aCount; ++ii )
+    {
+        const VECTOR2I& a = aPoints[ii];
+        const VECTOR2I& b = aPoints[ii + 1];
+
+        double sMinX = std::min( a.x, b.x ), sMaxX = std::max( a.x, b.x );
+        double sMinY = std::min( a.y, b.y ), sMaxY = std::max( a.y, b.y );
+
+        double dx = std::max( { aMin.x - sMaxX, sMinX - aMax.x, 0.0 } );
+        double dy = std::max( { aMin.y - sMaxY, sMinY - aMax.y, 0.0 } );
+        double fx = std::max( aMax.x - sMinX, sMaxX - aMin.x );
+        double fy = std::max( aMax.y - sMinY, sMaxY - aMin.y );
+
+        double bound = limit + ( fx + fy ) * 1e-6;
+
+        if( dx * dx + dy * dy <= bound * bound )
+            mask |= 1u << ii;
+    }
+
+    return mask;
+}
+
+
+/**
+ * Find a limit on the squared distance from \a aP to the nearest of a run of polyline segments,
+ * from the distance to the nearest of their start points.
+ *
+ * This is quick to find (it needs no projections) and is usually close, so it makes a good
+ * starting limit for ForEachSegmentNearBox() when looking for the nearest segment.  It is
+ * widened to cover the rounding in SEG::SquaredDistance(), so the segment starting at that point
+ * is always within it.
+ *
+ * @param aCount is the number of segments; aPoints[0] to aPoints[aCount - 1] are their starts.
+ */
+inline SEG::ecoord NearestVertexDistanceLimit( const VECTOR2I* aPoints, size_t aCount,
+                                               const VECTOR2I& aP )
+{
+    double best = std::numeric_limits<double>::max();
+    size_t ii = 0;
+
+#ifdef SEG_BATCH_USE_SSE2
+    const __m128d px = _mm_set1_pd( aP.x );
+    const __m128d py = _mm_set1_pd( aP.y );
+    __m128d       vBest = _mm_set1_pd( best );
+
+    for( ; ii + 2 <= aCount; ii += 2 )
+    {
+        __m128i p = _mm_loadu_si128( reinterpret_cast<const __m128i*>( aPoints + ii ) );
+
+        __m128d x = _mm_cvtepi32_pd( _mm_shuffle_epi32( p, _MM_SHUFFLE( 3, 1, 2, 0 ) ) );
+        __m128d y = _mm_cvtepi32_pd( _mm_shuffle_epi32( p, _MM_SHUFFLE( 2, 0, 3, 1 ) ) );
+        __m128d dx = _mm_sub_pd( x, px );
+        __m128d dy = _mm_sub_pd( y, py );
+
+        vBest = _mm_min_pd( vBest, _mm_add_pd( _mm_mul_pd( dx, dx ), _mm_mul_pd( dy, dy ) ) );
+    }
+
+    best = std::min( _mm_cvtsd_f64( vBest ), _mm_cvtsd_f64( _mm_unpackhi_pd( vBest, vBest ) ) );
+#endif
+
+    for( ; ii < aCount; ++ii )
+    {
+        double dx = (double) aPoints[ii].x - aP.x;
+        double dy = (double) aPoints[ii].y - aP.y;
+
+        best = std::min( best, dx * dx + dy * dy );
+    }
+
+    // Too far to be represented (or no points at all)
+    if( best >= 9e18 )
+        return VECTOR2I::ECOORD_MAX;
+
+    return (SEG::ecoord) ( best * ( 1.0 + 1e-12 ) ) + 2;
+}
+
+
+/**
+ * Call \a aFunc with the index of each segment of a polyline which may lie within \a aDistSq
+ * of the box \a aMin, \a aMax, in order, until it returns false.
+ *
+ * \a aDistSq is read again before each batch of segments, so the caller may tighten it as
+ * nearer segments are found.  Segment i runs from aPoints[i] to aPoints[i + 1], wrapping
+ * around to the first point for the closing segment of a closed polyline.
+ */
+template <class FUNC>
+void ForEachSegmentNearBox( const std::vector<VECTOR2I>& aPoints, size_t aSegmentCount,
+                            const VECTOR2I& aMin, const VECTOR2I& aMax,
+                            const SEG::ecoord& aDistSq, FUNC&& aFunc )
+{
+    // Segments which don't wrap around can be tested in batches
+    size_t batched = aPoints.empty() ? 0 : std::min( aSegmentCount, aPoints.size() - 1 );
+    size_t ii = 0;
+
+    for( ; ii < batched; ii += SEG_BATCH_SIZE )
+    {
+        int      count = (int) std::min<size_t>( SEG_BATCH_SIZE, batched - ii );
+        uint32_t mask = SegmentsNearBox( aPoints.data() + ii, count, aMin, aMax, aDistSq );
+
+        while( mask )
+        {
+            int jj = 0;
+
+            while( !( mask & ( 1u << jj ) ) )
+                jj++;
+
+            mask &= mask - 1;
+
+            if( !aFunc( ii + jj ) )
+                return;
+        }
+    }
+
+    for( ii = batched; ii < aSegmentCount; ++ii )
+    {
+        if( !aFunc( ii ) )
+            return;
+    }
+}
+
+
+#endif // SEG_BATCH_H
@@ -931,6 +931,14 @@ protected:
             std::vector<CLIPPER_Z_VALUE> &aZValueBuffer,
             std::vector<SHAPE_ARC> &aArcBuffer ) const;
 
+    /**
+     * Fill \a aPath with the Clipper2 path of the SHAPE_LINE_CHAIN in a given orientation,
+     * reusing its storage.
+     */
+    void convertToClipper2( Clipper2Lib::Path64& aPath, bool aRequiredOrientation,
+                            std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
+                            std::vector<SHAPE_ARC>& aArcBuffer ) const;
+
     /**
      * Fix indices of this chain to ensure arcs are not split between the end and start indices
      */
@@ -41,6 +41,7 @@
 
 #include <clipper.hpp>                  // for ClipType, PolyTree (ptr only)
 #include <clipper2/clipper.h>
+#include <core/profile.h>
 #include <geometry/corner_strategy.h>
 #include <geometry/seg.h>               // for SEG
 #include <geometry/shape.h>
@@ -50,6 +51,28 @@
 #include <hash_128.h>
 
 
+/**
+ * Counts of the allocations made by the polygon boolean operations, for profiling.  They are
+ * only kept while PooledPolygonBooleans is on, and only ever reset by whoever is reading them.
+ */
+struct POLY_BOOLEAN_COUNTERS
+{
+    PROF_COUNTER m_operations{ "Polygon boolean operations" };
+    PROF_COUNTER m_pooledOperations{ "Polygon boolean operations using pooled buffers" };
+    PROF_COUNTER m_bufferAllocations{ "Polygon boolean buffer allocations" };
+
+    void Reset()
+    {
+        m_operations.Reset();
+        m_pooledOperations.Reset();
+        m_bufferAllocations.Reset();
+    }
+};
+
+
+POLY_BOOLEAN_COUNTERS& PolyBooleanCounters();
+
+
 /**
  * Represent a set of closed polygons. Polygons may be nonconvex, self-intersecting
  * and have holes. Provides boolean operations (using Clipper library as the backend).
@@ -1015,6 +1038,19 @@ public:
     /// For \a aFastMode meaning, see function booleanOp
     void BooleanXor( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode );
 
+    /**
+     * Perform boolean polyset union with all of \a aShapes.
+     *
+     * Rather than adding the shapes one at a time, their polygons are grouped by locality and
+     * merged through a balanced tree of unions, the independent branches of which run on the
+     * thread pool.  For \a aFastMode meaning, see function booleanOp
+     */
+    void BooleanAdd( const std::vector<SHAPE_POLY_SET>& aShapes, POLYGON_MODE aFastMode );
+
+    /// Perform boolean polyset difference with the union of all of \a aShapes, which is built
+    /// as by BooleanAdd() above.  For \a aFastMode meaning, see function booleanOp
+    void BooleanSubtract( const std::vector<SHAPE_POLY_SET>& aShapes, POLYGON_MODE aFastMode );
+
     /// Perform boolean polyset union between a and b, store the result in it self
     /// For \a aFastMode meaning, see function booleanOp
     void BooleanAdd( const SHAPE_POLY_SET& a, const SHAPE_POLY_SET& b,
@@ -1110,6 +1146,14 @@ public:
     /// For \a aFastMode meaning, see function booleanOp
     void Simplify( POLYGON_MODE aFastMode );
 
+    /**
+     * Simplify a polyset of many (often overlapping) polygons, such as a set of knockouts.
+     *
+     * Gives the same result as Simplify(), but merges the polygons through a balanced tree of
+     * unions on the thread pool.  Small sets are just passed to Simplify().
+     */
+    void SimplifyBatched( POLYGON_MODE aFastMode );
+
     /**
      * Simplifies the lines in the polyset.  This checks intermediate points to see if they are
      * collinear with their neighbors, and removes them if they are.
@@ -1500,6 +1544,12 @@ private:
                      const std::vector<CLIPPER_Z_VALUE>&                 aZValueBuffer,
                      const std::vector<SHAPE_ARC>&                       aArcBuffer );
 
+    /**
+     * Replace the contents of the set with the union of \a aPolys, merged in a balanced tree.
+     * \a aPolys must not point into this set.
+     */
+    void mergeTree( std::vector<const POLYGON*>& aPolys, POLYGON_MODE aFastMode );
+
     void inflate1( int aAmount, int aCircleSegCount, CORNER_STRATEGY aCornerStrategy );
     void inflate2( int aAmount, int aCircleSegCount, CORNER_STRATEGY aCornerStrategy, bool aSimplify = false );
 
@@ -0,0 +1,162 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef SHAPE_POLY_SET_CACHE_H
+#define SHAPE_POLY_SET_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <geometry/shape_poly_set.h>
+#include <hash_128.h>
+
+
+/**
+ * A process-wide cache of the results of SHAPE_POLY_SET::Fracture() and
+ * SHAPE_POLY_SET::CacheTriangulation(), keyed by the contents of the polygon set.
+ *
+ * The same zone fills are fractured and triangulated by the 2D view, the 3D viewer, the
+ * plotters and the exporters, each on their own copy.  Since the key is the hash of the points
+ * rather than the object, any copy of a polygon set finds the work done on any other.
+ *
+ * Entries are kept within a memory budget (set from the SharedPolygonCacheSize advanced
+ * setting) and the least recently used are dropped first.  A budget of zero disables the cache.
+ */
+class SHAPE_POLY_SET_CACHE
+{
+public:
+    enum class OPERATION : uint8_t
+    {
+        FRACTURE,
+        TRIANGULATE
+    };
+
+    struct KEY
+    {
+        HASH_128  m_hash;
+        OPERATION m_operation;
+        int       m_flags;       ///< The options of the operation, which also change its result
+
+        bool operator==( const KEY& aOther ) const
+        {
+            return m_hash == aOther.m_hash && m_operation == aOther.m_operation
+                   && m_flags == aOther.m_flags;
+        }
+    };
+
+    struct ENTRY
+    {
+        /// The fractured polygons, for OPERATION::FRACTURE
+        std::vector<SHAPE_POLY_SET::POLYGON> m_polys;
+
+        /// The triangulation, for OPERATION::TRIANGULATE
+        std::vector<std::unique_ptr<SHAPE_POLY_SET::TRIANGULATED_POLYGON>> m_triangulation;
+    };
+
+    struct STATS
+    {
+        uint64_t m_hits = 0;
+        uint64_t m_misses = 0;
+        uint64_t m_evictions = 0;
+        size_t   m_entries = 0;
+        size_t   m_bytes = 0;
+        size_t   m_budget = 0;
+
+        double HitRate() const
+        {
+            return m_hits + m_misses ? double( m_hits ) / double( m_hits + m_misses ) : 0.0;
+        }
+    };
+
+    /// The fewest points a polygon set must have for its results to be worth caching
+    static constexpr int MIN_POINTS = 512;
+
+    static SHAPE_POLY_SET_CACHE& Instance();
+
+    bool IsEnabled() const { return m_budget > 0; }
+
+    /**
+     * Look up the result of an operation.  The entry stays valid for as long as it is held,
+     * even if it is evicted in the meantime.
+     *
+     * @return the cached result, or nullptr if there is none.
+     */
+    std::shared_ptr<const ENTRY> Find( const KEY& aKey );
+
+    /**
+     * Add the result of an operation, dropping older entries to keep within the budget.  An
+     * entry which is larger than the whole budget is not stored.
+     */
+    void Store( const KEY& aKey, std::shared_ptr<const ENTRY> aEntry );
+
+    /// Change the memory budget (in bytes), dropping entries if needed.  Zero disables the cache.
+    void SetBudget( size_t aBytes );
+
+    void Clear();
+
+    STATS GetStats() const;
+
+    /// @return an estimate of the memory used by \a aEntry.
+    static size_t EntrySize( const ENTRY& aEntry );
+
+private:
+    SHAPE_POLY_SET_CACHE( size_t aBudget ) :
+            m_budget( aBudget )
+    {
+    }
+
+    struct KEY_HASH
+    {
+        size_t operator()( const KEY& aKey ) const
+        {
+            return static_cast<size_t>( aKey.m_hash.Value64[0] ^ aKey.m_hash.Value64[1] )
+                   ^ ( static_cast<size_t>( aKey.m_operation ) << 8 )
+                   ^ static_cast<size_t>( aKey.m_flags );
+        }
+    };
+
+    struct SLOT
+    {
+        std::shared_ptr<const ENTRY> m_entry;
+        size_t                       m_bytes;
+        std::list<KEY>::iterator     m_lruPosition;
+    };
+
+    /// Drop the least recently used entries until the cache is within \a aBytes.
+    void evict( size_t aBytes );
+
+    mutable std::mutex                      m_mutex;
+    std::unordered_map<KEY, SLOT, KEY_HASH> m_slots;
+    std::list<KEY>                          m_lru;      ///< Most recently used first
+    size_t                                  m_budget;
+    size_t                                  m_bytes = 0;
+    uint64_t                                m_hits = 0;
+    uint64_t                                m_misses = 0;
+    uint64_t                                m_evictions = 0;
+};
+
+#endif // SHAPE_POLY_SET_CACHE_H
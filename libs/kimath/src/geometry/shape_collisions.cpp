@@ -27,6 +27,7 @@
 #include <limits>
 
 #include <geometry/seg.h>                         // for SEG
+#include <geometry/seg_batch.h>
 #include <geometry/shape.h>
 #include <geometry/shape_arc.h>
 #include <geometry/shape_line_chain.h>
@@ -202,26 +203,49 @@ static inline bool Collide( const SHAPE_CIRCLE& aA, const SHAPE_LINE_CHAIN_BASE&
     }
     else
     {
-        for( size_t s = 0; s < aB.GetSegmentCount(); s++ )
-        {
-            int collision_dist = 0;
-            VECTOR2I pn;
-
-            if( aA.Collide( aB.GetSegment( s ), aClearance,
-                            aActual || aLocation ? &collision_dist : nullptr,
-                            aLocation ? &pn : nullptr ) )
-            {
-                if( collision_dist < closest_dist )
+        auto collideSegment =
+                [&]( size_t s ) -> bool
                 {
-                    nearest = pn;
-                    closest_dist = collision_dist;
-                }
+                    int collision_dist = 0;
+                    VECTOR2I pn;
 
-                if( closest_dist == 0 )
-                    break;
+                    if( aA.Collide( aB.GetSegment( s ), aClearance,
+                                    aActual || aLocation ? &collision_dist : nullptr,
+                                    aLocation ? &pn : nullptr ) )
+                    {
+                        if( collision_dist < closest_dist )
+                        {
+                            nearest = pn;
+                            closest_dist = collision_dist;
+                        }
+
+                        if( closest_dist == 0 )
+                            return false;
+
+                        // If we're not looking for aActual then any collision will do
+                        if( !aActual )
+                            return false;
+                    }
 
-                // If we're not looking for aActual then any collision will do
-                if( !aActual )
+                    return true;
+                };
+
+        if( aB.Type() == SH_LINE_CHAIN )
+        {
+            // Only segments within the clearance of the circle's edge can collide
+            const SHAPE_LINE_CHAIN& chain = static_cast<const SHAPE_LINE_CHAIN&>( aB );
+            const VECTOR2I&         boxMin = aA.GetCenter();
+            const VECTOR2I&         boxMax = aA.GetCenter();
+            const SEG::ecoord       bound = SEG::Square( aClearance + aA.GetRadius() );
+
+            ForEachSegmentNearBox( chain.CPoints(), chain.GetSegmentCount(), boxMin, boxMax,
+                                   bound, collideSegment );
+        }
+        else
+        {
+            for( size_t s = 0; s < aB.GetSegmentCount(); s++ )
+            {
+                if( !collideSegment( s ) )
                     break;
             }
         }
@@ -422,26 +446,53 @@ static inline bool Collide( const SHAPE_RECT& aA, const SHAPE_LINE_CHAIN_BASE& a
     }
     else
     {
-        for( size_t s = 0; s < aB.GetSegmentCount(); s++ )
+        auto collideSegment =
+                [&]( size_t s ) -> bool
+                {
+                    int collision_dist = 0;
+                    VECTOR2I pn;
+
+                    if( aA.Collide( aB.GetSegment( s ), aClearance,
+                                    aActual || aLocation ? &collision_dist : nullptr,
+                                    aLocation ? &pn : nullptr ) )
+                    {
+                        if( collision_dist < closest_dist )
+                        {
+                            nearest = pn;
+                            closest_dist = collision_dist;
+                        }
+
+                        if( closest_dist == 0 )
+                            return false;
+
+                        // If we're not looking for aActual then any collision will do
+                        if( !aActual )
+                            return false;
+                    }
+
+                    return true;
+                };
+
+        if( aB.Type() == SH_LINE_CHAIN )
         {
-            int collision_dist = 0;
-            VECTOR2I pn;
+            // Only segments within the clearance of the rectangle can collide
+            const SHAPE_LINE_CHAIN& chain = static_cast<const SHAPE_LINE_CHAIN&>( aB );
+            BOX2I                   bbox = aA.BBox();
 
-            if( aA.Collide( aB.GetSegment( s ), aClearance,
-                            aActual || aLocation ? &collision_dist : nullptr,
-                            aLocation ? &pn : nullptr ) )
-            {
-                if( collision_dist < closest_dist )
-                {
-                    nearest = pn;
-                    closest_dist = collision_dist;
-                }
+            bbox.Normalize();
 
-                if( closest_dist == 0 )
-                    break;
+            const VECTOR2I    boxMin = bbox.GetOrigin();
+            const VECTOR2I    boxMax = bbox.GetEnd();
+            const SEG::ecoord bound = SEG::Square( aClearance );
 
-                // If we're not looking for aActual then any collision will do
-                if( !aActual )
+            ForEachSegmentNearBox( chain.CPoints(), chain.GetSegmentCount(), boxMin, boxMax,
+                                   bound, collideSegment );
+        }
+        else
+        {
+            for( size_t s = 0; s < aB.GetSegmentCount(); s++ )
+            {
+                if( !collideSegment( s ) )
                     break;
             }
         }
@@ -34,6 +34,7 @@
 #include <core/kicad_algo.h> // for alg::run_on_pair
 #include <geometry/circle.h>
 #include <geometry/seg.h>    // for SEG, OPT_VECTOR2I
+#include <geometry/seg_batch.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
 #include <math/box2.h>       // for BOX2I
@@ -206,8 +207,43 @@ Clipper2Lib::Path64 SHAPE_LINE_CHAIN::convertToClipper2( bool aRequiredOrientati
                                                      std::vector<SHAPE_ARC>& aArcBuffer ) const
 {
     Clipper2Lib::Path64 c_path;
+    convertToClipper2( c_path, aRequiredOrientation, aZValueBuffer, aArcBuffer );
+    return c_path;
+}
+
+
+void SHAPE_LINE_CHAIN::convertToClipper2( Clipper2Lib::Path64& aPath, bool aRequiredOrientation,
+                                          std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
+                                          std::vector<SHAPE_ARC>& aArcBuffer ) const
+{
+    bool orientation = Area( false ) >= 0;
+    int  pointCount = PointCount();
+
+    aPath.clear();
+    aPath.reserve( pointCount );
+
+    // Without arcs every point gets the same (empty) z value, so there's no need to copy (and
+    // perhaps reverse) the whole chain just to look them up
+    if( m_arcs.empty() )
+    {
+        size_t z_value_ptr = aZValueBuffer.size();
+        aZValueBuffer.emplace_back();
+
+        if( orientation != aRequiredOrientation )
+        {
+            for( int i = pointCount - 1; i >= 0; i-- )
+                aPath.emplace_back( m_points[i].x, m_points[i].y, z_value_ptr );
+        }
+        else
+        {
+            for( int i = 0; i < pointCount; i++ )
+                aPath.emplace_back( m_points[i].x, m_points[i].y, z_value_ptr );
+        }
+
+        return;
+    }
+
     SHAPE_LINE_CHAIN input;
-    bool             orientation = Area( false ) >= 0;
     ssize_t          shape_offset = aArcBuffer.size();
 
     if( orientation != aRequiredOrientation )
@@ -215,9 +251,6 @@ Clipper2Lib::Path64 SHAPE_LINE_CHAIN::convertToClipper2( bool aRequiredOrientati
     else
         input = *this;
 
-    int pointCount = input.PointCount();
-    c_path.reserve( pointCount );
-
     for( int i = 0; i < pointCount; i++ )
     {
         const VECTOR2I& vertex = input.CPoint( i );
@@ -226,12 +259,10 @@ Clipper2Lib::Path64 SHAPE_LINE_CHAIN::convertToClipper2( bool aRequiredOrientati
         size_t          z_value_ptr = aZValueBuffer.size();
         aZValueBuffer.push_back( z_value );
 
-        c_path.emplace_back( vertex.x, vertex.y, z_value_ptr );
+        aPath.emplace_back( vertex.x, vertex.y, z_value_ptr );
     }
 
     aArcBuffer.insert( aArcBuffer.end(), input.m_arcs.begin(), input.m_arcs.end() );
-
-    return c_path;
 }
 
 
@@ -488,29 +519,37 @@ bool SHAPE_LINE_CHAIN::Collide( const VECTOR2I& aP, int aClearance, int* aActual
     SEG::ecoord clearance_sq = SEG::Square( aClearance );
     VECTOR2I    nearest;
 
+    // Segments no nearer than the clearance can't collide, so only look at the ones which
+    // might be nearer than that (or than the nearest so far)
+    SEG::ecoord bound = clearance_sq;
+
     // Collide line segments
-    for( size_t i = 0; i < GetSegmentCount(); i++ )
-    {
-        if( IsArcSegment( i ) )
-            continue;
+    ForEachSegmentNearBox( m_points, GetSegmentCount(), aP, aP, bound,
+            [&]( size_t i ) -> bool
+            {
+                if( IsArcSegment( i ) )
+                    return true;
 
-        const SEG&  s = GetSegment( i );
-        VECTOR2I    pn = s.NearestPoint( aP );
-        SEG::ecoord dist_sq = ( pn - aP ).SquaredEuclideanNorm();
+                const SEG&  s = GetSegment( i );
+                VECTOR2I    pn = s.NearestPoint( aP );
+                SEG::ecoord dist_sq = ( pn - aP ).SquaredEuclideanNorm();
 
-        if( dist_sq < closest_dist_sq )
-        {
-            nearest = pn;
-            closest_dist_sq = dist_sq;
+                if( dist_sq < closest_dist_sq )
+                {
+                    nearest = pn;
+                    closest_dist_sq = dist_sq;
+                    bound = std::min( bound, closest_dist_sq );
 
-            if( closest_dist_sq == 0 )
-                break;
+                    if( closest_dist_sq == 0 )
+                        return false;
 
-            // If we're not looking for aActual then any collision will do
-            if( closest_dist_sq < clearance_sq && !aActual )
-                break;
-        }
-    }
+                    // If we're not looking for aActual then any collision will do
+                    if( closest_dist_sq < clearance_sq && !aActual )
+                        return false;
+                }
+
+                return true;
+            } );
 
     if( closest_dist_sq == 0 || closest_dist_sq < clearance_sq )
     {
@@ -877,30 +916,39 @@ bool SHAPE_LINE_CHAIN::Collide( const SEG& aSeg, int aClearance, int* aActual,
     SEG::ecoord clearance_sq = SEG::Square( aClearance );
     VECTOR2I    nearest;
 
+    // As above, only look at segments which might collide
+    SEG::ecoord bound = clearance_sq;
+    VECTOR2I    segMin( std::min( aSeg.A.x, aSeg.B.x ), std::min( aSeg.A.y, aSeg.B.y ) );
+    VECTOR2I    segMax( std::max( aSeg.A.x, aSeg.B.x ), std::max( aSeg.A.y, aSeg.B.y ) );
+
     // Collide line segments
-    for( size_t i = 0; i < GetSegmentCount(); i++ )
-    {
-        if( IsArcSegment( i ) )
-            continue;
+    ForEachSegmentNearBox( m_points, GetSegmentCount(), segMin, segMax, bound,
+            [&]( size_t i ) -> bool
+            {
+                if( IsArcSegment( i ) )
+                    return true;
 
-        const SEG&  s = GetSegment( i );
-        SEG::ecoord dist_sq = s.SquaredDistance( aSeg );
+                const SEG&  s = GetSegment( i );
+                SEG::ecoord dist_sq = s.SquaredDistance( aSeg );
 
-        if( dist_sq < closest_dist_sq )
-        {
-            if( aLocation )
-                nearest = s.NearestPoint( aSeg );
+                if( dist_sq < closest_dist_sq )
+                {
+                    if( aLocation )
+                        nearest = s.NearestPoint( aSeg );
 
-            closest_dist_sq = dist_sq;
+                    closest_dist_sq = dist_sq;
+                    bound = std::min( bound, closest_dist_sq );
 
-            if( closest_dist_sq == 0 )
-                break;
+                    if( closest_dist_sq == 0 )
+                        return false;
 
-            // If we're not looking for aActual then any collision will do
-            if( closest_dist_sq < clearance_sq && !aActual )
-                break;
-        }
-    }
+                    // If we're not looking for aActual then any collision will do
+                    if( closest_dist_sq < clearance_sq && !aActual )
+                        return false;
+                }
+
+                return true;
+            } );
 
     if( closest_dist_sq == 0 || closest_dist_sq < clearance_sq )
     {
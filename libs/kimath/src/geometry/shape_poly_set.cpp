@@ -30,12 +30,17 @@
 
 #include <algorithm>
 #include <assert.h>                          // for assert
+#include <atomic>
 #include <cmath>                             // for sqrt, cos, hypot, isinf
 #include <cstdio>
+#include <exception>
+#include <functional>
 #include <istream>                           // for operator<<, operator>>
 #include <limits>                            // for numeric_limits
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string> // for char_traits, operator!=
 #include <unordered_set>
@@ -44,12 +49,16 @@
 
 #include <clipper.hpp>                       // for Clipper, PolyNode, Clipp...
 #include <clipper2/clipper.h>
+#include <core/kicad_algo.h>
+#include <core/thread_pool.h>
 #include <geometry/geometry_utils.h>
 #include <geometry/polygon_triangulation.h>
 #include <geometry/seg.h>                    // for SEG, OPT_VECTOR2I
+#include <geometry/seg_batch.h>
 #include <geometry/shape.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
+#include <geometry/shape_poly_set_cache.h>
 #include <math/box2.h>                       // for BOX2I
 #include <math/util.h>                       // for KiROUND, rescale
 #include <math/vector2d.h>                   // for VECTOR2I, VECTOR2D, VECTOR2
@@ -733,6 +742,97 @@ void SHAPE_POLY_SET::RebuildHolesFromContours()
 }
 
 
+POLY_BOOLEAN_COUNTERS& PolyBooleanCounters()
+{
+    static POLY_BOOLEAN_COUNTERS counters;
+    return counters;
+}
+
+
+/// Pooled buffers which have grown past this many points (or paths) are freed after use
+/// rather than kept
+static constexpr size_t CLIPPER2_POOL_MAX_POINTS = 1 << 20;
+static constexpr size_t CLIPPER2_POOL_MAX_PATHS = 1 << 16;
+
+
+/**
+ * The temporaries of a Clipper2 boolean operation.  With PooledPolygonBooleans each thread
+ * keeps one set and reuses it from one operation to the next, so that once warmed up the many
+ * booleans of a zone fill don't allocate their paths afresh.
+ */
+struct CLIPPER2_BUFFERS
+{
+    Clipper2Lib::Clipper64       m_clipper;
+    Clipper2Lib::Paths64         m_subjects;
+    Clipper2Lib::Paths64         m_clips;
+    std::vector<CLIPPER_Z_VALUE> m_zValues;
+    std::vector<SHAPE_ARC>       m_arcBuffer;
+    bool                         m_inUse = false;
+
+    /**
+     * Release the buffers if they've grown too big to keep, and otherwise just empty them.
+     */
+    void Trim()
+    {
+        size_t points = 0;
+
+        for( const Clipper2Lib::Path64& path : m_subjects )
+            points += path.capacity();
+
+        for( const Clipper2Lib::Path64& path : m_clips )
+            points += path.capacity();
+
+        if( points > CLIPPER2_POOL_MAX_POINTS
+                || m_subjects.capacity() + m_clips.capacity() > CLIPPER2_POOL_MAX_PATHS
+                || m_zValues.capacity() > CLIPPER2_POOL_MAX_POINTS
+                || m_arcBuffer.capacity() > CLIPPER2_POOL_MAX_POINTS )
+        {
+            m_subjects = Clipper2Lib::Paths64();
+            m_clips = Clipper2Lib::Paths64();
+            m_zValues = std::vector<CLIPPER_Z_VALUE>();
+            m_arcBuffer = std::vector<SHAPE_ARC>();
+        }
+        else
+        {
+            m_zValues.clear();
+            m_arcBuffer.clear();
+        }
+    }
+};
+
+
+/**
+ * Holds a set of CLIPPER2_BUFFERS for the length of one boolean operation, and leaves them empty
+ * and free for the next one however the operation ends.
+ */
+class CLIPPER2_BUFFERS_LEASE
+{
+public:
+    CLIPPER2_BUFFERS_LEASE( CLIPPER2_BUFFERS& aBuffers ) :
+            m_buffers( aBuffers )
+    {
+        m_buffers.m_inUse = true;
+    }
+
+    ~CLIPPER2_BUFFERS_LEASE()
+    {
+        // The z callback refers to the operation's locals, so mustn't outlive them in a pooled
+        // clipper
+        m_buffers.m_clipper.SetZCallback( nullptr );
+        m_buffers.m_clipper.Clear();
+
+        m_buffers.Trim();
+        m_buffers.m_inUse = false;
+    }
+
+    CLIPPER2_BUFFERS_LEASE( const CLIPPER2_BUFFERS_LEASE& ) = delete;
+    CLIPPER2_BUFFERS_LEASE& operator=( const CLIPPER2_BUFFERS_LEASE& ) = delete;
+
+private:
+    CLIPPER2_BUFFERS& m_buffers;
+};
+
+
 void SHAPE_POLY_SET::booleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aOtherShape,
                                 POLYGON_MODE aFastMode )
 {
@@ -861,33 +961,65 @@ void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SE
                          "ClearArcs() before carrying out the boolean operation." ) );
     }
 
-    Clipper2Lib::Clipper64 c;
+    thread_local CLIPPER2_BUFFERS pooledBuffers;
 
-    std::vector<CLIPPER_Z_VALUE> zValues;
-    std::vector<SHAPE_ARC> arcBuffer;
-    std::map<VECTOR2I, CLIPPER_Z_VALUE> newIntersectPoints;
+    // Fall back to fresh buffers if the pool is turned off, or is somehow already in use.  The
+    // counters are shared between threads, so they're only kept while the pool is being used.
+    bool usePool = ADVANCED_CFG::GetCfg().m_PooledPolygonBooleans;
+    bool pooled = usePool && !pooledBuffers.m_inUse;
 
-    Clipper2Lib::Paths64 paths;
-    Clipper2Lib::Paths64 clips;
+    std::optional<CLIPPER2_BUFFERS> localBuffers;
+    CLIPPER2_BUFFERS*               buffers = pooled ? &pooledBuffers : &localBuffers.emplace();
+    CLIPPER2_BUFFERS_LEASE          lease( *buffers );
 
-    for( const POLYGON& poly : aShape.m_polys )
+    if( usePool )
     {
-        for( size_t i = 0; i < poly.size(); i++ )
-        {
-            paths.push_back( poly[i].convertToClipper2( i == 0, zValues, arcBuffer ) );
-        }
-    }
+        PolyBooleanCounters().m_operations++;
 
-    for( const POLYGON& poly : aOtherShape.m_polys )
-    {
-        for( size_t i = 0; i < poly.size(); i++ )
-        {
-            clips.push_back( poly[i].convertToClipper2( i == 0, zValues, arcBuffer ) );
-        }
+        if( pooled )
+            PolyBooleanCounters().m_pooledOperations++;
     }
 
-    c.AddSubject( paths );
-    c.AddClip( clips );
+    Clipper2Lib::Clipper64&             c = buffers->m_clipper;
+    std::vector<CLIPPER_Z_VALUE>&       zValues = buffers->m_zValues;
+    std::vector<SHAPE_ARC>&             arcBuffer = buffers->m_arcBuffer;
+    std::map<VECTOR2I, CLIPPER_Z_VALUE> newIntersectPoints;
+    size_t                              zCapacity = zValues.capacity();
+    size_t                              arcCapacity = arcBuffer.capacity();
+
+    // Reuse the paths left from the last operation; any spare ones are emptied (which Clipper
+    // skips) but kept for the next time
+    auto loadPaths =
+            [&]( const SHAPE_POLY_SET& aPolySet, Clipper2Lib::Paths64& aPaths )
+            {
+                size_t count = 0;
+
+                for( const POLYGON& poly : aPolySet.m_polys )
+                {
+                    for( size_t i = 0; i < poly.size(); i++ )
+                    {
+                        if( count == aPaths.size() )
+                            aPaths.emplace_back();
+
+                        Clipper2Lib::Path64& path = aPaths[count++];
+                        size_t               capacity = path.capacity();
+
+                        poly[i].convertToClipper2( path, i == 0, zValues, arcBuffer );
+
+                        if( usePool && path.capacity() > capacity )
+                            PolyBooleanCounters().m_bufferAllocations++;
+                    }
+                }
+
+                for( size_t i = count; i < aPaths.size(); i++ )
+                    aPaths[i].clear();
+            };
+
+    loadPaths( aShape, buffers->m_subjects );
+    loadPaths( aOtherShape, buffers->m_clips );
+
+    c.AddSubject( buffers->m_subjects );
+    c.AddClip( buffers->m_clips );
 
     Clipper2Lib::PolyTree64 solution;
 
@@ -954,6 +1086,12 @@ void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SE
 
     c.Execute( aType, Clipper2Lib::FillRule::NonZero, solution );
 
+    if( usePool && zValues.capacity() > zCapacity )
+        PolyBooleanCounters().m_bufferAllocations++;
+
+    if( usePool && arcBuffer.capacity() > arcCapacity )
+        PolyBooleanCounters().m_bufferAllocations++;
+
     importTree( solution, zValues, arcBuffer );
     solution.Clear(); // Free used memory (not done in dtor)
 }
@@ -1399,7 +1537,7 @@ void SHAPE_POLY_SET::importPolyPath( const std::unique_ptr<Clipper2Lib::PolyPath
                 importPolyPath( grandchild, aZValueBuffer, aArcBuffer );
         }
 
-        m_polys.push_back( paths );
+        m_polys.push_back( std::move( paths ) );
     }
 }
 
@@ -1409,6 +1547,7 @@ void SHAPE_POLY_SET::importTree( Clipper2Lib::PolyTree64&            tree,
                                  const std::vector<SHAPE_ARC>&       aArcBuffer )
 {
     m_polys.clear();
+    m_polys.reserve( tree.Count() );
 
     for( const std::unique_ptr<Clipper2Lib::PolyPath64>& n : tree )
         importPolyPath( n, aZValueBuffer, aArcBuffer );
@@ -1902,12 +2041,63 @@ void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
 }
 
 
+/**
+ * @return true if the results of operations on \a aPoly should go through the shared
+ * SHAPE_POLY_SET_CACHE: it must be big enough to be worth the lookup and, unless the
+ * operation drops them, have no arcs (which aren't covered by the hash).
+ */
+static bool useSharedCache( const SHAPE_POLY_SET& aPoly, bool aOperationClearsArcs )
+{
+    if( !SHAPE_POLY_SET_CACHE::Instance().IsEnabled()
+            || aPoly.TotalVertices() < SHAPE_POLY_SET_CACHE::MIN_POINTS )
+    {
+        return false;
+    }
+
+    if( !aOperationClearsArcs )
+    {
+        for( int ii = 0; ii < aPoly.OutlineCount(); ++ii )
+        {
+            for( const SHAPE_LINE_CHAIN& chain : aPoly.CPolygon( ii ) )
+            {
+                if( chain.ArcCount() )
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
 void SHAPE_POLY_SET::Fracture( POLYGON_MODE aFastMode )
 {
+    SHAPE_POLY_SET_CACHE&                    cache = SHAPE_POLY_SET_CACHE::Instance();
+    std::optional<SHAPE_POLY_SET_CACHE::KEY> key;
+
+    if( useSharedCache( *this, false ) )
+    {
+        key = SHAPE_POLY_SET_CACHE::KEY{ checksum(), SHAPE_POLY_SET_CACHE::OPERATION::FRACTURE,
+                                         aFastMode };
+
+        if( std::shared_ptr<const SHAPE_POLY_SET_CACHE::ENTRY> entry = cache.Find( *key ) )
+        {
+            m_polys = entry->m_polys;
+            return;
+        }
+    }
+
     Simplify( aFastMode );    // remove overlapping holes/degeneracy
 
     for( POLYGON& paths : m_polys )
         fractureSingle( paths );
+
+    if( key )
+    {
+        auto entry = std::make_shared<SHAPE_POLY_SET_CACHE::ENTRY>();
+        entry->m_polys = m_polys;
+        cache.Store( *key, std::move( entry ) );
+    }
 }
 
 
@@ -2113,6 +2303,234 @@ void SHAPE_POLY_SET::Simplify( POLYGON_MODE aFastMode )
 }
 
 
+/// Below this many polygons SimplifyBatched() just calls Simplify()
+static constexpr size_t MERGE_TREE_MIN_POLYGONS = 64;
+
+/// The fewest polygons which are worth merging in a task of their own
+static constexpr size_t MERGE_TREE_MIN_LEAF_POLYGONS = 16;
+
+
+/**
+ * Call \a aFunc with each index below \a aCount, one thread pool block per index.
+ *
+ * Each index is claimed before it is run, and the calling thread runs any that no pool thread
+ * has started yet.  It only waits for blocks which are already running, so this is safe to use
+ * from a task on a busy pool (such as a zone fill).
+ */
+static void claimingLoop( size_t aCount, const std::function<void( size_t )>& aFunc )
+{
+    // Blocks which only start after the caller has claimed everything find nothing left to do,
+    // so never touch the function (or anything it refers to)
+    auto claimed = std::make_shared<std::vector<std::atomic<bool>>>( aCount );
+
+    // Passed as an lvalue, since parallelize_loop() forwards it to every block
+    auto block =
+            [claimed, &aFunc]( size_t aStart, size_t aEnd )
+            {
+                for( size_t ii = aStart; ii < aEnd; ++ii )
+                {
+                    if( !( *claimed )[ii].exchange( true ) )
+                        aFunc( ii );
+                }
+            };
+
+    thread_pool&           tp = GetKiCadThreadPool();
+    BS::multi_future<void> results = tp.parallelize_loop( aCount, block, aCount );
+
+    std::exception_ptr exception;
+
+    for( size_t ii = 0; ii < aCount; ++ii )
+    {
+        try
+        {
+            // After an exception, the rest are only claimed to keep them from starting
+            if( !( *claimed )[ii].exchange( true ) )
+            {
+                if( !exception )
+                    aFunc( ii );
+            }
+            else
+            {
+                results[ii].get();
+            }
+        }
+        catch( ... )
+        {
+            if( !exception )
+                exception = std::current_exception();
+        }
+    }
+
+    if( exception )
+        std::rethrow_exception( exception );
+}
+
+
+void SHAPE_POLY_SET::mergeTree( std::vector<const POLYGON*>& aPolys, POLYGON_MODE aFastMode )
+{
+    m_polys.clear();
+
+    alg::delete_if( aPolys,
+            []( const POLYGON* aPoly )
+            {
+                return aPoly->empty() || aPoly->front().PointCount() == 0;
+            } );
+
+    if( aPolys.empty() )
+        return;
+
+    size_t threads = GetKiCadThreadPool().get_thread_count();
+
+    if( aPolys.size() < MERGE_TREE_MIN_POLYGONS || threads < 2 )
+    {
+        for( const POLYGON* poly : aPolys )
+            m_polys.push_back( *poly );
+
+        Simplify( aFastMode );
+        return;
+    }
+
+    // Sort the polygons along a Z-order curve so that each leaf of the tree holds a compact
+    // cluster of them; neighbours overlap the most, so merging them first removes the most
+    BOX2I bbox;
+
+    for( const POLYGON* poly : aPolys )
+        bbox.Merge( poly->front().BBox() );
+
+    auto zOrder =
+            [&]( const POLYGON* aPoly ) -> uint32_t
+            {
+                VECTOR2I centre = aPoly->front().BBox().Centre();
+                int64_t  dx = (int64_t) centre.x - bbox.GetX();
+                int64_t  dy = (int64_t) centre.y - bbox.GetY();
+                uint32_t x = (uint32_t) ( dx * 0xFFFF / std::max<int64_t>( bbox.GetWidth(), 1 ) );
+                uint32_t y = (uint32_t) ( dy * 0xFFFF / std::max<int64_t>( bbox.GetHeight(), 1 ) );
+                uint32_t key = 0;
+
+                for( int bit = 0; bit < 16; ++bit )
+                {
+                    key |= ( ( x >> bit ) & 1 ) << ( 2 * bit );
+                    key |= ( ( y >> bit ) & 1 ) << ( 2 * bit + 1 );
+                }
+
+                return key;
+            };
+
+    std::vector<std::pair<uint32_t, const POLYGON*>> sorted;
+    sorted.reserve( aPolys.size() );
+
+    for( const POLYGON* poly : aPolys )
+        sorted.emplace_back( zOrder( poly ), poly );
+
+    std::sort( sorted.begin(), sorted.end(),
+               []( const auto& a, const auto& b )
+               {
+                   return a.first < b.first;
+               } );
+
+    // A couple of leaves per thread, balanced by point count
+    size_t leafCount = std::min( 2 * threads, sorted.size() / MERGE_TREE_MIN_LEAF_POLYGONS );
+    size_t totalPoints = 0;
+
+    for( const auto& [key, poly] : sorted )
+    {
+        for( const SHAPE_LINE_CHAIN& chain : *poly )
+            totalPoints += chain.PointCount();
+    }
+
+    std::vector<SHAPE_POLY_SET> level( std::max<size_t>( leafCount, 1 ) );
+    size_t                      points = 0;
+
+    for( const auto& [key, poly] : sorted )
+    {
+        size_t leaf = std::min( level.size() - 1,
+                                points * level.size() / std::max<size_t>( totalPoints, 1 ) );
+
+        level[leaf].m_polys.push_back( *poly );
+
+        for( const SHAPE_LINE_CHAIN& chain : *poly )
+            points += chain.PointCount();
+    }
+
+    claimingLoop( level.size(),
+            [&]( size_t ii )
+            {
+                level[ii].Simplify( aFastMode );
+            } );
+
+    // Merge neighbouring pairs until only the root is left.  The last merge is a single
+    // boolean over everything, so the result is as clean as a plain Simplify()
+    while( level.size() > 1 )
+    {
+        std::vector<SHAPE_POLY_SET> next( ( level.size() + 1 ) / 2 );
+
+        claimingLoop( next.size(),
+                [&]( size_t ii )
+                {
+                    if( 2 * ii + 1 < level.size() )
+                        next[ii].BooleanAdd( level[2 * ii], level[2 * ii + 1], aFastMode );
+                    else
+                        next[ii] = std::move( level[2 * ii] );
+                } );
+
+        level = std::move( next );
+    }
+
+    m_polys = std::move( level.front().m_polys );
+}
+
+
+void SHAPE_POLY_SET::SimplifyBatched( POLYGON_MODE aFastMode )
+{
+    std::vector<POLYGON>        polys = std::move( m_polys );
+    std::vector<const POLYGON*> operands;
+
+    operands.reserve( polys.size() );
+
+    for( const POLYGON& poly : polys )
+        operands.push_back( &poly );
+
+    mergeTree( operands, aFastMode );
+}
+
+
+void SHAPE_POLY_SET::BooleanAdd( const std::vector<SHAPE_POLY_SET>& aShapes,
+                                 POLYGON_MODE aFastMode )
+{
+    std::vector<POLYGON>        polys = std::move( m_polys );
+    std::vector<const POLYGON*> operands;
+
+    for( const POLYGON& poly : polys )
+        operands.push_back( &poly );
+
+    for( const SHAPE_POLY_SET& shape : aShapes )
+    {
+        for( const POLYGON& poly : shape.m_polys )
+            operands.push_back( &poly );
+    }
+
+    mergeTree( operands, aFastMode );
+}
+
+
+void SHAPE_POLY_SET::BooleanSubtract( const std::vector<SHAPE_POLY_SET>& aShapes,
+                                      POLYGON_MODE aFastMode )
+{
+    std::vector<const POLYGON*> operands;
+
+    for( const SHAPE_POLY_SET& shape : aShapes )
+    {
+        for( const POLYGON& poly : shape.m_polys )
+            operands.push_back( &poly );
+    }
+
+    SHAPE_POLY_SET holes;
+    holes.mergeTree( operands, aFastMode );
+
+    BooleanSubtract( holes, aFastMode );
+}
+
+
 void SHAPE_POLY_SET::SimplifyOutlines( int aMaxError )
 {
     for( POLYGON& paths : m_polys )
@@ -2809,21 +3227,47 @@ SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( VECTOR2I aPoint, int aPoly
         return 0;
     }
 
-    CONST_SEGMENT_ITERATOR iterator = CIterateSegmentsWithHoles( aPolygonIndex );
+    const POLYGON& polygon = m_polys[aPolygonIndex];
+    SEG::ecoord    minDistance = polygon[0].CSegment( 0 ).SquaredDistance( aPoint );
 
-    SEG::ecoord minDistance = (*iterator).SquaredDistance( aPoint );
+    // The nearest vertex gives a close limit to start from, which rules out most segments
+    // before any of them are measured
+    SEG::ecoord bound = minDistance;
 
-    for( iterator++; iterator && minDistance > 0; iterator++ )
+    for( const SHAPE_LINE_CHAIN& contour : polygon )
     {
-        SEG::ecoord currentDistance = (*iterator).SquaredDistance( aPoint );
+        bound = std::min( bound, NearestVertexDistanceLimit( contour.CPoints().data(),
+                                                             contour.SegmentCount(), aPoint ) );
+    }
 
-        if( currentDistance < minDistance )
-        {
-            if( aNearest )
-                *aNearest = (*iterator).NearestPoint( aPoint );
+    // Walk the outline and then the holes, only looking at segments which might be nearer
+    // than that
+    for( const SHAPE_LINE_CHAIN& contour : polygon )
+    {
+        ForEachSegmentNearBox( contour.CPoints(), contour.SegmentCount(), aPoint, aPoint, bound,
+                [&]( size_t aIndex ) -> bool
+                {
+                    if( minDistance <= 0 )
+                        return false;
 
-            minDistance = currentDistance;
-        }
+                    // The first segment of the outline was our starting point
+                    if( aIndex == 0 && &contour == &polygon[0] )
+                        return true;
+
+                    const SEG   seg = contour.CSegment( aIndex );
+                    SEG::ecoord currentDistance = seg.SquaredDistance( aPoint );
+
+                    if( currentDistance < minDistance )
+                    {
+                        if( aNearest )
+                            *aNearest = seg.NearestPoint( aPoint );
+
+                        minDistance = currentDistance;
+                        bound = std::min( bound, minDistance );
+                    }
+
+                    return true;
+                } );
     }
 
     return minDistance;
@@ -2843,23 +3287,43 @@ SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( const SEG& aSegment, int a
         return 0;
     }
 
-    CONST_SEGMENT_ITERATOR iterator = CIterateSegmentsWithHoles( aPolygonIndex );
-    SEG::ecoord            minDistance = (*iterator).SquaredDistance( aSegment );
+    const POLYGON& polygon = m_polys[aPolygonIndex];
+    const SEG      first = polygon[0].CSegment( 0 );
+    SEG::ecoord    minDistance = first.SquaredDistance( aSegment );
 
     if( aNearest && minDistance == 0 )
-        *aNearest = ( *iterator ).NearestPoint( aSegment );
+        *aNearest = first.NearestPoint( aSegment );
 
-    for( iterator++; iterator && minDistance > 0; iterator++ )
+    VECTOR2I segMin( std::min( aSegment.A.x, aSegment.B.x ),
+                     std::min( aSegment.A.y, aSegment.B.y ) );
+    VECTOR2I segMax( std::max( aSegment.A.x, aSegment.B.x ),
+                     std::max( aSegment.A.y, aSegment.B.y ) );
+
+    for( const SHAPE_LINE_CHAIN& contour : polygon )
     {
-        SEG::ecoord currentDistance = (*iterator).SquaredDistance( aSegment );
+        ForEachSegmentNearBox( contour.CPoints(), contour.SegmentCount(), segMin, segMax,
+                               minDistance,
+                [&]( size_t aIndex ) -> bool
+                {
+                    if( minDistance <= 0 )
+                        return false;
 
-        if( currentDistance < minDistance )
-        {
-            if( aNearest )
-                *aNearest = (*iterator).NearestPoint( aSegment );
+                    if( aIndex == 0 && &contour == &polygon[0] )
+                        return true;
 
-            minDistance = currentDistance;
-        }
+                    const SEG   seg = contour.CSegment( aIndex );
+                    SEG::ecoord currentDistance = seg.SquaredDistance( aSegment );
+
+                    if( currentDistance < minDistance )
+                    {
+                        if( aNearest )
+                            *aNearest = seg.NearestPoint( aSegment );
+
+                        minDistance = currentDistance;
+                    }
+
+                    return true;
+                } );
     }
 
     // Return the maximum of minDistance and zero
@@ -3259,6 +3723,29 @@ void SHAPE_POLY_SET::cacheTriangulation( bool aPartition, bool aSimplify,
     m_triangulationValid = false;
     m_hashValid = false;
 
+    // Another copy of this polygon set may already have been triangulated
+    SHAPE_POLY_SET_CACHE&                    cache = SHAPE_POLY_SET_CACHE::Instance();
+    std::optional<SHAPE_POLY_SET_CACHE::KEY> key;
+
+    if( useSharedCache( *this, true ) )
+    {
+        key = SHAPE_POLY_SET_CACHE::KEY{ checksum(), SHAPE_POLY_SET_CACHE::OPERATION::TRIANGULATE,
+                                         ( aPartition ? 1 : 0 ) | ( aSimplify ? 2 : 0 ) };
+
+        if( std::shared_ptr<const SHAPE_POLY_SET_CACHE::ENTRY> entry = cache.Find( *key ) )
+        {
+            m_triangulatedPolys.clear();
+
+            for( const std::unique_ptr<TRIANGULATED_POLYGON>& tri : entry->m_triangulation )
+                m_triangulatedPolys.push_back( std::make_unique<TRIANGULATED_POLYGON>( *tri ) );
+
+            m_hash = key->m_hash;
+            m_hashValid = true;
+            m_triangulationValid = true;
+            return;
+        }
+    }
+
     auto triangulate =
             []( SHAPE_POLY_SET& polySet, int forOutline,
                 std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>& dest,
@@ -3375,6 +3862,16 @@ void SHAPE_POLY_SET::cacheTriangulation( bool aPartition, bool aSimplify,
             m_triangulationValid = true;
         }
     }
+
+    if( key && m_triangulationValid )
+    {
+        auto entry = std::make_shared<SHAPE_POLY_SET_CACHE::ENTRY>();
+
+        for( const std::unique_ptr<TRIANGULATED_POLYGON>& tri : m_triangulatedPolys )
+            entry->m_triangulation.push_back( std::make_unique<TRIANGULATED_POLYGON>( *tri ) );
+
+        cache.Store( *key, std::move( entry ) );
+    }
 }
 
 
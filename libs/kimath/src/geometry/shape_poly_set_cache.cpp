@@ -0,0 +1,159 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/shape_poly_set_cache.h>
+
+#include <advanced_config.h>
+
+
+SHAPE_POLY_SET_CACHE& SHAPE_POLY_SET_CACHE::Instance()
+{
+    static SHAPE_POLY_SET_CACHE cache(
+            static_cast<size_t>( ADVANCED_CFG::GetCfg().m_SharedPolygonCacheSize ) * 1024 * 1024 );
+
+    return cache;
+}
+
+
+std::shared_ptr<const SHAPE_POLY_SET_CACHE::ENTRY>
+SHAPE_POLY_SET_CACHE::Find( const KEY& aKey )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    auto it = m_slots.find( aKey );
+
+    if( it == m_slots.end() )
+    {
+        m_misses++;
+        return nullptr;
+    }
+
+    m_hits++;
+    m_lru.splice( m_lru.begin(), m_lru, it->second.m_lruPosition );
+
+    return it->second.m_entry;
+}
+
+
+void SHAPE_POLY_SET_CACHE::Store( const KEY& aKey, std::shared_ptr<const ENTRY> aEntry )
+{
+    size_t bytes = EntrySize( *aEntry );
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( bytes > m_budget )
+        return;
+
+    auto it = m_slots.find( aKey );
+
+    // Another thread got there first; the results are the same
+    if( it != m_slots.end() )
+        return;
+
+    evict( m_budget - bytes );
+
+    m_lru.push_front( aKey );
+    m_slots[aKey] = { std::move( aEntry ), bytes, m_lru.begin() };
+    m_bytes += bytes;
+}
+
+
+void SHAPE_POLY_SET_CACHE::SetBudget( size_t aBytes )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_budget = aBytes;
+    evict( m_budget );
+}
+
+
+void SHAPE_POLY_SET_CACHE::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_slots.clear();
+    m_lru.clear();
+    m_bytes = 0;
+    m_hits = 0;
+    m_misses = 0;
+    m_evictions = 0;
+}
+
+
+SHAPE_POLY_SET_CACHE::STATS SHAPE_POLY_SET_CACHE::GetStats() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    STATS stats;
+
+    stats.m_hits = m_hits;
+    stats.m_misses = m_misses;
+    stats.m_evictions = m_evictions;
+    stats.m_entries = m_slots.size();
+    stats.m_bytes = m_bytes;
+    stats.m_budget = m_budget;
+
+    return stats;
+}
+
+
+size_t SHAPE_POLY_SET_CACHE::EntrySize( const ENTRY& aEntry )
+{
+    size_t bytes = sizeof( ENTRY );
+
+    for( const SHAPE_POLY_SET::POLYGON& poly : aEntry.m_polys )
+    {
+        bytes += sizeof( SHAPE_POLY_SET::POLYGON );
+
+        for( const SHAPE_LINE_CHAIN& chain : poly )
+        {
+            bytes += sizeof( SHAPE_LINE_CHAIN );
+            bytes += chain.PointCount() * sizeof( VECTOR2I );
+            bytes += chain.CShapes().size() * sizeof( chain.CShapes().front() );
+            bytes += chain.ArcCount() * sizeof( SHAPE_ARC );
+        }
+    }
+
+    for( const std::unique_ptr<SHAPE_POLY_SET::TRIANGULATED_POLYGON>& tri : aEntry.m_triangulation )
+    {
+        bytes += sizeof( SHAPE_POLY_SET::TRIANGULATED_POLYGON );
+        bytes += tri->GetVertexCount() * sizeof( VECTOR2I );
+        bytes += tri->GetTriangleCount() * sizeof( SHAPE_POLY_SET::TRIANGULATED_POLYGON::TRI );
+    }
+
+    return bytes;
+}
+
+
+void SHAPE_POLY_SET_CACHE::evict( size_t aBytes )
+{
+    while( m_bytes > aBytes && !m_lru.empty() )
+    {
+        auto it = m_slots.find( m_lru.back() );
+
+        m_bytes -= it->second.m_bytes;
+        m_slots.erase( it );
+        m_lru.pop_back();
+        m_evictions++;
+    }
+}
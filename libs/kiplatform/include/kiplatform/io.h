@@ -20,6 +20,7 @@
 #ifndef KIPLATFORM_IO_H_
 #define KIPLATFORM_IO_H_
 
+#include <stddef.h>
 #include <stdio.h>
 
 class wxString;
@@ -50,6 +51,22 @@ namespace IO
     * @return true if the file attribut is set.
     */
     bool IsFileHidden( const wxString& aFileName );
+
+    /**
+     * Maps the whole of a file read-only into memory.
+     *
+     * @param aPath is the file to map.
+     * @param aData will be set to the start of the mapped contents.
+     * @param aSize will be set to the size of the mapped contents.
+     * @return an opaque handle to pass to UnmapFile(), or nullptr if the file could not be
+     *         mapped (including when it is empty, which some platforms refuse to map).
+     */
+    void* MapFile( const wxString& aPath, const char*& aData, size_t& aSize );
+
+    /**
+     * Releases a mapping created by MapFile().
+     */
+    void UnmapFile( void* aHandle );
 } // namespace IO
 } // namespace KIPLATFORM
 
@@ -25,6 +25,11 @@
 #include <wx/string.h>
 #include <wx/filename.h>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 FILE* KIPLATFORM::IO::SeqFOpen( const wxString& aPath, const wxString& aMode )
 {
     return wxFopen( aPath, aMode );
@@ -71,3 +76,54 @@ bool KIPLATFORM::IO::IsFileHidden( const wxString& aFileName )
 
     return fn.GetName().StartsWith( wxT( "." ) );
 }
+
+
+struct APPLE_MAPPED_FILE
+{
+    void*  m_addr;
+    size_t m_size;
+};
+
+
+void* KIPLATFORM::IO::MapFile( const wxString& aPath, const char*& aData, size_t& aSize )
+{
+    int fd = open( aPath.fn_str(), O_RDONLY );
+
+    if( fd < 0 )
+        return nullptr;
+
+    struct stat fileStat;
+
+    if( fstat( fd, &fileStat ) != 0 || !S_ISREG( fileStat.st_mode ) || fileStat.st_size <= 0 )
+    {
+        close( fd );
+        return nullptr;
+    }
+
+    size_t size = static_cast<size_t>( fileStat.st_size );
+    void*  addr = mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+    close( fd );
+
+    if( addr == MAP_FAILED )
+        return nullptr;
+
+    madvise( addr, size, MADV_SEQUENTIAL );
+
+    aData = static_cast<const char*>( addr );
+    aSize = size;
+
+    return new APPLE_MAPPED_FILE{ addr, size };
+}
+
+
+void KIPLATFORM::IO::UnmapFile( void* aHandle )
+{
+    APPLE_MAPPED_FILE* mapping = static_cast<APPLE_MAPPED_FILE*>( aHandle );
+
+    if( !mapping )
+        return;
+
+    munmap( mapping->m_addr, mapping->m_size );
+    delete mapping;
+}
@@ -24,6 +24,7 @@
 #include <wx/filename.h>
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -66,3 +67,55 @@ bool KIPLATFORM::IO::IsFileHidden( const wxString& aFileName )
 
     return fn.GetName().StartsWith( wxT( "." ) );
 }
+
+
+struct UNIX_MAPPED_FILE
+{
+    void*  m_addr;
+    size_t m_size;
+};
+
+
+void* KIPLATFORM::IO::MapFile( const wxString& aPath, const char*& aData, size_t& aSize )
+{
+    int fd = open( aPath.fn_str(), O_RDONLY );
+
+    if( fd < 0 )
+        return nullptr;
+
+    struct stat fileStat;
+
+    if( fstat( fd, &fileStat ) != 0 || !S_ISREG( fileStat.st_mode ) || fileStat.st_size <= 0 )
+    {
+        close( fd );
+        return nullptr;
+    }
+
+    size_t size = static_cast<size_t>( fileStat.st_size );
+    void*  addr = mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+    // The mapping holds its own reference to the file
+    close( fd );
+
+    if( addr == MAP_FAILED )
+        return nullptr;
+
+    posix_madvise( addr, size, POSIX_MADV_SEQUENTIAL );
+
+    aData = static_cast<const char*>( addr );
+    aSize = size;
+
+    return new UNIX_MAPPED_FILE{ addr, size };
+}
+
+
+void KIPLATFORM::IO::UnmapFile( void* aHandle )
+{
+    UNIX_MAPPED_FILE* mapping = static_cast<UNIX_MAPPED_FILE*>( aHandle );
+
+    if( !mapping )
+        return;
+
+    munmap( mapping->m_addr, mapping->m_size );
+    delete mapping;
+}
@@ -22,6 +22,8 @@
 #include <wx/string.h>
 #include <wx/wxcrt.h>
 
+#include <cstdint>
+
 #include <windows.h>
 
 // Define USE_MSYS2_FALlBACK if the code for _MSC_VER does not compile on msys2
@@ -123,4 +125,68 @@ bool KIPLATFORM::IO::IsFileHidden( const wxString& aFileName )
         result = true;
 
     return result;
-}
\ No newline at end of file
+}
+
+
+struct WIN_MAPPED_FILE
+{
+    HANDLE      m_file;
+    HANDLE      m_mapping;
+    const void* m_view;
+};
+
+
+void* KIPLATFORM::IO::MapFile( const wxString& aPath, const char*& aData, size_t& aSize )
+{
+    HANDLE hFile = CreateFileW( aPath.wc_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+
+    if( hFile == INVALID_HANDLE_VALUE )
+        return nullptr;
+
+    LARGE_INTEGER fileSize;
+
+    // CreateFileMapping() refuses empty files
+    if( !GetFileSizeEx( hFile, &fileSize ) || fileSize.QuadPart <= 0
+            || static_cast<unsigned long long>( fileSize.QuadPart ) > SIZE_MAX )
+    {
+        CloseHandle( hFile );
+        return nullptr;
+    }
+
+    HANDLE hMapping = CreateFileMappingW( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+
+    if( !hMapping )
+    {
+        CloseHandle( hFile );
+        return nullptr;
+    }
+
+    const void* view = MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+
+    if( !view )
+    {
+        CloseHandle( hMapping );
+        CloseHandle( hFile );
+        return nullptr;
+    }
+
+    aData = static_cast<const char*>( view );
+    aSize = static_cast<size_t>( fileSize.QuadPart );
+
+    return new WIN_MAPPED_FILE{ hFile, hMapping, view };
+}
+
+
+void KIPLATFORM::IO::UnmapFile( void* aHandle )
+{
+    WIN_MAPPED_FILE* mapping = static_cast<WIN_MAPPED_FILE*>( aHandle );
+
+    if( !mapping )
+        return;
+
+    UnmapViewOfFile( mapping->m_view );
+    CloseHandle( mapping->m_mapping );
+    CloseHandle( mapping->m_file );
+    delete mapping;
+}
@@ -154,7 +154,7 @@ void BOARD_COMMIT::dirtyIntersectingZones( BOARD_ITEM* item, int aChangeType )
             if( ( zone->GetLayerSet() & layers ).any()
                     && zone->GetBoundingBox().Intersects( bbox ) )
             {
-                zoneFillerTool->DirtyZone( zone );
+                zoneFillerTool->DirtyZoneArea( zone, bbox, layers );
             }
         }
     }
@@ -26,10 +26,13 @@
 
 
 #include <algorithm>
+#include <bitset>
 #include <future>
 #include <mutex>
 
+#include <advanced_config.h>
 #include <connectivity/connectivity_algo.h>
+#include <connectivity/zone_outline_index.h>
 #include <progress_reporter.h>
 #include <geometry/geometry_utils.h>
 #include <board_commit.h>
@@ -241,6 +244,16 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
 
     m_itemList.RemoveInvalidItems( garbage );
 
+    // The clusters holding removed items must be searched again
+    for( CN_ITEM* item : garbage )
+    {
+        for( int slot = 0; slot < CN_ITEM::SEARCH_SLOTS; ++slot )
+        {
+            if( CN_CLUSTER* cluster = item->GetSearchCluster( slot ) )
+                m_clusterCache[slot].m_stale.insert( cluster );
+        }
+    }
+
     for( CN_ITEM* item : garbage )
         delete item;
 
@@ -331,7 +344,219 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
                                                     PCB_FOOTPRINT_T,
                                                     PCB_SHAPE_T };
 
-    return SearchClusters( aMode, aMode == CSM_PROPAGATE ? withoutZones : withZones, -1 );
+    const std::vector<KICAD_T>& types = aMode == CSM_PROPAGATE ? withoutZones : withZones;
+
+    if( !ADVANCED_CFG::GetCfg().m_IncrementalConnectivity )
+        return SearchClusters( aMode, types, -1 );
+
+    if( m_itemList.IsDirty() )
+        searchConnections();
+
+    CLUSTERS clusters;
+
+    if( !updateClusters( aMode, types, clusters ) )
+    {
+        clusters = SearchClusters( aMode, types, -1 );
+
+        if( m_progressReporter && m_progressReporter->IsCancelled() )
+            return clusters;
+
+        cacheClusters( aMode, clusters );
+    }
+
+    return clusters;
+}
+
+
+void CN_CONNECTIVITY_ALGO::cacheClusters( CLUSTER_SEARCH_MODE aMode, const CLUSTERS& aClusters )
+{
+    int            slot = ( aMode == CSM_PROPAGATE ) ? 0 : 1;
+    CLUSTER_CACHE& cache = m_clusterCache[slot];
+
+    for( CN_ITEM* item : m_itemList )
+    {
+        item->SetSearchCluster( slot, nullptr );
+        item->ClearConnectionsChanged( slot );
+    }
+
+    for( const std::shared_ptr<CN_CLUSTER>& cluster : aClusters )
+    {
+        for( CN_ITEM* item : *cluster )
+            item->SetSearchCluster( slot, cluster.get() );
+    }
+
+    cache.m_clusters = aClusters;
+    cache.m_stale.clear();
+    cache.m_valid = true;
+}
+
+
+bool CN_CONNECTIVITY_ALGO::updateClusters( CLUSTER_SEARCH_MODE aMode,
+                                           const std::vector<KICAD_T>& aTypes,
+                                           CLUSTERS& aClusters )
+{
+    int            slot = ( aMode == CSM_PROPAGATE ) ? 0 : 1;
+    CLUSTER_CACHE& cache = m_clusterCache[slot];
+    bool           withinAnyNet = ( aMode != CSM_PROPAGATE );
+
+    if( !cache.m_valid )
+        return false;
+
+    std::bitset<MAX_STRUCT_TYPE_ID> typeBits;
+
+    for( KICAD_T type : aTypes )
+        typeBits.set( type );
+
+    auto inSearch =
+            [&]( CN_ITEM* aItem )
+            {
+                return aItem->Valid() && typeBits[aItem->Parent()->Type()]
+                        && !( withinAnyNet && aItem->Net() <= 0 );
+            };
+
+    std::unordered_set<CN_CLUSTER*>& stale = cache.m_stale;
+    bool                             hasNewItems = false;
+
+    // A cluster must be searched again if any of its items has been reconnected, changed net
+    // or dropped out of the search.  Items which weren't in any cluster are searched anyway.
+    for( CN_ITEM* item : m_itemList )
+    {
+        CN_CLUSTER* prev = item->GetSearchCluster( slot );
+        bool        wanted = inSearch( item );
+
+        if( prev )
+        {
+            if( !wanted || item->ConnectionsChanged( slot )
+                    || item->Net() != item->GetSearchNet( slot ) )
+            {
+                stale.insert( prev );
+            }
+        }
+        else if( wanted )
+        {
+            hasNewItems = true;
+        }
+
+        item->ClearConnectionsChanged( slot );
+    }
+
+    if( stale.empty() && !hasNewItems )
+    {
+        aClusters = cache.m_clusters;
+        return true;
+    }
+
+    CLUSTERS newClusters;
+    bool     restart = true;
+
+    while( restart )
+    {
+        restart = false;
+        newClusters.clear();
+
+        // Only the items to be re-clustered may be visited; everything else keeps its cluster
+        std::vector<CN_ITEM*> searchItems;
+
+        for( CN_ITEM* item : m_itemList )
+        {
+            CN_CLUSTER* prev = item->GetSearchCluster( slot );
+            bool        search = !prev || stale.count( prev );
+
+            if( search )
+                item->SetSearchCluster( slot, nullptr );
+
+            if( search && inSearch( item ) )
+            {
+                item->SetVisited( false );
+                searchItems.push_back( item );
+            }
+            else
+            {
+                item->SetVisited( true );
+            }
+        }
+
+        // Match the full search, which takes the lowest addressed item of each cluster as
+        // its root
+        std::sort( searchItems.begin(), searchItems.end() );
+
+        std::deque<CN_ITEM*> Q;
+
+        for( CN_ITEM* root : searchItems )
+        {
+            if( root->Visited() )
+                continue;
+
+            std::shared_ptr<CN_CLUSTER> cluster = std::make_shared<CN_CLUSTER>();
+
+            root->SetVisited( true );
+            Q.clear();
+            Q.push_back( root );
+
+            while( Q.size() && !restart )
+            {
+                CN_ITEM* current = Q.front();
+
+                Q.pop_front();
+                cluster->Add( current );
+
+                for( CN_ITEM* n : current->ConnectedItems() )
+                {
+                    if( withinAnyNet && n->Net() != root->Net() )
+                        continue;
+
+                    if( !n->Visited() && n->Valid() )
+                    {
+                        n->SetVisited( true );
+                        Q.push_back( n );
+                    }
+                    else if( n->GetSearchCluster( slot ) && inSearch( n ) )
+                    {
+                        // Reached a cluster which hasn't changed itself (for instance, an
+                        // item has just joined its net), so it has to be searched again too.
+                        stale.insert( n->GetSearchCluster( slot ) );
+                        restart = true;
+                        break;
+                    }
+                }
+            }
+
+            if( restart )
+                break;
+
+            newClusters.push_back( cluster );
+        }
+    }
+
+    CLUSTERS clusters;
+
+    clusters.reserve( cache.m_clusters.size() + newClusters.size() );
+
+    for( const std::shared_ptr<CN_CLUSTER>& cluster : cache.m_clusters )
+    {
+        if( !stale.count( cluster.get() ) )
+            clusters.push_back( cluster );
+    }
+
+    for( const std::shared_ptr<CN_CLUSTER>& cluster : newClusters )
+    {
+        for( CN_ITEM* item : *cluster )
+            item->SetSearchCluster( slot, cluster.get() );
+
+        clusters.push_back( cluster );
+    }
+
+    std::sort( clusters.begin(), clusters.end(),
+               []( const std::shared_ptr<CN_CLUSTER>& a, const std::shared_ptr<CN_CLUSTER>& b )
+               {
+                   return a->OriginNet() < b->OriginNet();
+               } );
+
+    cache.m_clusters = clusters;
+    stale.clear();
+
+    aClusters = std::move( clusters );
+    return true;
 }
 
 
@@ -380,6 +605,10 @@ CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode, const std::vect
                 item_set.insert( aItem );
             };
 
+    // Items outside the search mustn't be pulled into clusters through their connections
+    for( CN_ITEM* item : m_itemList )
+        item->SetVisited( true );
+
     std::for_each( m_itemList.begin(), m_itemList.end(), addToSearchList );
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
@@ -692,26 +921,81 @@ void CN_CONNECTIVITY_ALGO::FillIsolatedIslandsMap(
 
     m_connClusters = SearchClusters( CSM_CONNECTIVITY_CHECK );
 
-    for( auto& [ zone, zoneIslands ] : aMap )
+    bool useIndex = ADVANCED_CFG::GetCfg().m_ZoneAdjacencyIndex;
+
+    if( useIndex )
     {
-        for( auto& [ layer, layerIslands ] : zoneIslands )
+        for( auto& [ zone, zoneIslands ] : aMap )
         {
-            if( zone->GetFilledPolysList( layer )->IsEmpty() )
+            for( auto& [ layer, layerIslands ] : zoneIslands )
+            {
+                layerIslands.m_OutlineIndex = std::make_shared<ZONE_OUTLINE_INDEX>(
+                        *zone->GetFilledPolysList( layer ) );
+            }
+        }
+    }
+
+    // Sort the zone outlines into their zone layers in a single pass over the clusters, rather
+    // than searching every cluster again for each zone layer
+    for( const std::shared_ptr<CN_CLUSTER>& cluster : m_connClusters )
+    {
+        for( CN_ITEM* item : *cluster )
+        {
+            if( !item->Parent() || item->Parent()->Type() != PCB_ZONE_T )
+                continue;
+
+            auto zoneIter = aMap.find( static_cast<ZONE*>( item->Parent() ) );
+
+            if( zoneIter == aMap.end() )
+                continue;
+
+            auto layerIter = zoneIter->second.find( item->Layer() );
+
+            if( layerIter == zoneIter->second.end() )
+                continue;
+
+            if( zoneIter->first->GetFilledPolysList( item->Layer() )->IsEmpty() )
                 continue;
 
-            for( const std::shared_ptr<CN_CLUSTER>& cluster : m_connClusters )
+            ISOLATED_ISLANDS& layerIslands = layerIter->second;
+            CN_ZONE_LAYER*    z = static_cast<CN_ZONE_LAYER*>( item );
+
+            if( cluster->IsOrphaned() )
+                layerIslands.m_IsolatedOutlines.push_back( z->SubpolyIndex() );
+
+            if( useIndex )
             {
-                for( CN_ITEM* item : *cluster )
+                for( CN_ITEM* connected : z->ConnectedItems() )
                 {
-                    if( item->Parent() == zone && item->Layer() == layer )
-                    {
-                        CN_ZONE_LAYER* z = static_cast<CN_ZONE_LAYER*>( item );
+                    if( connected->Valid() )
+                        layerIslands.m_OutlineIndex->AddConnection( z->SubpolyIndex(),
+                                                                    connected->Parent() );
+                }
+            }
+            else if( !cluster->IsOrphaned() && z->HasSingleConnection() )
+            {
+                layerIslands.m_SingleConnectionOutlines.push_back( z->SubpolyIndex() );
+            }
+        }
+    }
 
-                        if( cluster->IsOrphaned() )
-                            layerIslands.m_IsolatedOutlines.push_back( z->SubpolyIndex() );
-                        else if( z->HasSingleConnection() )
-                            layerIslands.m_SingleConnectionOutlines.push_back( z->SubpolyIndex() );
-                    }
+    // The single-connection outlines are those the index has exactly one item for
+    if( useIndex )
+    {
+        for( auto& [ zone, zoneIslands ] : aMap )
+        {
+            for( auto& [ layer, layerIslands ] : zoneIslands )
+            {
+                const ZONE_OUTLINE_INDEX& index = *layerIslands.m_OutlineIndex;
+                std::vector<bool>         isolated( index.OutlineCount(), false );
+
+                for( int ii : layerIslands.m_IsolatedOutlines )
+                    isolated[ii] = true;
+
+                for( int ii = 0; ii < index.OutlineCount(); ++ii )
+                {
+                    if( !isolated[ii] && index.GetConnections( ii ).size() == 1 )
+                        layerIslands.m_SingleConnectionOutlines.push_back( ii );
                 }
             }
         }
@@ -949,6 +1233,10 @@ void CN_CONNECTIVITY_ALGO::Clear()
 {
     m_ratsnestClusters.clear();
     m_connClusters.clear();
+
+    for( CLUSTER_CACHE& cache : m_clusterCache )
+        cache = CLUSTER_CACHE();
+
     m_itemMap.clear();
     m_itemList.Clear();
 
@@ -37,9 +37,11 @@
 
 #include <geometry/shape_poly_set.h>
 
+#include <array>
 #include <memory>
 #include <algorithm>
 #include <functional>
+#include <unordered_set>
 #include <vector>
 #include <deque>
 
@@ -228,6 +230,14 @@ public:
 
     const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode, const std::vector<KICAD_T>& aTypes,
                                    int aSingleNet, CN_ITEM* rootItem = nullptr );
+
+    /**
+     * Search the whole board for clusters.
+     *
+     * With ADVANCED_CFG::m_IncrementalConnectivity set, the clusters found by the previous
+     * search of the same kind are kept, and only those touched by items added, removed,
+     * reconnected or renetted since then are searched again.
+     */
     const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode );
 
     /**
@@ -274,6 +284,18 @@ public:
 private:
     void searchConnections();
 
+    /**
+     * Re-search only the clusters of \a aMode which have changed since the last search.
+     *
+     * @return false if there are no earlier results to update; \a aClusters is then left
+     *         untouched.
+     */
+    bool updateClusters( CLUSTER_SEARCH_MODE aMode, const std::vector<KICAD_T>& aTypes,
+                         CLUSTERS& aClusters );
+
+    ///< Record the clusters found by a whole-board search for later incremental searches.
+    void cacheClusters( CLUSTER_SEARCH_MODE aMode, const CLUSTERS& aClusters );
+
     void propagateConnections( BOARD_COMMIT* aCommit = nullptr );
 
     template <class Container, class BItem>
@@ -295,6 +317,16 @@ private:
     std::vector<std::shared_ptr<CN_CLUSTER>>              m_ratsnestClusters;
     std::vector<bool>                                     m_dirtyNets;
 
+    struct CLUSTER_CACHE
+    {
+        bool                            m_valid = false;
+        CLUSTERS                        m_clusters;
+        std::unordered_set<CN_CLUSTER*> m_stale;    ///< clusters to be searched again
+    };
+
+    ///< Results of the last whole-board searches, indexed by CN_ITEM search slot
+    std::array<CLUSTER_CACHE, CN_ITEM::SEARCH_SLOTS>      m_clusterCache;
+
     bool                                                  m_isLocal;
     std::shared_ptr<CONNECTIVITY_DATA>                    m_globalConnectivityData;
 
@@ -28,6 +28,8 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <future>
 #include <initializer_list>
 
@@ -192,23 +194,41 @@ void CONNECTIVITY_DATA::updateRatsnest()
                 return aNet->IsDirty() && aNet->GetNodeCount() > 0;
             } );
 
+    // Hand the nets out one at a time, largest first.  Splitting the list into equal blocks
+    // leaves a thread which draws a large power net running long after the others are idle.
+    std::sort( dirty_nets.begin(), dirty_nets.end(),
+               []( const RN_NET* aLhs, const RN_NET* aRhs )
+               {
+                   return aLhs->GetNodeCount() > aRhs->GetNodeCount();
+               } );
+
     thread_pool& tp = GetKiCadThreadPool();
+    size_t       num_threads = std::min<size_t>( tp.get_thread_count(), dirty_nets.size() );
 
-    tp.push_loop( dirty_nets.size(),
-            [&]( const int a, const int b )
+    auto runOnNets =
+            [&]( const std::function<void( RN_NET* )>& aFunc )
             {
-                for( int ii = a; ii < b; ++ii )
-                    dirty_nets[ii]->UpdateNet();
-            } );
-    tp.wait_for_tasks();
+                std::atomic<size_t>            next( 0 );
+                std::vector<std::future<void>> returns;
 
-    tp.push_loop( dirty_nets.size(),
-            [&]( const int a, const int b )
-            {
-                for( int ii = a; ii < b; ++ii )
-                    dirty_nets[ii]->OptimizeRNEdges();
-            } );
-    tp.wait_for_tasks();
+                returns.reserve( num_threads );
+
+                for( size_t ii = 0; ii < num_threads; ++ii )
+                {
+                    returns.emplace_back( tp.submit(
+                            [&]()
+                            {
+                                for( size_t jj = next++; jj < dirty_nets.size(); jj = next++ )
+                                    aFunc( dirty_nets[jj] );
+                            } ) );
+                }
+
+                for( const std::future<void>& ret : returns )
+                    ret.wait();
+            };
+
+    runOnNets( []( RN_NET* aNet ) { aNet->UpdateNet(); } );
+    runOnNets( []( RN_NET* aNet ) { aNet->OptimizeRNEdges(); } );
 
 #ifdef PROFILE
     rnUpdate.Show();
@@ -138,7 +138,10 @@ void CN_ITEM::RemoveInvalidRefs()
     for( auto it = m_connected.begin(); it != m_connected.end(); /* increment in loop */ )
     {
         if( !(*it)->Valid() )
+        {
             it = m_connected.erase( it );
+            m_connectionsChanged = ALL_SEARCH_SLOTS;
+        }
         else
             ++it;
     }
@@ -38,6 +38,7 @@
 
 #include <geometry/shape_poly_set.h>
 
+#include <array>
 #include <memory>
 #include <algorithm>
 #include <functional>
@@ -144,6 +145,9 @@ public:
         m_anchors.reserve( std::max( 6, aAnchorCount ) );
         m_layers = LAYER_RANGE( 0, PCB_LAYER_ID_COUNT );
         m_connected.reserve( 8 );
+        m_connectionsChanged = 0;
+        m_searchClusters.fill( nullptr );
+        m_searchNets.fill( -1 );
     }
 
     virtual ~CN_ITEM()
@@ -200,7 +204,12 @@ public:
     BOARD_CONNECTED_ITEM* Parent() const { return m_parent; }
 
     const std::vector<CN_ITEM*>& ConnectedItems() const { return m_connected; }
-    void ClearConnections() { m_connected.clear(); }
+
+    void ClearConnections()
+    {
+        m_connected.clear();
+        m_connectionsChanged = ALL_SEARCH_SLOTS;
+    }
 
     void SetVisited( bool aVisited ) { m_visited = aVisited; }
     bool Visited() const { return m_visited; }
@@ -217,6 +226,7 @@ public:
           return;
 
         m_connected.insert( i, b );
+        m_connectionsChanged = ALL_SEARCH_SLOTS;
     }
 
     void RemoveInvalidRefs();
@@ -229,6 +239,26 @@ public:
         return ( !m_parent || !m_valid ) ? -1 : m_parent->GetNetCode();
     }
 
+    /**
+     * Incremental cluster searches (see CN_CONNECTIVITY_ALGO::SearchClusters()) keep a slot
+     * per kind of search.  Each records the cluster the item was last put in (nullptr if it
+     * wasn't part of that search) and the item's net at the time.
+     */
+    static const int SEARCH_SLOTS = 2;
+
+    CN_CLUSTER* GetSearchCluster( int aSlot ) const { return m_searchClusters[aSlot]; }
+    int GetSearchNet( int aSlot ) const { return m_searchNets[aSlot]; }
+
+    void SetSearchCluster( int aSlot, CN_CLUSTER* aCluster )
+    {
+        m_searchClusters[aSlot] = aCluster;
+        m_searchNets[aSlot] = Net();
+    }
+
+    ///< @return true if the item's connections have changed since the last search in \a aSlot.
+    bool ConnectionsChanged( int aSlot ) const { return m_connectionsChanged & ( 1 << aSlot ); }
+    void ClearConnectionsChanged( int aSlot ) { m_connectionsChanged &= ~( 1 << aSlot ); }
+
 protected:
     bool            m_dirty;         ///< used to identify recently added item not yet
                                      ///< scanned into the connectivity search
@@ -241,6 +271,12 @@ private:
     std::vector<CN_ITEM*>                    m_connected;   ///< list of physically touching items
     std::vector<std::shared_ptr<CN_ANCHOR>>  m_anchors;
 
+    static const uint8_t ALL_SEARCH_SLOTS = ( 1 << SEARCH_SLOTS ) - 1;
+
+    uint8_t                                  m_connectionsChanged; ///< bit per search slot
+    std::array<CN_CLUSTER*, SEARCH_SLOTS>    m_searchClusters;
+    std::array<int, SEARCH_SLOTS>            m_searchNets;
+
     bool            m_canChangeNet;  ///< can the net propagator modify the netcode?
 
     bool            m_visited;       ///< visited flag for the BFS scan
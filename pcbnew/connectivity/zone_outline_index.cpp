@@ -0,0 +1,96 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <geometry/shape_poly_set.h>
+
+#include <connectivity/zone_outline_index.h>
+
+
+ZONE_OUTLINE_INDEX::ZONE_OUTLINE_INDEX( const SHAPE_POLY_SET& aFill )
+{
+    m_bboxes.reserve( aFill.OutlineCount() );
+
+    for( int ii = 0; ii < aFill.OutlineCount(); ++ii )
+        m_bboxes.push_back( aFill.COutline( ii ).BBox() );
+
+    m_connections.resize( m_bboxes.size() );
+    buildTree();
+}
+
+
+void ZONE_OUTLINE_INDEX::buildTree()
+{
+    m_tree.RemoveAll();
+
+    for( int ii = 0; ii < (int) m_bboxes.size(); ++ii )
+    {
+        int min[2] = { m_bboxes[ii].GetX(), m_bboxes[ii].GetY() };
+        int max[2] = { m_bboxes[ii].GetRight(), m_bboxes[ii].GetBottom() };
+
+        m_tree.Insert( min, max, ii );
+    }
+}
+
+
+std::vector<int> ZONE_OUTLINE_INDEX::Query( const BOX2I& aArea ) const
+{
+    std::vector<int> outlines;
+    int              min[2] = { aArea.GetX(), aArea.GetY() };
+    int              max[2] = { aArea.GetRight(), aArea.GetBottom() };
+
+    m_tree.Search( min, max,
+                   [&]( const int& aOutline )
+                   {
+                       outlines.push_back( aOutline );
+                       return true;
+                   } );
+
+    std::sort( outlines.begin(), outlines.end() );
+    return outlines;
+}
+
+
+void ZONE_OUTLINE_INDEX::RemoveOutlines( const std::vector<int>& aOutlines )
+{
+    if( aOutlines.empty() )
+        return;
+
+    std::vector<bool> removed( m_bboxes.size(), false );
+
+    for( int outline : aOutlines )
+        removed[outline] = true;
+
+    size_t kept = 0;
+
+    for( size_t ii = 0; ii < m_bboxes.size(); ++ii )
+    {
+        if( removed[ii] )
+            continue;
+
+        m_bboxes[kept] = m_bboxes[ii];
+        m_connections[kept] = std::move( m_connections[ii] );
+        kept++;
+    }
+
+    m_bboxes.resize( kept );
+    m_connections.resize( kept );
+    buildTree();
+}
@@ -0,0 +1,84 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZONE_OUTLINE_INDEX_H
+#define ZONE_OUTLINE_INDEX_H
+
+#include <vector>
+
+#include <geometry/rtree.h>
+#include <math/box2.h>
+
+class BOARD_CONNECTED_ITEM;
+class SHAPE_POLY_SET;
+
+
+/**
+ * An index of the fill outlines of one zone layer: their bounding boxes, and the items (pads,
+ * vias, tracks and the outlines of other zones) that each of them touches.
+ *
+ * It is built by the connectivity pass which finds the isolated islands, from the connections
+ * that pass has already found, so that island removal and the zone connection DRC can look
+ * outlines up rather than searching for them again.
+ */
+class ZONE_OUTLINE_INDEX
+{
+public:
+    ZONE_OUTLINE_INDEX( const SHAPE_POLY_SET& aFill );
+
+    ZONE_OUTLINE_INDEX( const ZONE_OUTLINE_INDEX& ) = delete;
+    ZONE_OUTLINE_INDEX& operator=( const ZONE_OUTLINE_INDEX& ) = delete;
+
+    int OutlineCount() const { return (int) m_bboxes.size(); }
+
+    const BOX2I& GetBBox( int aOutline ) const { return m_bboxes[aOutline]; }
+
+    /**
+     * @return the items which \a aOutline touches.  Another zone appears once for each of its
+     *         outlines that is touched.
+     */
+    const std::vector<BOARD_CONNECTED_ITEM*>& GetConnections( int aOutline ) const
+    {
+        return m_connections[aOutline];
+    }
+
+    void AddConnection( int aOutline, BOARD_CONNECTED_ITEM* aItem )
+    {
+        m_connections[aOutline].push_back( aItem );
+    }
+
+    /**
+     * @return the outlines whose bounding boxes overlap \a aArea, in outline order.
+     */
+    std::vector<int> Query( const BOX2I& aArea ) const;
+
+    /**
+     * Forget outlines which have been deleted from the fill, and renumber the rest to match.
+     */
+    void RemoveOutlines( const std::vector<int>& aOutlines );
+
+private:
+    void buildTree();
+
+    std::vector<BOX2I>                              m_bboxes;
+    std::vector<std::vector<BOARD_CONNECTED_ITEM*>> m_connections;
+    RTree<int, int, 2, double>                      m_tree;
+};
+
+#endif // ZONE_OUTLINE_INDEX_H
@@ -143,6 +143,9 @@ bool DRC_CACHE_GENERATOR::Run()
                     m_board->m_CopperItemRTreeCache = std::make_shared<DRC_RTREE>();
 
                 forEachGeometryItem( itemTypes, LSET::AllCuMask(), addToCopperTree );
+
+                // The tree is read-only from here on
+                m_board->m_CopperItemRTreeCache->Pack();
             } );
 
     std::future_status status = retn.wait_for( std::chrono::milliseconds( 250 ) );
@@ -186,6 +189,8 @@ bool DRC_CACHE_GENERATOR::Run()
                                    rtree->Insert( aZone, layer );
                            } );
 
+                   rtree->Pack();
+
                    {
                        std::unique_lock<std::shared_mutex> writeLock( m_board->m_CachesMutex );
                        m_board->m_CopperZoneRTreeCache[ aZone ] = std::move( rtree );
@@ -23,6 +23,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
 #include <atomic>
 #include <reporter.h>
 #include <progress_reporter.h>
@@ -36,6 +37,8 @@
 #include <drc/drc_test_provider.h>
 #include <drc/drc_item.h>
 #include <drc/drc_cache_generator.h>
+#include <drc/drc_result_cache.h>
+#include <mmh3_hash.h>
 #include <footprint.h>
 #include <pad.h>
 #include <pcb_track.h>
@@ -73,7 +76,11 @@ DRC_ENGINE::DRC_ENGINE( BOARD* aBoard, BOARD_DESIGN_SETTINGS *aSettings ) :
     m_reportAllTrackErrors( false ),
     m_testFootprints( false ),
     m_reporter( nullptr ),
-    m_progressReporter( nullptr )
+    m_progressReporter( nullptr ),
+    m_resultCache( nullptr ),
+    m_constraintCacheTimeStamp( -1 ),
+    m_constraintCacheHits( 0 ),
+    m_constraintCacheMisses( 0 )
 {
     m_errorLimits.resize( DRCE_LAST + 1 );
 
@@ -537,6 +544,151 @@ void DRC_ENGINE::compileRules()
             m_constraintMap[ constraint.m_Type ]->push_back( engineConstraint );
         }
     }
+
+    // Find the constraint types whose rules depend only on the netclasses and types of the
+    // items (and the layer), so that EvalRules() can share their results between items.
+    // Disallow, hole-to-hole and assertion constraints also depend on other item attributes.
+    m_classLevelConstraintTypes.clear();
+
+    for( const auto& [constraintType, ruleset] : m_constraintMap )
+    {
+        if( constraintType == DISALLOW_CONSTRAINT
+                || constraintType == HOLE_TO_HOLE_CONSTRAINT
+                || constraintType == ASSERTION_CONSTRAINT )
+        {
+            continue;
+        }
+
+        bool classLevel = std::all_of( ruleset->begin(), ruleset->end(),
+                [&]( const DRC_ENGINE_CONSTRAINT* c )
+                {
+                    return !c->condition
+                            || c->condition->GetExpression().IsEmpty()
+                            || c->condition->IsClassLevel();
+                } );
+
+        if( classLevel )
+            m_classLevelConstraintTypes.insert( constraintType );
+    }
+
+    clearConstraintCache();
+}
+
+
+void DRC_ENGINE::clearConstraintCache()
+{
+    std::unique_lock<std::shared_mutex> writeLock( m_constraintCacheMutex );
+
+    m_constraintCache.clear();
+    m_constraintCacheTimeStamp = -1;
+}
+
+
+bool DRC_ENGINE::lookupCachedConstraint( const CONSTRAINT_CACHE_KEY& aKey,
+                                         DRC_CONSTRAINT& aConstraint )
+{
+    std::shared_lock<std::shared_mutex> readLock( m_constraintCacheMutex );
+
+    // Any change to the board (such as to netclass assignments) invalidates the cache
+    if( m_constraintCacheTimeStamp == m_board->GetTimeStamp() )
+    {
+        auto it = m_constraintCache.find( aKey );
+
+        if( it != m_constraintCache.end() )
+        {
+            aConstraint = it->second;
+            m_constraintCacheHits++;
+            return true;
+        }
+    }
+
+    m_constraintCacheMisses++;
+    return false;
+}
+
+
+void DRC_ENGINE::cacheConstraint( const CONSTRAINT_CACHE_KEY& aKey,
+                                  const DRC_CONSTRAINT& aConstraint )
+{
+    std::unique_lock<std::shared_mutex> writeLock( m_constraintCacheMutex );
+
+    if( m_constraintCacheTimeStamp != m_board->GetTimeStamp() )
+    {
+        m_constraintCache.clear();
+        m_constraintCacheTimeStamp = m_board->GetTimeStamp();
+    }
+
+    m_constraintCache[ aKey ] = aConstraint;
+}
+
+
+HASH_128 DRC_ENGINE::computeRulesHash() const
+{
+    MMH3_HASH hash( 0x4452 );
+
+    for( const std::shared_ptr<DRC_RULE>& rule : m_rules )
+    {
+        DRC_RESULT_CACHE::HashString( hash, rule->m_Name );
+        hash.add( rule->m_Implicit );
+        hash.add( rule->m_Severity );
+        DRC_RESULT_CACHE::HashLayers( hash, rule->m_LayerCondition );
+
+        if( rule->m_Condition )
+            DRC_RESULT_CACHE::HashString( hash, rule->m_Condition->GetExpression() );
+
+        for( const DRC_CONSTRAINT& constraint : rule->m_Constraints )
+        {
+            const MINOPTMAX<int>& value = constraint.GetValue();
+
+            hash.add( constraint.m_Type );
+            hash.add( value.HasMin() ? value.Min() : INT_MIN );
+            hash.add( value.HasOpt() ? value.Opt() : INT_MIN );
+            hash.add( value.HasMax() ? value.Max() : INT_MIN );
+            hash.add( constraint.m_DisallowFlags );
+            hash.add( static_cast<int>( constraint.m_ZoneConnection ) );
+        }
+    }
+
+    hash.add( m_designSettings->m_MinClearance );
+    hash.add( m_designSettings->m_HoleClearance );
+    hash.add( m_designSettings->GetDRCEpsilon() );
+    hash.add( m_designSettings->m_MaxError );
+    hash.add( m_board->GetCopperLayerCount() );
+
+    return hash.digest();
+}
+
+
+bool DRC_ENGINE::canCacheResults( wxString* aRuleName ) const
+{
+    for( const std::shared_ptr<DRC_RULE>& rule : m_rules )
+    {
+        if( !rule->m_Condition )
+            continue;
+
+        // Only the clearance tests use the cache
+        bool cached = false;
+
+        for( const DRC_CONSTRAINT& constraint : rule->m_Constraints )
+        {
+            if( constraint.m_Type == CLEARANCE_CONSTRAINT
+                    || constraint.m_Type == HOLE_CLEARANCE_CONSTRAINT )
+            {
+                cached = true;
+            }
+        }
+
+        if( cached
+                && !DRC_RESULT_CACHE::IsConditionCacheable( rule->m_Condition->GetExpression() ) )
+        {
+            if( aRuleName )
+                *aRuleName = rule->m_Name;
+
+            return false;
+        }
+    }
+
+    return true;
 }
 
 
@@ -622,6 +774,26 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
 
     int timestamp = m_board->GetTimeStamp();
 
+    m_constraintCacheHits = 0;
+    m_constraintCacheMisses = 0;
+
+    if( m_resultCache )
+    {
+        wxString ruleName;
+
+        if( canCacheResults( &ruleName ) )
+        {
+            m_resultCache->BeginRun( computeRulesHash() );
+        }
+        else
+        {
+            ReportAux( wxString::Format( wxT( "Result cache not used: the condition of rule '%s' "
+                                              "depends on more than the items tested" ),
+                                         ruleName ) );
+            m_resultCache->BeginRun( HASH_128(), false );
+        }
+    }
+
     for( DRC_TEST_PROVIDER* provider : m_testProviders )
     {
         ReportAux( wxString::Format( wxT( "Run DRC provider: '%s'" ), provider->GetName() ) );
@@ -630,6 +802,17 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
             break;
     }
 
+    if( m_resultCache )
+    {
+        ReportAux( wxString::Format( wxT( "Result cache: %zu hits, %zu misses" ),
+                                     m_resultCache->GetHits(),
+                                     m_resultCache->GetMisses() ) );
+    }
+
+    ReportAux( wxString::Format( wxT( "Constraint cache: %zu hits, %zu misses" ),
+                                 GetConstraintCacheHits(),
+                                 GetConstraintCacheMisses() ) );
+
     // DRC tests are multi-threaded; anything that causes us to attempt to re-generate the
     // caches while DRC is running is problematic.
     wxASSERT( timestamp == m_board->GetTimeStamp() );
@@ -1284,8 +1467,32 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BO
     {
         std::vector<DRC_ENGINE_CONSTRAINT*>* ruleset = m_constraintMap[ aConstraintType ];
 
-        for( int ii = 0; ii < (int) ruleset->size(); ++ii )
-            processConstraint( ruleset->at( ii ) );
+        if( !aReporter && m_classLevelConstraintTypes.count( aConstraintType ) )
+        {
+            // The outcome of the ruleset depends only on what's in the key, so it can be
+            // shared between all items with the same netclasses and types.
+            CONSTRAINT_CACHE_KEY key = { aConstraintType,
+                                         ac ? ac->GetEffectiveNetClass() : nullptr,
+                                         bc ? bc->GetEffectiveNetClass() : nullptr,
+                                         a ? a->Type() : NOT_USED,
+                                         b ? b->Type() : NOT_USED,
+                                         aLayer,
+                                         a_is_non_copper,
+                                         b_is_non_copper };
+
+            if( !lookupCachedConstraint( key, constraint ) )
+            {
+                for( int ii = 0; ii < (int) ruleset->size(); ++ii )
+                    processConstraint( ruleset->at( ii ) );
+
+                cacheConstraint( key, constraint );
+            }
+        }
+        else
+        {
+            for( int ii = 0; ii < (int) ruleset->size(); ++ii )
+                processConstraint( ruleset->at( ii ) );
+        }
     }
 
     if( constraint.GetParentRule() && !constraint.GetParentRule()->m_Implicit )
@@ -24,12 +24,18 @@
 #ifndef DRC_ENGINE_H
 #define DRC_ENGINE_H
 
+#include <atomic>
 #include <memory>
+#include <set>
+#include <shared_mutex>
 #include <vector>
 #include <unordered_map>
 
 #include <units_provider.h>
+#include <core/typeinfo.h>
 #include <geometry/shape.h>
+#include <hash.h>
+#include <hash_128.h>
 #include <lset.h>
 #include <drc/drc_rule.h>
 
@@ -59,6 +65,7 @@ void drcPrintDebugMessage( int level, const wxString& msg, const char *function,
     drcPrintDebugMessage(level, wxString::Format( fmt, __VA_ARGS__ ), __FUNCTION__, __LINE__ );
 
 class DRC_RULE_CONDITION;
+class DRC_RESULT_CACHE;
 class DRC_ITEM;
 class DRC_RULE;
 class DRC_CONSTRAINT;
@@ -132,6 +139,13 @@ public:
      */
     void SetLogReporter( REPORTER* aReporter ) { m_reporter = aReporter; }
 
+    /**
+     * Set an optional cache of results from previous runs, which test providers can use to
+     * skip re-testing items which haven't changed.
+     */
+    void SetResultCache( DRC_RESULT_CACHE* aCache ) { m_resultCache = aCache; }
+    DRC_RESULT_CACHE* GetResultCache() const { return m_resultCache; }
+
     /**
      * Initialize the DRC engine.
      *
@@ -159,6 +173,14 @@ public:
 
     bool HasRulesForConstraintType( DRC_CONSTRAINT_T constraintID );
 
+    /**
+     * Statistics for the memoization of EvalRules() results for constraint types whose rules
+     * depend only on class-level attributes (netclass, item type and layer).  Reset by
+     * RunTests().
+     */
+    size_t GetConstraintCacheHits() const { return m_constraintCacheHits; }
+    size_t GetConstraintCacheMisses() const { return m_constraintCacheMisses; }
+
     bool GetReportAllTrackErrors() const { return m_reportAllTrackErrors; }
     bool GetTestFootprints() const { return m_testFootprints; }
 
@@ -224,9 +246,59 @@ private:
         DRC_CONSTRAINT             constraint;
     };
 
+    /**
+     * Everything which the rules for a class-level constraint type can depend on.
+     */
+    struct CONSTRAINT_CACHE_KEY
+    {
+        DRC_CONSTRAINT_T type;
+        const NETCLASS*  netclassA;
+        const NETCLASS*  netclassB;
+        KICAD_T          typeA;
+        KICAD_T          typeB;
+        PCB_LAYER_ID     layer;
+        bool             nonCopperA;
+        bool             nonCopperB;
+
+        bool operator==( const CONSTRAINT_CACHE_KEY& aOther ) const
+        {
+            return type == aOther.type && netclassA == aOther.netclassA
+                    && netclassB == aOther.netclassB && typeA == aOther.typeA
+                    && typeB == aOther.typeB && layer == aOther.layer
+                    && nonCopperA == aOther.nonCopperA && nonCopperB == aOther.nonCopperB;
+        }
+    };
+
+    struct CONSTRAINT_CACHE_KEY_HASH
+    {
+        size_t operator()( const CONSTRAINT_CACHE_KEY& aKey ) const
+        {
+            return hash_val( static_cast<int>( aKey.type ), aKey.netclassA, aKey.netclassB,
+                             static_cast<int>( aKey.typeA ), static_cast<int>( aKey.typeB ),
+                             static_cast<int>( aKey.layer ), aKey.nonCopperA, aKey.nonCopperB );
+        }
+    };
+
+    bool lookupCachedConstraint( const CONSTRAINT_CACHE_KEY& aKey, DRC_CONSTRAINT& aConstraint );
+    void cacheConstraint( const CONSTRAINT_CACHE_KEY& aKey, const DRC_CONSTRAINT& aConstraint );
+    void clearConstraintCache();
+
     void loadImplicitRules();
     std::shared_ptr<DRC_RULE> createImplicitRule( const wxString& name );
 
+    /**
+     * @return a hash of everything outside of the items themselves which can influence the
+     * result of a test (the rules and the relevant board settings).
+     */
+    HASH_128 computeRulesHash() const;
+
+    /**
+     * @return false if a rule used by the tests which cache their results has a condition which
+     *         reads anything not covered by the cache's keys (see
+     *         DRC_RESULT_CACHE::IsConditionCacheable()).  \a aRuleName is set to its name.
+     */
+    bool canCacheResults( wxString* aRuleName ) const;
+
 protected:
     BOARD_DESIGN_SETTINGS*     m_designSettings;
     BOARD*                     m_board;
@@ -244,9 +316,22 @@ protected:
     // constraint -> rule -> provider
     std::map<DRC_CONSTRAINT_T, std::vector<DRC_ENGINE_CONSTRAINT*>*> m_constraintMap;
 
+    // Constraint types whose rules all have class-level-only conditions (see compileRules())
+    std::set<DRC_CONSTRAINT_T> m_classLevelConstraintTypes;
+
+    // Memoized EvalRules() results for m_classLevelConstraintTypes; only valid for a single
+    // board timestamp
+    std::unordered_map<CONSTRAINT_CACHE_KEY, DRC_CONSTRAINT, CONSTRAINT_CACHE_KEY_HASH>
+                               m_constraintCache;
+    int                        m_constraintCacheTimeStamp;
+    std::shared_mutex          m_constraintCacheMutex;
+    std::atomic<size_t>        m_constraintCacheHits;
+    std::atomic<size_t>        m_constraintCacheMisses;
+
     DRC_VIOLATION_HANDLER      m_violationHandler;
     REPORTER*                  m_reporter;
     PROGRESS_REPORTER*         m_progressReporter;
+    DRC_RESULT_CACHE*          m_resultCache;
 
     std::shared_ptr<KIGFX::VIEW_OVERLAY> m_debugOverlay;
 };
@@ -0,0 +1,580 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <cstring>
+#include <set>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+#include <board.h>
+#include <board_connected_item.h>
+#include <footprint.h>
+#include <lset.h>
+#include <mmh3_hash.h>
+#include <netclass.h>
+#include <pad.h>
+#include <pcb_shape.h>
+#include <pcb_track.h>
+#include <zone.h>
+#include <drc/drc_result_cache.h>
+
+
+static const char     DRC_CACHE_MAGIC[16] = "KICAD_DRC_CACHE";
+static const uint32_t DRC_CACHE_VERSION = 2;
+
+
+static void addToHash( MMH3_HASH& aHash, uint64_t aValue )
+{
+    aHash.add( static_cast<int32_t>( aValue >> 32 ) );
+    aHash.add( static_cast<int32_t>( aValue & 0xFFFFFFFF ) );
+}
+
+
+static void addToHash( MMH3_HASH& aHash, const HASH_128& aValue )
+{
+    addToHash( aHash, aValue.Value64[0] );
+    addToHash( aHash, aValue.Value64[1] );
+}
+
+
+static void addToHash( MMH3_HASH& aHash, const VECTOR2I& aValue )
+{
+    aHash.add( aValue.x );
+    aHash.add( aValue.y );
+}
+
+
+static void addToHash( MMH3_HASH& aHash, const std::optional<int>& aValue )
+{
+    aHash.add( aValue.has_value() );
+    aHash.add( aValue.value_or( 0 ) );
+}
+
+
+static void addToHash( MMH3_HASH& aHash, const EDA_ANGLE& aValue )
+{
+    double   degrees = aValue.AsDegrees();
+    uint64_t bits;
+
+    static_assert( sizeof( bits ) == sizeof( degrees ) );
+    memcpy( &bits, &degrees, sizeof( bits ) );
+    addToHash( aHash, bits );
+}
+
+
+static bool isCacheable( const BOARD_ITEM* aItem )
+{
+    // Types which itemHash() hashes completely
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    case PCB_VIA_T:
+    case PCB_PAD_T:
+    case PCB_SHAPE_T:
+    case PCB_ZONE_T:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+
+DRC_RESULT_CACHE::DRC_RESULT_CACHE() :
+        m_enabled( true ),
+        m_hits( 0 ),
+        m_misses( 0 )
+{
+}
+
+
+void DRC_RESULT_CACHE::HashString( MMH3_HASH& aHash, const wxString& aValue )
+{
+    wxScopedCharBuffer utf8 = aValue.utf8_str();
+    const char*        data = utf8.data();
+    size_t             length = utf8.length();
+
+    aHash.add( static_cast<int32_t>( length ) );
+
+    for( size_t ii = 0; ii < length; ii += 4 )
+    {
+        uint32_t word = 0;
+
+        for( size_t jj = ii; jj < std::min( ii + 4, length ); ++jj )
+            word |= static_cast<uint32_t>( static_cast<uint8_t>( data[jj] ) )
+                    << ( 8 * ( jj - ii ) );
+
+        aHash.add( static_cast<int32_t>( word ) );
+    }
+}
+
+
+void DRC_RESULT_CACHE::HashLayers( MMH3_HASH& aHash, const LSET& aLayers )
+{
+    LSEQ layers = aLayers.Seq();
+
+    aHash.add( static_cast<int32_t>( layers.size() ) );
+
+    for( PCB_LAYER_ID layer : layers )
+        aHash.add( layer );
+}
+
+
+bool DRC_RESULT_CACHE::IsConditionCacheable( const wxString& aExpression )
+{
+    // Properties (with '_' for ' ', lower case) whose values are all covered by itemHash()
+    static const std::set<wxString> pairProperties = {
+        wxS( "type" ), wxS( "layer" ), wxS( "net" ), wxS( "netname" ), wxS( "netclass" ),
+        wxS( "net class" ), wxS( "width" ), wxS( "via type" ), wxS( "diameter" ), wxS( "hole" ),
+        wxS( "layer top" ), wxS( "layer bottom" ), wxS( "pad type" ), wxS( "pad number" ),
+        wxS( "pad shape" ), wxS( "hole shape" ), wxS( "hole size x" ), wxS( "hole size y" ),
+        wxS( "size x" ), wxS( "size y" ), wxS( "orientation" ), wxS( "position x" ),
+        wxS( "position y" ), wxS( "start x" ), wxS( "start y" ), wxS( "end x" ), wxS( "end y" )
+    };
+
+    // Functions which only look at the items being tested
+    static const std::set<wxString> pairFunctions = {
+        wxS( "existsonlayer" ), wxS( "isplated" ), wxS( "ismicrovia" ),
+        wxS( "isblindburiedvia" ), wxS( "hasnetclass" ),
+        wxS( "iscoupleddiffpair" )   // Only compares the two items' net names
+    };
+
+    size_t ii = 0;
+    size_t length = aExpression.length();
+
+    auto isIdentChar =
+            [&]( size_t aIdx )
+            {
+                return aIdx < length
+                       && ( wxIsalnum( aExpression[aIdx] ) || aExpression[aIdx] == '_' );
+            };
+
+    auto skipSpace =
+            [&]( size_t aIdx )
+            {
+                while( aIdx < length && wxIsspace( aExpression[aIdx] ) )
+                    aIdx++;
+
+                return aIdx;
+            };
+
+    while( ii < length )
+    {
+        wxUniChar c = aExpression[ii];
+
+        if( c == '\'' || c == '"' )
+        {
+            // Skip string literals, which are compared against rather than read
+            for( ii++; ii < length && aExpression[ii] != c; ii++ )
+            {
+                if( aExpression[ii] == '\\' )
+                    ii++;
+            }
+
+            ii++;
+        }
+        else if( isIdentChar( ii ) && !wxIsdigit( c ) )
+        {
+            size_t start = ii;
+
+            while( isIdentChar( ii ) )
+                ii++;
+
+            wxString ident = aExpression.Mid( start, ii - start ).Lower();
+            size_t   next = skipSpace( ii );
+
+            if( next < length && aExpression[next] == '(' )
+            {
+                if( !pairFunctions.count( ident ) )
+                    return false;
+            }
+            else if( next < length && aExpression[next] == '.' )
+            {
+                // An object; the property or function is checked as the next identifier
+                if( ident != wxS( "a" ) && ident != wxS( "b" ) && ident != wxS( "ab" ) )
+                    return false;
+
+                ii = skipSpace( next + 1 );
+                start = ii;
+
+                while( isIdentChar( ii ) )
+                    ii++;
+
+                wxString member = aExpression.Mid( start, ii - start ).Lower();
+                next = skipSpace( ii );
+
+                if( next < length && aExpression[next] == '(' )
+                {
+                    if( !pairFunctions.count( member ) )
+                        return false;
+                }
+                else
+                {
+                    member.Replace( wxS( "_" ), wxS( " " ) );
+
+                    if( !pairProperties.count( member ) )
+                        return false;
+                }
+            }
+
+            // Anything else is a unit suffix (or a syntax error, which fails to compile anyway)
+        }
+        else if( wxIsdigit( c ) )
+        {
+            // Numbers, including any unit suffix
+            while( isIdentChar( ii ) || ( ii < length && aExpression[ii] == '.' ) )
+                ii++;
+        }
+        else
+        {
+            ii++;
+        }
+    }
+
+    return true;
+}
+
+
+wxString DRC_RESULT_CACHE::GetCacheFilename( const BOARD* aBoard )
+{
+    wxFileName fn( aBoard->GetFileName() );
+    fn.SetExt( wxS( "drc-cache" ) );
+
+    return fn.GetFullPath();
+}
+
+
+bool DRC_RESULT_CACHE::Load( const wxString& aFilename )
+{
+    std::unique_lock<std::shared_mutex> lock( m_resultsMutex );
+
+    m_previous.clear();
+    m_rulesHash.Clear();
+
+    wxFFile file( aFilename, wxS( "rb" ) );
+
+    if( !file.IsOpened() )
+        return false;
+
+    char     magic[16];
+    uint32_t version = 0;
+    uint64_t count = 0;
+    HASH_128 rulesHash;
+
+    auto read =
+            [&]( void* aBuffer, size_t aSize )
+            {
+                return file.Read( aBuffer, aSize ) == aSize;
+            };
+
+    if( !read( magic, sizeof( magic ) )
+            || memcmp( magic, DRC_CACHE_MAGIC, sizeof( magic ) ) != 0
+            || !read( &version, sizeof( version ) )
+            || version != DRC_CACHE_VERSION
+            || !read( rulesHash.Value8, sizeof( rulesHash.Value8 ) )
+            || !read( &count, sizeof( count ) ) )
+    {
+        return false;
+    }
+
+    m_previous.reserve( count );
+
+    for( uint64_t ii = 0; ii < count; ++ii )
+    {
+        HASH_128 key;
+
+        if( !read( key.Value8, sizeof( key.Value8 ) ) )
+        {
+            m_previous.clear();
+            return false;
+        }
+
+        m_previous.insert( key );
+    }
+
+    m_rulesHash = rulesHash;
+    return true;
+}
+
+
+bool DRC_RESULT_CACHE::Save( const wxString& aFilename ) const
+{
+    std::shared_lock<std::shared_mutex> lock( m_resultsMutex );
+
+    wxFFile file( aFilename, wxS( "wb" ) );
+
+    if( !file.IsOpened() )
+        return false;
+
+    auto write =
+            [&]( const void* aBuffer, size_t aSize )
+            {
+                return file.Write( aBuffer, aSize ) == aSize;
+            };
+
+    uint64_t count = m_current.size();
+
+    if( !write( DRC_CACHE_MAGIC, sizeof( DRC_CACHE_MAGIC ) )
+            || !write( &DRC_CACHE_VERSION, sizeof( DRC_CACHE_VERSION ) )
+            || !write( m_rulesHash.Value8, sizeof( m_rulesHash.Value8 ) )
+            || !write( &count, sizeof( count ) ) )
+    {
+        return false;
+    }
+
+    for( const HASH_128& key : m_current )
+    {
+        if( !write( key.Value8, sizeof( key.Value8 ) ) )
+            return false;
+    }
+
+    return file.Close();
+}
+
+
+void DRC_RESULT_CACHE::BeginRun( const HASH_128& aRulesHash, bool aEnabled )
+{
+    std::unique_lock<std::shared_mutex> lock( m_resultsMutex );
+    std::unique_lock<std::shared_mutex> itemLock( m_itemHashesMutex );
+
+    // If the cache is being reused then the last run's results supersede whatever was loaded
+    if( !m_current.empty() )
+        m_previous = std::move( m_current );
+
+    // Any previous results were produced under different rules; we can't trust them
+    if( !aEnabled || !( aRulesHash == m_rulesHash ) )
+        m_previous.clear();
+
+    m_enabled = aEnabled;
+    m_rulesHash = aRulesHash;
+    m_current.clear();
+    m_itemHashes.clear();
+    m_hits = 0;
+    m_misses = 0;
+}
+
+
+HASH_128 DRC_RESULT_CACHE::itemHash( const BOARD_ITEM* aItem, PCB_LAYER_ID aLayer )
+{
+    // The shapes of pads, vias and zones differ by layer
+    std::pair<const BOARD_ITEM*, int> cacheKey( aItem, aLayer );
+
+    {
+        std::shared_lock<std::shared_mutex> readLock( m_itemHashesMutex );
+        auto                                it = m_itemHashes.find( cacheKey );
+
+        if( it != m_itemHashes.end() )
+            return it->second;
+    }
+
+    MMH3_HASH hash( 0x4452 );
+
+    HashString( hash, aItem->m_Uuid.AsString() );
+    hash.add( aItem->Type() );
+    HashLayers( hash, aItem->GetLayerSet() );
+
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    {
+        const PCB_TRACK* track = static_cast<const PCB_TRACK*>( aItem );
+
+        addToHash( hash, track->GetStart() );
+        addToHash( hash, track->GetEnd() );
+        hash.add( track->GetWidth() );
+
+        if( track->Type() == PCB_ARC_T )
+            addToHash( hash, static_cast<const PCB_ARC*>( track )->GetMid() );
+
+        break;
+    }
+
+    case PCB_VIA_T:
+    {
+        const PCB_VIA* via = static_cast<const PCB_VIA*>( aItem );
+
+        addToHash( hash, via->GetPosition() );
+        hash.add( via->GetWidth() );
+        hash.add( via->GetDrillValue() );
+        hash.add( static_cast<int>( via->GetViaType() ) );
+        hash.add( via->TopLayer() );
+        hash.add( via->BottomLayer() );
+        hash.add( via->FlashLayer( aLayer ) );
+        break;
+    }
+
+    case PCB_PAD_T:
+    {
+        const PAD* pad = static_cast<const PAD*>( aItem );
+
+        addToHash( hash, pad->GetPosition() );
+        addToHash( hash, pad->GetOrientation() );
+        addToHash( hash, pad->GetSize() );
+        addToHash( hash, pad->GetOffset() );
+        hash.add( static_cast<int>( pad->GetShape() ) );
+        hash.add( static_cast<int>( pad->GetAttribute() ) );
+        addToHash( hash, pad->GetDrillSize() );
+        hash.add( static_cast<int>( pad->GetDrillShape() ) );
+        hash.add( pad->FlashLayer( aLayer ) );
+        HashString( hash, pad->GetNumber() );
+
+        // Covers the rest of the shape (corner radii, chamfers, custom primitives, etc.)
+        addToHash( hash, pad->GetEffectivePolygon( ERROR_INSIDE )->GetHash() );
+        break;
+    }
+
+    case PCB_SHAPE_T:
+    {
+        const PCB_SHAPE* shape = static_cast<const PCB_SHAPE*>( aItem );
+
+        hash.add( static_cast<int>( shape->GetShape() ) );
+        addToHash( hash, shape->GetStart() );
+        addToHash( hash, shape->GetEnd() );
+        hash.add( shape->GetWidth() );
+        hash.add( shape->IsFilled() );
+
+        switch( shape->GetShape() )
+        {
+        case SHAPE_T::ARC:
+            addToHash( hash, shape->GetArcMid() );
+            break;
+
+        case SHAPE_T::BEZIER:
+            addToHash( hash, shape->GetBezierC1() );
+            addToHash( hash, shape->GetBezierC2() );
+            break;
+
+        case SHAPE_T::POLY:
+            addToHash( hash, shape->GetPolyShape().GetHash() );
+            break;
+
+        default:
+            break;
+        }
+
+        break;
+    }
+
+    case PCB_ZONE_T:
+    {
+        const ZONE* zone = static_cast<const ZONE*>( aItem );
+
+        addToHash( hash, zone->Outline()->GetHash() );
+        hash.add( zone->GetIsRuleArea() );
+        hash.add( zone->IsTeardropArea() );
+
+        if( zone->HasFilledPolysForLayer( aLayer ) )
+            addToHash( hash, zone->GetFilledPolysList( aLayer )->GetHash() );
+
+        break;
+    }
+
+    default:
+        wxFAIL_MSG( wxT( "DRC_RESULT_CACHE::itemHash: type not handled by isCacheable()" ) );
+        break;
+    }
+
+    if( aItem->IsConnected() )
+    {
+        const BOARD_CONNECTED_ITEM* cItem = static_cast<const BOARD_CONNECTED_ITEM*>( aItem );
+
+        HashString( hash, cItem->GetNetname() );
+
+        if( NETCLASS* netclass = cItem->GetEffectiveNetClass() )
+        {
+            HashString( hash, netclass->GetName() );
+            HashString( hash, netclass->GetVariableSubstitutionName() );
+        }
+
+        addToHash( hash, cItem->GetLocalClearance() );
+        addToHash( hash, cItem->GetLocalClearance( nullptr ) );
+        addToHash( hash, cItem->GetClearanceOverrides( nullptr ) );
+    }
+
+    if( const FOOTPRINT* parentFP = aItem->GetParentFootprint() )
+    {
+        HashString( hash, parentFP->m_Uuid.AsString() );
+        HashString( hash, parentFP->GetReference() );
+        HashString( hash, parentFP->GetValue() );
+        hash.add( parentFP->GetAttributes() );
+        addToHash( hash, parentFP->GetLocalClearance() );
+
+        // Net-tie exclusions depend on which of the footprint's pads are tied
+        for( const wxString& group : parentFP->GetNetTiePadGroups() )
+            HashString( hash, group );
+    }
+
+    HASH_128 result = hash.digest();
+
+    std::unique_lock<std::shared_mutex> writeLock( m_itemHashesMutex );
+    m_itemHashes[ cacheKey ] = result;
+
+    return result;
+}
+
+
+bool DRC_RESULT_CACHE::GetKey( int aTest, const BOARD_ITEM* aItemA, const BOARD_ITEM* aItemB,
+                               PCB_LAYER_ID aLayer, HASH_128& aKey )
+{
+    if( !m_enabled || !isCacheable( aItemA ) || !isCacheable( aItemB ) )
+        return false;
+
+    MMH3_HASH hash( 0x4452 );
+
+    addToHash( hash, m_rulesHash );
+    addToHash( hash, aTest );
+    addToHash( hash, aLayer );
+    addToHash( hash, itemHash( aItemA, aLayer ) );
+    addToHash( hash, itemHash( aItemB, aLayer ) );
+
+    aKey = hash.digest();
+    return true;
+}
+
+
+bool DRC_RESULT_CACHE::IsClean( const HASH_128& aKey )
+{
+    {
+        std::shared_lock<std::shared_mutex> readLock( m_resultsMutex );
+
+        if( !m_previous.count( aKey ) )
+        {
+            m_misses++;
+            return false;
+        }
+    }
+
+    m_hits++;
+    MarkClean( aKey );
+    return true;
+}
+
+
+void DRC_RESULT_CACHE::MarkClean( const HASH_128& aKey )
+{
+    std::unique_lock<std::shared_mutex> writeLock( m_resultsMutex );
+    m_current.insert( aKey );
+}
@@ -0,0 +1,160 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#ifndef DRC_RESULT_CACHE__H
+#define DRC_RESULT_CACHE__H
+
+#include <atomic>
+#include <map>
+#include <shared_mutex>
+#include <unordered_set>
+
+#include <hash_128.h>
+#include <layer_ids.h>
+#include <wx/string.h>
+
+class BOARD;
+class BOARD_ITEM;
+class LSET;
+class MMH3_HASH;
+
+
+/**
+ * A persistent record of the item pairs which passed a DRC test, so that a later run can skip
+ * re-testing them if none of their inputs have changed.
+ *
+ * Only passing results are recorded: pairs which produced a violation are always re-tested (so
+ * that their markers are regenerated).
+ *
+ * A result is keyed on the test which produced it, the layer, and a hash of each item.  An
+ * item's hash covers its geometry (and fill, for zones), its net and netclass, its local
+ * overrides and those of its parent footprint.  The whole cache is further tied to a hash of the
+ * resolved rule set, and is discarded when that changes.
+ *
+ * A rule condition can read almost anything on the board (other items, rule areas, courtyards,
+ * fields of the parent footprint, etc.), none of which is in the key.  So the cache is only used
+ * when every condition of the rules the cached tests evaluate reads nothing but the properties
+ * in the key; see IsConditionCacheable().
+ *
+ * All hashes are MurmurHash3 of the values themselves (never std::hash, which can differ between
+ * builds), so that they can be saved.
+ */
+class DRC_RESULT_CACHE
+{
+public:
+    DRC_RESULT_CACHE();
+
+    /**
+     * @return the name of the cache file kept alongside \a aBoard.
+     */
+    static wxString GetCacheFilename( const BOARD* aBoard );
+
+    /**
+     * Load the results of a previous run.  A missing or malformed file just leaves the cache
+     * empty.
+     */
+    bool Load( const wxString& aFilename );
+
+    /**
+     * Save the results of the current run (ie: all pairs which were either tested clean or
+     * skipped as clean).
+     */
+    bool Save( const wxString& aFilename ) const;
+
+    /**
+     * Start a new run using the given rule set.  Results of previous runs are only kept if
+     * they were produced with the same rule set.
+     *
+     * @param aEnabled false if the rule set can't be cached, in which case no results are
+     *                 looked up or recorded during the run.
+     */
+    void BeginRun( const HASH_128& aRulesHash, bool aEnabled = true );
+
+    bool IsEnabled() const { return m_enabled; }
+
+    /**
+     * @return true if a rule condition only depends on properties of the two items which are
+     *         covered by their hashes (such as their type, layer, net, netclass and geometry).
+     *         Anything else, including every function which looks beyond the item itself, makes
+     *         the condition uncacheable.
+     */
+    static bool IsConditionCacheable( const wxString& aExpression );
+
+    /**
+     * Add \a aValue to \a aHash in a way which doesn't depend on the build (unlike std::hash).
+     */
+    static void HashString( MMH3_HASH& aHash, const wxString& aValue );
+
+    static void HashLayers( MMH3_HASH& aHash, const LSET& aLayers );
+
+    /**
+     * Build the key for the result of test \a aTest between \a aItemA and \a aItemB on
+     * \a aLayer.
+     *
+     * @return false if the result can't be cached (because one of the items is of a type
+     *         which can't be completely hashed).
+     */
+    bool GetKey( int aTest, const BOARD_ITEM* aItemA, const BOARD_ITEM* aItemB,
+                 PCB_LAYER_ID aLayer, HASH_128& aKey );
+
+    /**
+     * @return true if the result for \a aKey was clean last time.  (The result is carried
+     * forward to the current run.)
+     */
+    bool IsClean( const HASH_128& aKey );
+
+    void MarkClean( const HASH_128& aKey );
+
+    size_t GetHits() const { return m_hits; }
+    size_t GetMisses() const { return m_misses; }
+
+private:
+    HASH_128 itemHash( const BOARD_ITEM* aItem, PCB_LAYER_ID aLayer );
+
+    struct HASH_128_HASH
+    {
+        size_t operator()( const HASH_128& aHash ) const
+        {
+            return static_cast<size_t>( aHash.Value64[0] ^ aHash.Value64[1] );
+        }
+    };
+
+private:
+    bool                                                    m_enabled;
+    HASH_128                                                m_rulesHash;
+
+    std::unordered_set<HASH_128, HASH_128_HASH>             m_previous;
+    std::unordered_set<HASH_128, HASH_128_HASH>             m_current;
+    mutable std::shared_mutex                               m_resultsMutex;
+
+    // Item hashes are only valid for a single run
+    std::map<std::pair<const BOARD_ITEM*, int>, HASH_128>   m_itemHashes;
+    std::shared_mutex                                       m_itemHashesMutex;
+
+    std::atomic<size_t>                                     m_hits;
+    std::atomic<size_t>                                     m_misses;
+};
+
+
+#endif // DRC_RESULT_CACHE__H
@@ -33,6 +33,7 @@
 #include <set>
 #include <vector>
 
+#include <geometry/packed_rtree.h>
 #include <geometry/rtree.h>
 #include <geometry/shape.h>
 #include <geometry/shape_segment.h>
@@ -71,11 +72,13 @@ public:
         const SHAPE*           shape;
         std::shared_ptr<SHAPE> shapeStorage;
         std::shared_ptr<SHAPE> parentShape;
+        BOX2I                  bbox;        // The indexed box (ie: including clearance)
     };
 
 private:
 
     using drc_rtree = RTree<ITEM_WITH_SHAPE*, int, 2, double>;
+    using drc_packed_rtree = PACKED_RTREE<ITEM_WITH_SHAPE*>;
 
 public:
 
@@ -85,6 +88,7 @@ public:
             m_tree[layer] = new drc_rtree();
 
         m_count = 0;
+        m_packed = false;
     }
 
     ~DRC_RTREE()
@@ -115,6 +119,9 @@ public:
     {
         wxCHECK( aTargetLayer != UNDEFINED_LAYER, /* void */ );
 
+        if( m_packed )
+            unpack();
+
         if( ( aItem->Type() == PCB_FIELD_T || aItem->Type() == PCB_TEXT_T )
             && !static_cast<PCB_TEXT*>( aItem )->IsVisible() )
         {
@@ -142,6 +149,7 @@ public:
             const int        mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
             ITEM_WITH_SHAPE* itemShape = new ITEM_WITH_SHAPE( aItem, subshape, shape );
 
+            itemShape->bbox = bbox;
             m_tree[aTargetLayer]->Insert( mmin, mmax, itemShape );
             m_count++;
         }
@@ -157,6 +165,7 @@ public:
             const int        mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
             ITEM_WITH_SHAPE* itemShape = new ITEM_WITH_SHAPE( aItem, hole, shape );
 
+            itemShape->bbox = bbox;
             m_tree[aTargetLayer]->Insert( mmin, mmax, itemShape );
             m_count++;
         }
@@ -170,9 +179,39 @@ public:
         for( auto tree : m_tree )
             tree->RemoveAll();
 
+        unpack();
         m_count = 0;
     }
 
+    /**
+     * Build a packed, read-only copy of the index which is used for all subsequent queries
+     * until the tree is next modified.  Call once the tree is fully populated (for instance,
+     * by DRC_CACHE_GENERATOR before the DRC providers are run).
+     */
+    void Pack()
+    {
+        for( int layer : LSET::AllLayersMask().Seq() )
+        {
+            drc_packed_rtree& packedTree = m_packedTree[layer];
+
+            packedTree.clear();
+
+            for( ITEM_WITH_SHAPE* item : *m_tree[layer] )
+            {
+                const int mmin[2] = { item->bbox.GetX(), item->bbox.GetY() };
+                const int mmax[2] = { item->bbox.GetRight(), item->bbox.GetBottom() };
+
+                packedTree.Add( mmin, mmax, item );
+            }
+
+            packedTree.Build();
+        }
+
+        m_packed = true;
+    }
+
+    bool IsPacked() const { return m_packed; }
+
     bool CheckColliding( SHAPE* aRefShape, PCB_LAYER_ID aTargetLayer, int aClearance = 0,
                          std::function<bool( BOARD_ITEM*)> aFilter = nullptr ) const
     {
@@ -201,7 +240,7 @@ public:
                     return true;
                 };
 
-        this->m_tree[aTargetLayer]->Search( min, max, visit );
+        search( aTargetLayer, min, max, visit );
         return count > 0;
     }
 
@@ -271,7 +310,7 @@ public:
                     return true;
                 };
 
-        this->m_tree[aTargetLayer]->Search( min, max, visit );
+        search( aTargetLayer, min, max, visit );
         return count;
     }
 
@@ -318,7 +357,7 @@ public:
                     return true;
                 };
 
-        this->m_tree[aLayer]->Search( min, max, visit );
+        search( aLayer, min, max, visit );
 
         if( collision )
         {
@@ -389,9 +428,9 @@ public:
                 };
 
         if( poly && poly->OutlineCount() == 1 && poly->HoleCount( 0 ) == 0 )
-            this->m_tree[aLayer]->Search( min, max, polyVisitor );
+            search( aLayer, min, max, polyVisitor );
         else
-            this->m_tree[aLayer]->Search( min, max, visitor );
+            search( aLayer, min, max, visitor );
 
         return collision;
     }
@@ -416,7 +455,7 @@ public:
                     return true;
                 };
 
-        m_tree[aLayer]->Search( min, max, visitor );
+        search( aLayer, min, max, visitor );
 
         return retval;
     }
@@ -468,7 +507,7 @@ public:
                             return true;
                         };
 
-                this->m_tree[targetLayer]->Search( min, max, visit );
+                search( targetLayer, min, max, visit );
             };
         }
 
@@ -579,8 +618,30 @@ public:
 
 
 private:
-    drc_rtree*  m_tree[PCB_LAYER_ID_COUNT];
-    size_t      m_count;
+    template <class VISITOR>
+    void search( PCB_LAYER_ID aLayer, const int aMin[2], const int aMax[2],
+                 VISITOR& aVisitor ) const
+    {
+        if( m_packed )
+            m_packedTree[aLayer].Search( aMin, aMax, aVisitor );
+        else
+            m_tree[aLayer]->Search( aMin, aMax, aVisitor );
+    }
+
+    void unpack()
+    {
+        for( drc_packed_rtree& packedTree : m_packedTree )
+            packedTree.clear();
+
+        m_packed = false;
+    }
+
+private:
+    drc_rtree*        m_tree[PCB_LAYER_ID_COUNT];
+    size_t            m_count;
+
+    drc_packed_rtree  m_packedTree[PCB_LAYER_ID_COUNT];
+    bool              m_packed;
 };
 
 
@@ -22,15 +22,299 @@
  */
 
 
-#include <board_item.h>
+#include <vector>
+
+#include <board_connected_item.h>
+#include <netclass.h>
+#include <pad.h>
 #include <reporter.h>
+#include <string_utils.h>
 #include <drc/drc_rule_condition.h>
 #include <pcbexpr_evaluator.h>
 
 
+namespace
+{
+
+using TERM = std::function<bool( BOARD_ITEM* aItemA, BOARD_ITEM* aItemB, PCB_LAYER_ID aLayer )>;
+
+
+/**
+ * A minimal scanner for the condition shapes which DRC_RULE_CONDITION lowers to native
+ * predicates.  It follows the LIBEVAL tokenizer's rules for identifiers and string literals;
+ * anything else is left to the interpreter.
+ */
+class CONDITION_SCANNER
+{
+public:
+    CONDITION_SCANNER( const wxString& aExpression ) :
+            m_str( aExpression ),
+            m_pos( 0 )
+    {}
+
+    bool AtEnd()
+    {
+        skipWhitespace();
+        return m_pos >= m_str.length();
+    }
+
+    bool Match( const wxString& aToken )
+    {
+        skipWhitespace();
+
+        if( m_str.compare( m_pos, aToken.length(), aToken ) != 0 )
+            return false;
+
+        m_pos += aToken.length();
+        return true;
+    }
+
+    bool Identifier( wxString& aIdentifier )
+    {
+        skipWhitespace();
+
+        size_t start = m_pos;
+
+        if( m_pos < m_str.length() && ( wxIsalpha( m_str[m_pos] ) || m_str[m_pos] == '_' ) )
+        {
+            while( m_pos < m_str.length() && ( wxIsalnum( m_str[m_pos] ) || m_str[m_pos] == '_' ) )
+                m_pos++;
+        }
+
+        aIdentifier = m_str.Mid( start, m_pos - start );
+        return m_pos > start;
+    }
+
+    bool StringLiteral( wxString& aValue )
+    {
+        if( !Match( wxT( "'" ) ) )
+            return false;
+
+        aValue.clear();
+
+        while( m_pos < m_str.length() && m_str[m_pos] != '\'' )
+        {
+            if( m_str[m_pos] == '\\' && m_pos + 1 < m_str.length() && m_str[m_pos + 1] == '\'' )
+                m_pos++;
+
+            aValue.append( 1, m_str[m_pos++] );
+        }
+
+        if( m_pos >= m_str.length() )
+            return false;
+
+        m_pos++;
+        return true;
+    }
+
+private:
+    void skipWhitespace()
+    {
+        while( m_pos < m_str.length() && wxIsspace( m_str[m_pos] ) )
+            m_pos++;
+    }
+
+private:
+    const wxString& m_str;
+    size_t          m_pos;
+};
+
+
+/**
+ * Mirrors LIBEVAL::VALUE::EqualTo() for a string compared against a literal.
+ */
+struct STRING_MATCHER
+{
+    STRING_MATCHER( const wxString& aLiteral ) :
+            m_literal( aLiteral ),
+            m_isWildcard( aLiteral.Contains( wxT( "*" ) ) || aLiteral.Contains( wxT( "?" ) ) )
+    {}
+
+    bool operator()( const wxString& aValue ) const
+    {
+        if( m_isWildcard )
+            return WildCompareString( m_literal, aValue, false );
+        else
+            return aValue.IsSameAs( m_literal, false );
+    }
+
+    wxString m_literal;
+    bool     m_isWildcard;
+};
+
+
+/**
+ * Lower "A.<field> == 'literal'" (or !=).  As with the interpreter, a comparison against an
+ * undefined value (a missing item, or a net property of an unconnected item) is false for both
+ * operators.
+ */
+TERM makeComparisonTerm( int aIdx, const wxString& aField, bool aEqual, const wxString& aLiteral )
+{
+    STRING_MATCHER matcher( aLiteral );
+
+    if( aField.CmpNoCase( wxT( "NetClass" ) ) == 0 )
+    {
+        return [aIdx, aEqual, matcher]( BOARD_ITEM* a, BOARD_ITEM* b, PCB_LAYER_ID )
+               {
+                   BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( aIdx ? b : a );
+
+                   if( !item )
+                       return false;
+
+                   NETCLASS* netclass = item->GetEffectiveNetClass();
+
+                   return matcher( netclass->GetVariableSubstitutionName() ) == aEqual;
+               };
+    }
+    else if( aField.CmpNoCase( wxT( "NetName" ) ) == 0 )
+    {
+        return [aIdx, aEqual, matcher]( BOARD_ITEM* a, BOARD_ITEM* b, PCB_LAYER_ID )
+               {
+                   BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( aIdx ? b : a );
+
+                   if( !item )
+                       return false;
+
+                   return matcher( item->GetNetname() ) == aEqual;
+               };
+    }
+    else if( aField.CmpNoCase( wxT( "Type" ) ) == 0 )
+    {
+        // Resolve the literal against the type names once, here, rather than per evaluation
+        std::vector<bool> matches( MAX_STRUCT_TYPE_ID, false );
+
+        for( int type = 0; type < MAX_STRUCT_TYPE_ID; ++type )
+            matches[type] = matcher( ENUM_MAP<KICAD_T>::Instance().ToString( static_cast<KICAD_T>( type ) ) );
+
+        return [aIdx, aEqual, matches]( BOARD_ITEM* a, BOARD_ITEM* b, PCB_LAYER_ID )
+               {
+                   BOARD_ITEM* item = aIdx ? b : a;
+
+                   if( !item )
+                       return false;
+
+                   return matches[ item->Type() ] == aEqual;
+               };
+    }
+
+    return nullptr;
+}
+
+
+/**
+ * Lower "A.<func>()" or "A.<func>('arg')".
+ */
+TERM makeFunctionTerm( int aIdx, const wxString& aFunc, bool aHasArg, const wxString& aArg )
+{
+    if( aFunc == wxT( "isplated" ) && !aHasArg )
+    {
+        return [aIdx]( BOARD_ITEM* a, BOARD_ITEM* b, PCB_LAYER_ID )
+               {
+                   BOARD_ITEM* item = aIdx ? b : a;
+
+                   if( !item )
+                       return false;
+
+                   if( item->Type() == PCB_PAD_T )
+                       return static_cast<PAD*>( item )->GetAttribute() == PAD_ATTRIB::PTH;
+
+                   return item->Type() == PCB_VIA_T;
+               };
+    }
+    else if( ( aFunc == wxT( "intersectscourtyard" ) || aFunc == wxT( "insidecourtyard" ) )
+             && aHasArg && !aArg.IsEmpty() )
+    {
+        return [aIdx, aArg]( BOARD_ITEM* a, BOARD_ITEM* b, PCB_LAYER_ID aLayer )
+               {
+                   BOARD_ITEM* item = aIdx ? b : a;
+
+                   if( !item )
+                       return false;
+
+                   // Only needed to resolve 'A' and 'B' arguments, and the layer of the item's
+                   // effective shape.
+                   PCBEXPR_CONTEXT ctx( 0, aLayer );
+                   ctx.SetItems( a, b );
+
+                   return ItemIntersectsCourtyard( item, aArg, &ctx );
+               };
+    }
+
+    return nullptr;
+}
+
+
+/**
+ * @param aClassLevel will be cleared if the term depends on anything other than the netclass
+ *                    or type of the items.
+ */
+TERM parseTerm( CONDITION_SCANNER& aScanner, bool& aClassLevel )
+{
+    bool     negate = aScanner.Match( wxT( "!" ) );
+    wxString var;
+    wxString field;
+
+    // "AB" and "L" references are left to the interpreter
+    if( !aScanner.Identifier( var ) || ( var != wxT( "A" ) && var != wxT( "B" ) ) )
+        return nullptr;
+
+    if( !aScanner.Match( wxT( "." ) ) || !aScanner.Identifier( field ) )
+        return nullptr;
+
+    int idx = ( var == wxT( "A" ) ) ? 0 : 1;
+
+    if( aScanner.Match( wxT( "(" ) ) )
+    {
+        wxString arg;
+        bool     hasArg = aScanner.StringLiteral( arg );
+
+        if( !aScanner.Match( wxT( ")" ) ) )
+            return nullptr;
+
+        TERM term = makeFunctionTerm( idx, field.Lower(), hasArg, arg );
+        aClassLevel = false;
+
+        if( term && negate )
+        {
+            return [term]( BOARD_ITEM* a, BOARD_ITEM* b, PCB_LAYER_ID aLayer )
+                   {
+                       return !term( a, b, aLayer );
+                   };
+        }
+
+        return term;
+    }
+
+    // '!' binds more tightly than '==' and '!=', so leave "!A.Type == 'x'" to the interpreter
+    if( negate )
+        return nullptr;
+
+    bool     equal;
+    wxString literal;
+
+    if( aScanner.Match( wxT( "==" ) ) )
+        equal = true;
+    else if( aScanner.Match( wxT( "!=" ) ) )
+        equal = false;
+    else
+        return nullptr;
+
+    if( !aScanner.StringLiteral( literal ) )
+        return nullptr;
+
+    if( field.CmpNoCase( wxT( "NetClass" ) ) != 0 && field.CmpNoCase( wxT( "Type" ) ) != 0 )
+        aClassLevel = false;
+
+    return makeComparisonTerm( idx, field, equal, literal );
+}
+
+} // anonymous namespace
+
+
 DRC_RULE_CONDITION::DRC_RULE_CONDITION( const wxString& aExpression ) :
     m_expression( aExpression ),
-    m_ucode ( nullptr )
+    m_ucode ( nullptr ),
+    m_classLevel( false )
 {
 }
 
@@ -54,6 +338,20 @@ bool DRC_RULE_CONDITION::EvaluateFor( const BOARD_ITEM* aItemA, const BOARD_ITEM
         return false;
     }
 
+    BOARD_ITEM* a = const_cast<BOARD_ITEM*>( aItemA );
+    BOARD_ITEM* b = const_cast<BOARD_ITEM*>( aItemB );
+
+    // The interpreter is still used when reporting so that any runtime errors are reported
+    if( m_predicate && !aReporter )
+    {
+        if( m_predicate( a, b, aLayer ) )
+            return true;
+        else if( aItemB )   // Conditions are commutative
+            return m_predicate( b, a, aLayer );
+
+        return false;
+    }
+
     PCBEXPR_CONTEXT ctx( aConstraint, aLayer );
 
     if( aReporter )
@@ -65,9 +363,6 @@ bool DRC_RULE_CONDITION::EvaluateFor( const BOARD_ITEM* aItemA, const BOARD_ITEM
                 } );
     }
 
-    BOARD_ITEM* a = const_cast<BOARD_ITEM*>( aItemA );
-    BOARD_ITEM* b = const_cast<BOARD_ITEM*>( aItemB );
-
     ctx.SetItems( a, b );
 
     if( m_ucode->Run( &ctx )->AsDouble() != 0.0 )
@@ -108,11 +403,89 @@ bool DRC_RULE_CONDITION::Compile( REPORTER* aReporter, int aSourceLine, int aSou
     }
 
     m_ucode = std::make_unique<PCBEXPR_UCODE>();
+    m_predicate = nullptr;
+    m_classLevel = false;
 
     PCBEXPR_CONTEXT preflightContext( 0, F_Cu );
 
     bool ok = compiler.Compile( GetExpression().ToUTF8().data(), m_ucode.get(), &preflightContext );
+
+    if( ok )
+        compileNativePredicate();
+
     return ok;
 }
 
 
+void DRC_RULE_CONDITION::compileNativePredicate()
+{
+    CONDITION_SCANNER scanner( m_expression );
+    std::vector<TERM> terms;
+    wxString          joiner;
+    bool              classLevel = true;
+
+    while( true )
+    {
+        TERM term = parseTerm( scanner, classLevel );
+
+        if( !term )
+            return;
+
+        terms.push_back( std::move( term ) );
+
+        if( scanner.AtEnd() )
+            break;
+
+        wxString op;
+
+        if( scanner.Match( wxT( "&&" ) ) )
+            op = wxT( "&&" );
+        else if( scanner.Match( wxT( "||" ) ) )
+            op = wxT( "||" );
+        else
+            return;
+
+        // Mixed operators would require honouring LIBEVAL's precedence; leave them to it
+        if( !joiner.IsEmpty() && op != joiner )
+            return;
+
+        joiner = op;
+    }
+
+    m_classLevel = classLevel;
+
+    if( terms.size() == 1 )
+    {
+        m_predicate = std::move( terms[0] );
+    }
+    else if( joiner == wxT( "&&" ) )
+    {
+        m_predicate =
+                [terms]( BOARD_ITEM* a, BOARD_ITEM* b, PCB_LAYER_ID aLayer )
+                {
+                    for( const TERM& term : terms )
+                    {
+                        if( !term( a, b, aLayer ) )
+                            return false;
+                    }
+
+                    return true;
+                };
+    }
+    else
+    {
+        m_predicate =
+                [terms]( BOARD_ITEM* a, BOARD_ITEM* b, PCB_LAYER_ID aLayer )
+                {
+                    for( const TERM& term : terms )
+                    {
+                        if( term( a, b, aLayer ) )
+                            return true;
+                    }
+
+                    return false;
+                };
+    }
+}
+
+
@@ -24,6 +24,9 @@
 #ifndef DRC_RULE_CONDITION_H
 #define DRC_RULE_CONDITION_H
 
+#include <functional>
+#include <memory>
+
 #include <core/typeinfo.h>
 #include <layer_ids.h>
 
@@ -46,9 +49,34 @@ public:
     void SetExpression( const wxString& aExpression ) { m_expression = aExpression; }
     wxString GetExpression() const { return m_expression; }
 
+    /**
+     * @return true if the expression was lowered to a native predicate (in which case the
+     *         LIBEVAL interpreter is only used when evaluating with a reporter).
+     */
+    bool HasNativePredicate() const { return !!m_predicate; }
+
+    /**
+     * @return true if the condition depends only on the netclasses and types of the items
+     *         (so that its result can be shared by all items with the same netclasses and types).
+     */
+    bool IsClassLevel() const { return m_classLevel; }
+
 private:
+    /**
+     * Recognize a handful of common condition shapes (netclass, netname and type comparisons,
+     * isPlated() and intersectsCourtyard() tests, and simple conjunctions or disjunctions of
+     * these) and lower them to a pre-bound C++ predicate.
+     */
+    void compileNativePredicate();
+
+private:
+    using PREDICATE = std::function<bool( BOARD_ITEM* aItemA, BOARD_ITEM* aItemB,
+                                          PCB_LAYER_ID aLayer )>;
+
     wxString                       m_expression;
     std::unique_ptr<PCBEXPR_UCODE> m_ucode;
+    PREDICATE                      m_predicate;
+    bool                           m_classLevel;
 };
 
 
@@ -38,6 +38,7 @@
 #include <drc/drc_engine.h>
 #include <drc/drc_rtree.h>
 #include <drc/drc_item.h>
+#include <drc/drc_result_cache.h>
 #include <drc/drc_rule.h>
 #include <drc/drc_test_provider_clearance_base.h>
 #include <pcb_dimension.h>
@@ -107,6 +108,13 @@ private:
 
     void testKnockoutTextAgainstZone( BOARD_ITEM* aText, NETINFO_ITEM** aInheritedNet, ZONE* aZone );
 
+    // Tests whose clean results are recorded in the DRC_RESULT_CACHE
+    enum CACHED_TEST
+    {
+        ITEM_TO_ITEM_TEST = 1,
+        ITEM_TO_ZONE_TEST
+    };
+
     typedef struct checked
     {
         checked()
@@ -211,6 +219,17 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testSingleLayerItemAgainstItem( BOARD_C
     bool           has_error = false;
     int            otherNet = 0;
 
+    DRC_RESULT_CACHE* resultCache = m_drcEngine->GetResultCache();
+    HASH_128          cacheKey;
+    bool              cacheable = resultCache && resultCache->GetKey( ITEM_TO_ITEM_TEST, item,
+                                                                      other, layer, cacheKey );
+
+    if( cacheable && resultCache->IsClean( cacheKey ) )
+        return true;
+
+    // A clean result is only worth recording if it was the result of a complete test
+    cacheable &= testClearance && testShorting && testHoles;
+
     if( BOARD_CONNECTED_ITEM* connectedItem = dynamic_cast<BOARD_CONNECTED_ITEM*>( other ) )
         otherNet = connectedItem->GetNetCode();
 
@@ -352,6 +371,9 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testSingleLayerItemAgainstItem( BOARD_C
         }
     }
 
+    if( cacheable && !has_error )
+        resultCache->MarkClean( cacheKey );
+
     return !has_error;
 }
 
@@ -424,6 +446,18 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testItemAgainstZone( BOARD_ITEM* aItem,
     if( !zoneTree )
         return;
 
+    DRC_RESULT_CACHE* resultCache = m_drcEngine->GetResultCache();
+    HASH_128          cacheKey;
+    bool              cacheable = resultCache && resultCache->GetKey( ITEM_TO_ZONE_TEST, aItem,
+                                                                      aZone, aLayer, cacheKey );
+    bool              has_error = false;
+
+    if( cacheable && resultCache->IsClean( cacheKey ) )
+        return;
+
+    // A clean result is only worth recording if it was the result of a complete test
+    cacheable &= testClearance && testHoles;
+
     DRC_CONSTRAINT constraint;
     int            clearance = -1;
     int            actual;
@@ -463,6 +497,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testItemAgainstZone( BOARD_ITEM* aItem,
             drce->SetViolatingRule( constraint.GetParentRule() );
 
             reportViolation( drce, pos, aLayer );
+            has_error = true;
         }
     }
 
@@ -502,10 +537,14 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testItemAgainstZone( BOARD_ITEM* aItem,
                     drce->SetViolatingRule( constraint.GetParentRule() );
 
                     reportViolation( drce, pos, aLayer );
+                    has_error = true;
                 }
             }
         }
     }
+
+    if( cacheable && !has_error )
+        resultCache->MarkClean( cacheKey );
 }
 
 
@@ -120,11 +120,9 @@ void DRC_TEST_PROVIDER_SOLDER_MASK::addItemToRTrees( BOARD_ITEM* aItem )
 
         for( PCB_LAYER_ID layer : { F_Mask, B_Mask } )
         {
+            // Merged with everything else once all the items are in
             if( zone->IsOnLayer( layer ) )
-            {
-                solderMask->GetFill( layer )->BooleanAdd( *zone->GetFilledPolysList( layer ),
-                                                          SHAPE_POLY_SET::PM_FAST );
-            }
+                solderMask->GetFill( layer )->Append( *zone->GetFilledPolysList( layer ) );
         }
     }
     else if( aItem->Type() == PCB_PAD_T )
@@ -222,8 +220,8 @@ void DRC_TEST_PROVIDER_SOLDER_MASK::buildRTrees()
                 return true;
             } );
 
-    solderMask->GetFill( F_Mask )->Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
-    solderMask->GetFill( B_Mask )->Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+    solderMask->GetFill( F_Mask )->SimplifyBatched( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+    solderMask->GetFill( B_Mask )->SimplifyBatched( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
 
     solderMask->GetFill( F_Mask )->Deflate( m_webWidth / 2, CORNER_STRATEGY::CHAMFER_ALL_CORNERS,
                                             m_maxError );
@@ -24,6 +24,7 @@
 #include <board.h>
 #include <board_design_settings.h>
 #include <connectivity/connectivity_data.h>
+#include <connectivity/zone_outline_index.h>
 #include <zone.h>
 #include <footprint.h>
 #include <pad.h>
@@ -94,6 +95,14 @@ void DRC_TEST_PROVIDER_ZONE_CONNECTIONS::testZoneLayer( ZONE* aZone, PCB_LAYER_I
             isolatedIslands = layerIter->second;
     }
 
+    // An outline can only cross a pad's thermal relief if their bounding boxes overlap, so look
+    // the outlines up in the index built by the connectivity pass (when it still matches the fill)
+    // rather than intersecting each one with every pad
+    const ZONE_OUTLINE_INDEX* outlineIndex = isolatedIslands.m_OutlineIndex.get();
+
+    if( outlineIndex && outlineIndex->OutlineCount() != zoneFill->OutlineCount() )
+        outlineIndex = nullptr;
+
     for( FOOTPRINT* footprint : board->Footprints() )
     {
         for( PAD* pad : footprint->Pads() )
@@ -149,27 +158,42 @@ void DRC_TEST_PROVIDER_ZONE_CONNECTIONS::testZoneLayer( ZONE* aZone, PCB_LAYER_I
             int               ignoredSpokes = 0;
             VECTOR2I          ignoredSpokePos;
 
-            for( int jj = 0; jj < zoneFill->OutlineCount(); ++jj )
-            {
-                std::vector<SHAPE_LINE_CHAIN::INTERSECTION> intersections;
-
-                zoneFill->Outline( jj ).Intersect( padOutline, intersections, true, &padBBox );
-
-                // If we connect to an island that only connects to a single item then we *are*
-                // that item.  Thermal spokes to this (otherwise isolated) island don't provide
-                // electrical connectivity to anything, so we don't count them.
-                if( intersections.size() >= 2 )
-                {
-                    if( alg::contains( isolatedIslands.m_SingleConnectionOutlines, jj ) )
+            auto countSpokes =
+                    [&]( int jj )
                     {
-                        ignoredSpokes += (int) intersections.size() / 2;
-                        ignoredSpokePos = ( intersections[0].p + intersections[1].p ) / 2;
-                    }
-                    else
-                    {
-                        spokes += (int) intersections.size() / 2;
-                    }
-                }
+                        std::vector<SHAPE_LINE_CHAIN::INTERSECTION> intersections;
+
+                        zoneFill->Outline( jj ).Intersect( padOutline, intersections, true,
+                                                           &padBBox );
+
+                        // If we connect to an island that only connects to a single item then
+                        // we *are* that item.  Thermal spokes to this (otherwise isolated) island
+                        // don't provide electrical connectivity to anything, so we don't count
+                        // them.
+                        if( intersections.size() >= 2 )
+                        {
+                            if( alg::contains( isolatedIslands.m_SingleConnectionOutlines, jj ) )
+                            {
+                                ignoredSpokes += (int) intersections.size() / 2;
+                                ignoredSpokePos = ( intersections[0].p + intersections[1].p ) / 2;
+                            }
+                            else
+                            {
+                                spokes += (int) intersections.size() / 2;
+                            }
+                        }
+                    };
+
+            if( outlineIndex )
+            {
+                // In outline order, as without the index (ignoredSpokePos is the last found)
+                for( int jj : outlineIndex->Query( padBBox ) )
+                    countSpokes( jj );
+            }
+            else
+            {
+                for( int jj = 0; jj < zoneFill->OutlineCount(); ++jj )
+                    countSpokes( jj );
             }
 
             if( spokes == 0 && ignoredSpokes == 0 )     // Not connected at all
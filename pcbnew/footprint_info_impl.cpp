@@ -248,22 +248,26 @@ void FOOTPRINT_LIST_IMPL::loadFootprints()
                 if( m_cancelled || !m_queue_out.pop( nickname ) )
                     return 0;
 
-                wxArrayString fpnames;
+                std::vector<FOOTPRINT_SUMMARY> summaries;
 
+                // Where the plugin supports it only the summaries are read; the footprints
+                // themselves are loaded when something (such as a preview) asks for them.
                 CatchErrors(
                         [&]()
                         {
-                            m_lib_table->FootprintEnumerate( fpnames, nickname, false );
+                            m_lib_table->FootprintEnumerateSummaries( summaries, nickname,
+                                                                      false );
                         } );
 
-                for( wxString fpname : fpnames )
+                for( const FOOTPRINT_SUMMARY& summary : summaries )
                 {
-                    CatchErrors(
-                            [&]()
-                            {
-                                auto* fpinfo = new FOOTPRINT_INFO_IMPL( this, nickname, fpname );
-                                queue_parsed.move_push( std::unique_ptr<FOOTPRINT_INFO>( fpinfo ) );
-                            } );
+                    auto* fpinfo = new FOOTPRINT_INFO_IMPL( nickname, summary.m_name,
+                                                            summary.m_description,
+                                                            summary.m_keywords, 0,
+                                                            summary.m_padCount,
+                                                            summary.m_uniquePadCount );
+
+                    queue_parsed.move_push( std::unique_ptr<FOOTPRINT_INFO>( fpinfo ) );
 
                     if( m_cancelled )
                         return 0;
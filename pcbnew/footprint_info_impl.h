@@ -48,7 +48,7 @@ public:
         load();
     }
 
-    // A constructor for cached items
+    // A constructor for cached or summarised items
     FOOTPRINT_INFO_IMPL( const wxString& aNickname, const wxString& aFootprintName,
                          const wxString& aDescription, const wxString& aKeywords,
                          int aOrderNum, unsigned int aPadCount, unsigned int aUniquePadCount )
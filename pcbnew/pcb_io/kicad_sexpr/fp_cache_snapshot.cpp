@@ -0,0 +1,307 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+#include <wx/filename.h>
+
+#include <kiplatform/io.h>
+#include <paths.h>
+#include <wx_filename.h>
+#include <pcb_io/kicad_sexpr/fp_cache_snapshot.h>
+
+
+static const char     FP_SNAPSHOT_MAGIC[16] = "KICAD_FP_SNAP";
+static const uint32_t FP_SNAPSHOT_VERSION = 1;
+
+// Offset of the library timestamp in the header (after the magic, version and path length)
+static const size_t   FP_SNAPSHOT_TIMESTAMP_OFFSET = sizeof( FP_SNAPSHOT_MAGIC )
+                                                     + sizeof( uint32_t ) + sizeof( uint32_t );
+
+
+wxString FP_CACHE_SNAPSHOT::GetSnapshotFilename( const wxString& aLibPath )
+{
+    wxFileName fn;
+
+    fn.AssignDir( PATHS::GetUserCachePath() );
+    fn.AppendDir( wxS( "footprint-libs" ) );
+
+    // The library path is also stored in the snapshot, so a hash collision can only cost
+    // a cache miss
+    size_t hash = std::hash<std::string>{}( aLibPath.utf8_string() );
+
+    fn.SetName( wxString::Format( wxS( "%016llx" ), (unsigned long long) hash ) );
+    fn.SetExt( wxS( "fpcache" ) );
+
+    return fn.GetFullPath();
+}
+
+
+FP_CACHE_SNAPSHOT::FP_CACHE_SNAPSHOT() :
+        m_mapping( nullptr ),
+        m_libTimestamp( 0 )
+{
+}
+
+
+FP_CACHE_SNAPSHOT::~FP_CACHE_SNAPSHOT()
+{
+    close();
+}
+
+
+void FP_CACHE_SNAPSHOT::close()
+{
+    m_entries.clear();
+    m_libTimestamp = 0;
+
+    if( m_mapping )
+        KIPLATFORM::IO::UnmapFile( m_mapping );
+
+    m_mapping = nullptr;
+}
+
+
+bool FP_CACHE_SNAPSHOT::Open( const wxString& aFilename, const wxString& aLibPath )
+{
+    close();
+
+    if( !wxFileName::FileExists( aFilename ) )
+        return false;
+
+    const char* data = nullptr;
+    size_t      size = 0;
+
+    m_mapping = KIPLATFORM::IO::MapFile( aFilename, data, size );
+
+    if( !m_mapping )
+        return false;
+
+    size_t pos = 0;
+
+    auto read =
+            [&]( void* aBuffer, size_t aSize )
+            {
+                if( size - pos < aSize )
+                    return false;
+
+                memcpy( aBuffer, data + pos, aSize );
+                pos += aSize;
+                return true;
+            };
+
+    auto readView =
+            [&]( std::string_view& aView, uint64_t aSize )
+            {
+                if( size - pos < aSize )
+                    return false;
+
+                aView = std::string_view( data + pos, aSize );
+                pos += aSize;
+                return true;
+            };
+
+    char             magic[16];
+    uint32_t         version = 0;
+    uint32_t         libPathLength = 0;
+    long long        libTimestamp = 0;
+    uint64_t         count = 0;
+    std::string_view libPath;
+
+    if( !read( magic, sizeof( magic ) )
+            || memcmp( magic, FP_SNAPSHOT_MAGIC, sizeof( magic ) ) != 0
+            || !read( &version, sizeof( version ) )
+            || version != FP_SNAPSHOT_VERSION
+            || !read( &libPathLength, sizeof( libPathLength ) )
+            || !read( &libTimestamp, sizeof( libTimestamp ) )
+            || !read( &count, sizeof( count ) )
+            || !readView( libPath, libPathLength )
+            || libPath != aLibPath.utf8_string() )
+    {
+        close();
+        return false;
+    }
+
+    // Each entry takes at least its fixed-size fields
+    if( count > size / ( sizeof( uint32_t ) + 3 * sizeof( uint64_t ) ) )
+    {
+        close();
+        return false;
+    }
+
+    m_entries.reserve( count );
+
+    for( uint64_t ii = 0; ii < count; ++ii )
+    {
+        ENTRY    entry;
+        uint32_t nameLength = 0;
+        uint64_t textLength = 0;
+
+        if( !read( &nameLength, sizeof( nameLength ) )
+                || !read( &entry.m_timestamp, sizeof( entry.m_timestamp ) )
+                || !read( &entry.m_size, sizeof( entry.m_size ) )
+                || !read( &textLength, sizeof( textLength ) )
+                || !readView( entry.m_name, nameLength )
+                || !readView( entry.m_text, textLength ) )
+        {
+            close();
+            return false;
+        }
+
+        m_entries.push_back( entry );
+    }
+
+    std::sort( m_entries.begin(), m_entries.end(),
+               []( const ENTRY& aLhs, const ENTRY& aRhs )
+               {
+                   return aLhs.m_name < aRhs.m_name;
+               } );
+
+    m_libTimestamp = libTimestamp;
+    return true;
+}
+
+
+const FP_CACHE_SNAPSHOT::ENTRY* FP_CACHE_SNAPSHOT::Find( std::string_view aName ) const
+{
+    auto it = std::lower_bound( m_entries.begin(), m_entries.end(), aName,
+                                []( const ENTRY& aEntry, std::string_view aKey )
+                                {
+                                    return aEntry.m_name < aKey;
+                                } );
+
+    if( it == m_entries.end() || it->m_name != aName )
+        return nullptr;
+
+    return &*it;
+}
+
+
+const FP_CACHE_SNAPSHOT::ENTRY* FP_CACHE_SNAPSHOT::FindCurrent( WX_FILENAME& aFile,
+                                                                long long aLibTimestamp ) const
+{
+    const ENTRY* entry = Find( aFile.GetFullName().utf8_string() );
+
+    if( !entry || aLibTimestamp == m_libTimestamp )
+        return entry;
+
+    // The library has changed since the snapshot; only use the entry if its own file hasn't
+    wxULongLong size = wxFileName::GetSize( aFile.GetFullPath() );
+
+    if( entry->m_timestamp != aFile.GetTimestamp() || entry->m_size != size.GetValue() )
+        return nullptr;
+
+    return entry;
+}
+
+
+FP_CACHE_SNAPSHOT::WRITER::WRITER( const wxString& aFilename, const wxString& aLibPath ) :
+        m_filename( aFilename ),
+        m_count( 0 ),
+        m_ok( false )
+{
+    wxFileName fn( aFilename );
+
+    if( !PATHS::EnsurePathExists( fn.GetPath() ) )
+        return;
+
+    m_tempFilename = wxFileName::CreateTempFileName( fn.GetPathWithSep() + fn.GetName() );
+
+    if( m_tempFilename.IsEmpty() || !m_file.Open( m_tempFilename, wxS( "wb" ) ) )
+        return;
+
+    std::string libPath = aLibPath.utf8_string();
+    uint32_t    libPathLength = libPath.length();
+    long long   libTimestamp = 0;       // filled in by Commit()
+    uint64_t    count = 0;              // ditto
+
+    m_ok = true;
+
+    write( FP_SNAPSHOT_MAGIC, sizeof( FP_SNAPSHOT_MAGIC ) );
+    write( &FP_SNAPSHOT_VERSION, sizeof( FP_SNAPSHOT_VERSION ) );
+    write( &libPathLength, sizeof( libPathLength ) );
+    write( &libTimestamp, sizeof( libTimestamp ) );
+    write( &count, sizeof( count ) );
+    write( libPath.data(), libPath.length() );
+}
+
+
+FP_CACHE_SNAPSHOT::WRITER::~WRITER()
+{
+    // Not committed: don't leave a partial snapshot lying around
+    if( m_file.IsOpened() )
+    {
+        m_file.Close();
+        wxRemoveFile( m_tempFilename );
+    }
+}
+
+
+bool FP_CACHE_SNAPSHOT::WRITER::write( const void* aBuffer, size_t aSize )
+{
+    m_ok = m_ok && m_file.Write( aBuffer, aSize ) == aSize;
+    return m_ok;
+}
+
+
+void FP_CACHE_SNAPSHOT::WRITER::Add( std::string_view aName, long long aTimestamp,
+                                     uint64_t aSize, std::string_view aText )
+{
+    uint32_t nameLength = aName.length();
+    uint64_t textLength = aText.length();
+
+    write( &nameLength, sizeof( nameLength ) );
+    write( &aTimestamp, sizeof( aTimestamp ) );
+    write( &aSize, sizeof( aSize ) );
+    write( &textLength, sizeof( textLength ) );
+    write( aName.data(), aName.length() );
+    write( aText.data(), aText.length() );
+
+    m_count++;
+}
+
+
+bool FP_CACHE_SNAPSHOT::WRITER::Commit( long long aLibTimestamp )
+{
+    if( !m_ok || !m_file.Seek( FP_SNAPSHOT_TIMESTAMP_OFFSET ) )
+        return false;
+
+    write( &aLibTimestamp, sizeof( aLibTimestamp ) );
+    write( &m_count, sizeof( m_count ) );
+
+    if( !m_file.Close() || !m_ok )
+    {
+        wxRemoveFile( m_tempFilename );
+        return false;
+    }
+
+    if( !wxRenameFile( m_tempFilename, m_filename, true ) )
+    {
+        wxRemoveFile( m_tempFilename );
+        return false;
+    }
+
+    return true;
+}
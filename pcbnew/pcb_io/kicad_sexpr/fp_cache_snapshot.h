@@ -0,0 +1,135 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef FP_CACHE_SNAPSHOT_H
+#define FP_CACHE_SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <wx/ffile.h>
+#include <wx/string.h>
+
+class WX_FILENAME;
+
+
+/**
+ * A single-file snapshot of the contents of a footprint library directory.
+ *
+ * Reading one file sequentially is far cheaper than opening every footprint file of a large
+ * library one at a time, particularly on network filesystems.  The snapshot is kept in the
+ * user cache directory (shared libraries are often read-only), and is memory-mapped when
+ * read so footprints are parsed straight out of the mapping.
+ *
+ * The snapshot records the library timestamp (see FP_CACHE::GetTimestamp()) it was taken at;
+ * if that still matches then every entry can be used as-is.  Otherwise each entry also
+ * records the modification time and size of its file so that only changed files need to be
+ * read again.
+ */
+class FP_CACHE_SNAPSHOT
+{
+public:
+    struct ENTRY
+    {
+        std::string_view m_name;        ///< UTF-8 file name (without path) of the footprint
+        long long        m_timestamp;   ///< modification time of the file
+        uint64_t         m_size;        ///< size of the file
+        std::string_view m_text;        ///< contents of the file
+    };
+
+    /**
+     * @return the name of the snapshot file for the library at \a aLibPath.
+     */
+    static wxString GetSnapshotFilename( const wxString& aLibPath );
+
+    FP_CACHE_SNAPSHOT();
+    ~FP_CACHE_SNAPSHOT();
+
+    /**
+     * Map a snapshot of the library at \a aLibPath.  A missing or malformed snapshot, or one
+     * taken of a different library, just leaves this empty.
+     *
+     * @return true if the snapshot was read.
+     */
+    bool Open( const wxString& aFilename, const wxString& aLibPath );
+
+    long long GetLibraryTimestamp() const { return m_libTimestamp; }
+
+    size_t GetCount() const { return m_entries.size(); }
+
+    /**
+     * @return the entry for the footprint file \a aName (UTF-8, without path), or nullptr.
+     */
+    const ENTRY* Find( std::string_view aName ) const;
+
+    /**
+     * @return the entry for the footprint file \a aFile if it is still up to date, or nullptr.
+     *         If the library hasn't changed since the snapshot (ie: \a aLibTimestamp matches)
+     *         the file itself isn't checked.
+     */
+    const ENTRY* FindCurrent( WX_FILENAME& aFile, long long aLibTimestamp ) const;
+
+    /**
+     * Streams a new snapshot out to a temporary file, which replaces any existing snapshot
+     * when committed.
+     */
+    class WRITER
+    {
+    public:
+        WRITER( const wxString& aFilename, const wxString& aLibPath );
+        ~WRITER();
+
+        bool IsOk() const { return m_ok; }
+
+        void Add( std::string_view aName, long long aTimestamp, uint64_t aSize,
+                  std::string_view aText );
+
+        /**
+         * Finish the snapshot and move it into place.
+         *
+         * @param aLibTimestamp is the library timestamp the entries were read at.
+         */
+        bool Commit( long long aLibTimestamp );
+
+    private:
+        bool write( const void* aBuffer, size_t aSize );
+
+        wxString m_filename;
+        wxString m_tempFilename;
+        wxFFile  m_file;
+        uint64_t m_count;
+        bool     m_ok;
+    };
+
+private:
+    void close();
+
+    void*              m_mapping;
+    long long          m_libTimestamp;
+    std::vector<ENTRY> m_entries;       ///< sorted by name
+};
+
+
+#endif // FP_CACHE_SNAPSHOT_H
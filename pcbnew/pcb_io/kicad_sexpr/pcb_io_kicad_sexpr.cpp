@@ -30,6 +30,7 @@
 #include <wx/log.h>
 #include <wx/msgdlg.h>
 #include <wx/mstream.h>
+#include <algorithm>
 
 #include <advanced_config.h>
 #include <board.h>
@@ -48,6 +49,7 @@
 #include <pcb_dimension.h>
 #include <pcb_generator.h>
 #include <pcb_group.h>
+#include <pcb_io/kicad_sexpr/fp_cache_snapshot.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_parser.h>
 #include <pcb_reference_image.h>
@@ -88,6 +90,7 @@ FP_CACHE::FP_CACHE( PCB_IO_KICAD_SEXPR* aOwner, const wxString& aLibraryPath )
     m_lib_path.SetPath( aLibraryPath );
     m_cache_timestamp = 0;
     m_cache_dirty = true;
+    m_complete = false;
 }
 
 
@@ -173,6 +176,7 @@ void FP_CACHE::Load()
 {
     m_cache_dirty = false;
     m_cache_timestamp = 0;
+    m_complete = true;
 
     wxDir dir( m_lib_raw_path );
 
@@ -190,6 +194,27 @@ void FP_CACHE::Load()
     // the filename thereafter.
     WX_FILENAME fn( m_lib_raw_path, wxT( "dummyName" ) );
 
+    std::unique_ptr<FP_CACHE_SNAPSHOT>         snapshot;
+    std::unique_ptr<FP_CACHE_SNAPSHOT::WRITER> snapshotWriter;
+    long long                                  libTimestamp = 0;
+    bool                                       snapshotCurrent = false;
+
+    if( ADVANCED_CFG::GetCfg().m_FootprintLibrarySnapshot )
+    {
+        wxString snapshotFile = FP_CACHE_SNAPSHOT::GetSnapshotFilename( m_lib_raw_path );
+
+        libTimestamp = GetTimestamp( m_lib_raw_path );
+        snapshot = std::make_unique<FP_CACHE_SNAPSHOT>();
+
+        if( snapshot->Open( snapshotFile, m_lib_raw_path ) )
+            snapshotCurrent = snapshot->GetLibraryTimestamp() == libTimestamp;
+
+        // Anything out of date gets a new snapshot, written as the footprints are read
+        if( !snapshotCurrent )
+            snapshotWriter = std::make_unique<FP_CACHE_SNAPSHOT::WRITER>( snapshotFile,
+                                                                          m_lib_raw_path );
+    }
+
     if( dir.GetFirst( &fullName, fileSpec ) )
     {
         wxString cacheError;
@@ -198,11 +223,34 @@ void FP_CACHE::Load()
         {
             fn.SetFullName( fullName );
 
+            const FP_CACHE_SNAPSHOT::ENTRY* entry = nullptr;
+
+            if( snapshot )
+                entry = snapshot->FindCurrent( fn, libTimestamp );
+
             // Queue I/O errors so only files that fail to parse don't get loaded.
             try
             {
-                FILE_LINE_READER reader( fn.GetFullPath() );
-                PCB_IO_KICAD_SEXPR_PARSER       parser( &reader, nullptr, nullptr );
+                std::unique_ptr<STRING_VIEW_LINE_READER> reader;
+                long long                                fileTimestamp = 0;
+
+                if( entry )
+                {
+                    reader = std::make_unique<STRING_VIEW_LINE_READER>( entry->m_text,
+                                                                        fn.GetFullPath() );
+                    fileTimestamp = entry->m_timestamp;
+                }
+                else
+                {
+                    // Timestamp before reading so that a change made while reading will
+                    // be seen next time
+                    if( snapshotWriter )
+                        fileTimestamp = fn.GetTimestamp();
+
+                    reader = std::make_unique<MAPPED_FILE_LINE_READER>( fn.GetFullPath() );
+                }
+
+                PCB_IO_KICAD_SEXPR_PARSER parser( reader.get(), nullptr, nullptr );
 
                 FOOTPRINT* footprint = dynamic_cast<FOOTPRINT*>( parser.Parse() );
                 wxString fpName = fn.GetName();
@@ -212,6 +260,13 @@ void FP_CACHE::Load()
 
                 footprint->SetFPID( LIB_ID( wxEmptyString, fpName ) );
                 m_footprints.insert( fpName, new FP_CACHE_ITEM( footprint, fn ) );
+
+                if( snapshotWriter )
+                {
+                    std::string_view text( reader->Data(), reader->Size() );
+                    snapshotWriter->Add( fullName.utf8_string(), fileTimestamp, text.size(),
+                                         text );
+                }
             }
             catch( const IO_ERROR& ioe )
             {
@@ -224,7 +279,24 @@ void FP_CACHE::Load()
             }
         } while( dir.GetNext( &fullName ) );
 
-        m_cache_timestamp = GetTimestamp( m_lib_raw_path );
+        // Re-timestamping a large library is slow over a network, and the snapshot needed a
+        // timestamp taken before anything was read anyway
+        if( snapshot )
+            m_cache_timestamp = libTimestamp;
+        else
+            m_cache_timestamp = GetTimestamp( m_lib_raw_path );
+
+        if( snapshotWriter )
+        {
+            // Release the old snapshot first; it can't be replaced while mapped on Windows
+            snapshot.reset();
+
+            if( !snapshotWriter->Commit( libTimestamp ) )
+            {
+                wxLogTrace( traceKicadPcbPlugin, wxT( "Unable to save snapshot of '%s'." ),
+                            m_lib_raw_path );
+            }
+        }
 
         if( !cacheError.IsEmpty() )
             THROW_IO_ERROR( cacheError );
@@ -232,6 +304,34 @@ void FP_CACHE::Load()
 }
 
 
+const FOOTPRINT* FP_CACHE::LoadFootprint( const wxString& aFootprintName )
+{
+    FP_CACHE_FOOTPRINT_MAP::const_iterator it = m_footprints.find( aFootprintName );
+
+    if( it != m_footprints.end() )
+        return it->second->GetFootprint();
+
+    WX_FILENAME fn( m_lib_raw_path, aFootprintName + wxT( "." )
+                                    + FILEEXT::KiCadFootprintFileExtension );
+
+    if( !wxFileName::FileExists( fn.GetFullPath() ) )
+        return nullptr;
+
+    MAPPED_FILE_LINE_READER   reader( fn.GetFullPath() );
+    PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, nullptr );
+
+    FOOTPRINT* footprint = dynamic_cast<FOOTPRINT*>( parser.Parse() );
+
+    if( !footprint )
+        return nullptr;
+
+    footprint->SetFPID( LIB_ID( wxEmptyString, aFootprintName ) );
+    m_footprints.insert( aFootprintName, new FP_CACHE_ITEM( footprint, fn ) );
+
+    return footprint;
+}
+
+
 void FP_CACHE::Remove( const wxString& aFootprintName )
 {
     FP_CACHE_FOOTPRINT_MAP::const_iterator it = m_footprints.find( aFootprintName );
@@ -2652,11 +2752,18 @@ PCB_IO_KICAD_SEXPR::~PCB_IO_KICAD_SEXPR()
 BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendToMe,
                               const STRING_UTF8_MAP* aProperties, PROJECT* aProject )
 {
-    FILE_LINE_READER reader( aFileName );
+    fontconfig::FONTCONFIG::SetReporter( &WXLOG_REPORTER::GetInstance() );
 
-    unsigned lineCount = 0;
+    MAPPED_FILE_LINE_READER reader( aFileName );
 
-    fontconfig::FONTCONFIG::SetReporter( &WXLOG_REPORTER::GetInstance() );
+    // Appending resets the UUIDs of the new items, which the workers can't share
+    if( !aAppendToMe && ADVANCED_CFG::GetCfg().m_ParallelBoardLoad )
+    {
+        if( BOARD* board = loadBoardParallel( reader, aProperties ) )
+            return board;
+    }
+
+    unsigned lineCount = 0;
 
     if( m_progressReporter )
     {
@@ -2665,10 +2772,7 @@ BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendT
         if( !m_progressReporter->KeepRefreshing() )
             THROW_IO_ERROR( _( "Open cancelled by user." ) );
 
-        while( reader.ReadLine() )
-            lineCount++;
-
-        reader.Rewind();
+        lineCount = std::count( reader.Data(), reader.Data() + reader.Size(), '\n' );
     }
 
     BOARD* board = DoLoad( reader, aAppendToMe, aProperties, m_progressReporter, lineCount );
@@ -2681,14 +2785,47 @@ BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendT
 }
 
 
+BOARD* PCB_IO_KICAD_SEXPR::loadBoardParallel( const MAPPED_FILE_LINE_READER& aFile,
+                                              const STRING_UTF8_MAP* aProperties )
+{
+    PCB_BULK_ITEMS bulkItems;
+
+    if( !bulkItems.Split( std::string_view( aFile.Data(), aFile.Size() ) ) )
+        return nullptr;
+
+    unsigned lineCount = 0;
+
+    if( m_progressReporter )
+    {
+        m_progressReporter->Report( wxString::Format( _( "Loading %s..." ), aFile.GetSource() ) );
+
+        if( !m_progressReporter->KeepRefreshing() )
+            THROW_IO_ERROR( _( "Open cancelled by user." ) );
+
+        lineCount = std::count( aFile.Data(), aFile.Data() + aFile.Size(), '\n' );
+    }
+
+    STRING_LINE_READER reader( bulkItems.m_skeleton, aFile.GetSource() );
+
+    BOARD* board = DoLoad( reader, nullptr, aProperties, m_progressReporter, lineCount,
+                           &bulkItems );
+
+    board->SetFileName( aFile.GetSource() );
+    return board;
+}
+
+
 BOARD* PCB_IO_KICAD_SEXPR::DoLoad( LINE_READER& aReader, BOARD* aAppendToMe, const STRING_UTF8_MAP* aProperties,
-                           PROGRESS_REPORTER* aProgressReporter, unsigned aLineCount)
+                           PROGRESS_REPORTER* aProgressReporter, unsigned aLineCount,
+                           const PCB_BULK_ITEMS* aBulkItems )
 {
     init( aProperties );
 
     PCB_IO_KICAD_SEXPR_PARSER parser( &aReader, aAppendToMe, m_queryUserCallback, aProgressReporter, aLineCount );
     BOARD*     board;
 
+    parser.SetBulkItems( aBulkItems );
+
     try
     {
         board = dynamic_cast<BOARD*>( parser.Parse() );
@@ -2729,7 +2866,8 @@ void PCB_IO_KICAD_SEXPR::validateCache( const wxString& aLibraryPath, bool check
 {
     fontconfig::FONTCONFIG::SetReporter( nullptr );
 
-    if( !m_cache || !m_cache->IsPath( aLibraryPath ) || ( checkModified && m_cache->IsModified() ) )
+    if( !m_cache || !m_cache->IsPath( aLibraryPath ) || !m_cache->IsComplete()
+            || ( checkModified && m_cache->IsModified() ) )
     {
         // a spectacular episode in memory management:
         delete m_cache;
@@ -2768,6 +2906,102 @@ void PCB_IO_KICAD_SEXPR::FootprintEnumerate( wxArrayString& aFootprintNames, con
 }
 
 
+void PCB_IO_KICAD_SEXPR::FootprintEnumerateSummaries( std::vector<FOOTPRINT_SUMMARY>& aSummaries,
+                                                      const wxString& aLibPath,
+                                                      bool aBestEfforts,
+                                                      const STRING_UTF8_MAP* aProperties )
+{
+    LOCALE_IO toggle;     // toggles on, then off, the C locale.
+
+    init( aProperties );
+
+    // Nothing to be gained from re-reading a library which is already loaded
+    if( m_cache && m_cache->IsPath( aLibPath ) && m_cache->IsComplete()
+            && !m_cache->IsModified() )
+    {
+        PCB_IO::FootprintEnumerateSummaries( aSummaries, aLibPath, aBestEfforts, aProperties );
+        return;
+    }
+
+    wxDir dir( aLibPath );
+
+    if( !dir.IsOpened() )
+    {
+        if( aBestEfforts )
+            return;
+
+        THROW_IO_ERROR( wxString::Format( _( "Footprint library '%s' not found." ), aLibPath ) );
+    }
+
+    wxString    fullName;
+    wxString    fileSpec = wxT( "*." ) + wxString( FILEEXT::KiCadFootprintFileExtension );
+    WX_FILENAME fn( aLibPath, wxT( "dummyName" ) );
+    wxString    errorMsg;
+
+    std::unique_ptr<FP_CACHE_SNAPSHOT> snapshot;
+    long long                          libTimestamp = 0;
+
+    if( ADVANCED_CFG::GetCfg().m_FootprintLibrarySnapshot )
+    {
+        libTimestamp = FP_CACHE::GetTimestamp( aLibPath );
+        snapshot = std::make_unique<FP_CACHE_SNAPSHOT>();
+
+        if( !snapshot->Open( FP_CACHE_SNAPSHOT::GetSnapshotFilename( aLibPath ), aLibPath ) )
+            snapshot.reset();
+    }
+
+    if( dir.GetFirst( &fullName, fileSpec ) )
+    {
+        do
+        {
+            fn.SetFullName( fullName );
+
+            const FP_CACHE_SNAPSHOT::ENTRY* entry = nullptr;
+
+            if( snapshot )
+                entry = snapshot->FindCurrent( fn, libTimestamp );
+
+            try
+            {
+                std::unique_ptr<STRING_VIEW_LINE_READER> reader;
+
+                if( entry )
+                {
+                    reader = std::make_unique<STRING_VIEW_LINE_READER>( entry->m_text,
+                                                                        fn.GetFullPath() );
+                }
+                else
+                {
+                    reader = std::make_unique<MAPPED_FILE_LINE_READER>( fn.GetFullPath() );
+                }
+
+                PCB_IO_KICAD_SEXPR_PARSER parser( reader.get(), nullptr, nullptr );
+                FOOTPRINT_SUMMARY         summary;
+
+                if( !parser.ParseFootprintSummary( summary ) )
+                    THROW_IO_ERROR( wxEmptyString );   // caught locally, just below...
+
+                // As in FP_CACHE::Load(), the file name is the footprint name
+                summary.m_name = fn.GetName();
+                aSummaries.push_back( std::move( summary ) );
+            }
+            catch( const IO_ERROR& ioe )
+            {
+                if( !errorMsg.IsEmpty() )
+                    errorMsg += wxT( "\n\n" );
+
+                errorMsg += wxString::Format( _( "Unable to read file '%s'" ) + '\n',
+                                              fn.GetFullPath() );
+                errorMsg += ioe.What();
+            }
+        } while( dir.GetNext( &fullName ) );
+    }
+
+    if( !errorMsg.IsEmpty() && !aBestEfforts )
+        THROW_IO_ERROR( errorMsg );
+}
+
+
 const FOOTPRINT* PCB_IO_KICAD_SEXPR::getFootprint( const wxString& aLibraryPath,
                                            const wxString& aFootprintName,
                                            const STRING_UTF8_MAP* aProperties,
@@ -2777,6 +3011,29 @@ const FOOTPRINT* PCB_IO_KICAD_SEXPR::getFootprint( const wxString& aLibraryPath,
 
     init( aProperties );
 
+    // Previews of enumerated footprints only need the one footprint, which doesn't warrant
+    // reading the whole library when it hasn't been already.
+    if( !checkModified && ( !m_cache || !m_cache->IsPath( aLibraryPath )
+                                     || !m_cache->IsComplete() ) )
+    {
+        fontconfig::FONTCONFIG::SetReporter( nullptr );
+
+        if( !m_cache || !m_cache->IsPath( aLibraryPath ) )
+        {
+            delete m_cache;
+            m_cache = new FP_CACHE( this, aLibraryPath );
+        }
+
+        try
+        {
+            return m_cache->LoadFootprint( aFootprintName );
+        }
+        catch( const IO_ERROR& )
+        {
+            return nullptr;
+        }
+    }
+
     try
     {
         validateCache( aLibraryPath, checkModified );
@@ -42,6 +42,7 @@ class BOARD_ITEM;
 class FP_CACHE;
 class LSET;
 class PCB_IO_KICAD_SEXPR_PARSER;
+struct PCB_BULK_ITEMS;
 class NETINFO_MAPPING;
 class BOARD_DESIGN_SETTINGS;
 class PCB_DIMENSION_BASE;
@@ -216,6 +217,8 @@ class FP_CACHE
                                  // m_cache_timestamp against all the files.
     long long m_cache_timestamp; // A hash of the timestamps for all the footprint
                                  // files.
+    bool m_complete;             // False until Load(); before then only footprints loaded
+                                 // one at a time by LoadFootprint() are present.
 
 public:
     FP_CACHE( PCB_IO_KICAD_SEXPR* aOwner, const wxString& aLibraryPath );
@@ -241,6 +244,19 @@ public:
 
     void Load();
 
+    /**
+     * Load a single footprint without reading the rest of the library.
+     *
+     * @return the footprint, or nullptr if the library has no footprint \a aFootprintName.
+     */
+    const FOOTPRINT* LoadFootprint( const wxString& aFootprintName );
+
+    /**
+     * @return true if the whole library has been loaded, rather than just the footprints
+     *         loaded by LoadFootprint().
+     */
+    bool IsComplete() const { return m_complete; }
+
     void Remove( const wxString& aFootprintName );
 
     /**
@@ -313,12 +329,20 @@ public:
     BOARD* LoadBoard( const wxString& aFileName, BOARD* aAppendToMe,
                       const STRING_UTF8_MAP* aProperties = nullptr, PROJECT* aProject = nullptr ) override;
 
+    /**
+     * @param aBulkItems optional; if given, \a aReader must be reading its skeleton.
+     */
     BOARD* DoLoad( LINE_READER& aReader, BOARD* aAppendToMe, const STRING_UTF8_MAP* aProperties,
-                     PROGRESS_REPORTER* aProgressReporter, unsigned aLineCount );
+                     PROGRESS_REPORTER* aProgressReporter, unsigned aLineCount,
+                     const PCB_BULK_ITEMS* aBulkItems = nullptr );
 
     void FootprintEnumerate( wxArrayString& aFootprintNames, const wxString& aLibraryPath,
                              bool aBestEfforts, const STRING_UTF8_MAP* aProperties = nullptr ) override;
 
+    void FootprintEnumerateSummaries( std::vector<FOOTPRINT_SUMMARY>& aSummaries,
+                                      const wxString& aLibraryPath, bool aBestEfforts,
+                                      const STRING_UTF8_MAP* aProperties = nullptr ) override;
+
     const FOOTPRINT* GetEnumeratedFootprint( const wxString& aLibraryPath,
                                              const wxString& aFootprintName,
                                              const STRING_UTF8_MAP* aProperties = nullptr ) override;
@@ -384,6 +408,14 @@ protected:
 
     void init( const STRING_UTF8_MAP* aProperties );
 
+    /**
+     * Load a board with its footprints, tracks, vias and zones parsed on worker threads.
+     *
+     * @return nullptr if the file can't be split up for parallel parsing.
+     */
+    BOARD* loadBoardParallel( const MAPPED_FILE_LINE_READER& aFile,
+                              const STRING_UTF8_MAP* aProperties );
+
     /// formats the board setup information
     void formatSetup( const BOARD* aBoard, int aNestLevel = 0 ) const;
 
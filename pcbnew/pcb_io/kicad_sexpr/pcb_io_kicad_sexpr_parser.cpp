@@ -69,6 +69,10 @@
 #include <progress_reporter.h>
 #include <board_stackup_manager/stackup_predefined_prms.h>
 #include <pgm_base.h>
+#include <core/thread_pool.h>
+
+#include <set>
+#include <string_view>
 
 // For some reason wxWidgets is built with wxUSE_BASE64 unset so expose the wxWidgets
 // base64 code. Needed for PCB_REFERENCE_IMAGE
@@ -89,6 +93,161 @@ constexpr double INT_LIMIT = std::numeric_limits<int>::max() - 10;
 using namespace PCB_KEYS_T;
 
 
+/**
+ * Top-level board items which make up the header: these must all be parsed before any of the
+ * bulk items can be.
+ */
+static const std::set<std::string_view> boardHeaderKeywords =
+{
+    "version", "host", "generator", "generator_version", "general", "paper", "page",
+    "title_block", "layers", "setup", "property", "net", "net_class"
+};
+
+
+/**
+ * Top-level board items which are split out of a board's text to be parsed in parallel.
+ */
+static const std::set<std::string_view> boardBulkKeywords =
+{
+    "footprint", "module", "segment", "arc", "via", "zone"
+};
+
+
+bool PCB_BULK_ITEMS::Split( std::string_view aText )
+{
+    m_text = aText;
+    m_skeleton.clear();
+    m_ranges.clear();
+
+    const char* text = aText.data();
+    size_t      length = aText.length();
+    unsigned    line = 1;
+    int         depth = 0;
+    size_t      copied = 0;        // the text before this has been copied to the skeleton
+    bool        pastHeader = false;
+
+    auto keywordAt =
+            [&]( size_t aPos ) -> std::string_view
+            {
+                size_t end = aPos;
+
+                while( end < length && ( isalnum( (unsigned char) text[end] ) || text[end] == '_' ) )
+                    ++end;
+
+                return std::string_view( text + aPos, end - aPos );
+            };
+
+    // Advance aPos past a quoted string starting at aPos
+    auto skipString =
+            [&]( size_t& aPos )
+            {
+                for( ++aPos; aPos < length && text[aPos] != '"'; ++aPos )
+                {
+                    if( text[aPos] == '\\' && aPos + 1 < length )
+                        ++aPos;
+
+                    if( text[aPos] == '\n' )
+                        ++line;
+                }
+            };
+
+    // Advance aPos to the parenthesis closing the list starting at aPos
+    auto skipList =
+            [&]( size_t& aPos ) -> bool
+            {
+                int listDepth = 0;
+
+                for( ; aPos < length; ++aPos )
+                {
+                    switch( text[aPos] )
+                    {
+                    case '\n': ++line;                    break;
+                    case '"':  skipString( aPos );        break;
+                    case '(':  ++listDepth;               break;
+                    case ')':
+                        if( --listDepth == 0 )
+                            return true;
+
+                        break;
+                    }
+                }
+
+                return false;
+            };
+
+    for( size_t pos = 0; pos < length; ++pos )
+    {
+        switch( text[pos] )
+        {
+        case '\n':
+            ++line;
+            break;
+
+        case '"':
+            skipString( pos );
+            break;
+
+        case ')':
+            if( --depth < 0 )
+                return false;
+
+            break;
+
+        case '(':
+        {
+            std::string_view keyword = keywordAt( pos + 1 );
+
+            if( depth == 0 && keyword != "kicad_pcb" )
+                return false;
+
+            if( depth == 1 && boardBulkKeywords.count( keyword ) )
+            {
+                size_t   start = pos;
+                unsigned startLine = line;
+
+                if( !skipList( pos ) )
+                    return false;
+
+                m_skeleton.append( text + copied, start - copied );
+                m_skeleton.append( line - startLine, '\n' );
+                m_ranges.push_back( { start, pos + 1 - start, startLine } );
+                copied = pos + 1;
+                pastHeader = true;
+                break;
+            }
+
+            if( depth == 1 )
+            {
+                if( !boardHeaderKeywords.count( keyword ) )
+                    pastHeader = true;
+                else if( pastHeader )
+                    return false;
+            }
+
+            ++depth;
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    if( depth != 0 || m_ranges.empty() )
+        return false;
+
+    m_skeleton.append( text + copied, length - copied );
+    return true;
+}
+
+
+PCB_IO_KICAD_SEXPR_PARSER::~PCB_IO_KICAD_SEXPR_PARSER()
+{
+    // The workers refer to our board and to the board text; don't leave them running
+    abandonBulkItems();
+}
+
+
 void PCB_IO_KICAD_SEXPR_PARSER::init()
 {
     m_showLegacySegmentZoneWarning = true;
@@ -805,7 +964,9 @@ FP_3DMODEL* PCB_IO_KICAD_SEXPR_PARSER::parse3DModel()
 
 bool PCB_IO_KICAD_SEXPR_PARSER::IsValidBoardHeader()
 {
+#ifdef DSNLEXER_PARSE_DOUBLE_USES_LOCALE
     LOCALE_IO       toggle;
+#endif
 
     m_groupInfos.clear();
 
@@ -823,11 +984,100 @@ bool PCB_IO_KICAD_SEXPR_PARSER::IsValidBoardHeader()
 }
 
 
+bool PCB_IO_KICAD_SEXPR_PARSER::ParseFootprintSummary( FOOTPRINT_SUMMARY& aSummary )
+{
+#ifdef DSNLEXER_PARSE_DOUBLE_USES_LOCALE
+    LOCALE_IO       toggle;
+#endif
+
+    // See Parse() - FOOTPRINTS can be prefixed with an initial block of single line comments
+    ReadCommentLines();
+
+    if( CurTok() != T_LEFT )
+        return false;
+
+    T token = NextTok();
+
+    if( token != T_footprint && token != T_module )
+        return false;
+
+    NeedSYMBOLorNUMBER();
+    aSummary.m_name = FromUTF8();
+
+    std::set<wxString> padNumbers;
+
+    for( token = NextTok(); token != T_RIGHT && token != T_EOF; token = NextTok() )
+    {
+        // Skip flags such as "locked" and "placed"
+        if( token != T_LEFT )
+            continue;
+
+        switch( NextTok() )
+        {
+        case T_descr:
+            NeedSYMBOLorNUMBER();
+            aSummary.m_description = FromUTF8();
+            NeedRIGHT();
+            break;
+
+        case T_tags:
+            NeedSYMBOLorNUMBER();
+            aSummary.m_keywords = FromUTF8();
+            NeedRIGHT();
+            break;
+
+        case T_pad:
+        {
+            // Counted the same way as FOOTPRINT::GetPadCount() and GetUniquePadCount(),
+            // excluding NPTH pads
+            NeedSYMBOLorNUMBER();
+            wxString number = FromUTF8();
+            bool     npth = NextTok() == T_np_thru_hole;
+            bool     copper = true;     // a new PAD is on the copper layers until told not to be
+
+            for( token = NextTok(); token != T_RIGHT && token != T_EOF; token = NextTok() )
+            {
+                if( token != T_LEFT )
+                    continue;
+
+                if( NextTok() == T_layers )
+                    copper = ( parseBoardItemLayersAsMask() & LSET::AllCuMask() ).any();
+                else
+                    skipCurrent();
+            }
+
+            if( !npth )
+            {
+                aSummary.m_padCount++;
+
+                if( copper && !number.IsEmpty() )
+                    padNumbers.insert( number );
+            }
+
+            break;
+        }
+
+        default:
+            skipCurrent();
+            break;
+        }
+    }
+
+    aSummary.m_uniquePadCount = padNumbers.size();
+    return true;
+}
+
+
 BOARD_ITEM* PCB_IO_KICAD_SEXPR_PARSER::Parse()
 {
     T               token;
     BOARD_ITEM*     item;
+
+    // Numbers are parsed with std::from_chars() (which ignores the locale) unless the
+    // compiler doesn't support it for floating point
+#ifdef DSNLEXER_PARSE_DOUBLE_USES_LOCALE
     LOCALE_IO       toggle;
+#endif
 
     m_groupInfos.clear();
 
@@ -917,6 +1167,30 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
                 }
             };
 
+    auto isHeaderToken =
+            []( T aToken )
+            {
+                switch( aToken )
+                {
+                case T_host:
+                case T_generator:
+                case T_generator_version:
+                case T_general:
+                case T_paper:
+                case T_page:
+                case T_title_block:
+                case T_layers:
+                case T_setup:
+                case T_property:
+                case T_net:
+                case T_net_class:
+                    return true;
+
+                default:
+                    return false;
+                }
+            };
+
     std::vector<BOARD_ITEM*> bulkAddedItems;
     BOARD_ITEM* item = nullptr;
 
@@ -929,6 +1203,10 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
 
         token = NextTok();
 
+        // Once past the header the bulk items can be parsed alongside the rest of the board
+        if( m_bulkItems && m_bulkJobs.empty() && !isHeaderToken( token ) )
+            startBulkItems();
+
         if( token == T_page && m_requiredVersion <= 20200119 )
             token = T_paper;
 
@@ -1118,6 +1396,14 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
         }
     }
 
+    if( m_bulkItems )
+    {
+        if( m_bulkJobs.empty() )
+            startBulkItems();
+
+        finishBulkItems( bulkAddedItems );
+    }
+
     if( bulkAddedItems.size() > 0 )
         m_board->FinalizeBulkAdd( bulkAddedItems );
 
@@ -1229,6 +1515,190 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
 }
 
 
+void PCB_IO_KICAD_SEXPR_PARSER::startBulkItems()
+{
+    thread_pool&   tp = GetKiCadThreadPool();
+    const wxString source = CurSource();
+
+    // Split the items into contiguous batches of roughly equal size.  There are several
+    // batches per thread so that a few large footprints or zones don't hold up the rest.
+    size_t totalLength = 0;
+
+    for( const PCB_BULK_ITEMS::RANGE& range : m_bulkItems->m_ranges )
+        totalLength += range.m_length;
+
+    size_t batchCount = std::max<size_t>( 1, tp.get_thread_count() * 4 );
+    size_t batchLength = std::max<size_t>( 1, totalLength / batchCount );
+    size_t first = 0;
+
+    while( first < m_bulkItems->m_ranges.size() )
+    {
+        size_t last = first;
+        size_t length = 0;
+
+        while( last < m_bulkItems->m_ranges.size() && length < batchLength )
+            length += m_bulkItems->m_ranges[last++].m_length;
+
+        // The workers get a copy of everything they need from the header, as the rest of the
+        // board continues to be parsed here in the meantime.
+        auto worker = std::make_unique<PCB_IO_KICAD_SEXPR_PARSER>( nullptr, m_board, nullptr );
+
+        worker->m_appendToExisting = m_appendToExisting;
+        worker->m_layerIndices = m_layerIndices;
+        worker->m_layerMasks = m_layerMasks;
+        worker->m_netCodes = m_netCodes;
+        worker->m_tooRecent = m_tooRecent;
+        worker->m_requiredVersion = m_requiredVersion;
+        worker->m_generatorVersion = m_generatorVersion;
+        worker->m_bulkWorker = true;
+
+        auto parseBatch =
+                [this, worker = worker.get(), first, last, source]()
+                {
+                    // N.B. where a LOCALE_IO is needed at all, the one held by Parse()
+                    // covers the workers too
+                    try
+                    {
+                        for( size_t ii = first; ii < last && !m_bulkCancelled; ++ii )
+                        {
+                            const PCB_BULK_ITEMS::RANGE& range = m_bulkItems->m_ranges[ii];
+
+                            // Number the lines as they are in the file
+                            STRING_VIEW_LINE_READER reader( m_bulkItems->m_text.substr(
+                                                                    range.m_offset,
+                                                                    range.m_length ),
+                                                            source, range.m_line - 1 );
+
+                            worker->PushReader( &reader );
+                            worker->m_bulkParsedItems.push_back( worker->parseBulkItem() );
+                            worker->PopReader();
+                        }
+                    }
+                    catch( ... )
+                    {
+                        for( BOARD_ITEM* parsedItem : worker->m_bulkParsedItems )
+                            delete parsedItem;
+
+                        worker->m_bulkParsedItems.clear();
+                        throw;
+                    }
+                };
+
+        m_bulkWorkers.push_back( std::move( worker ) );
+        m_bulkJobs.push_back( tp.submit( parseBatch ) );
+        first = last;
+    }
+}
+
+
+void PCB_IO_KICAD_SEXPR_PARSER::finishBulkItems( std::vector<BOARD_ITEM*>& aBulkAddedItems )
+{
+    std::exception_ptr error;
+
+    for( std::future<void>& job : m_bulkJobs )
+    {
+        while( job.wait_for( std::chrono::milliseconds( 100 ) ) != std::future_status::ready )
+        {
+            if( m_progressReporter && !m_progressReporter->KeepRefreshing() )
+            {
+                abandonBulkItems();
+                THROW_IO_ERROR( _( "Open cancelled by user." ) );
+            }
+        }
+
+        try
+        {
+            job.get();
+        }
+        catch( ... )
+        {
+            if( !error )
+                error = std::current_exception();
+        }
+    }
+
+    if( error )
+    {
+        abandonBulkItems();
+        std::rethrow_exception( error );
+    }
+
+    for( const std::unique_ptr<PCB_IO_KICAD_SEXPR_PARSER>& worker : m_bulkWorkers )
+    {
+        for( BOARD_ITEM* parsedItem : worker->m_bulkParsedItems )
+        {
+            m_board->Add( parsedItem, ADD_MODE::BULK_APPEND, true );
+            aBulkAddedItems.push_back( parsedItem );
+
+            if( parsedItem->Type() == PCB_ZONE_T && m_requiredVersion < 20230517
+                    && static_cast<ZONE*>( parsedItem )->IsTeardropArea() )
+            {
+                m_board->SetLegacyTeardrops( true );
+            }
+        }
+
+        for( const auto& [ zone, netName ] : worker->m_unresolvedZoneNets )
+            resolveZoneNet( zone, netName );
+
+        m_undefinedLayers.insert( worker->m_undefinedLayers.begin(),
+                                  worker->m_undefinedLayers.end() );
+        m_fontTextMap.insert( worker->m_fontTextMap.begin(), worker->m_fontTextMap.end() );
+        m_groupInfos.insert( m_groupInfos.end(), worker->m_groupInfos.begin(),
+                             worker->m_groupInfos.end() );
+        m_generatorInfos.insert( m_generatorInfos.end(), worker->m_generatorInfos.begin(),
+                                 worker->m_generatorInfos.end() );
+
+        worker->m_bulkParsedItems.clear();
+    }
+
+    m_bulkJobs.clear();
+    m_bulkWorkers.clear();
+}
+
+
+void PCB_IO_KICAD_SEXPR_PARSER::abandonBulkItems()
+{
+    m_bulkCancelled = true;
+
+    for( std::future<void>& job : m_bulkJobs )
+    {
+        if( job.valid() )
+            job.wait();
+    }
+
+    for( const std::unique_ptr<PCB_IO_KICAD_SEXPR_PARSER>& worker : m_bulkWorkers )
+    {
+        for( BOARD_ITEM* parsedItem : worker->m_bulkParsedItems )
+            delete parsedItem;
+    }
+
+    m_bulkJobs.clear();
+    m_bulkWorkers.clear();
+}
+
+
+BOARD_ITEM* PCB_IO_KICAD_SEXPR_PARSER::parseBulkItem()
+{
+    if( NextTok() != T_LEFT )
+        Expecting( T_LEFT );
+
+    switch( NextTok() )
+    {
+    case T_module:      // legacy token
+    case T_footprint:   return parseFOOTPRINT();
+    case T_segment:     return parsePCB_TRACK();
+    case T_arc:         return parseARC();
+    case T_via:         return parsePCB_VIA();
+    case T_zone:        return parseZONE( m_board );
+
+    default:
+        wxString err;
+        err.Printf( _( "Unknown token '%s'" ), FromUTF8() );
+        THROW_PARSE_ERROR( err, CurSource(), CurLine(), CurLineNumber(), CurOffset() );
+    }
+}
+
+
 void PCB_IO_KICAD_SEXPR_PARSER::resolveGroups( BOARD_ITEM* aParent )
 {
     auto getItem =
@@ -6624,30 +7094,15 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
     if( zone_has_net
         && ( !zone->GetNet() || zone->GetNet()->GetNetname() != netnameFromfile ) )
     {
-        // Can happens which old boards, with nonexistent nets ...
-        // or after being edited by hand
-        // We try to fix the mismatch.
-        NETINFO_ITEM* net = m_board->FindNet( netnameFromfile );
-
-        if( net )   // An existing net has the same net name. use it for the zone
-        {
-            zone->SetNetCode( net->GetNetCode() );
-        }
-        else    // Not existing net: add a new net to keep trace of the zone netname
-        {
-            int newnetcode = m_board->GetNetCount();
-            net = new NETINFO_ITEM( m_board, netnameFromfile, newnetcode );
-            m_board->Add( net, ADD_MODE::INSERT, true );
-
-            // Store the new code mapping
-            pushValueIntoMap( newnetcode, net->GetNetCode() );
-
-            // and update the zone netcode
-            zone->SetNetCode( net->GetNetCode() );
-        }
+        // A bulk item worker can't modify the board; the main parser fixes the net up when
+        // it adds the zone to the board
+        if( m_bulkWorker )
+            m_unresolvedZoneNets.emplace_back( zone.get(), netnameFromfile );
+        else
+            resolveZoneNet( zone.get(), netnameFromfile );
     }
 
-    if( zone->IsTeardropArea() && m_requiredVersion < 20230517 )
+    if( zone->IsTeardropArea() && m_requiredVersion < 20230517 && !m_bulkWorker )
         m_board->SetLegacyTeardrops( true );
 
     // Clear flags used in zone edition:
@@ -6657,6 +7112,32 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
 }
 
 
+void PCB_IO_KICAD_SEXPR_PARSER::resolveZoneNet( ZONE* aZone, const wxString& aNetName )
+{
+    // Can happens which old boards, with nonexistent nets ...
+    // or after being edited by hand
+    // We try to fix the mismatch.
+    NETINFO_ITEM* net = m_board->FindNet( aNetName );
+
+    if( net )   // An existing net has the same net name. use it for the zone
+    {
+        aZone->SetNetCode( net->GetNetCode() );
+    }
+    else    // Not existing net: add a new net to keep trace of the zone netname
+    {
+        int newnetcode = m_board->GetNetCount();
+        net = new NETINFO_ITEM( m_board, aNetName, newnetcode );
+        m_board->Add( net, ADD_MODE::INSERT, true );
+
+        // Store the new code mapping
+        pushValueIntoMap( newnetcode, net->GetNetCode() );
+
+        // and update the zone netcode
+        aZone->SetNetCode( net->GetNetCode() );
+    }
+}
+
+
 PCB_TARGET* PCB_IO_KICAD_SEXPR_PARSER::parsePCB_TARGET()
 {
     wxCHECK_MSG( CurTok() == T_target, nullptr,
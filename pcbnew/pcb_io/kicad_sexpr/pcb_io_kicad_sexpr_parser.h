@@ -39,8 +39,15 @@
 #include <math/box2.h>
 #include <string_any_map.h>
 
+#include <atomic>
+#include <charconv>
 #include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 
 class PCB_ARC;
@@ -67,6 +74,38 @@ class SHAPE_LINE_CHAIN;
 struct LAYER;
 class PROGRESS_REPORTER;
 class TEARDROP_PARAMETERS;
+struct FOOTPRINT_SUMMARY;
+
+
+/**
+ * The text of a board file split up for parallel parsing.
+ *
+ * The board's footprints, tracks, vias and zones (which make up the bulk of any large board)
+ * are cut out into separate ranges which can be parsed on worker threads.  Everything else
+ * stays in the "skeleton", which is parsed as normal.  The line breaks of the cut-out items
+ * are kept in the skeleton so that its line numbers match the original file.
+ */
+struct PCB_BULK_ITEMS
+{
+    struct RANGE
+    {
+        size_t   m_offset;
+        size_t   m_length;
+        unsigned m_line;         ///< line number of the first line of the range
+    };
+
+    /**
+     * Split \a aText, which must outlive this object.
+     *
+     * @return false if the text doesn't have the layout written by KiCad (eg: a header section
+     *         which follows some of the items), in which case it should be parsed serially.
+     */
+    bool Split( std::string_view aText );
+
+    std::string_view    m_text;
+    std::string         m_skeleton;
+    std::vector<RANGE>  m_ranges;
+};
 
 
 /**
@@ -85,15 +124,27 @@ public:
         m_progressReporter( aProgressReporter ),
         m_lastProgressTime( std::chrono::steady_clock::now() ),
         m_lineCount( aLineCount ),
-        m_queryUserCallback( std::move( aQueryUserCallback ) )
+        m_queryUserCallback( std::move( aQueryUserCallback ) ),
+        m_bulkItems( nullptr ),
+        m_bulkWorker( false ),
+        m_bulkCancelled( false )
     {
         init();
     }
 
-    // ~PCB_IO_KICAD_SEXPR_PARSER() {}
+    ~PCB_IO_KICAD_SEXPR_PARSER();
 
     BOARD_ITEM* Parse();
 
+    /**
+     * Parse the given footprints, tracks, vias and zones on worker threads.
+     *
+     * The reader must be reading \a aBulkItems' skeleton.  The workers are started once the
+     * board's header (layers, nets, etc.) has been parsed, and their items are added to the
+     * board in file order when the skeleton has been parsed.
+     */
+    void SetBulkItems( const PCB_BULK_ITEMS* aBulkItems ) { m_bulkItems = aBulkItems; }
+
     /**
      * @param aInitialComments may be a pointer to a heap allocated initial comment block
      *                         or NULL.  If not NULL, then caller has given ownership of a
@@ -122,6 +173,14 @@ public:
      */
     bool IsValidBoardHeader();
 
+    /**
+     * Read just the name, description, keywords and pad counts of a footprint, skipping
+     * everything else without building any of it.
+     *
+     * @return false if the input is not a footprint.
+     */
+    bool ParseFootprintSummary( FOOTPRINT_SUMMARY& aSummary );
+
 private:
 
     // Group membership info refers to other Uuids in the file.
@@ -241,6 +300,32 @@ private:
     // Parse a board, but do not replace PARSE_ERROR with FUTURE_FORMAT_ERROR automatically.
     BOARD*      parseBOARD_unchecked();
 
+    /**
+     * Add the net of a copper zone whose net code doesn't match its net name.
+     */
+    void        resolveZoneNet( ZONE* aZone, const wxString& aNetName );
+
+    /**
+     * Start parsing the bulk items (see SetBulkItems()) on worker threads.
+     */
+    void        startBulkItems();
+
+    /**
+     * Wait for the bulk item workers and add their items (and anything else they found which
+     * is resolved at the board level) to the board.
+     */
+    void        finishBulkItems( std::vector<BOARD_ITEM*>& aBulkAddedItems );
+
+    /**
+     * Cancel and wait for any bulk item workers, deleting their items.
+     */
+    void        abandonBulkItems();
+
+    /**
+     * Parse a single bulk item in a worker parser.
+     */
+    BOARD_ITEM* parseBulkItem();
+
     /**
      * Parse the current token for the layer definition of a #BOARD_ITEM object.
      *
@@ -334,7 +419,18 @@ private:
 
     inline int parseInt()
     {
-        return (int)strtol( CurText(), nullptr, 10 );
+        // std::from_chars() is locale independent and doesn't need a nul terminated string,
+        // but unlike strtol() doesn't accept a leading '+'
+        const std::string& text = CurStr();
+        const char*        begin = text.data();
+        const char*        end = begin + text.size();
+        int                value = 0;
+
+        if( begin < end && *begin == '+' )
+            ++begin;
+
+        std::from_chars( begin, end, value );
+        return value;
     }
 
     inline int parseInt( const char* aExpected )
@@ -413,6 +509,16 @@ private:
     std::vector<GENERATOR_INFO> m_generatorInfos;
 
     std::function<bool( wxString aTitle, int aIcon, wxString aMsg, wxString aAction )> m_queryUserCallback;
+
+    const PCB_BULK_ITEMS*                                   m_bulkItems; ///< optional
+    std::vector<std::unique_ptr<PCB_IO_KICAD_SEXPR_PARSER>> m_bulkWorkers;
+    std::vector<std::future<void>>                          m_bulkJobs;
+    bool                                                    m_bulkWorker; ///< true for a worker
+    std::atomic<bool>                                       m_bulkCancelled;
+
+    ///< Results of a bulk item worker
+    std::vector<BOARD_ITEM*>                m_bulkParsedItems;
+    std::vector<std::pair<ZONE*, wxString>> m_unresolvedZoneNets;
 };
 
 
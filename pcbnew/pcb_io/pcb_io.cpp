@@ -23,6 +23,7 @@
  */
 
 #include <unordered_set>
+#include <footprint.h>
 #include <pcb_io/pcb_io.h>
 #include <pcb_io/pcb_io_mgr.h>
 #include <ki_exception.h>
@@ -101,6 +102,45 @@ void PCB_IO::FootprintEnumerate( wxArrayString& aFootprintNames, const wxString&
 }
 
 
+void PCB_IO::FootprintEnumerateSummaries( std::vector<FOOTPRINT_SUMMARY>& aSummaries,
+                                          const wxString& aLibraryPath, bool aBestEfforts,
+                                          const STRING_UTF8_MAP* aProperties )
+{
+    wxArrayString names;
+    wxString      errorMsg;
+
+    // Some of the footprints may have loaded even if others didn't
+    try
+    {
+        FootprintEnumerate( names, aLibraryPath, aBestEfforts, aProperties );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        errorMsg = ioe.What();
+    }
+
+    for( const wxString& name : names )
+    {
+        FOOTPRINT_SUMMARY summary;
+
+        summary.m_name = name;
+
+        if( const FOOTPRINT* footprint = GetEnumeratedFootprint( aLibraryPath, name, aProperties ) )
+        {
+            summary.m_description = footprint->GetLibDescription();
+            summary.m_keywords = footprint->GetKeywords();
+            summary.m_padCount = footprint->GetPadCount( DO_NOT_INCLUDE_NPTH );
+            summary.m_uniquePadCount = footprint->GetUniquePadCount( DO_NOT_INCLUDE_NPTH );
+        }
+
+        aSummaries.push_back( std::move( summary ) );
+    }
+
+    if( !errorMsg.IsEmpty() )
+        THROW_IO_ERROR( errorMsg );
+}
+
+
 void PCB_IO::PrefetchLib( const wxString&, const STRING_UTF8_MAP* )
 {
 }
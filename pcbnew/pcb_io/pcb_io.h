@@ -40,6 +40,21 @@ class STRING_UTF8_MAP;
 class PROJECT;
 class PROGRESS_REPORTER;
 
+
+/**
+ * The information about a library footprint which is shown in footprint choosers, which is
+ * much cheaper to hold (and for some plugins to read) than the footprint itself.
+ */
+struct FOOTPRINT_SUMMARY
+{
+    wxString m_name;
+    wxString m_description;
+    wxString m_keywords;
+    unsigned m_padCount = 0;            ///< not including NPTH pads
+    unsigned m_uniquePadCount = 0;      ///< not including NPTH pads
+};
+
+
 /**
  * A base class that #BOARD loading and saving plugins should derive from.
  *
@@ -177,6 +192,23 @@ public:
     virtual void FootprintEnumerate( wxArrayString& aFootprintNames, const wxString& aLibraryPath,
                                      bool aBestEfforts, const STRING_UTF8_MAP* aProperties = nullptr );
 
+    /**
+     * Return a #FOOTPRINT_SUMMARY for each footprint in the library at @a aLibraryPath.
+     *
+     * The default implementation loads the footprints through FootprintEnumerate() and
+     * GetEnumeratedFootprint().  Plugins which can read the summary information without fully
+     * loading each footprint should override it.
+     *
+     * @param aSummaries is filled in with the summaries of the footprints which could be read,
+     *                   even if an error is thrown for the others.
+     * @param aBestEfforts if true, don't throw on errors.
+     *
+     * @throw IO_ERROR if the library cannot be found, or a footprint cannot be read.
+     */
+    virtual void FootprintEnumerateSummaries( std::vector<FOOTPRINT_SUMMARY>& aSummaries,
+                                              const wxString& aLibraryPath, bool aBestEfforts,
+                                              const STRING_UTF8_MAP* aProperties = nullptr );
+
     /**
      * Generate a timestamp representing all the files in the library (including the library
      * directory).
@@ -154,6 +154,16 @@ public:
 };
 
 
+/**
+ * Implementation of the intersectsCourtyard() expression function.
+ *
+ * @param aArg a footprint reference designator (or FPID) pattern, or "A" or "B" to test against
+ *             the footprint in the corresponding slot of \a aCtx.
+ * @return true if \a aItem intersects either courtyard of any of the matching footprints.
+ */
+bool ItemIntersectsCourtyard( BOARD_ITEM* aItem, const wxString& aArg, PCBEXPR_CONTEXT* aCtx );
+
+
 class PCBEXPR_BUILTIN_FUNCTIONS
 {
 public:
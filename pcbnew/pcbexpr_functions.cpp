@@ -248,6 +248,40 @@ static bool searchFootprints( BOARD* aBoard, const wxString& aArg, PCBEXPR_CONTE
 #define MISSING_FP_ARG( f ) \
     wxString::Format( _( "Missing footprint argument (A, B, or reference designator) to %s." ), f )
 
+bool ItemIntersectsCourtyard( BOARD_ITEM* aItem, const wxString& aArg, PCBEXPR_CONTEXT* aCtx )
+{
+    BOARD*                 board = aItem->GetBoard();
+    std::shared_ptr<SHAPE> itemShape;
+
+    return searchFootprints( board, aArg, aCtx,
+            [&]( FOOTPRINT* fp )
+            {
+                PTR_PTR_CACHE_KEY key = { fp, aItem };
+
+                if( ( aItem->GetFlags() & ROUTER_TRANSIENT ) == 0 )
+                {
+                    std::shared_lock<std::shared_mutex> readLock( board->m_CachesMutex );
+
+                    auto i = board->m_IntersectsCourtyardCache.find( key );
+
+                    if( i != board->m_IntersectsCourtyardCache.end() )
+                        return i->second;
+                }
+
+                bool res = collidesWithCourtyard( aItem, itemShape, aCtx, fp, F_Cu )
+                        || collidesWithCourtyard( aItem, itemShape, aCtx, fp, B_Cu );
+
+                if( ( aItem->GetFlags() & ROUTER_TRANSIENT ) == 0 )
+                {
+                    std::unique_lock<std::shared_mutex> cacheLock( board->m_CachesMutex );
+                    board->m_IntersectsCourtyardCache[ key ] = res;
+                }
+
+                return res;
+            } );
+}
+
+
 static void intersectsCourtyardFunc( LIBEVAL::CONTEXT* aCtx, void* self )
 {
     PCBEXPR_CONTEXT* context = static_cast<PCBEXPR_CONTEXT*>( aCtx );
@@ -274,40 +308,7 @@ static void intersectsCourtyardFunc( LIBEVAL::CONTEXT* aCtx, void* self )
     result->SetDeferredEval(
             [item, arg, context]() -> double
             {
-                BOARD*                 board = item->GetBoard();
-                std::shared_ptr<SHAPE> itemShape;
-
-                if( searchFootprints( board, arg->AsString(), context,
-                        [&]( FOOTPRINT* fp )
-                        {
-                            PTR_PTR_CACHE_KEY key = { fp, item };
-
-                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                            {
-                                std::shared_lock<std::shared_mutex> readLock( board->m_CachesMutex );
-
-                                auto i = board->m_IntersectsCourtyardCache.find( key );
-
-                                if( i != board->m_IntersectsCourtyardCache.end() )
-                                    return i->second;
-                            }
-
-                            bool res = collidesWithCourtyard( item, itemShape, context, fp, F_Cu )
-                                    || collidesWithCourtyard( item, itemShape, context, fp, B_Cu );
-
-                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                            {
-                                std::unique_lock<std::shared_mutex> cacheLock( board->m_CachesMutex );
-                                board->m_IntersectsCourtyardCache[ key ] = res;
-                            }
-
-                            return res;
-                        } ) )
-                {
-                    return 1.0;
-                }
-
-                return 0.0;
+                return ItemIntersectsCourtyard( item, arg->AsString(), context ) ? 1.0 : 0.0;
             } );
 }
 
@@ -22,8 +22,10 @@
 #include "pcbnew_jobs_handler.h"
 #include <board_commit.h>
 #include <board_design_settings.h>
+#include <advanced_config.h>
 #include <drc/drc_item.h>
 #include <drc/drc_report.h>
+#include <drc/drc_result_cache.h>
 #include <drawing_sheet/ds_data_model.h>
 #include <drawing_sheet/ds_proxy_view_item.h>
 #include <jobs/job_fp_export_svg.h>
@@ -1351,11 +1353,32 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
                 commit.Add( marker );
             } );
 
+    DRC_RESULT_CACHE resultCache;
+    wxString         resultCacheFile = DRC_RESULT_CACHE::GetCacheFilename( brd );
+
+    if( ADVANCED_CFG::GetCfg().m_DRCResultCache )
+    {
+        resultCache.Load( resultCacheFile );
+        drcEngine->SetResultCache( &resultCache );
+    }
+
     brd->RecordDRCExclusions();
     brd->DeleteMARKERs( true, true );
     drcEngine->RunTests( units, drcJob->m_reportAllTrackErrors, drcJob->m_parity );
     drcEngine->ClearViolationHandler();
 
+    if( drcEngine->GetResultCache() )
+    {
+        drcEngine->SetResultCache( nullptr );
+
+        if( !resultCache.Save( resultCacheFile ) )
+        {
+            m_reporter->Report( wxString::Format( _( "Unable to write DRC result cache '%s'.\n" ),
+                                                  resultCacheFile ),
+                                RPT_SEVERITY_WARNING );
+        }
+    }
+
     commit.Push( _( "DRC" ), SKIP_UNDO | SKIP_SET_DIRTY );
 
     // Update the exclusion status on any excluded markers that still exist.
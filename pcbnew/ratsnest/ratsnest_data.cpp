@@ -139,6 +139,14 @@ class RN_NET::TRIANGULATOR_STATE
 private:
     std::multiset<std::shared_ptr<CN_ANCHOR>, CN_PTR_CMP> m_allNodes;
 
+    // The node coordinates and Delaunay edges (as pairs of node indices) of the previous
+    // triangulation.  Most updates to a net change how its items are connected rather than
+    // where they are, and the triangulation depends only on the latter.  If any anchor has
+    // moved the net is triangulated again from scratch; Delaunator can't update a triangulation
+    // in place, so there is no dynamic spanning tree to maintain between commits.
+    std::vector<double>                        m_prevNodePts;
+    std::vector<std::pair<size_t, size_t>>     m_prevTriangEdges;
+
 
     // Checks if all nodes in aNodes lie on a single line. Requires the nodes to
     // have unique coordinates!
@@ -217,23 +225,30 @@ public:
         }
         else
         {
-            delaunator::Delaunator delaunator( node_pts );
-            auto& triangles = delaunator.triangles;
-
-            for( size_t i = 0; i < triangles.size(); i += 3 )
+            if( node_pts != m_prevNodePts )
             {
-                addEdge( anchors[triangles[i]],     anchors[triangles[i + 1]] );
-                addEdge( anchors[triangles[i + 1]], anchors[triangles[i + 2]] );
-                addEdge( anchors[triangles[i + 2]], anchors[triangles[i]]     );
-            }
+                delaunator::Delaunator delaunator( node_pts );
+                auto& triangles = delaunator.triangles;
 
-            for( size_t i = 0; i < delaunator.halfedges.size(); i++ )
-            {
-                if( delaunator.halfedges[i] == delaunator::INVALID_INDEX )
-                    continue;
+                m_prevTriangEdges.clear();
+                m_prevTriangEdges.reserve( triangles.size() / 2 + 1 );
 
-                addEdge( anchors[triangles[i]], anchors[triangles[delaunator.halfedges[i]]] );
+                // Half-edge i runs from triangles[i] to the next vertex of its triangle.  Edges
+                // inside the hull are shared by two triangles; only take them once.
+                for( size_t i = 0; i < triangles.size(); i++ )
+                {
+                    size_t next = ( i % 3 == 2 ) ? i - 2 : i + 1;
+                    size_t opposite = delaunator.halfedges[i];
+
+                    if( opposite == delaunator::INVALID_INDEX || i < opposite )
+                        m_prevTriangEdges.emplace_back( triangles[i], triangles[next] );
+                }
+
+                m_prevNodePts = node_pts;
             }
+
+            for( const auto& [src, dst] : m_prevTriangEdges )
+                addEdge( anchors[src], anchors[dst] );
         }
 
         for( size_t i = 0; i < anchorChains.size(); i++ )
@@ -99,7 +99,7 @@ public:
     bool NearestBicoloredPair( RN_NET* aOtherNet, VECTOR2I& aPos1, VECTOR2I& aPos2 ) const;
 
 protected:
-    ///< Recompute ratsnest from scratch.
+    ///< Recompute ratsnest (reusing the previous triangulation if no nodes have moved).
     void compute();
 
     ///< Compute the minimum spanning tree using Kruskal's algorithm
@@ -0,0 +1,170 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PNS_COW_SHARDS_H
+#define __PNS_COW_SHARDS_H
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+
+namespace PNS {
+
+/**
+ * A hashed container split into a fixed number of copy-on-write shards.
+ *
+ * Copying only copies the shard pointers, so branched NODEs can share their parent's maps;
+ * the first change to a shared shard copies just that shard.  Callers pick the shard of each
+ * element from its hash with ShardOf(), and must always use the same one for a given key.
+ */
+template <class CONTAINER, size_t SHARDS = 64>
+class COW_SHARDS
+{
+public:
+    typedef typename CONTAINER::value_type     value_type;
+    typedef typename CONTAINER::const_iterator INNER_ITERATOR;
+
+    static constexpr size_t SHARD_COUNT = SHARDS;
+
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag                  iterator_category;
+        typedef typename CONTAINER::value_type             value_type;
+        typedef typename CONTAINER::difference_type        difference_type;
+        typedef typename CONTAINER::const_pointer          pointer;
+        typedef typename CONTAINER::const_reference        reference;
+
+        const_iterator( const COW_SHARDS* aShards, size_t aShard ) :
+                m_shards( aShards ),
+                m_shard( aShard )
+        {
+            seek();
+        }
+
+        reference operator*() const { return *m_inner; }
+        pointer operator->() const { return &*m_inner; }
+
+        const_iterator& operator++()
+        {
+            if( ++m_inner == m_shards->m_shards[m_shard]->end() )
+            {
+                m_shard++;
+                seek();
+            }
+
+            return *this;
+        }
+
+        bool operator==( const const_iterator& aOther ) const
+        {
+            return m_shard == aOther.m_shard && ( m_shard == SHARDS || m_inner == aOther.m_inner );
+        }
+
+        bool operator!=( const const_iterator& aOther ) const
+        {
+            return !( *this == aOther );
+        }
+
+    private:
+        ///< Move to the first element at or after the start of the current shard.
+        void seek()
+        {
+            while( m_shard < SHARDS
+                    && ( !m_shards->m_shards[m_shard] || m_shards->m_shards[m_shard]->empty() ) )
+            {
+                m_shard++;
+            }
+
+            if( m_shard < SHARDS )
+                m_inner = m_shards->m_shards[m_shard]->begin();
+        }
+
+        const COW_SHARDS* m_shards;
+        size_t            m_shard;
+        INNER_ITERATOR    m_inner;
+    };
+
+    /**
+     * @return the shard for an element with the hash \a aHash.
+     */
+    static size_t ShardOf( size_t aHash )
+    {
+        // Take the top bits of a multiplicative hash, as the low bits also pick the bucket
+        // inside the shard (and some of our hashes are rather weak).
+        uint64_t h = static_cast<uint64_t>( aHash ) * UINT64_C( 0x9E3779B97F4A7C15 );
+        return static_cast<size_t>( ( h >> 32 ) % SHARDS );
+    }
+
+    ///< @return the contents of the shard \a aShard for reading.
+    const CONTAINER& Get( size_t aShard ) const
+    {
+        static const CONTAINER empty;
+
+        return m_shards[aShard] ? *m_shards[aShard] : empty;
+    }
+
+    ///< @return the shard \a aShard for changing, first copying it if it is shared.
+    CONTAINER& Mutable( size_t aShard )
+    {
+        std::shared_ptr<CONTAINER>& shard = m_shards[aShard];
+
+        if( !shard )
+            shard = std::make_shared<CONTAINER>();
+        else if( shard.use_count() > 1 )
+            shard = std::make_shared<CONTAINER>( *shard );
+
+        return *shard;
+    }
+
+    size_t size() const
+    {
+        size_t count = 0;
+
+        for( const std::shared_ptr<CONTAINER>& shard : m_shards )
+        {
+            if( shard )
+                count += shard->size();
+        }
+
+        return count;
+    }
+
+    bool empty() const
+    {
+        return begin() == end();
+    }
+
+    void clear()
+    {
+        for( std::shared_ptr<CONTAINER>& shard : m_shards )
+            shard.reset();
+    }
+
+    const_iterator begin() const { return const_iterator( this, 0 ); }
+    const_iterator end() const { return const_iterator( this, SHARDS ); }
+
+private:
+    std::array<std::shared_ptr<CONTAINER>, SHARDS> m_shards;
+};
+
+}
+
+#endif
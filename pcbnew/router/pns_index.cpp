@@ -19,12 +19,25 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include "pns_index.h"
 #include "pns_router.h"
 
 namespace PNS {
 
 
+static void itemBox( const ITEM* aItem, int aMin[2], int aMax[2] )
+{
+    BOX2I box = aItem->Shape()->BBox();
+
+    aMin[0] = box.GetX();
+    aMin[1] = box.GetY();
+    aMax[0] = box.GetRight();
+    aMax[1] = box.GetBottom();
+}
+
+
 void INDEX::Add( ITEM* aItem )
 {
     const LAYER_RANGE& range = aItem->Layers();
@@ -33,14 +46,19 @@ void INDEX::Add( ITEM* aItem )
     if( m_subIndices.size() <= static_cast<size_t>( range.End() ) )
         m_subIndices.resize( 2 * range.End() + 1 ); // +1 handles the 0 case
 
+    int min[2], max[2];
+    itemBox( aItem, min, max );
+
     for( int i = range.Start(); i <= range.End(); ++i )
-        m_subIndices[i].Add( aItem );
+        m_subIndices[i].Insert( min, max, aItem );
 
-    m_allItems.insert( aItem );
+    size_t shard = shardOf( aItem );
+
+    m_allItems.Mutable( shard ).insert( aItem );
     NET_HANDLE net = aItem->Net();
 
     if( net )
-        m_netMap[net].push_back( aItem );
+        m_netMap.Mutable( shard ).emplace( net, aItem );
 }
 
 
@@ -52,14 +70,38 @@ void INDEX::Remove( ITEM* aItem )
     if( m_subIndices.size() <= static_cast<size_t>( range.End() ) )
         return;
 
+    int min[2], max[2];
+    itemBox( aItem, min, max );
+
     for( int i = range.Start(); i <= range.End(); ++i )
-        m_subIndices[i].Remove( aItem );
+        m_subIndices[i].Remove( min, max, aItem );
+
+    size_t shard = shardOf( aItem );
+
+    if( m_allItems.Get( shard ).count( aItem ) )
+        m_allItems.Mutable( shard ).erase( aItem );
 
-    m_allItems.erase( aItem );
     NET_HANDLE net = aItem->Net();
 
-    if( net && m_netMap.find( net ) != m_netMap.end() )
-        m_netMap[net].remove( aItem );
+    if( !net )
+        return;
+
+    auto isItem =
+            [aItem]( const NET_ITEMS_MAP::value_type& aEntry )
+            {
+                return aEntry.second == aItem;
+            };
+
+    // Check before asking for a mutable shard, which might have to copy it
+    auto found = m_netMap.Get( shard ).equal_range( net );
+
+    if( std::find_if( found.first, found.second, isItem ) == found.second )
+        return;
+
+    auto& netItems = m_netMap.Mutable( shard );
+    auto  items = netItems.equal_range( net );
+
+    netItems.erase( std::find_if( items.first, items.second, isItem ) );
 }
 
 
@@ -70,12 +112,15 @@ void INDEX::Replace( ITEM* aOldItem, ITEM* aNewItem )
 }
 
 
-INDEX::NET_ITEMS_LIST* INDEX::GetItemsForNet( NET_HANDLE aNet )
+void INDEX::GetItemsForNet( NET_HANDLE aNet, std::vector<ITEM*>& aItems ) const
 {
-    if( m_netMap.find( aNet ) == m_netMap.end() )
-        return nullptr;
+    for( size_t shard = 0; shard < NET_ITEMS_MAP::SHARD_COUNT; ++shard )
+    {
+        auto range = m_netMap.Get( shard ).equal_range( aNet );
 
-    return &m_netMap[aNet];
+        for( auto it = range.first; it != range.second; ++it )
+            aItems.push_back( it->second );
+    }
 }
 
 };
@@ -22,14 +22,15 @@
 #ifndef __PNS_INDEX_H
 #define __PNS_INDEX_H
 
-#include <deque>
-#include <list>
-#include <map>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <layer_ids.h>
-#include <geometry/shape_index.h>
+#include <geometry/persistent_rtree.h>
+#include <geometry/shape.h>
 
+#include "pns_cow_shards.h"
 #include "pns_item.h"
 
 namespace PNS {
@@ -41,13 +42,16 @@ namespace PNS {
  * Custom spatial index, holding our board items and allowing for very fast searches. Items
  * are assigned to separate R-Tree subindices depending on their type and spanned layers, reducing
  * overlap and improving search time.
+ *
+ * Copies of an index share their contents until either is changed (and then only copy what
+ * is changed), so branching a NODE costs the same however many changes its parent holds.
  **/
 class INDEX
 {
 public:
-    typedef std::list<ITEM*>            NET_ITEMS_LIST;
-    typedef SHAPE_INDEX<ITEM*>          ITEM_SHAPE_INDEX;
-    typedef std::unordered_set<ITEM*>   ITEM_SET;
+    typedef PERSISTENT_RTREE<ITEM*>                                ITEM_SHAPE_INDEX;
+    typedef COW_SHARDS<std::unordered_set<ITEM*>>                  ITEM_SET;
+    typedef COW_SHARDS<std::unordered_multimap<NET_HANDLE, ITEM*>> NET_ITEMS_MAP;
 
     INDEX(){};
 
@@ -95,9 +99,9 @@ public:
     int Query( const SHAPE* aShape, int aMinDistance, Visitor& aVisitor ) const;
 
     /**
-     * Returns list of all items in a given net.
+     * Returns all items in a given net.
      */
-    NET_ITEMS_LIST* GetItemsForNet( NET_HANDLE aNet );
+    void GetItemsForNet( NET_HANDLE aNet, std::vector<ITEM*>& aItems ) const;
 
     /**
      * Function Contains()
@@ -106,7 +110,7 @@ public:
      */
     bool Contains( ITEM* aItem ) const
     {
-        return m_allItems.find( aItem ) != m_allItems.end();
+        return m_allItems.Get( shardOf( aItem ) ).count( aItem ) > 0;
     }
 
     /**
@@ -114,27 +118,34 @@ public:
      */
     int Size() const { return m_allItems.size(); }
 
-    ITEM_SET::iterator begin() { return m_allItems.begin(); }
-    ITEM_SET::iterator end() { return m_allItems.end(); }
+    ITEM_SET::const_iterator begin() const { return m_allItems.begin(); }
+    ITEM_SET::const_iterator end() const { return m_allItems.end(); }
 
 private:
+    static size_t shardOf( const ITEM* aItem )
+    {
+        return ITEM_SET::ShardOf( std::hash<const ITEM*>()( aItem ) );
+    }
+
     template <class Visitor>
-    int querySingle( std::size_t aIndex, const SHAPE* aShape, int aMinDistance, Visitor& aVisitor ) const;
+    int querySingle( std::size_t aIndex, const int aMin[2], const int aMax[2],
+                     Visitor& aVisitor ) const;
 
 private:
-    std::deque<ITEM_SHAPE_INDEX>         m_subIndices;
-    std::map<NET_HANDLE, NET_ITEMS_LIST> m_netMap;
-    ITEM_SET                             m_allItems;
+    std::vector<ITEM_SHAPE_INDEX> m_subIndices;
+    NET_ITEMS_MAP                 m_netMap;     ///< sharded by item, like m_allItems
+    ITEM_SET                      m_allItems;
 };
 
 
 template<class Visitor>
-int INDEX::querySingle( std::size_t aIndex, const SHAPE* aShape, int aMinDistance, Visitor& aVisitor ) const
+int INDEX::querySingle( std::size_t aIndex, const int aMin[2], const int aMax[2],
+                        Visitor& aVisitor ) const
 {
     if( aIndex >= m_subIndices.size() )
         return 0;
 
-    return m_subIndices[aIndex].Query( aShape, aMinDistance, aVisitor);
+    return m_subIndices[aIndex].Search( aMin, aMax, aVisitor );
 }
 
 template<class Visitor>
@@ -144,10 +155,16 @@ int INDEX::Query( const ITEM* aItem, int aMinDistance, Visitor& aVisitor ) const
 
     wxCHECK( aItem->Kind() != ITEM::INVALID_T, 0 );
 
+    BOX2I box = aItem->Shape()->BBox();
+    box.Inflate( aMinDistance );
+
+    int min[2] = { box.GetX(), box.GetY() };
+    int max[2] = { box.GetRight(), box.GetBottom() };
+
     const LAYER_RANGE& layers = aItem->Layers();
 
     for( int i = layers.Start(); i <= layers.End(); ++i )
-        total += querySingle( i, aItem->Shape(), aMinDistance, aVisitor );
+        total += querySingle( i, min, max, aVisitor );
 
     return total;
 }
@@ -157,8 +174,14 @@ int INDEX::Query( const SHAPE* aShape, int aMinDistance, Visitor& aVisitor ) con
 {
     int total = 0;
 
+    BOX2I box = aShape->BBox();
+    box.Inflate( aMinDistance );
+
+    int min[2] = { box.GetX(), box.GetY() };
+    int max[2] = { box.GetRight(), box.GetBottom() };
+
     for( std::size_t i = 0; i < m_subIndices.size(); ++i )
-        total += querySingle( i, aShape, aMinDistance, aVisitor );
+        total += querySingle( i, min, max, aVisitor );
 
     return total;
 }
@@ -43,6 +43,7 @@
 #include "pns_index.h"
 #include "pns_debug_decorator.h"
 #include "pns_router.h"
+#include "pns_perf_counters.h"
 #include "pns_utils.h"
 
 
@@ -61,6 +62,8 @@ NODE::NODE()
     m_ruleResolver = nullptr;
     m_index = new INDEX;
 
+    PerfCounters().m_nodeAllocations++;
+
 #ifdef DEBUG
     allocNodes.insert( this );
 #endif
@@ -152,15 +155,12 @@ NODE* NODE::Branch()
     child->m_root = isRoot() ? this : m_root;
     child->m_maxClearance = m_maxClearance;
 
-    // Immediate offspring of the root branch needs not copy anything. For the rest, deep-copy
-    // joints, overridden item maps and pointers to stored items.
+    // Immediate offspring of the root branch needs not copy anything. For the rest, share
+    // joints, overridden item maps and the index of stored items with this branch; they are
+    // copied piecemeal as either branch changes them.
     if( !isRoot() )
     {
-        JOINT_MAP::iterator j;
-
-        for( ITEM* item : *m_index )
-            child->m_index->Add( item );
-
+        *child->m_index = *m_index;
         child->m_joints = m_joints;
         child->m_override = m_override;
     }
@@ -252,6 +252,8 @@ struct NODE::DEFAULT_OBSTACLE_VISITOR : public OBSTACLE_VISITOR
 int NODE::QueryColliding( const ITEM* aItem, NODE::OBSTACLES& aObstacles,
                           const COLLISION_SEARCH_OPTIONS& aOpts ) const
 {
+    PerfCounters().m_queryColliding++;
+
     COLLISION_SEARCH_CONTEXT ctx( aObstacles, aOpts );
 
     /// By default, virtual items cannot collide
@@ -728,10 +730,10 @@ void NODE::doRemove( ITEM* aItem )
     // mark it as overridden, but do not remove
     if( aItem->BelongsTo( m_root ) && !isRoot() )
     {
-        m_override.insert( aItem );
+        m_override.Mutable( itemShard( aItem ) ).insert( aItem );
 
         if( aItem->HasHole() )
-            m_override.insert( aItem->Hole() );
+            m_override.Mutable( itemShard( aItem->Hole() ) ).insert( aItem->Hole() );
     }
 
     // case 2: the item belongs to this branch or a parent, non-root branch,
@@ -789,14 +791,15 @@ void NODE::rebuildJoint( const JOINT* aJoint, const ITEM* aItem )
     tag.net = net;
     tag.pos = aJoint->Pos();
 
-    bool split;
+    JOINT_MAP& joints = m_joints.Mutable( jointShard( tag ) );
+    bool       split;
 
     do
     {
         split = false;
-        auto range = m_joints.equal_range( tag );
+        auto range = joints.equal_range( tag );
 
-        if( range.first == m_joints.end() )
+        if( range.first == joints.end() )
             break;
 
         // find and remove all joints containing the via to be removed
@@ -805,7 +808,7 @@ void NODE::rebuildJoint( const JOINT* aJoint, const ITEM* aItem )
         {
             if( aItem->LayersOverlap( &f->second ) )
             {
-                m_joints.erase( f );
+                joints.erase( f );
                 split = true;
                 break;
             }
@@ -1146,7 +1149,7 @@ void NODE::FixupVirtualVias()
     const SEGMENT* locked_seg = nullptr;
     std::vector<VVIA*> vvias;
 
-    for( auto& jointPair : m_joints )
+    for( const TagJointPair& jointPair : m_joints )
     {
         JOINT joint = jointPair.second;
 
@@ -1219,12 +1222,15 @@ const JOINT* NODE::FindJoint( const VECTOR2I& aPos, int aLayer, NET_HANDLE aNet
     tag.net = aNet;
     tag.pos = aPos;
 
-    JOINT_MAP::const_iterator f = m_joints.find( tag ), end = m_joints.end();
+    size_t                    shard = jointShard( tag );
+    const JOINT_MAP*          joints = &m_joints.Get( shard );
+    JOINT_MAP::const_iterator f = joints->find( tag ), end = joints->end();
 
     if( f == end && !isRoot() )
     {
-        end = m_root->m_joints.end();
-        f = m_root->m_joints.find( tag );    // m_root->FindJoint(aPos, aLayer, aNet);
+        joints = &m_root->m_joints.Get( shard );
+        end = joints->end();
+        f = joints->find( tag );    // m_root->FindJoint(aPos, aLayer, aNet);
     }
 
     if( f == end )
@@ -1256,18 +1262,21 @@ JOINT& NODE::touchJoint( const VECTOR2I& aPos, const LAYER_RANGE& aLayers, NET_H
     tag.pos = aPos;
     tag.net = aNet;
 
+    size_t     shard = jointShard( tag );
+    JOINT_MAP& joints = m_joints.Mutable( shard );
+
     // try to find the joint in this node.
-    JOINT_MAP::iterator f = m_joints.find( tag );
+    JOINT_MAP::iterator f = joints.find( tag );
 
     std::pair<JOINT_MAP::iterator, JOINT_MAP::iterator> range;
 
     // not found and we are not root? find in the root and copy results here.
-    if( f == m_joints.end() && !isRoot() )
+    if( f == joints.end() && !isRoot() )
     {
-        range = m_root->m_joints.equal_range( tag );
+        auto rootRange = m_root->m_joints.Get( shard ).equal_range( tag );
 
-        for( f = range.first; f != range.second; ++f )
-            m_joints.insert( *f );
+        for( auto rf = rootRange.first; rf != rootRange.second; ++rf )
+            joints.insert( *rf );
     }
 
     // now insert and combine overlapping joints
@@ -1278,9 +1287,9 @@ JOINT& NODE::touchJoint( const VECTOR2I& aPos, const LAYER_RANGE& aLayers, NET_H
     do
     {
         merged  = false;
-        range   = m_joints.equal_range( tag );
+        range   = joints.equal_range( tag );
 
-        if( range.first == m_joints.end() )
+        if( range.first == joints.end() )
             break;
 
         for( f = range.first; f != range.second; ++f )
@@ -1288,14 +1297,14 @@ JOINT& NODE::touchJoint( const VECTOR2I& aPos, const LAYER_RANGE& aLayers, NET_H
             if( aLayers.Overlaps( f->second.Layers() ) )
             {
                 jt.Merge( f->second );
-                m_joints.erase( f );
+                joints.erase( f );
                 merged = true;
                 break;
             }
         }
     } while( merged );
 
-    return m_joints.insert( TagJointPair( tag, jt ) )->second;
+    return joints.insert( TagJointPair( tag, jt ) )->second;
 }
 
 
@@ -1504,28 +1513,26 @@ void NODE::KillChildren()
 
 void NODE::AllItemsInNet( NET_HANDLE aNet, std::set<ITEM*>& aItems, int aKindMask )
 {
-    INDEX::NET_ITEMS_LIST* l_cur = m_index->GetItemsForNet( aNet );
+    std::vector<ITEM*> l_cur;
+
+    m_index->GetItemsForNet( aNet, l_cur );
 
-    if( l_cur )
+    for( ITEM* item : l_cur )
     {
-        for( ITEM* item : *l_cur )
-        {
-            if( item->OfKind( aKindMask ) && item->IsRoutable() )
-                aItems.insert( item );
-        }
+        if( item->OfKind( aKindMask ) && item->IsRoutable() )
+            aItems.insert( item );
     }
 
     if( !isRoot() )
     {
-        INDEX::NET_ITEMS_LIST* l_root = m_root->m_index->GetItemsForNet( aNet );
+        std::vector<ITEM*> l_root;
+
+        m_root->m_index->GetItemsForNet( aNet, l_root );
 
-        if( l_root )
+        for( ITEM* item : l_root )
         {
-            for( ITEM* item : *l_root )
-            {
-                if( !Overrides( item ) && item->OfKind( aKindMask ) && item->IsRoutable() )
-                    aItems.insert( item );
-            }
+            if( !Overrides( item ) && item->OfKind( aKindMask ) && item->IsRoutable() )
+                aItems.insert( item );
         }
     }
 }
@@ -1626,14 +1633,14 @@ ARC* NODE::findRedundantArc( ARC* aArc )
 }
 
 
-int NODE::QueryJoints( const BOX2I& aBox, std::vector<JOINT*>& aJoints, LAYER_RANGE aLayerMask,
-                       int aKindMask )
+int NODE::QueryJoints( const BOX2I& aBox, std::vector<const JOINT*>& aJoints,
+                       LAYER_RANGE aLayerMask, int aKindMask )
 {
     int n = 0;
 
     aJoints.clear();
 
-    for( JOINT_MAP::value_type& j : m_joints )
+    for( const TagJointPair& j : m_joints )
     {
         if( !j.second.Layers().Overlaps( aLayerMask ) )
             continue;
@@ -1648,9 +1655,9 @@ int NODE::QueryJoints( const BOX2I& aBox, std::vector<JOINT*>& aJoints, LAYER_RA
     if( isRoot() )
         return n;
 
-    for( JOINT_MAP::value_type& j : m_root->m_joints )
+    for( const TagJointPair& j : m_root->m_joints )
     {
-        if( !Overrides( &j.second ) && j.second.Layers().Overlaps( aLayerMask ) )
+        if( j.second.Layers().Overlaps( aLayerMask ) )
         {
             if( aBox.Contains( j.second.Pos() ) && j.second.LinkCount( aKindMask ) )
             {
@@ -1669,15 +1676,14 @@ ITEM *NODE::FindItemByParent( const BOARD_ITEM* aParent )
     if( aParent->IsConnected() )
     {
         const BOARD_CONNECTED_ITEM* cItem = static_cast<const BOARD_CONNECTED_ITEM*>( aParent );
-        INDEX::NET_ITEMS_LIST*      l_cur = m_index->GetItemsForNet( cItem->GetNet() );
+        std::vector<ITEM*>          l_cur;
+
+        m_index->GetItemsForNet( cItem->GetNet(), l_cur );
 
-        if( l_cur )
+        for( ITEM* item : l_cur )
         {
-            for( ITEM* item : *l_cur )
-            {
-                if( item->Parent() == aParent )
-                    return item;
-            }
+            if( item->Parent() == aParent )
+                return item;
         }
     }
 
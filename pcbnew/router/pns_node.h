@@ -31,6 +31,7 @@
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_index.h>
 
+#include "pns_cow_shards.h"
 #include "pns_item.h"
 #include "pns_joint.h"
 #include "pns_itemset.h"
@@ -271,7 +272,7 @@ public:
     int QueryColliding( const ITEM* aItem, OBSTACLES& aObstacles,
                         const COLLISION_SEARCH_OPTIONS& aOpts = COLLISION_SEARCH_OPTIONS() ) const;
 
-    int QueryJoints( const BOX2I& aBox, std::vector<JOINT*>& aJoints,
+    int QueryJoints( const BOX2I& aBox, std::vector<const JOINT*>& aJoints,
                      LAYER_RANGE aLayerMask = LAYER_RANGE::All(), int aKindMask = ITEM::ANY_T );
 
     /**
@@ -369,7 +370,8 @@ public:
 
     /**
      * Create a lightweight copy (called branch) of self that tracks the changes (added/removed
-     * items) wrs to the root.
+     * items) wrs to the root.  The branch shares its parent's index and joints until one of
+     * them changes them, so branching doesn't get slower as changes pile up.
      *
      * @note If there are any branches in use, their parents must **not** be deleted.
      *
@@ -464,7 +466,7 @@ public:
     ///< Check if this branch contains an updated version of the m_item from the root branch.
     bool Overrides( ITEM* aItem ) const
     {
-        return m_override.find( aItem ) != m_override.end();
+        return m_override.Get( itemShard( aItem ) ).count( aItem ) > 0;
     }
 
     void FixupVirtualVias();
@@ -515,6 +517,16 @@ private:
         return m_parent == nullptr;
     }
 
+    static size_t jointShard( const JOINT::HASH_TAG& aTag )
+    {
+        return JOINT_SHARDS::ShardOf( JOINT::JOINT_TAG_HASH()( aTag ) );
+    }
+
+    static size_t itemShard( const ITEM* aItem )
+    {
+        return ITEM_SHARDS::ShardOf( std::hash<const ITEM*>()( aItem ) );
+    }
+
     SEGMENT* findRedundantSegment( const VECTOR2I& A, const VECTOR2I& B, const LAYER_RANGE& lr,
                                    NET_HANDLE aNet );
     SEGMENT* findRedundantSegment( SEGMENT* aSeg );
@@ -532,16 +544,19 @@ private:
     struct DEFAULT_OBSTACLE_VISITOR;
     typedef std::unordered_multimap<JOINT::HASH_TAG, JOINT, JOINT::JOINT_TAG_HASH> JOINT_MAP;
     typedef JOINT_MAP::value_type TagJointPair;
+    typedef COW_SHARDS<JOINT_MAP> JOINT_SHARDS;
+    typedef COW_SHARDS<std::unordered_set<ITEM*>> ITEM_SHARDS;
 
-    JOINT_MAP       m_joints;           ///< hash table with the joints, linking the items. Joints
+    JOINT_SHARDS    m_joints;           ///< hash table with the joints, linking the items. Joints
                                         ///< are hashed by their position, layer set and net.
+                                        ///< Shared with the parent branch until changed.
 
     NODE*           m_parent;           ///< node this node was branched from
     NODE*           m_root;             ///< root node of the whole hierarchy
     std::set<NODE*> m_children;         ///< list of nodes branched from this one
 
-    std::unordered_set<ITEM*> m_override;   ///< hash of root's items that have been changed
-                                            ///< in this node
+    ITEM_SHARDS     m_override;         ///< hash of root's items that have been changed
+                                        ///< in this node
 
     int             m_maxClearance;     ///< worst case item-item clearance
     RULE_RESOLVER*  m_ruleResolver;     ///< Design rules resolver
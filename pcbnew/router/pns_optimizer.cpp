@@ -376,14 +376,14 @@ bool KEEP_TOPOLOGY_CONSTRAINT::Check( int aVertex1, int aVertex2, const LINE* aO
     encPoly.SetClosed( true );
 
     BOX2I bb = encPoly.BBox();
-    std::vector<JOINT*> joints;
+    std::vector<const JOINT*> joints;
 
     int cnt = m_world->QueryJoints( bb, joints, aOriginLine->Layers(), ITEM::SOLID_T );
 
     if( !cnt )
         return true;
 
-    for( JOINT* j : joints )
+    for( const JOINT* j : joints )
     {
         if( j->Net() == aOriginLine->Net() )
             continue;
@@ -0,0 +1,50 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PNS_PERF_COUNTERS_H
+#define __PNS_PERF_COUNTERS_H
+
+#include <core/profile.h>
+
+namespace PNS {
+
+/**
+ * Counts of the router's most expensive operations, for benchmarking.  They are always
+ * kept (the counters are cheap) and only ever reset by whoever is reading them.
+ */
+struct PERF_COUNTERS
+{
+    PROF_COUNTER m_shoveIterations{ "PNS shove iterations" };
+    PROF_COUNTER m_queryColliding{ "PNS NODE::QueryColliding() calls" };
+    PROF_COUNTER m_nodeAllocations{ "PNS NODE allocations" };
+
+    void Reset()
+    {
+        m_shoveIterations.Reset();
+        m_queryColliding.Reset();
+        m_nodeAllocations.Reset();
+    }
+};
+
+
+PERF_COUNTERS& PerfCounters();
+
+}
+
+#endif
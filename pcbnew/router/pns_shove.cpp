@@ -19,8 +19,12 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <array>
+#include <atomic>
 #include <deque>
 #include <cassert>
+#include <future>
+#include <memory>
 #include <math/box2.h>
 
 #include <wx/log.h>
@@ -33,6 +37,7 @@
 #include "pns_shove.h"
 #include "pns_solid.h"
 #include "pns_optimizer.h"
+#include "pns_perf_counters.h"
 #include "pns_via.h"
 #include "pns_utils.h"
 #include "pns_router.h"
@@ -40,10 +45,17 @@
 
 #include "time_limit.h"
 
+#include <advanced_config.h>
+#include <core/thread_pool.h>
+
 // fixme - move all logger calls to debug decorator
 
 typedef VECTOR2I::extended_type ecoord;
 
+// Hull points times obstacle line points below which walking around the hulls is too quick
+// to be worth handing out to other threads
+static constexpr int PARALLEL_SHOVE_MIN_COMPLEXITY = 2048;
+
 namespace PNS {
 
 void SHOVE::replaceItems( ITEM* aOld, std::unique_ptr< ITEM > aNew )
@@ -264,93 +276,203 @@ SHOVE::SHOVE_STATUS SHOVE::shoveLineToHullSet( const LINE& aCurLine, const LINE&
 {
     const SHAPE_LINE_CHAIN& obs = aObstacleLine.CLine();
 
-    int attempt;
+    enum ATTEMPT_RESULT
+    {
+        AR_WALK_FAILED,
+        AR_BAD_ENDS,
+        AR_WRONG_DIRECTION,
+        AR_SELF_INTERSECTING,
+        AR_OK
+    };
 
-    PNS_DBG( Dbg(), BeginGroup, "shove-details", 1 );
+    // The geometric part of each attempt: walk the line around every hull in turn and check
+    // the shape of the result.  This doesn't look at the node, so the attempts can be made
+    // independently of each other.
+    auto walkAttempt =
+            [&]( int aAttempt, LINE& l ) -> ATTEMPT_RESULT
+            {
+                bool invertTraversal = ( aAttempt >= 2 );
+                bool clockwise = aAttempt % 2;
+                int vFirst = -1, vLast = -1;
 
-    for( attempt = 0; attempt < 4; attempt++ )
-    {
-        bool invertTraversal = ( attempt >= 2 );
-        bool clockwise = attempt % 2;
-        int vFirst = -1, vLast = -1;
+                SHAPE_LINE_CHAIN path( l.CLine() );
 
-        LINE l( aObstacleLine );
-        SHAPE_LINE_CHAIN path( l.CLine() );
+                for( int i = 0; i < (int) aHulls.size(); i++ )
+                {
+                    const SHAPE_LINE_CHAIN& hull = aHulls[invertTraversal ? aHulls.size() - 1 - i
+                                                                          : i];
 
-        for( int i = 0; i < (int) aHulls.size(); i++ )
-        {
-            const SHAPE_LINE_CHAIN& hull = aHulls[invertTraversal ? aHulls.size() - 1 - i : i];
+                    PNS_DBG( Dbg(), AddShape, &hull, YELLOW, 10000, wxString::Format( "hull[%d]", i ) );
+                    PNS_DBG( Dbg(), AddShape, &path, WHITE, l.Width(), wxString::Format( "path[%d]", i ) );
+                    PNS_DBG( Dbg(), AddShape, &obs, LIGHTGRAY, aObstacleLine.Width(),  wxString::Format( "obs[%d]", i ) );
 
-            PNS_DBG( Dbg(), AddShape, &hull, YELLOW, 10000, wxString::Format( "hull[%d]", i ) );
-            PNS_DBG( Dbg(), AddShape, &path, WHITE, l.Width(), wxString::Format( "path[%d]", i ) );
-            PNS_DBG( Dbg(), AddShape, &obs, LIGHTGRAY, aObstacleLine.Width(),  wxString::Format( "obs[%d]", i ) );
+                    if( !l.Walkaround( hull, path, clockwise ) )
+                    {
+                        PNS_DBG( Dbg(), Message, wxString::Format( wxT( "Fail-Walk %s %s %d\n" ),
+                                                                   hull.Format().c_str(),
+                                                                   l.CLine().Format().c_str(),
+                                                                   clockwise? 1 : 0) );
+                        return AR_WALK_FAILED;
+                    }
 
-            if( !l.Walkaround( hull, path, clockwise ) )
-            {
-                PNS_DBG( Dbg(), Message, wxString::Format( wxT( "Fail-Walk %s %s %d\n" ),
-                                                           hull.Format().c_str(),
-                                                           l.CLine().Format().c_str(),
-                                                           clockwise? 1 : 0) );
+                    PNS_DBG( Dbg(), AddShape, &path, WHITE, l.Width(), wxString::Format( "path-presimp[%d]", i ) );
 
-                PNS_DBGN( Dbg(), EndGroup );
-                return SH_INCOMPLETE;
-            }
+                    path.Simplify();
 
-            PNS_DBG( Dbg(), AddShape, &path, WHITE, l.Width(), wxString::Format( "path-presimp[%d]", i ) );
+                    PNS_DBG( Dbg(), AddShape, &path, WHITE, l.Width(), wxString::Format( "path-postsimp[%d]", i ) );
 
-            path.Simplify();
+                    l.SetShape( path );
+                }
 
-            PNS_DBG( Dbg(), AddShape, &path, WHITE, l.Width(), wxString::Format( "path-postsimp[%d]", i ) );
+                for( int i = 0; i < std::min( path.PointCount(), obs.PointCount() ); i++ )
+                {
+                    if( path.CPoint( i ) != obs.CPoint( i ) )
+                    {
+                        vFirst = i;
+                        break;
+                    }
+                }
 
-            l.SetShape( path );
-        }
+                int k = obs.PointCount() - 1;
+
+                for( int i = path.PointCount() - 1; i >= 0 && k >= 0; i--, k-- )
+                {
+                    if( path.CPoint( i ) != obs.CPoint( k ) )
+                    {
+                        vLast = i;
+                        break;
+                    }
+                }
+
+                if( ( vFirst < 0 || vLast < 0 ) && !path.CompareGeometry( aObstacleLine.CLine() ) )
+                {
+                    PNS_DBG( Dbg(), Message, wxString::Format( wxT( "attempt %d fail vfirst-last" ),
+                                                               aAttempt ) );
+                    return AR_BAD_ENDS;
+                }
+
+                if( path.CPoint( -1 ) != obs.CPoint( -1 ) || path.CPoint( 0 ) != obs.CPoint( 0 ) )
+                {
+                    PNS_DBG( Dbg(), Message, wxString::Format( wxT( "attempt %d fail vend-start\n" ),
+                                                               aAttempt ) );
+                    return AR_BAD_ENDS;
+                }
+
+                if( !checkShoveDirection( aCurLine, aObstacleLine, l ) )
+                {
+                    PNS_DBG( Dbg(), Message, wxString::Format( wxT( "attempt %d fail direction-check" ),
+                                                               aAttempt ) );
+                    return AR_WRONG_DIRECTION;
+                }
+
+                if( path.SelfIntersecting() )
+                {
+                    PNS_DBG( Dbg(), Message, wxString::Format( wxT( "attempt %d fail self-intersect" ),
+                                                               aAttempt ) );
+                    return AR_SELF_INTERSECTING;
+                }
+
+                return AR_OK;
+            };
+
+    // Attempts handed to the thread pool.  Whichever thread claims an attempt first makes it,
+    // so the calling thread never waits for a worker that hasn't started yet.
+    struct SPECULATIVE_ATTEMPTS
+    {
+        std::array<std::atomic<bool>, 4>            m_claimed = {};
+        std::array<std::promise<ATTEMPT_RESULT>, 4> m_results;
+    };
+
+    std::vector<LINE>                          lines( 4, aObstacleLine );
+    std::shared_ptr<SPECULATIVE_ATTEMPTS>      pending;
+    std::array<std::future<ATTEMPT_RESULT>, 4> returns;
+    std::array<bool, 4>                        claimedHere = {};
+
+    // When it's worth it, offer the other attempts to the thread pool while this thread makes
+    // the first one.  The debug decorator isn't thread-safe, so never do this while it's
+    // recording.
+    if( ADVANCED_CFG::GetCfg().m_ParallelShove && !( Dbg() && Dbg()->IsDebugEnabled() ) )
+    {
+        int hullPoints = 0;
+
+        for( const SHAPE_LINE_CHAIN& hull : aHulls )
+            hullPoints += hull.PointCount();
 
-        for( int i = 0; i < std::min( path.PointCount(), obs.PointCount() ); i++ )
+        if( hullPoints * obs.PointCount() >= PARALLEL_SHOVE_MIN_COMPLEXITY )
+            pending = std::make_shared<SPECULATIVE_ATTEMPTS>();
+    }
+
+    if( pending )
+    {
+        thread_pool& tp = GetKiCadThreadPool();
+
+        for( int attempt = 1; attempt < 4; attempt++ )
         {
-            if( path.CPoint( i ) != obs.CPoint( i ) )
-            {
-                vFirst = i;
-                break;
-            }
+            returns[attempt] = pending->m_results[attempt].get_future();
+
+            // A task still queued after this call has returned finds its attempt claimed and
+            // does nothing, so it never touches the lines or hulls
+            tp.push_task(
+                    [pending, attempt, &walkAttempt, &lines]()
+                    {
+                        if( !pending->m_claimed[attempt].exchange( true ) )
+                        {
+                            pending->m_results[attempt].set_value(
+                                    walkAttempt( attempt, lines[attempt] ) );
+                        }
+                    } );
         }
+    }
 
-        int k = obs.PointCount() - 1;
+    auto attemptResult =
+            [&]( int aAttempt ) -> ATTEMPT_RESULT
+            {
+                if( !pending || !pending->m_claimed[aAttempt].exchange( true ) )
+                {
+                    claimedHere[aAttempt] = true;
+                    return walkAttempt( aAttempt, lines[aAttempt] );
+                }
 
-        for( int i = path.PointCount() - 1; i >= 0 && k >= 0; i--, k-- )
-        {
-            if( path.CPoint( i ) != obs.CPoint( k ) )
+                return returns[aAttempt].get();
+            };
+
+    // Keep workers from starting attempts that are no longer needed, and wait for the ones
+    // already under way, which still use the lines and hulls
+    auto finish =
+            [&]( SHOVE_STATUS aStatus ) -> SHOVE_STATUS
             {
-                vLast = i;
-                break;
-            }
-        }
+                for( int attempt = 1; pending && attempt < 4; attempt++ )
+                {
+                    if( !pending->m_claimed[attempt].exchange( true ) )
+                        claimedHere[attempt] = true;
+                    else if( !claimedHere[attempt] && returns[attempt].valid() )
+                        returns[attempt].wait();
+                }
 
-        if( ( vFirst < 0 || vLast < 0 ) && !path.CompareGeometry( aObstacleLine.CLine() ) )
-        {
-            PNS_DBG( Dbg(), Message, wxString::Format( wxT( "attempt %d fail vfirst-last" ),
-                                                       attempt ) );
-            continue;
-        }
+                PNS_DBGN( Dbg(), EndGroup );
+                return aStatus;
+            };
+
+    PNS_DBG( Dbg(), BeginGroup, "shove-details", 1 );
+
+    // Collision checks use the node and the rule resolver's caches, so they are always made
+    // here, in the order the attempts would have been made one after another.
+    for( int attempt = 0; attempt < 4; attempt++ )
+    {
+        LINE&          l = lines[attempt];
+        ATTEMPT_RESULT result = attemptResult( attempt );
 
-        if( path.CPoint( -1 ) != obs.CPoint( -1 ) || path.CPoint( 0 ) != obs.CPoint( 0 ) )
+        if( result == AR_WALK_FAILED )
         {
-            PNS_DBG( Dbg(), Message, wxString::Format( wxT( "attempt %d fail vend-start\n" ),
-                                                       attempt ) );
-            continue;
+            return finish( SH_INCOMPLETE );
         }
-
-        if( !checkShoveDirection( aCurLine, aObstacleLine, l ) )
+        else if( result == AR_WRONG_DIRECTION )
         {
-            PNS_DBG( Dbg(), Message, wxString::Format( wxT( "attempt %d fail direction-check" ),
-                                                       attempt ) );
             aResultLine.SetShape( l.CLine() );
             continue;
         }
-
-        if( path.SelfIntersecting() )
+        else if( result != AR_OK )
         {
-            PNS_DBG( Dbg(), Message, wxString::Format( wxT( "attempt %d fail self-intersect" ),
-                                                       attempt ) );
             continue;
         }
 
@@ -376,14 +498,10 @@ SHOVE::SHOVE_STATUS SHOVE::shoveLineToHullSet( const LINE& aCurLine, const LINE&
 
         aResultLine.SetShape( l.CLine() );
 
-        PNS_DBGN( Dbg(), EndGroup );
-
-        return SH_OK;
+        return finish( SH_OK );
     }
 
-    PNS_DBGN( Dbg(), EndGroup );
-
-    return SH_INCOMPLETE;
+    return finish( SH_INCOMPLETE );
 }
 
 
@@ -1518,6 +1636,7 @@ SHOVE::SHOVE_STATUS SHOVE::shoveMainLoop()
         st = shoveIteration( m_iter );
 
         m_iter++;
+        PerfCounters().m_shoveIterations++;
 
         if( st == SH_INCOMPLETE || timeLimit.Expired() || m_iter >= iterLimit )
         {
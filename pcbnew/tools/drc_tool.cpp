@@ -35,7 +35,9 @@
 #include <progress_reporter.h>
 #include <drc/drc_engine.h>
 #include <drc/drc_item.h>
+#include <drc/drc_result_cache.h>
 #include <netlist_reader/pcb_netlist.h>
+#include <advanced_config.h>
 #include <macros.h>
 
 DRC_TOOL::DRC_TOOL() :
@@ -178,11 +180,30 @@ void DRC_TOOL::RunTests( PROGRESS_REPORTER* aProgressReporter, bool aRefillZones
                 commit.Add( marker );
             } );
 
+    DRC_RESULT_CACHE resultCache;
+    wxString         resultCacheFile;
+
+    if( ADVANCED_CFG::GetCfg().m_DRCResultCache && !m_pcb->GetFileName().IsEmpty() )
+    {
+        resultCacheFile = DRC_RESULT_CACHE::GetCacheFilename( m_pcb );
+        resultCache.Load( resultCacheFile );
+        m_drcEngine->SetResultCache( &resultCache );
+    }
+
     m_drcEngine->RunTests( m_editFrame->GetUserUnits(), aReportAllTrackErrors, aTestFootprints );
 
     m_drcEngine->SetProgressReporter( nullptr );
     m_drcEngine->ClearViolationHandler();
 
+    if( m_drcEngine->GetResultCache() )
+    {
+        m_drcEngine->SetResultCache( nullptr );
+
+        // A cancelled run only knows about some of the clean pairs
+        if( !aProgressReporter || !aProgressReporter->IsCancelled() )
+            resultCache.Save( resultCacheFile );
+    }
+
     if( m_drcDialog )
     {
         m_drcDialog->SetDrcRun();
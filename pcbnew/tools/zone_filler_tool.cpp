@@ -25,6 +25,7 @@
 #include <cstdint>
 #include <thread>
 #include <zone.h>
+#include <advanced_config.h>
 #include <connectivity/connectivity_data.h>
 #include <board_commit.h>
 #include <footprint.h>
@@ -60,6 +61,13 @@ ZONE_FILLER_TOOL::~ZONE_FILLER_TOOL()
 
 void ZONE_FILLER_TOOL::Reset( RESET_REASON aReason )
 {
+    if( aReason == MODEL_RELOAD )
+    {
+        m_dirtyZoneIDs.clear();
+        m_fullRefillZoneIDs.clear();
+        m_dirtyZoneAreas.clear();
+        m_fillCache.Clear();
+    }
 }
 
 
@@ -80,6 +88,9 @@ void ZONE_FILLER_TOOL::CheckAllZones( wxWindow* aCaller, PROGRESS_REPORTER* aRep
 
     m_filler = std::make_unique<ZONE_FILLER>( frame()->GetBoard(), &commit );
 
+    if( ADVANCED_CFG::GetCfg().m_IncrementalZoneFill )
+        m_filler->SetIncrementalFill( &m_fillCache );
+
     if( aReporter )
     {
         m_filler->SetProgressReporter( aReporter );
@@ -137,6 +148,9 @@ void ZONE_FILLER_TOOL::FillAllZones( wxWindow* aCaller, PROGRESS_REPORTER* aRepo
 
     m_filler = std::make_unique<ZONE_FILLER>( board(), &commit );
 
+    if( ADVANCED_CFG::GetCfg().m_IncrementalZoneFill )
+        m_filler->SetIncrementalFill( &m_fillCache );
+
     if( !board()->GetDesignSettings().m_DRCEngine->RulesValid() )
     {
         WX_INFOBAR* infobar = frame->GetInfoBar();
@@ -196,13 +210,23 @@ void ZONE_FILLER_TOOL::FillAllZones( wxWindow* aCaller, PROGRESS_REPORTER* aRepo
 
 int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
 {
-    PCB_EDIT_FRAME*    frame = getEditFrame<PCB_EDIT_FRAME>();
-    std::vector<ZONE*> toFill;
+    PCB_EDIT_FRAME*                   frame = getEditFrame<PCB_EDIT_FRAME>();
+    std::vector<ZONE*>                toFill;
+    std::map<ZONE*, ZONE_DIRTY_AREAS> dirtyAreas;
 
     for( ZONE* zone : board()->Zones() )
     {
         if( !zone->IsFilled() || m_dirtyZoneIDs.count( zone->m_Uuid ) )
+        {
             toFill.push_back( zone );
+
+            // Zones which only need refilling around the changes can be filled incrementally
+            if( zone->IsFilled() && !m_fullRefillZoneIDs.count( zone->m_Uuid )
+                    && m_dirtyZoneAreas.count( zone->m_Uuid ) )
+            {
+                dirtyAreas[ zone ] = m_dirtyZoneAreas.at( zone->m_Uuid );
+            }
+        }
     }
 
     if( toFill.empty() )
@@ -215,6 +239,8 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
     m_fillInProgress = true;
 
     m_dirtyZoneIDs.clear();
+    m_fullRefillZoneIDs.clear();
+    m_dirtyZoneAreas.clear();
 
     board()->IncrementTimeStamp();    // Clear caches
 
@@ -224,6 +250,9 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
 
     m_filler = std::make_unique<ZONE_FILLER>( board(), &commit );
 
+    if( ADVANCED_CFG::GetCfg().m_IncrementalZoneFill )
+        m_filler->SetIncrementalFill( &m_fillCache, dirtyAreas );
+
     if( !board()->GetDesignSettings().m_DRCEngine->RulesValid() )
     {
         WX_INFOBAR* infobar = frame->GetInfoBar();
@@ -347,6 +376,9 @@ int ZONE_FILLER_TOOL::ZoneFill( const TOOL_EVENT& aEvent )
 
     m_filler = std::make_unique<ZONE_FILLER>( board(), &commit );
 
+    if( ADVANCED_CFG::GetCfg().m_IncrementalZoneFill )
+        m_filler->SetIncrementalFill( &m_fillCache );
+
     reporter = std::make_unique<WX_PROGRESS_REPORTER>( frame(), _( "Fill Zone" ), 5 );
     m_filler->SetProgressReporter( reporter.get() );
 
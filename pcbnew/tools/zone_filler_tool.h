@@ -29,12 +29,12 @@
 
 #include <tools/pcb_tool_base.h>
 #include <zone.h>
+#include <zone_filler.h>
 
 
 class PCB_EDIT_FRAME;
 class PROGRESS_REPORTER;
 class WX_PROGRESS_REPORTER;
-class ZONE_FILLER;
 
 
 /**
@@ -62,9 +62,24 @@ public:
 
     PROGRESS_REPORTER* GetProgressReporter();
 
+    /**
+     * Mark a zone as needing to be refilled in its entirety (for instance, because its outline
+     * or properties have changed).
+     */
     void DirtyZone( ZONE* aZone )
     {
         m_dirtyZoneIDs.insert( aZone->m_Uuid );
+        m_fullRefillZoneIDs.insert( aZone->m_Uuid );
+    }
+
+    /**
+     * Mark a zone as needing to be refilled because something within \a aArea on \a aLayers
+     * has changed.
+     */
+    void DirtyZoneArea( ZONE* aZone, const BOX2I& aArea, const LSET& aLayers )
+    {
+        m_dirtyZoneIDs.insert( aZone->m_Uuid );
+        m_dirtyZoneAreas[ aZone->m_Uuid ].emplace_back( aArea, aLayers );
     }
 
     static bool IsZoneFillAction( const TOOL_EVENT* aEvent );
@@ -84,6 +99,10 @@ private:
     bool                         m_fillInProgress;
 
     std::set<KIID>               m_dirtyZoneIDs;
+    std::set<KIID>               m_fullRefillZoneIDs;
+    std::map<KIID, ZONE_DIRTY_AREAS> m_dirtyZoneAreas;
+
+    ZONE_FILL_CACHE              m_fillCache;        // previous fills for incremental refilling
 };
 
 #endif
@@ -26,6 +26,7 @@
 #define ZONE_H
 
 
+#include <memory>
 #include <mutex>
 #include <vector>
 #include <gr_basic.h>
@@ -43,6 +44,7 @@ class PCB_EDIT_FRAME;
 class BOARD;
 class ZONE;
 class MSG_PANEL_ITEM;
+class ZONE_OUTLINE_INDEX;
 
 
 /**
@@ -55,11 +57,15 @@ class MSG_PANEL_ITEM;
  * Single-connection outlines are those with a *direct* connection to only a single item.  These
  * participate in thermal spoke counting as a pad spoke to an *otherwise* unconnected island
  * provides no connectivity to the pad.
+ *
+ * With the ZoneAdjacencyIndex advanced setting, the outline index records the bounding box of
+ * each outline and the items it touches.  It is shared between copies.
  */
 struct ISOLATED_ISLANDS
 {
-    std::vector<int> m_IsolatedOutlines;
-    std::vector<int> m_SingleConnectionOutlines;
+    std::vector<int>                    m_IsolatedOutlines;
+    std::vector<int>                    m_SingleConnectionOutlines;
+    std::shared_ptr<ZONE_OUTLINE_INDEX> m_OutlineIndex;
 };
 
 
@@ -39,16 +39,19 @@
 #include <pcb_table.h>
 #include <pcb_dimension.h>
 #include <connectivity/connectivity_data.h>
+#include <connectivity/zone_outline_index.h>
 #include <convert_basic_shapes_to_polygon.h>
 #include <board_commit.h>
 #include <progress_reporter.h>
 #include <geometry/shape_poly_set.h>
+#include <geometry/shape_rect.h>
 #include <geometry/convex_hull.h>
 #include <geometry/geometry_utils.h>
 #include <geometry/vertex_set.h>
 #include <kidialog.h>
 #include <core/thread_pool.h>
 #include <math/util.h>      // for KiROUND
+#include <trigo.h>
 #include "zone_filler.h"
 
 // Helper classes for connect_nearby_polys
@@ -197,7 +200,11 @@ ZONE_FILLER::ZONE_FILLER(  BOARD* aBoard, COMMIT* aCommit ) :
         m_commit( aCommit ),
         m_progressReporter( nullptr ),
         m_maxError( ARC_HIGH_DEF ),
-        m_worstClearance( 0 )
+        m_worstClearance( 0 ),
+        m_worstThermalGap( 0 ),
+        m_fillCache( nullptr ),
+        m_incrementalRefills( 0 ),
+        m_tiledZones( 0 )
 {
     // To enable add "DebugZoneFiller=1" to kicad_advanced settings file.
     m_debugZoneFiller = ADVANCED_CFG::GetCfg().m_DebugZoneFiller;
@@ -235,13 +242,32 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
     std::map<std::pair<ZONE*, PCB_LAYER_ID>, HASH_128>        oldFillHashes;
     std::map<ZONE*, std::map<PCB_LAYER_ID, ISOLATED_ISLANDS>> isolatedIslandsMap;
 
+    // Fills as they come out of fillSingleZone(), for the incremental fill cache
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, SHAPE_POLY_SET>      rawFills;
+
+    // Zone layers which are only to be refilled within the given areas
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, std::vector<BOX2I>>  refillAreas;
+
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
 
     // Rebuild (from scratch, ignoring dirty flags) just in case. This really needs to be reliable.
     connectivity->ClearRatsnest();
     connectivity->Build( m_board, m_progressReporter );
 
+    BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+    DRC_CONSTRAINT         worstThermalConstraint;
+
     m_worstClearance = m_board->GetMaxClearanceValue();
+    m_maxError = bds.m_MaxError;
+    m_worstThermalGap = 0;
+    m_incrementalRefills = 0;
+    m_tiledZones = 0;
+
+    if( bds.m_DRCEngine->QueryWorstConstraint( THERMAL_RELIEF_GAP_CONSTRAINT,
+                                               worstThermalConstraint ) )
+    {
+        m_worstThermalGap = worstThermalConstraint.GetValue().Min();
+    }
 
     if( m_progressReporter )
     {
@@ -270,6 +296,8 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                 pad->BuildEffectiveShapes( UNDEFINED_LAYER );
                 pad->BuildEffectivePolygon( ERROR_OUTSIDE );
             }
+
+            m_worstThermalGap = std::max( m_worstThermalGap, pad->GetThermalGap() );
         }
 
         for( ZONE* zone : footprint->Zones() )
@@ -464,12 +492,18 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
             toFill.emplace_back( std::make_pair( zone, layer ) );
 
             isolatedIslandsMap[ zone ][ layer ] = ISOLATED_ISLANDS();
+
+            if( m_fillCache )
+                rawFills[ { zone, layer } ] = SHAPE_POLY_SET();
         }
 
         // Remove existing fill first to prevent drawing invalid polygons on some platforms
         zone->UnFill();
     }
 
+    if( m_fillCache && !aCheck )
+        buildRefillAreas( aZones, oldFillHashes, refillAreas );
+
     auto check_fill_dependency =
             [&]( ZONE* aZone, PCB_LAYER_ID aLayer, ZONE* aOtherZone ) -> bool
             {
@@ -512,27 +546,30 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                 return aZone->Outline()->Collide( aOtherZone->Outline(), m_worstClearance );
             };
 
-    auto fill_lambda =
-            [&]( std::pair<ZONE*, PCB_LAYER_ID> aFillItem ) -> int
+    auto has_fill_dependencies =
+            [&]( ZONE* aZone, PCB_LAYER_ID aLayer ) -> bool
             {
-                PCB_LAYER_ID layer = aFillItem.second;
-                ZONE*        zone = aFillItem.first;
-                bool         canFill = true;
-
                 // Check for any fill dependencies.  If our zone needs to be clipped by
                 // another zone then we can't fill until that zone is filled.
                 for( ZONE* otherZone : aZones )
                 {
-                    if( otherZone == zone )
+                    if( otherZone == aZone )
                         continue;
 
-                    if( check_fill_dependency( zone, layer, otherZone ) )
-                    {
-                        canFill = false;
-                        break;
-                    }
+                    if( check_fill_dependency( aZone, aLayer, otherZone ) )
+                        return true;
                 }
 
+                return false;
+            };
+
+    auto fill_lambda =
+            [&]( std::pair<ZONE*, PCB_LAYER_ID> aFillItem ) -> int
+            {
+                PCB_LAYER_ID layer = aFillItem.second;
+                ZONE*        zone = aFillItem.first;
+                bool         canFill = !has_fill_dependencies( zone, layer );
+
                 if( m_progressReporter && m_progressReporter->IsCancelled() )
                     return 0;
 
@@ -546,12 +583,20 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                     if( !zoneLock.owns_lock() )
                         return 0;
 
-                    SHAPE_POLY_SET fillPolys;
+                    SHAPE_POLY_SET            fillPolys;
+                    const std::vector<BOX2I>* areas = nullptr;
 
-                    if( !fillSingleZone( zone, layer, fillPolys ) )
+                    if( refillAreas.count( aFillItem ) )
+                        areas = &refillAreas.at( aFillItem );
+
+                    if( !fillSingleZone( zone, layer, fillPolys, areas ) )
                         return 0;
 
                     zone->SetFilledPolysList( layer, fillPolys );
+
+                    // NB: the entry already exists, so this doesn't modify the map itself
+                    if( m_fillCache )
+                        rawFills.at( aFillItem ) = std::move( fillPolys );
                 }
 
                 if( m_progressReporter )
@@ -582,27 +627,191 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                 return 1;
             };
 
+    thread_pool& tp = GetKiCadThreadPool();
+
+    // If there are fewer zone layers than threads then split the large copper ones into tiles
+    // so that the remaining threads have something to do.  Each tile is filled independently
+    // (with enough overlap that the result is the same as an untiled fill), and the tiles are
+    // then stitched back together in place of the usual fill step.
+    std::vector<std::pair<size_t, BOX2I>> tiles;          // fill item index, tile area
+    std::vector<SHAPE_POLY_SET>           tileFills;
+    std::vector<size_t>                   pendingTiles( toFill.size(), 0 );
+    std::map<size_t, std::pair<SHAPE_POLY_SET, SHAPE_POLY_SET>> tiledOutlines;
+
+    if( ADVANCED_CFG::GetCfg().m_ZoneFillTiling && !m_debugZoneFiller && !aCheck
+            && !toFill.empty() && toFill.size() < tp.get_thread_count() )
+    {
+        int tileCount = (int) ( 2 * tp.get_thread_count() / toFill.size() );
+
+        for( size_t ii = 0; ii < toFill.size(); ++ii )
+        {
+            auto [ zone, layer ] = toFill[ii];
+
+            if( !zone->IsOnCopperLayer() || zone->IsTeardropArea()
+                    || zone->GetFillMode() == ZONE_FILL_MODE::HATCH_PATTERN
+                    || refillAreas.count( toFill[ii] ) )
+            {
+                continue;
+            }
+
+            std::vector<BOX2I> areas;
+            buildFillTiles( zone, tileCount, areas );
+
+            if( areas.empty() )
+                continue;
+
+            SHAPE_POLY_SET* boardOutline = m_brdOutlinesValid ? &m_boardOutline : nullptr;
+            SHAPE_POLY_SET  maxExtents;
+            SHAPE_POLY_SET  smoothedPoly;
+
+            if( !zone->BuildSmoothedPoly( maxExtents, layer, boardOutline, &smoothedPoly ) )
+                continue;
+
+            tiledOutlines[ii] = std::make_pair( std::move( smoothedPoly ), std::move( maxExtents ) );
+
+            for( const BOX2I& area : areas )
+                tiles.emplace_back( ii, area );
+
+            pendingTiles[ii] = areas.size();
+        }
+
+        tileFills.resize( tiles.size() );
+    }
+
+    auto tile_lambda =
+            [&]( size_t aTile ) -> int
+            {
+                size_t       item = tiles[aTile].first;
+                ZONE*        zone = toFill[item].first;
+                PCB_LAYER_ID layer = toFill[item].second;
+
+                if( m_progressReporter && m_progressReporter->IsCancelled() )
+                    return 0;
+
+                if( has_fill_dependencies( zone, layer ) )
+                    return 0;
+
+                const std::pair<SHAPE_POLY_SET, SHAPE_POLY_SET>& outlines = tiledOutlines.at( item );
+
+                if( !fillCopperZoneWindow( zone, layer, outlines.first, outlines.second,
+                                           tiles[aTile].second, tileFills[aTile] ) )
+                {
+                    return 0;
+                }
+
+                return 1;
+            };
+
+    auto stitch_lambda =
+            [&]( size_t aItem ) -> int
+            {
+                ZONE*        zone = toFill[aItem].first;
+                PCB_LAYER_ID layer = toFill[aItem].second;
+
+                if( m_progressReporter && m_progressReporter->IsCancelled() )
+                    return 0;
+
+                std::unique_lock<std::mutex> zoneLock( zone->GetLock(), std::try_to_lock );
+
+                if( !zoneLock.owns_lock() )
+                    return 0;
+
+                SHAPE_POLY_SET     fillPolys;
+                std::vector<BOX2I> areas;
+
+                for( size_t ii = 0; ii < tiles.size(); ++ii )
+                {
+                    if( tiles[ii].first == aItem )
+                    {
+                        fillPolys.Append( tileFills[ii] );
+                        areas.push_back( tiles[ii].second );
+                    }
+                }
+
+                // Neighbouring tiles overlap by a sliver; merge them back into single polygons,
+                // and then drop the vertices the tile edges left along the seams.
+                fillPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
+                mergeSpliceVertices( fillPolys, areas );
+                fillPolys.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+                zone->SetNeedRefill( false );
+                zone->SetFilledPolysList( layer, fillPolys );
+                m_tiledZones++;
+
+                // NB: the entry already exists, so this doesn't modify the map itself
+                if( m_fillCache )
+                    rawFills.at( toFill[aItem] ) = std::move( fillPolys );
+
+                if( m_progressReporter )
+                    m_progressReporter->AdvanceProgress();
+
+                return 1;
+            };
+
     // Calculate the copper fills (NB: this is multi-threaded)
     //
+    // The first toFill.size() entries are the fill items themselves, which go through a fill
+    // (or stitch) step and then a tessellation step.  They're followed by a single-step entry
+    // for each tile.
     std::vector<std::pair<std::future<int>, int>> returns;
-    returns.reserve( toFill.size() );
+    returns.reserve( toFill.size() + tiles.size() );
     size_t finished = 0;
     bool cancelled = false;
 
-    thread_pool& tp = GetKiCadThreadPool();
+    for( size_t ii = 0; ii < toFill.size(); ++ii )
+    {
+        // Tiled items don't get queued until all their tiles are done
+        if( pendingTiles[ii] )
+            returns.emplace_back( std::make_pair( std::future<int>(), 0 ) );
+        else
+            returns.emplace_back( std::make_pair( tp.submit( fill_lambda, toFill[ii] ), 0 ) );
+    }
 
-    for( const std::pair<ZONE*, PCB_LAYER_ID>& fillItem : toFill )
-        returns.emplace_back( std::make_pair( tp.submit( fill_lambda, fillItem ), 0 ) );
+    for( size_t ii = 0; ii < tiles.size(); ++ii )
+        returns.emplace_back( std::make_pair( tp.submit( tile_lambda, ii ), 0 ) );
 
-    while( !cancelled && finished != 2 * toFill.size() )
+    while( !cancelled && finished != 2 * toFill.size() + tiles.size() )
     {
         for( size_t ii = 0; ii < returns.size(); ++ii )
         {
             auto& ret = returns[ii];
 
+            if( ii >= toFill.size() )
+            {
+                if( ret.second > 0 )
+                    continue;
+
+                if( ret.first.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+                    continue;
+
+                size_t tile = ii - toFill.size();
+
+                if( ret.first.get() )
+                {
+                    ++finished;
+                    ret.second++;
+
+                    if( --pendingTiles[ tiles[tile].first ] == 0 && !cancelled )
+                    {
+                        size_t item = tiles[tile].first;
+                        returns[item].first = tp.submit( stitch_lambda, item );
+                    }
+                }
+                else if( !cancelled )
+                {
+                    ret.first = tp.submit( tile_lambda, tile );
+                }
+
+                continue;
+            }
+
             if( ret.second > 1 )
                 continue;
 
+            // Tiled item still waiting on its tiles
+            if( !ret.first.valid() )
+                continue;
+
             std::future_status status = ret.first.wait_for( std::chrono::seconds( 0 ) );
 
             if( status == std::future_status::ready )
@@ -616,7 +825,9 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                 if( !cancelled )
                 {
                     // Queue the next step (will re-queue the existing step if it didn't complete)
-                    if( ret.second == 0 )
+                    if( ret.second == 0 && tiledOutlines.count( ii ) )
+                        returns[ii].first = tp.submit( stitch_lambda, ii );
+                    else if( ret.second == 0 )
                         returns[ii].first = tp.submit( fill_lambda, toFill[ii] );
                     else if( ret.second == 1 )
                         returns[ii].first = tp.submit( tesselate_lambda, toFill[ii] );
@@ -721,19 +932,27 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
             std::shared_ptr<SHAPE_POLY_SET> poly = zone->GetFilledPolysList( layer );
             long long int                   minArea = zone->GetMinIslandArea();
             ISLAND_REMOVAL_MODE             mode = zone->GetIslandRemovalMode();
+            std::vector<int>                deleted;
 
             for( int idx : islands )
             {
                 SHAPE_LINE_CHAIN& outline = poly->Outline( idx );
 
                 if( mode == ISLAND_REMOVAL_MODE::ALWAYS )
-                    poly->DeletePolygonAndTriangulationData( idx, false );
+                    deleted.push_back( idx );
                 else if ( mode == ISLAND_REMOVAL_MODE::AREA && outline.Area( true ) < minArea )
-                    poly->DeletePolygonAndTriangulationData( idx, false );
+                    deleted.push_back( idx );
                 else
                     zone->SetIsIsland( layer, idx );
             }
 
+            for( int idx : deleted )
+                poly->DeletePolygonAndTriangulationData( idx, false );
+
+            // Keep the outline index in step with the fill
+            if( layerIslands.m_OutlineIndex )
+                layerIslands.m_OutlineIndex->RemoveOutlines( deleted );
+
             poly->UpdateTriangulationDataHash();
             zone->CalculateFilledArea();
 
@@ -744,9 +963,17 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
 
     // Now remove islands which are either outside the board edge or fail to meet the minimum
     // area requirements
-    using island_check_return = std::vector<std::pair<std::shared_ptr<SHAPE_POLY_SET>, int>>;
+    struct ISLAND_CHECK
+    {
+        std::shared_ptr<SHAPE_POLY_SET> m_Fill;
+        ZONE_OUTLINE_INDEX*             m_Index;        // optional
+        double                          m_MinArea;
+    };
+
+    // The index into polys_to_check, and the outline to delete
+    using island_check_return = std::vector<std::pair<size_t, int>>;
 
-    std::vector<std::pair<std::shared_ptr<SHAPE_POLY_SET>, double>> polys_to_check;
+    std::vector<ISLAND_CHECK> polys_to_check;
 
     // rough estimate to save re-allocation time
     polys_to_check.reserve( m_board->GetCopperLayerCount() * aZones.size() );
@@ -768,10 +995,36 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
             if( m_debugZoneFiller && LSET::InternalCuMask().Contains( layer ) )
                 continue;
 
-            polys_to_check.emplace_back( zone->GetFilledPolysList( layer ), minArea );
+            std::shared_ptr<SHAPE_POLY_SET> fill = zone->GetFilledPolysList( layer );
+            ZONE_OUTLINE_INDEX*             index = nullptr;
+            auto                            zoneIter = isolatedIslandsMap.find( zone );
+
+            if( zoneIter != isolatedIslandsMap.end() && zoneIter->second.count( layer ) )
+                index = zoneIter->second.at( layer ).m_OutlineIndex.get();
+
+            if( index && index->OutlineCount() != fill->OutlineCount() )
+                index = nullptr;
+
+            polys_to_check.push_back( { fill, index, minArea } );
         }
     }
 
+    BOX2I boardBBox = m_boardOutline.BBox();
+
+    // An outline whose bounding box no board edge crosses lies either entirely inside the board
+    // or entirely outside it
+    auto insideBoard =
+            [&]( const BOX2I& aBBox ) -> bool
+            {
+                for( auto it = m_boardOutline.CIterateSegmentsWithHoles(); it; it++ )
+                {
+                    if( aBBox.Intersects( ( *it ).A, ( *it ).B ) )
+                        return false;
+                }
+
+                return m_boardOutline.Contains( aBBox.GetOrigin() );
+            };
+
     auto island_lambda =
             [&]( int aStart, int aEnd ) -> island_check_return
             {
@@ -779,18 +1032,33 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
 
                 for( int ii = aStart; ii < aEnd && !cancelled; ++ii )
                 {
-                    auto [poly, minArea] = polys_to_check[ii];
+                    const ISLAND_CHECK& check = polys_to_check[ii];
+                    const SHAPE_POLY_SET& poly = *check.m_Fill;
 
-                    for( int jj = poly->OutlineCount() - 1; jj >= 0; jj-- )
+                    for( int jj = poly.OutlineCount() - 1; jj >= 0; jj-- )
                     {
                         SHAPE_POLY_SET island;
                         SHAPE_POLY_SET intersection;
-                        const SHAPE_LINE_CHAIN& test_poly = poly->Polygon( jj ).front();
+                        const SHAPE_LINE_CHAIN& test_poly = poly.CPolygon( jj ).front();
                         double island_area = test_poly.Area();
 
-                        if( island_area < minArea )
+                        if( island_area < check.m_MinArea )
                             continue;
 
+                        // The index settles most outlines from their bounding boxes alone
+                        if( check.m_Index )
+                        {
+                            const BOX2I& bbox = check.m_Index->GetBBox( jj );
+
+                            if( !boardBBox.Intersects( bbox ) )
+                            {
+                                retval.emplace_back( ii, jj );
+                                continue;
+                            }
+
+                            if( insideBoard( bbox ) )
+                                continue;
+                        }
 
                         island.AddOutline( test_poly );
                         intersection.BooleanIntersection( m_boardOutline, island,
@@ -802,7 +1070,7 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                         // slight overlap at the edges, so testing against half-size area acts as
                         // a fail-safe.
                         if( intersection.Area() < island_area / 2.0 )
-                            retval.emplace_back( poly, jj );
+                            retval.emplace_back( ii, jj );
                     }
                 }
 
@@ -839,17 +1107,28 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
     if( cancelled )
         return false;
 
+    std::vector<std::vector<int>> deletions( polys_to_check.size() );
+
     for( size_t ii = 0; ii < island_returns.size(); ++ii )
     {
         std::future<island_check_return>& ret = island_returns[ii];
 
         if( ret.valid() )
         {
-            for( auto& action_item : ret.get() )
-                action_item.first->DeletePolygonAndTriangulationData( action_item.second, true );
+            for( auto& [ check, outline ] : ret.get() )
+            {
+                polys_to_check[check].m_Fill->DeletePolygonAndTriangulationData( outline, true );
+                deletions[check].push_back( outline );
+            }
         }
     }
 
+    for( size_t ii = 0; ii < polys_to_check.size(); ++ii )
+    {
+        if( polys_to_check[ii].m_Index )
+            polys_to_check[ii].m_Index->RemoveOutlines( deletions[ii] );
+    }
+
     for( ZONE* zone : aZones )
         zone->CalculateFilledArea();
 
@@ -891,6 +1170,24 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
         }
     }
 
+    if( m_fillCache )
+    {
+        for( auto& [ fillItem, rawFill ] : rawFills )
+        {
+            auto& [ zone, layer ] = fillItem;
+            ZONE_FILL_CACHE::ENTRY entry;
+
+            zone->BuildHashValue( layer );
+
+            entry.m_RawFill = std::move( rawFill );
+            entry.m_FillHash = zone->GetHashValue( layer );
+            entry.m_WorstClearance = m_worstClearance;
+            entry.m_MaxError = m_maxError;
+
+            m_fillCache->Store( zone, layer, std::move( entry ) );
+        }
+    }
+
     if( m_progressReporter )
     {
         if( m_progressReporter->IsCancelled() )
@@ -1010,7 +1307,7 @@ void ZONE_FILLER::addKnockout( BOARD_ITEM* aItem, PCB_LAYER_ID aLayer, int aGap,
  * in spokes, which must be done later.
  */
 void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer,
-                                          SHAPE_POLY_SET& aFill,
+                                          const BOX2I& aExtents, SHAPE_POLY_SET& aFill,
                                           std::vector<PAD*>& aThermalConnectionPads,
                                           std::vector<PAD*>& aNoConnectionPads )
 {
@@ -1029,7 +1326,7 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer
             BOX2I padBBox = pad->GetBoundingBox();
             padBBox.Inflate( m_worstClearance );
 
-            if( !padBBox.Intersects( aZone->GetBoundingBox() ) )
+            if( !padBBox.Intersects( aExtents ) )
                 continue;
 
             bool noConnection = pad->GetNetCode() != aZone->GetNetCode();
@@ -1124,6 +1421,7 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer
  * not connected to it.
  */
 void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                             const BOX2I& aExtents,
                                              const std::vector<PAD*>& aNoConnectionPads,
                                              SHAPE_POLY_SET& aHoles )
 {
@@ -1139,9 +1437,13 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
     // A small extra clearance to be sure actual track clearances are not smaller than
     // requested clearance due to many approximations in calculations, like arc to segment
     // approx, rounding issues, etc.
-    BOX2I zone_boundingbox = aZone->GetBoundingBox();
+    BOX2I zone_boundingbox = aExtents;
     int   extra_margin = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_ExtraClearance );
 
+    // When only part of the zone is being filled, other zones' fills are clipped to the part
+    // being filled before being knocked out.
+    bool  clipToExtents = !aExtents.Contains( aZone->GetBoundingBox() );
+
     // Items outside the zone bounding box are skipped, so it needs to be inflated by the
     // largest clearance value found in the netclasses and rules
     zone_boundingbox.Inflate( m_worstClearance + extra_margin );
@@ -1454,8 +1756,24 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
                                                                 aZone, aKnockout, aLayer ) );
 
                         SHAPE_POLY_SET poly;
-                        aKnockout->TransformShapeToPolygon( poly, aLayer, gap + extra_margin,
-                                                            m_maxError, ERROR_OUTSIDE );
+
+                        if( clipToExtents )
+                        {
+                            BOX2I clipBox = zone_boundingbox;
+                            clipBox.Inflate( gap + extra_margin + m_maxError );
+
+                            aKnockout->TransformSolidAreasShapesToPolygon( aLayer, poly );
+                            poly.BooleanIntersection( SHAPE_POLY_SET( SHAPE_RECT( clipBox ).Outline() ),
+                                                      SHAPE_POLY_SET::PM_FAST );
+                            poly.Inflate( gap + extra_margin + m_maxError,
+                                          CORNER_STRATEGY::ROUND_ALL_CORNERS, m_maxError );
+                        }
+                        else
+                        {
+                            aKnockout->TransformShapeToPolygon( poly, aLayer, gap + extra_margin,
+                                                                m_maxError, ERROR_OUTSIDE );
+                        }
+
                         aHoles.Append( poly );
                     }
                 }
@@ -1502,7 +1820,7 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
         }
     }
 
-    aHoles.Simplify( SHAPE_POLY_SET::PM_FAST );
+    aHoles.SimplifyBatched( SHAPE_POLY_SET::PM_FAST );
 }
 
 
@@ -1511,9 +1829,9 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
  * in charge of the fill parameters within their own outlines.
  */
 void ZONE_FILLER::subtractHigherPriorityZones( const ZONE* aZone, PCB_LAYER_ID aLayer,
-                                               SHAPE_POLY_SET& aRawFill )
+                                               const BOX2I& aExtents, SHAPE_POLY_SET& aRawFill )
 {
-    BOX2I zoneBBox = aZone->GetBoundingBox();
+    BOX2I zoneBBox = aExtents;
 
     auto knockoutZoneOutline =
             [&]( ZONE* aKnockout )
@@ -1632,7 +1950,8 @@ void ZONE_FILLER::connect_nearby_polys( SHAPE_POLY_SET& aPolys, double aDistance
  */
 bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LAYER_ID aDebugLayer,
                                   const SHAPE_POLY_SET& aSmoothedOutline,
-                                  const SHAPE_POLY_SET& aMaxExtents, SHAPE_POLY_SET& aFillPolys )
+                                  const SHAPE_POLY_SET& aMaxExtents, const BOX2I& aExtents,
+                                  SHAPE_POLY_SET& aFillPolys )
 {
     m_maxError = m_board->GetDesignSettings().m_MaxError;
 
@@ -1670,7 +1989,8 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      * Knockout thermal reliefs.
      */
 
-    knockoutThermalReliefs( aZone, aLayer, aFillPolys, thermalConnectionPads, noConnectionPads );
+    knockoutThermalReliefs( aZone, aLayer, aExtents, aFillPolys, thermalConnectionPads,
+                            noConnectionPads );
     DUMP_POLYS_TO_COPPER_LAYER( aFillPolys, In2_Cu, wxT( "minus-thermal-reliefs" ) );
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
@@ -1680,7 +2000,7 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      * Knockout electrical clearances.
      */
 
-    buildCopperItemClearances( aZone, aLayer, noConnectionPads, clearanceHoles );
+    buildCopperItemClearances( aZone, aLayer, aExtents, noConnectionPads, clearanceHoles );
     DUMP_POLYS_TO_COPPER_LAYER( clearanceHoles, In3_Cu, wxT( "clearance-holes" ) );
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
@@ -1859,7 +2179,7 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      * Lastly give any same-net but higher-priority zones control over their own area.
      */
 
-    subtractHigherPriorityZones( aZone, aLayer, aFillPolys );
+    subtractHigherPriorityZones( aZone, aLayer, aExtents, aFillPolys );
     DUMP_POLYS_TO_COPPER_LAYER( aFillPolys, In18_Cu, wxT( "minus-higher-priority-zones" ) );
 
     aFillPolys.Fracture( SHAPE_POLY_SET::PM_FAST );
@@ -1867,6 +2187,313 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
 }
 
 
+int ZONE_FILLER::getFillInfluenceDistance( const ZONE* aZone ) const
+{
+    int extra_margin = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_ExtraClearance );
+
+    // Clearance holes and thermal reliefs (along with the spokes which reach just beyond them)
+    // extend out from an item by at most their respective gaps.  Min-width pruning and the
+    // connecting of nearby polygons can then carry a change up to a few min-widths further.
+    return m_worstClearance + extra_margin
+               + std::max( m_worstThermalGap, aZone->GetThermalReliefGap() )
+               + 3 * aZone->GetMinThickness() + 2 * m_maxError;
+}
+
+
+void ZONE_FILLER::buildRefillAreas( const std::vector<ZONE*>& aZones,
+                                    const std::map<std::pair<ZONE*, PCB_LAYER_ID>, HASH_128>& aFillHashes,
+                                    std::map<std::pair<ZONE*, PCB_LAYER_ID>, std::vector<BOX2I>>& aAreas )
+{
+    if( !m_fillCache || m_debugZoneFiller )
+        return;
+
+    // Zones are visited in priority order so that the areas being refilled in a higher-priority
+    // zone can be carried over to the lower-priority zones it is knocked out of.
+    std::vector<ZONE*> zones;
+
+    for( ZONE* zone : aZones )
+    {
+        if( !zone->GetIsRuleArea() && zone->GetNumCorners() > 2 )
+            zones.push_back( zone );
+    }
+
+    std::sort( zones.begin(), zones.end(),
+               []( const ZONE* a, const ZONE* b )
+               {
+                   return a->HigherPriority( b );
+               } );
+
+    std::set<std::pair<ZONE*, PCB_LAYER_ID>> fullFills;
+
+    for( ZONE* zone : zones )
+    {
+        // Hatched fills are aligned to the zone as a whole, and teardrops are small enough
+        // that it's not worth the bother.
+        bool canRefill = m_dirtyAreas.count( zone )
+                            && zone->IsOnCopperLayer()
+                            && !zone->IsTeardropArea()
+                            && zone->GetFillMode() != ZONE_FILL_MODE::HATCH_PATTERN;
+
+        BOX2I zoneBBox = zone->GetBoundingBox();
+        int   distance = getFillInfluenceDistance( zone );
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            const ZONE_FILL_CACHE::ENTRY* entry = nullptr;
+
+            if( canRefill )
+                entry = m_fillCache->Find( zone, layer );
+
+            if( !entry
+                    || entry->m_FillHash != aFillHashes.at( { zone, layer } )
+                    || entry->m_WorstClearance != m_worstClearance
+                    || entry->m_MaxError != m_maxError )
+            {
+                fullFills.insert( { zone, layer } );
+                continue;
+            }
+
+            std::vector<BOX2I> areas;
+
+            auto addArea =
+                    [&]( BOX2I aArea )
+                    {
+                        aArea.Inflate( distance );
+
+                        if( aArea.Intersects( zoneBBox ) )
+                            areas.push_back( aArea.Intersect( zoneBBox ) );
+                    };
+
+            for( const auto& [ area, layers ] : m_dirtyAreas.at( zone ) )
+            {
+                if( layers.test( layer ) )
+                    addArea( area );
+            }
+
+            // Higher-priority zones of other nets are knocked out of this one, so wherever
+            // their fills change so may ours.
+            for( ZONE* other : zones )
+            {
+                if( other == zone )
+                    break;
+
+                if( other->SameNet( zone ) || !other->GetLayerSet().test( layer ) )
+                    continue;
+
+                if( fullFills.count( { other, layer } ) )
+                {
+                    addArea( other->GetBoundingBox() );
+                }
+                else if( aAreas.count( { other, layer } ) )
+                {
+                    for( const BOX2I& otherArea : aAreas.at( { other, layer } ) )
+                        addArea( otherArea );
+                }
+            }
+
+            // Merge overlapping areas so that no part of the zone gets refilled twice
+            for( bool merged = true; merged; )
+            {
+                merged = false;
+
+                for( size_t ii = 0; ii < areas.size() && !merged; ++ii )
+                {
+                    for( size_t jj = ii + 1; jj < areas.size(); ++jj )
+                    {
+                        if( areas[ii].Intersects( areas[jj] ) )
+                        {
+                            areas[ii].Merge( areas[jj] );
+                            areas.erase( areas.begin() + jj );
+                            merged = true;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            double refillArea = 0.0;
+
+            for( const BOX2I& area : areas )
+                refillArea += (double) area.GetArea();
+
+            // Once the windows start to cover much of the zone it's cheaper to just fill it.
+            if( refillArea > 0.5 * (double) zoneBBox.GetArea() )
+            {
+                fullFills.insert( { zone, layer } );
+                continue;
+            }
+
+            aAreas[ { zone, layer } ] = std::move( areas );
+        }
+    }
+}
+
+
+bool ZONE_FILLER::fillCopperZoneWindow( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                        const SHAPE_POLY_SET& aSmoothedOutline,
+                                        const SHAPE_POLY_SET& aMaxExtents, const BOX2I& aArea,
+                                        SHAPE_POLY_SET& aFillPolys )
+{
+    // Nothing outside aArea inflated by the influence distance can affect the fill within
+    // it.  The window is then inflated by the same distance again so that its own (artificial)
+    // edges don't either.
+    BOX2I          window = aArea;
+    SHAPE_POLY_SET windowPoly;
+    SHAPE_POLY_SET windowOutline;
+    SHAPE_POLY_SET windowExtents;
+
+    window.Inflate( 2 * getFillInfluenceDistance( aZone ) );
+    windowPoly.AddOutline( SHAPE_RECT( window ).Outline() );
+
+    aFillPolys.RemoveAllContours();
+
+    windowOutline.BooleanIntersection( aSmoothedOutline, windowPoly, SHAPE_POLY_SET::PM_FAST );
+
+    if( windowOutline.IsEmpty() )
+        return true;
+
+    windowExtents.BooleanIntersection( aMaxExtents, windowPoly, SHAPE_POLY_SET::PM_FAST );
+
+    if( !fillCopperZone( aZone, aLayer, UNDEFINED_LAYER, windowOutline, windowExtents, window,
+                         aFillPolys ) )
+    {
+        return false;
+    }
+
+    // Keep a sliver of overlap with whatever the result is spliced to so that round-off
+    // differences along the splice can't leave hairline gaps in the copper.
+    BOX2I spliceArea = aArea;
+    spliceArea.Inflate( m_maxError );
+
+    aFillPolys.BooleanIntersection( SHAPE_POLY_SET( SHAPE_RECT( spliceArea ).Outline() ),
+                                    SHAPE_POLY_SET::PM_FAST );
+    return true;
+}
+
+
+bool ZONE_FILLER::refillCopperZoneAreas( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                         const SHAPE_POLY_SET& aSmoothedOutline,
+                                         const SHAPE_POLY_SET& aMaxExtents,
+                                         const std::vector<BOX2I>& aAreas,
+                                         const SHAPE_POLY_SET& aPreviousFill,
+                                         SHAPE_POLY_SET& aFillPolys )
+{
+    SHAPE_POLY_SET refilledAreas;
+    SHAPE_POLY_SET refills;
+
+    if( aAreas.empty() )
+    {
+        aFillPolys = aPreviousFill;
+        return true;
+    }
+
+    for( const BOX2I& area : aAreas )
+    {
+        SHAPE_POLY_SET areaFill;
+
+        if( !fillCopperZoneWindow( aZone, aLayer, aSmoothedOutline, aMaxExtents, area, areaFill ) )
+            return false;
+
+        refilledAreas.AddOutline( SHAPE_RECT( area ).Outline() );
+        refills.Append( areaFill );
+    }
+
+    aFillPolys = aPreviousFill.CloneDropTriangulation();
+    aFillPolys.BooleanSubtract( refilledAreas, SHAPE_POLY_SET::PM_FAST );
+    aFillPolys.BooleanAdd( refills, SHAPE_POLY_SET::PM_FAST );
+    aFillPolys.Fracture( SHAPE_POLY_SET::PM_FAST );
+    return true;
+}
+
+
+void ZONE_FILLER::buildFillTiles( const ZONE* aZone, int aTileCount, std::vector<BOX2I>& aTiles )
+{
+    BOX2I bbox = aZone->GetBoundingBox();
+
+    // Each tile is filled over a window which reaches twice the influence distance beyond it
+    // on every side.  Smaller tiles than this would spend most of their time on the overlap.
+    int   minTileSize = 8 * getFillInfluenceDistance( aZone );
+    int   maxCols = std::max( 1, bbox.GetWidth() / std::max( 1, minTileSize ) );
+    int   maxRows = std::max( 1, bbox.GetHeight() / std::max( 1, minTileSize ) );
+
+    // Keep the tiles roughly square
+    double aspect = (double) bbox.GetWidth() / std::max( 1, bbox.GetHeight() );
+    int    cols = std::clamp( KiROUND( std::sqrt( aTileCount * aspect ) ), 1, maxCols );
+    int    rows = std::clamp( ( aTileCount + cols - 1 ) / cols, 1, maxRows );
+
+    aTiles.clear();
+
+    if( cols * rows < 2 )
+        return;
+
+    for( int row = 0; row < rows; ++row )
+    {
+        int y0 = bbox.GetY() + KiROUND( (double) bbox.GetHeight() * row / rows );
+        int y1 = bbox.GetY() + KiROUND( (double) bbox.GetHeight() * ( row + 1 ) / rows );
+
+        for( int col = 0; col < cols; ++col )
+        {
+            int x0 = bbox.GetX() + KiROUND( (double) bbox.GetWidth() * col / cols );
+            int x1 = bbox.GetX() + KiROUND( (double) bbox.GetWidth() * ( col + 1 ) / cols );
+
+            aTiles.emplace_back( VECTOR2I( x0, y0 ), VECTOR2I( x1 - x0, y1 - y0 ) );
+        }
+    }
+}
+
+
+void ZONE_FILLER::mergeSpliceVertices( SHAPE_POLY_SET& aFillPolys,
+                                       const std::vector<BOX2I>& aAreas ) const
+{
+    // fillCopperZoneWindow() clips to the area inflated by m_maxError
+    std::set<int> cutsX;
+    std::set<int> cutsY;
+
+    for( const BOX2I& area : aAreas )
+    {
+        cutsX.insert( area.GetLeft() - m_maxError );
+        cutsX.insert( area.GetRight() + m_maxError );
+        cutsY.insert( area.GetTop() - m_maxError );
+        cutsY.insert( area.GetBottom() + m_maxError );
+    }
+
+    for( int ii = 0; ii < aFillPolys.OutlineCount(); ++ii )
+    {
+        for( SHAPE_LINE_CHAIN& path : aFillPolys.Polygon( ii ) )
+        {
+            if( path.PointCount() < 4 || path.ArcCount() )
+                continue;
+
+            SHAPE_LINE_CHAIN merged;
+            int              count = path.PointCount();
+
+            for( int jj = 0; jj < count; ++jj )
+            {
+                const VECTOR2I& pt = path.CPoint( jj );
+                const VECTOR2I& prev = merged.PointCount() ? merged.CLastPoint()
+                                                           : path.CPoint( count - 1 );
+                const VECTOR2I& next = path.CPoint( ( jj + 1 ) % count );
+
+                // Clipper rounds the intersections with the cut to the nearest unit
+                if( ( cutsX.count( pt.x ) || cutsY.count( pt.y ) )
+                        && TestSegmentHitFast( pt, prev, next, 1 ) )
+                {
+                    continue;
+                }
+
+                merged.Append( pt );
+            }
+
+            if( merged.PointCount() < 3 )
+                continue;
+
+            merged.SetClosed( true );
+            path = std::move( merged );
+        }
+    }
+}
+
+
 bool ZONE_FILLER::fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
                                      const SHAPE_POLY_SET& aSmoothedOutline,
                                      SHAPE_POLY_SET& aFillPolys )
@@ -1962,7 +2589,8 @@ bool ZONE_FILLER::fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
  * The solid areas can be more than one on copper layers, and do not have holes
  * ( holes are linked by overlapping segments to the main outline)
  */
-bool ZONE_FILLER::fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFillPolys )
+bool ZONE_FILLER::fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFillPolys,
+                                  const std::vector<BOX2I>* aRefillAreas )
 {
     SHAPE_POLY_SET* boardOutline = m_brdOutlinesValid ? &m_boardOutline : nullptr;
     SHAPE_POLY_SET  maxExtents;
@@ -1981,10 +2609,24 @@ bool ZONE_FILLER::fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_S
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return false;
 
-    if( aZone->IsOnCopperLayer() )
+    if( aZone->IsOnCopperLayer() && aRefillAreas )
     {
-        if( fillCopperZone( aZone, aLayer, debugLayer, smoothedPoly, maxExtents, aFillPolys ) )
+        const SHAPE_POLY_SET& previousFill = m_fillCache->Find( aZone, aLayer )->m_RawFill;
+
+        if( refillCopperZoneAreas( aZone, aLayer, smoothedPoly, maxExtents, *aRefillAreas,
+                                   previousFill, aFillPolys ) )
+        {
             aZone->SetNeedRefill( false );
+            m_incrementalRefills++;
+        }
+    }
+    else if( aZone->IsOnCopperLayer() )
+    {
+        if( fillCopperZone( aZone, aLayer, debugLayer, smoothedPoly, maxExtents,
+                            aZone->GetBoundingBox(), aFillPolys ) )
+        {
+            aZone->SetNeedRefill( false );
+        }
     }
     else
     {
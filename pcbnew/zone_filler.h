@@ -26,6 +26,8 @@
 #ifndef ZONE_FILLER_H
 #define ZONE_FILLER_H
 
+#include <atomic>
+#include <map>
 #include <vector>
 #include <zone.h>
 
@@ -36,6 +38,50 @@ class SHAPE_POLY_SET;
 class SHAPE_LINE_CHAIN;
 
 
+/**
+ * Zone fills retained from previous runs of the #ZONE_FILLER so that a later run can refill
+ * only the parts of a zone affected by an edit.
+ *
+ * Each entry holds a zone layer's fill as it came out of the filler (ie: before isolated
+ * islands were removed) along with the hash of the final fill.  The hash is used to reject
+ * entries for fills which have since been changed by other means (undo, unfill, etc.).
+ */
+class ZONE_FILL_CACHE
+{
+public:
+    struct ENTRY
+    {
+        SHAPE_POLY_SET m_RawFill;
+        HASH_128       m_FillHash;
+        int            m_WorstClearance = 0;
+        int            m_MaxError = 0;
+    };
+
+    const ENTRY* Find( const ZONE* aZone, PCB_LAYER_ID aLayer ) const
+    {
+        auto it = m_entries.find( { aZone->m_Uuid, aLayer } );
+        return it == m_entries.end() ? nullptr : &it->second;
+    }
+
+    void Store( const ZONE* aZone, PCB_LAYER_ID aLayer, ENTRY&& aEntry )
+    {
+        m_entries[ { aZone->m_Uuid, aLayer } ] = std::move( aEntry );
+    }
+
+    void Clear() { m_entries.clear(); }
+
+private:
+    std::map<std::pair<KIID, PCB_LAYER_ID>, ENTRY> m_entries;
+};
+
+
+/**
+ * An area of the board (and the layers within it) whose contents have changed since the last
+ * fill.
+ */
+typedef std::vector<std::pair<BOX2I, LSET>> ZONE_DIRTY_AREAS;
+
+
 class ZONE_FILLER
 {
 public:
@@ -57,6 +103,31 @@ public:
      */
     bool Fill( const std::vector<ZONE*>& aZones, bool aCheck = false, wxWindow* aParent = nullptr );
 
+    /**
+     * Enable incremental filling.
+     *
+     * Fills are recorded in \a aCache.  Zones which have an entry in \a aDirtyAreas and a
+     * still-valid fill in \a aCache are only refilled within (and around) the dirty areas; the
+     * result is spliced into the cached fill.  All other zones are filled in their entirety.
+     */
+    void SetIncrementalFill( ZONE_FILL_CACHE* aCache,
+                             const std::map<ZONE*, ZONE_DIRTY_AREAS>& aDirtyAreas = {} )
+    {
+        m_fillCache = aCache;
+        m_dirtyAreas = aDirtyAreas;
+    }
+
+    /**
+     * @return the number of zone layers which the last call to Fill() refilled incrementally
+     *         (rather than in their entirety).
+     */
+    int GetIncrementalRefillCount() const { return m_incrementalRefills; }
+
+    /**
+     * @return the number of zone layers which the last call to Fill() filled in tiles.
+     */
+    int GetTiledZoneCount() const { return m_tiledZones; }
+
     bool IsDebug() const { return m_debugZoneFiller; }
 
 private:
@@ -68,16 +139,22 @@ private:
 
     void addHoleKnockout( PAD* aPad, int aGap, SHAPE_POLY_SET& aHoles );
 
-    void knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFill,
+    /*
+     * The aExtents parameters below give the area of the zone being filled.  This is normally
+     * the zone's bounding box, but is smaller when only part of the zone is being refilled.
+     */
+
+    void knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aExtents,
+                                 SHAPE_POLY_SET& aFill,
                                  std::vector<PAD*>& aThermalConnectionPads,
                                  std::vector<PAD*>& aNoConnectionPads );
 
-    void buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer,
+    void buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aExtents,
                                     const std::vector<PAD*>& aNoConnectionPads,
                                     SHAPE_POLY_SET& aHoles );
 
     void subtractHigherPriorityZones( const ZONE* aZone, PCB_LAYER_ID aLayer,
-                                      SHAPE_POLY_SET& aRawFill );
+                                      const BOX2I& aExtents, SHAPE_POLY_SET& aRawFill );
 
     /**
      * Function fillCopperZone
@@ -92,7 +169,57 @@ private:
      */
     bool fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LAYER_ID aDebugLayer,
                          const SHAPE_POLY_SET& aSmoothedOutline,
-                         const SHAPE_POLY_SET& aMaxExtents, SHAPE_POLY_SET& aFillPolys );
+                         const SHAPE_POLY_SET& aMaxExtents, const BOX2I& aExtents,
+                         SHAPE_POLY_SET& aFillPolys );
+
+    /**
+     * Fill the part of a copper zone within \a aArea.
+     *
+     * The zone is filled over a window large enough that nothing outside it can influence the
+     * fill inside \a aArea, and whose own edges are far enough away that they don't either.
+     * The result is then clipped back to \a aArea.
+     */
+    bool fillCopperZoneWindow( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                               const SHAPE_POLY_SET& aSmoothedOutline,
+                               const SHAPE_POLY_SET& aMaxExtents, const BOX2I& aArea,
+                               SHAPE_POLY_SET& aFillPolys );
+
+    /**
+     * Refill a copper zone within the given areas only, splicing the results into the zone's
+     * previous fill.
+     */
+    bool refillCopperZoneAreas( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                const SHAPE_POLY_SET& aSmoothedOutline,
+                                const SHAPE_POLY_SET& aMaxExtents,
+                                const std::vector<BOX2I>& aAreas,
+                                const SHAPE_POLY_SET& aPreviousFill, SHAPE_POLY_SET& aFillPolys );
+
+    /**
+     * Split a zone's bounding box into (about) \a aTileCount tiles which can be filled
+     * independently.  Leaves \a aTiles empty if the zone isn't large enough to be worth tiling.
+     */
+    void buildFillTiles( const ZONE* aZone, int aTileCount, std::vector<BOX2I>& aTiles );
+
+    /**
+     * Remove the extra vertices left on the cut lines after splicing fills clipped to
+     * \a aAreas back together.  An edge which crossed a cut comes back in pieces; a vertex is
+     * only removed if it lies on a cut and (to within round-off) on the line through its
+     * neighbours.
+     */
+    void mergeSpliceVertices( SHAPE_POLY_SET& aFillPolys, const std::vector<BOX2I>& aAreas ) const;
+
+    /**
+     * @return the distance over which a change to the board can affect the fill of \a aZone.
+     */
+    int getFillInfluenceDistance( const ZONE* aZone ) const;
+
+    /**
+     * Determine which zone layers can be refilled incrementally, and the areas within them
+     * which need refilling.  Zone layers which must be filled in their entirety are omitted.
+     */
+    void buildRefillAreas( const std::vector<ZONE*>& aZones,
+                           const std::map<std::pair<ZONE*, PCB_LAYER_ID>, HASH_128>& aFillHashes,
+                           std::map<std::pair<ZONE*, PCB_LAYER_ID>, std::vector<BOX2I>>& aAreas );
 
     bool fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
                             const SHAPE_POLY_SET& aSmoothedOutline, SHAPE_POLY_SET& aFillPolys );
@@ -123,7 +250,8 @@ private:
      * by aZone->GetMinThickness() / 2 to be drawn with a outline thickness = aZone->GetMinThickness()
      * aFillPolys are polygons that will be drawn on screen and plotted
      */
-    bool fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFillPolys );
+    bool fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFillPolys,
+                         const std::vector<BOX2I>* aRefillAreas = nullptr );
 
     /**
      * for zones having the ZONE_FILL_MODE::ZONE_FILL_MODE::HATCH_PATTERN, create a grid pattern
@@ -143,8 +271,14 @@ private:
 
     int                   m_maxError;
     int                   m_worstClearance;
+    int                   m_worstThermalGap;
 
     bool                  m_debugZoneFiller;
+
+    ZONE_FILL_CACHE*                  m_fillCache;    // optional; enables incremental fills
+    std::map<ZONE*, ZONE_DIRTY_AREAS> m_dirtyAreas;
+    std::atomic<int>                  m_incrementalRefills;
+    std::atomic<int>                  m_tiledZones;
 };
 
 #endif
@@ -31,6 +31,9 @@
 // Code under test
 #include <richio.h>
 
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
 /**
  * Declare the test suite
  */
@@ -80,4 +83,60 @@ BOOST_AUTO_TEST_CASE( VPrint )
     output.clear();
 }
 
+
+/**
+ * Check that #MAPPED_FILE_LINE_READER returns the same lines as #STRING_LINE_READER.
+ */
+BOOST_AUTO_TEST_CASE( MappedFileLineReader )
+{
+    const std::vector<std::string> contents = {
+        "(kicad_pcb (version 20240108)\n  (at 1.5 -2)\n\n(last line without newline)",
+        "(crlf\r\n  line)\r\n",
+        "",
+    };
+
+    for( const std::string& text : contents )
+    {
+        wxString fileName = wxFileName::CreateTempFileName( wxS( "richio" ) );
+
+        {
+            wxFFile file( fileName, wxS( "wb" ) );
+            BOOST_REQUIRE( file.IsOpened() );
+            BOOST_REQUIRE( file.Write( text.data(), text.size() ) == text.size() );
+        }
+
+        {
+            MAPPED_FILE_LINE_READER mapped( fileName );
+
+            BOOST_CHECK_EQUAL( std::string( mapped.Data(), mapped.Size() ), text );
+
+            // Read it twice to check Rewind()
+            for( int pass = 0; pass < 2; ++pass )
+            {
+                STRING_LINE_READER expected( text, fileName );
+                char*              line;
+
+                do
+                {
+                    line = mapped.ReadLine();
+                    char* expectedLine = expected.ReadLine();
+
+                    BOOST_REQUIRE_EQUAL( !line, !expectedLine );
+
+                    if( line )
+                        BOOST_CHECK_EQUAL( std::string( line ), std::string( expectedLine ) );
+
+                    BOOST_CHECK_EQUAL( mapped.LineNumber(), expected.LineNumber() );
+                } while( line );
+
+                mapped.Rewind();
+            }
+        }
+
+        wxRemoveFile( fileName );
+    }
+
+    BOOST_CHECK_THROW( MAPPED_FILE_LINE_READER( wxS( "/this/file/does/not/exist" ) ), IO_ERROR );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
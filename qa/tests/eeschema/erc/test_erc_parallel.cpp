@@ -0,0 +1,178 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one at
+ * http://www.gnu.org/licenses/
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <qa_utils/advanced_config_override.h>
+#include <schematic_utils/schematic_file_util.h>
+
+#include <connection_graph.h>
+#include <schematic.h>
+#include <erc/erc_settings.h>
+#include <erc/erc.h>
+#include <erc/erc_report.h>
+#include <settings/settings_manager.h>
+#include <core/thread_pool.h>
+#include <locale_io.h>
+
+#include <functional>
+#include <future>
+
+struct ERC_PARALLEL_TEST_FIXTURE
+{
+    ERC_PARALLEL_TEST_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    SETTINGS_MANAGER           m_settingsManager;
+    std::unique_ptr<SCHEMATIC> m_schematic;
+};
+
+
+static wxString markerReport( SCHEMATIC* aSchematic )
+{
+    ERC_REPORT reportWriter( aSchematic, EDA_UNITS::MILLIMETRES );
+
+    // The first line holds the time of the report
+    return reportWriter.GetTextReport().AfterFirst( '\n' );
+}
+
+
+/**
+ * Tests run together on the thread pool, each with its own marker buffer, must leave the same
+ * markers as running them one after another.
+ */
+BOOST_FIXTURE_TEST_CASE( ERCBufferedTestsMatchSerial, ERC_PARALLEL_TEST_FIXTURE )
+{
+    LOCALE_IO dummy;
+
+    for( const wxString& name : { wxString( "issue16897" ), wxString( "issue17870" ),
+                                  wxString( "same_local_global_label" ),
+                                  wxString( "erc_pin_not_connected_basic" ) } )
+    {
+        KI_TEST::LoadSchematic( m_settingsManager, name, m_schematic );
+
+        ERC_SETTINGS& settings = m_schematic->ErcSettings();
+
+        settings.m_ERCSeverities[ERCE_SIMILAR_LABELS] = RPT_SEVERITY_ERROR;
+        settings.m_ERCSeverities[ERCE_SIMILAR_POWER] = RPT_SEVERITY_ERROR;
+        settings.m_ERCSeverities[ERCE_SIMILAR_LABEL_AND_POWER] = RPT_SEVERITY_ERROR;
+        settings.m_ERCSeverities[ERCE_SAME_LOCAL_GLOBAL_LABEL] = RPT_SEVERITY_ERROR;
+        settings.m_ERCSeverities[ERCE_FOUR_WAY_JUNCTION] = RPT_SEVERITY_ERROR;
+
+        ERC_TESTER tester( m_schematic.get() );
+
+        std::vector<std::function<void()>> tests = {
+            [&]() { tester.TestMultUnitPinConflicts(); },
+            [&]() { tester.TestPinToPin(); },
+            [&]() { tester.TestSimilarLabels(); },
+            [&]() { tester.TestSameLocalGlobalLabel(); },
+            [&]() { tester.TestNoConnectPins(); },
+            [&]() { tester.TestOffGridEndpoints(); },
+            [&]() { tester.TestFourWayJunction(); },
+            [&]() { tester.TestLabelMultipleWires(); }
+        };
+
+        for( const std::function<void()>& test : tests )
+            test();
+
+        wxString serial = markerReport( m_schematic.get() );
+
+        SCH_SCREENS( m_schematic->Root() ).DeleteAllMarkers( MARKER_BASE::MARKER_ERC, true );
+
+        std::vector<ERC_MARKER_BUFFER> buffers( tests.size() );
+        std::vector<std::future<void>> results;
+
+        for( size_t ii = 0; ii < tests.size(); ++ii )
+        {
+            results.push_back( GetKiCadThreadPool().submit(
+                    [&tests, &buffers, ii]()
+                    {
+                        ERC_MARKER_BUFFER::SCOPE scope( buffers[ii] );
+                        tests[ii]();
+                    } ) );
+        }
+
+        for( std::future<void>& result : results )
+            result.get();
+
+        for( ERC_MARKER_BUFFER& buffer : buffers )
+            buffer.Commit();
+
+        wxString parallel = markerReport( m_schematic.get() );
+
+        BOOST_CHECK_MESSAGE( parallel == serial,
+                             "Buffered ERC of " << name.ToStdString() << " differs:\n"
+                                                << parallel.ToStdString() << "\nexpected:\n"
+                                                << serial.ToStdString() );
+    }
+}
+
+
+/**
+ * The whole of ERC_TESTER::RunTests() must give the same markers, in the same order, with the
+ * tests run on the thread pool as when they are run one after another.
+ */
+BOOST_FIXTURE_TEST_CASE( ERCParallelRunTestsMatchSerial, ERC_PARALLEL_TEST_FIXTURE )
+{
+    LOCALE_IO dummy;
+
+    for( const wxString& name : { wxString( "issue16897" ), wxString( "issue17870" ),
+                                  wxString( "same_local_global_label" ),
+                                  wxString( "erc_pin_not_connected_basic" ),
+                                  wxString( "netlists/video/video" ),
+                                  wxString( "netlists/complex_hierarchy/complex_hierarchy" ) } )
+    {
+        KI_TEST::LoadSchematic( m_settingsManager, name, m_schematic );
+
+        ERC_SETTINGS& settings = m_schematic->ErcSettings();
+
+        // The symbol libraries aren't loaded, so these would only report that
+        settings.m_ERCSeverities[ERCE_LIB_SYMBOL_ISSUES] = RPT_SEVERITY_IGNORE;
+        settings.m_ERCSeverities[ERCE_LIB_SYMBOL_MISMATCH] = RPT_SEVERITY_IGNORE;
+
+        settings.m_ERCSeverities[ERCE_SIMILAR_LABELS] = RPT_SEVERITY_ERROR;
+        settings.m_ERCSeverities[ERCE_SAME_LOCAL_GLOBAL_LABEL] = RPT_SEVERITY_ERROR;
+        settings.m_ERCSeverities[ERCE_FOUR_WAY_JUNCTION] = RPT_SEVERITY_ERROR;
+        settings.m_ERCSeverities[ERCE_ENDPOINT_OFF_GRID] = RPT_SEVERITY_ERROR;
+
+        auto runTests =
+                [&]( bool aParallel ) -> wxString
+                {
+                    KI_TEST::ADVANCED_CFG_OVERRIDE<bool> parallel( &ADVANCED_CFG::m_ParallelERC,
+                                                                   aParallel );
+
+                    SCH_SCREENS( m_schematic->Root() ).DeleteAllMarkers( MARKER_BASE::MARKER_ERC,
+                                                                         true );
+
+                    ERC_TESTER tester( m_schematic.get() );
+                    tester.RunTests( nullptr, nullptr, nullptr, &m_schematic->Prj(), nullptr );
+
+                    return markerReport( m_schematic.get() );
+                };
+
+        wxString serial = runTests( false );
+        wxString parallel = runTests( true );
+
+        BOOST_CHECK_MESSAGE( parallel == serial,
+                             "Parallel ERC of " << name.ToStdString() << " differs:\n"
+                                                << parallel.ToStdString() << "\nexpected:\n"
+                                                << serial.ToStdString() );
+    }
+}
@@ -27,11 +27,18 @@
 
 #include <connection_graph.h>
 #include <schematic.h>
+#include <sch_label.h>
+#include <sch_line.h>
 #include <sch_sheet.h>
+#include <sch_sheet_pin.h>
 #include <sch_screen.h>
 #include <settings/settings_manager.h>
 #include <locale_io.h>
 
+#include <algorithm>
+#include <map>
+#include <random>
+
 struct INCREMENTAL_NETLIST_TEST_FIXTURE
 {
     INCREMENTAL_NETLIST_TEST_FIXTURE() :
@@ -42,6 +49,26 @@ struct INCREMENTAL_NETLIST_TEST_FIXTURE
     std::unique_ptr<SCHEMATIC> m_schematic;
 };
 
+
+/**
+ * Merge a graph built for an edit into \a aGraph as SCH_EDIT_FRAME::RecalculateConnections()
+ * does, rebuilding \a aGraph instead when the edit renamed nets which the new graph doesn't hold.
+ *
+ * @return true if the new graph was merged.
+ */
+static bool mergeOrRecalculate( CONNECTION_GRAPH* aGraph, CONNECTION_GRAPH& aNewGraph,
+                                const SCH_SHEET_LIST& aSheets )
+{
+    if( aGraph->CanMerge( aNewGraph ) )
+    {
+        aGraph->Merge( aNewGraph );
+        return true;
+    }
+
+    aGraph->Recalculate( aSheets, true );
+    return false;
+}
+
 BOOST_FIXTURE_TEST_CASE( RemoveAddItems, INCREMENTAL_NETLIST_TEST_FIXTURE )
 {
     LOCALE_IO dummy;
@@ -144,7 +171,8 @@ BOOST_FIXTURE_TEST_CASE( RemoveAddItems, INCREMENTAL_NETLIST_TEST_FIXTURE )
                     }
 
                     new_graph.Recalculate( sheets, false );
-                    m_schematic->ConnectionGraph()->Merge( new_graph );
+
+                    mergeOrRecalculate( m_schematic->ConnectionGraph(), new_graph, sheets );
 
                     SCH_ITEM_VEC curr_items = item->ConnectedItems( path );
                     std::sort( curr_items.begin(), curr_items.end() );
@@ -161,4 +189,624 @@ BOOST_FIXTURE_TEST_CASE( RemoveAddItems, INCREMENTAL_NETLIST_TEST_FIXTURE )
             }
         }
     }
-}
\ No newline at end of file
+}
+
+
+/**
+ * Differential test of the incremental update.  Random sets of items are updated as the editor
+ * does after an edit, and the net of every item must then be the same as after rebuilding the
+ * whole graph.
+ */
+BOOST_FIXTURE_TEST_CASE( IncrementalMatchesFullRecalculation, INCREMENTAL_NETLIST_TEST_FIXTURE )
+{
+    LOCALE_IO dummy;
+
+    std::vector<wxString> tests = { "issue7203" };
+    std::mt19937          rng( 1234 );
+
+    for( const wxString& test : tests )
+    {
+        KI_TEST::LoadSchematic( m_settingsManager, test, m_schematic );
+
+        SCH_SHEET_LIST sheets = m_schematic->BuildSheetListSortedByPageNumbers();
+
+        std::vector<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> candidates;
+
+        for( const SCH_SHEET_PATH& path : sheets )
+        {
+            for( SCH_ITEM* item : path.LastScreen()->Items() )
+            {
+                if( !item->IsConnectable() )
+                    continue;
+
+                if( item->Type() == SCH_SYMBOL_T )
+                {
+                    for( SCH_PIN* pin : static_cast<SCH_SYMBOL*>( item )->GetPins( &path ) )
+                        candidates.emplace_back( path, pin );
+                }
+                else
+                {
+                    candidates.emplace_back( path, item );
+                }
+            }
+        }
+
+        BOOST_REQUIRE( !candidates.empty() );
+
+        auto netNames =
+                [&]()
+                {
+                    std::map<std::pair<wxString, SCH_ITEM*>, wxString> names;
+
+                    for( const auto& [path, item] : candidates )
+                    {
+                        SCH_CONNECTION* conn = item->Connection( &path );
+                        names[{ path.PathAsString(), item }] = conn ? conn->Name() : wxString();
+                    }
+
+                    return names;
+                };
+
+        std::uniform_int_distribution<size_t> pick( 0, candidates.size() - 1 );
+        std::uniform_int_distribution<int>    count( 1, 4 );
+
+        for( int round = 0; round < 50; ++round )
+        {
+            std::set<SCH_ITEM*>                            changed;
+            std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> changedPaths;
+
+            for( int ii = count( rng ); ii > 0; --ii )
+            {
+                const auto& candidate = candidates[pick( rng )];
+
+                changed.insert( candidate.second );
+                changedPaths.insert( candidate );
+            }
+
+            std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> all_items =
+                    m_schematic->ConnectionGraph()->ExtractAffectedItems( changed );
+
+            all_items.insert( changedPaths.begin(), changedPaths.end() );
+
+            CONNECTION_GRAPH new_graph( m_schematic.get() );
+
+            new_graph.SetLastCodes( m_schematic->ConnectionGraph() );
+
+            for( auto& [path, item] : all_items )
+                item->SetConnectivityDirty();
+
+            new_graph.Recalculate( sheets, false );
+            mergeOrRecalculate( m_schematic->ConnectionGraph(), new_graph, sheets );
+
+            auto incremental = netNames();
+
+            m_schematic->ConnectionGraph()->Recalculate( sheets, true );
+
+            auto full = netNames();
+
+            for( const auto& [key, name] : full )
+            {
+                BOOST_TEST_CONTEXT( test.ToStdString() << " round " << round << " item "
+                                    << key.second->GetFriendlyName().ToStdString() << " on "
+                                    << key.first.ToStdString() )
+                {
+                    BOOST_CHECK_EQUAL( incremental[key].ToStdString(), name.ToStdString() );
+                }
+            }
+        }
+    }
+}
+
+
+/**
+ * Update the graph after an edit as SCH_EDIT_FRAME::RecalculateConnections() does.  The edited
+ * items, and whatever is connected at their old and new connection points, are rebuilt in a new
+ * graph which is then merged into the schematic's.
+ *
+ * @return false if the new graph couldn't be merged, and the whole graph was rebuilt instead.
+ */
+static bool recalculateAfterEdit( SCHEMATIC* aSchematic, const SCH_SHEET_LIST& aSheets,
+                                  SCH_SCREEN* aScreen, const std::vector<SCH_ITEM*>& aEdited,
+                                  std::vector<VECTOR2I> aPoints )
+{
+    std::set<SCH_ITEM*>                            changed;
+    std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> itemPaths;
+
+    for( SCH_ITEM* item : aEdited )
+    {
+        std::vector<VECTOR2I> pts = item->GetConnectionPoints();
+
+        aPoints.insert( aPoints.end(), pts.begin(), pts.end() );
+        changed.insert( item );
+
+        for( const SCH_SHEET_PATH& path : aSheets )
+        {
+            if( path.LastScreen() == aScreen )
+                itemPaths.emplace( path, item );
+        }
+    }
+
+    for( const VECTOR2I& pt : aPoints )
+    {
+        for( SCH_ITEM* item : aScreen->Items().Overlapping( pt ) )
+        {
+            if( !item->IsConnectable() )
+                continue;
+
+            if( item->Type() == SCH_LINE_T )
+            {
+                if( item->HitTest( pt ) )
+                    changed.insert( item );
+            }
+            else if( item->Type() == SCH_SYMBOL_T && item->IsConnected( pt ) )
+            {
+                for( SCH_PIN* pin : static_cast<SCH_SYMBOL*>( item )->GetPins() )
+                    changed.insert( pin );
+            }
+            else if( item->Type() == SCH_SHEET_T )
+            {
+                for( SCH_SHEET_PIN* pin : static_cast<SCH_SHEET*>( item )->GetPins() )
+                    changed.insert( pin );
+            }
+            else if( item->IsConnected( pt ) )
+            {
+                changed.insert( item );
+            }
+        }
+    }
+
+    CONNECTION_GRAPH* graph = aSchematic->ConnectionGraph();
+
+    std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> all_items =
+            graph->ExtractAffectedItems( changed );
+
+    all_items.insert( itemPaths.begin(), itemPaths.end() );
+
+    CONNECTION_GRAPH new_graph( aSchematic );
+
+    new_graph.SetLastCodes( graph );
+
+    for( auto& [path, item] : all_items )
+        item->SetConnectivityDirty();
+
+    new_graph.Recalculate( aSheets, false );
+
+    return mergeOrRecalculate( graph, new_graph, aSheets );
+}
+
+
+/**
+ * Edit hierarchical designs as a user would: move, delete and add wires, and move, rename and
+ * add labels, including global labels which join nets across sheets.  After each edit the
+ * incrementally updated nets must be the same as after rebuilding the whole graph.
+ */
+BOOST_FIXTURE_TEST_CASE( IncrementalEditsMatchFullRecalculation, INCREMENTAL_NETLIST_TEST_FIXTURE )
+{
+    LOCALE_IO dummy;
+
+    std::vector<wxString> tests = { "netlists/complex_hierarchy/complex_hierarchy",
+                                    "netlists/hierarchy_aliases/hierarchy_aliases",
+                                    "netlists/test_hier_renaming/test_hier_renaming",
+                                    "netlists/test_global_promotion/test_global_promotion",
+                                    "netlists/video/video" };
+
+    for( const wxString& test : tests )
+    {
+        KI_TEST::LoadSchematic( m_settingsManager, test, m_schematic );
+
+        SCH_SHEET_LIST    sheets = m_schematic->BuildSheetListSortedByPageNumbers();
+        CONNECTION_GRAPH* graph = m_schematic->ConnectionGraph();
+
+        std::vector<std::unique_ptr<SCH_ITEM>> deleted;
+        std::vector<wxString>                  globalNames;
+        std::mt19937                           rng( 1234 );
+        const int                              grid = schIUScale.MilsToIU( 50 );
+
+        for( const SCH_SHEET_PATH& path : sheets )
+        {
+            for( SCH_ITEM* item : path.LastScreen()->Items().OfType( SCH_GLOBAL_LABEL_T ) )
+                globalNames.push_back( static_cast<SCH_GLOBALLABEL*>( item )->GetText() );
+        }
+
+        auto netNames =
+                [&]()
+                {
+                    std::map<std::pair<wxString, SCH_ITEM*>, wxString> names;
+
+                    auto addName =
+                            [&]( const SCH_SHEET_PATH& aPath, SCH_ITEM* aItem )
+                            {
+                                SCH_CONNECTION* conn = aItem->Connection( &aPath );
+                                names[{ aPath.PathAsString(), aItem }] = conn ? conn->Name()
+                                                                              : wxString();
+                            };
+
+                    for( const SCH_SHEET_PATH& path : sheets )
+                    {
+                        for( SCH_ITEM* item : path.LastScreen()->Items() )
+                        {
+                            if( !item->IsConnectable() )
+                                continue;
+
+                            if( SCH_SYMBOL* symbol = dynamic_cast<SCH_SYMBOL*>( item ) )
+                            {
+                                for( SCH_PIN* pin : symbol->GetPins( &path ) )
+                                    addName( path, pin );
+                            }
+                            else if( SCH_SHEET* sheet = dynamic_cast<SCH_SHEET*>( item ) )
+                            {
+                                for( SCH_SHEET_PIN* pin : sheet->GetPins() )
+                                    addName( path, pin );
+                            }
+                            else
+                            {
+                                addName( path, item );
+                            }
+                        }
+                    }
+
+                    return names;
+                };
+
+        auto randomOffset =
+                [&]()
+                {
+                    return VECTOR2I( grid * ( (int) ( rng() % 9 ) - 4 ),
+                                     grid * ( (int) ( rng() % 9 ) - 4 ) );
+                };
+
+        int edits = 0;
+        int merged = 0;
+
+        for( int round = 0; round < 40; ++round )
+        {
+            const SCH_SHEET_PATH&        path = sheets[rng() % sheets.size()];
+            SCH_SCREEN*                  screen = path.LastScreen();
+            std::vector<SCH_LINE*>       wires;
+            std::vector<SCH_LABEL_BASE*> labels;
+
+            for( SCH_ITEM* item : screen->Items() )
+            {
+                if( item->Type() == SCH_LINE_T && item->GetLayer() == LAYER_WIRE )
+                {
+                    wires.push_back( static_cast<SCH_LINE*>( item ) );
+                }
+                else if( item->Type() == SCH_LABEL_T || item->Type() == SCH_GLOBAL_LABEL_T
+                         || item->Type() == SCH_HIER_LABEL_T )
+                {
+                    labels.push_back( static_cast<SCH_LABEL_BASE*>( item ) );
+                }
+            }
+
+            SCH_LINE*             wire = wires.empty() ? nullptr : wires[rng() % wires.size()];
+            SCH_LABEL_BASE*       label = labels.empty() ? nullptr
+                                                         : labels[rng() % labels.size()];
+            SCH_ITEM*             edited = nullptr;
+            std::vector<VECTOR2I> oldPoints;
+            wxString              action;
+
+            switch( rng() % 6 )
+            {
+            case 0:
+                if( !wire )
+                    continue;
+
+                action = wxS( "move wire" );
+                oldPoints = wire->GetConnectionPoints();
+                screen->Remove( wire );
+                wire->Move( randomOffset() );
+                screen->Append( wire );
+                edited = wire;
+                break;
+
+            case 1:
+                if( !wire )
+                    continue;
+
+                action = wxS( "delete wire" );
+                screen->Remove( wire );
+                deleted.emplace_back( wire );
+                edited = wire;
+                break;
+
+            case 2:
+            {
+                if( !wire )
+                    continue;
+
+                VECTOR2I  start = rng() % 2 ? wire->GetStartPoint() : wire->GetEndPoint();
+                SCH_LINE* newWire = new SCH_LINE( start, LAYER_WIRE );
+
+                action = wxS( "add wire" );
+                newWire->SetEndPoint( start + randomOffset() );
+                screen->Append( newWire );
+                edited = newWire;
+                break;
+            }
+
+            case 3:
+                if( !label )
+                    continue;
+
+                action = wxS( "move label" );
+                oldPoints = label->GetConnectionPoints();
+                screen->Remove( label );
+                label->Move( randomOffset() );
+                screen->Append( label );
+                edited = label;
+                break;
+
+            case 4:
+                if( !label )
+                    continue;
+
+                action = wxS( "rename label" );
+
+                if( label->Type() == SCH_GLOBAL_LABEL_T && !globalNames.empty() )
+                    label->SetText( globalNames[rng() % globalNames.size()] );
+                else
+                    label->SetText( wxString::Format( wxS( "RENAMED_%d" ), round ) );
+
+                edited = label;
+                break;
+
+            case 5:
+            {
+                if( !wire )
+                    continue;
+
+                // Join the wire's net to one on another sheet where there is one to join
+                wxString name = globalNames.empty()
+                                        ? wxString::Format( wxS( "ADDED_%d" ), round )
+                                        : globalNames[rng() % globalNames.size()];
+
+                action = wxS( "add global label" );
+                edited = new SCH_GLOBALLABEL( wire->GetEndPoint(), name );
+                screen->Append( edited );
+                break;
+            }
+            }
+
+            edits++;
+
+            if( recalculateAfterEdit( m_schematic.get(), sheets, screen, { edited }, oldPoints ) )
+                merged++;
+
+            auto incremental = netNames();
+
+            graph->Recalculate( sheets, true );
+
+            auto full = netNames();
+
+            BOOST_REQUIRE_EQUAL( incremental.size(), full.size() );
+
+            for( const auto& [key, name] : full )
+            {
+                BOOST_TEST_CONTEXT( test.ToStdString() << " round " << round << " ("
+                                    << action.ToStdString() << ") item "
+                                    << key.second->GetFriendlyName().ToStdString() << " on "
+                                    << key.first.ToStdString() )
+                {
+                    BOOST_CHECK_EQUAL( incremental[key].ToStdString(), name.ToStdString() );
+                }
+            }
+        }
+
+        // Only edits which join two global nets need the whole graph rebuilt
+        BOOST_TEST_MESSAGE( test.ToStdString() << ": " << merged << " of " << edits
+                            << " edits merged" );
+        BOOST_CHECK_GT( merged, edits / 2 );
+    }
+}
+
+
+/**
+ * A wire on a net named by a global label or power symbol, with no hierarchical links, only
+ * takes the part of the net on its own sheet with it when it is updated.  The nets must come
+ * out as they were.
+ */
+BOOST_FIXTURE_TEST_CASE( SheetLocalEditsStayOnTheirSheet, INCREMENTAL_NETLIST_TEST_FIXTURE )
+{
+    LOCALE_IO dummy;
+
+    KI_TEST::LoadSchematic( m_settingsManager, "netlists/video/video", m_schematic );
+
+    SCH_SHEET_LIST    sheets = m_schematic->BuildSheetListSortedByPageNumbers();
+    CONNECTION_GRAPH* graph = m_schematic->ConnectionGraph();
+
+    std::vector<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> wires;
+
+    for( const SCH_SHEET_PATH& path : sheets )
+    {
+        for( SCH_ITEM* item : path.LastScreen()->Items().OfType( SCH_LINE_T ) )
+        {
+            if( item->IsConnectable() )
+                wires.emplace_back( path, item );
+        }
+    }
+
+    auto netNames =
+            [&]()
+            {
+                std::map<std::pair<wxString, SCH_ITEM*>, wxString> names;
+
+                for( const auto& [path, item] : wires )
+                {
+                    SCH_CONNECTION* conn = item->Connection( &path );
+                    names[{ path.PathAsString(), item }] = conn ? conn->Name() : wxString();
+                }
+
+                return names;
+            };
+
+    auto expected = netNames();
+    int  sheetLocal = 0;
+
+    for( const auto& [path, wire] : wires )
+    {
+        CONNECTION_SUBGRAPH* subgraph = graph->GetSubgraphForItem( wire );
+
+        if( !subgraph
+                || subgraph->GetDriverPriority() < CONNECTION_SUBGRAPH::PRIORITY::POWER_PIN )
+        {
+            continue;
+        }
+
+        wxString netName = subgraph->GetNetName();
+
+        std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> all_items =
+                graph->ExtractAffectedItems( { wire } );
+
+        bool onOwnSheet = std::all_of( all_items.begin(), all_items.end(),
+                                       [&]( const std::pair<SCH_SHEET_PATH, SCH_ITEM*>& aItem )
+                                       {
+                                           return aItem.first.LastScreen() == path.LastScreen();
+                                       } );
+
+        // The parts of the net on other sheets were left in the graph
+        if( onOwnSheet && !graph->GetAllSubgraphs( netName ).empty() )
+            sheetLocal++;
+
+        all_items.insert( { path, wire } );
+
+        CONNECTION_GRAPH new_graph( m_schematic.get() );
+
+        new_graph.SetLastCodes( graph );
+
+        for( auto& [itemPath, item] : all_items )
+            item->SetConnectivityDirty();
+
+        new_graph.Recalculate( sheets, false );
+
+        BOOST_REQUIRE( mergeOrRecalculate( graph, new_graph, sheets ) );
+    }
+
+    BOOST_CHECK_GT( sheetLocal, 0 );
+
+    auto incremental = netNames();
+
+    for( const auto& [key, name] : expected )
+    {
+        BOOST_TEST_CONTEXT( "wire on " << key.first.ToStdString() )
+        {
+            BOOST_CHECK_EQUAL( incremental[key].ToStdString(), name.ToStdString() );
+        }
+    }
+}
+
+
+/**
+ * Handles kept on a connection are only used with the table they came from, and are dropped
+ * when the connection's name changes.
+ */
+BOOST_AUTO_TEST_CASE( NetNameTableHandles )
+{
+    NET_NAME_TABLE table;
+
+    int a = table.Intern( wxString( "A" ) );
+    int b = table.Intern( wxString( "B" ) );
+
+    BOOST_CHECK_NE( a, b );
+    BOOST_CHECK_EQUAL( table.Intern( wxString( "A" ) ), a );
+    BOOST_CHECK_EQUAL( table.Find( wxString( "B" ) ), b );
+    BOOST_CHECK_EQUAL( table.Find( wxString( "C" ) ), NET_NAME_TABLE::NONE );
+    BOOST_CHECK_EQUAL( table.Name( b ), wxString( "B" ) );
+    BOOST_CHECK_EQUAL( table.Size(), 2 );
+
+    SCH_CONNECTION conn;
+    conn.SetName( wxS( "B" ) );
+
+    BOOST_CHECK_EQUAL( table.Find( conn ), b );
+    BOOST_CHECK_EQUAL( conn.GetNameHandle( table.Id(), false ), NET_NAME_TABLE::NONE );
+
+    BOOST_CHECK_EQUAL( table.Intern( conn ), b );
+    BOOST_CHECK_EQUAL( conn.GetNameHandle( table.Id(), false ), b );
+    BOOST_CHECK_EQUAL( conn.GetNameHandle( table.Id(), true ), NET_NAME_TABLE::NONE );
+
+    conn.SetName( wxS( "C" ) );
+
+    BOOST_CHECK_EQUAL( conn.GetNameHandle( table.Id(), false ), NET_NAME_TABLE::NONE );
+
+    int c = table.Intern( conn );
+
+    BOOST_CHECK_EQUAL( table.Name( c ), wxString( "C" ) );
+
+    NET_NAME_TABLE other;
+
+    BOOST_CHECK_NE( other.Id(), table.Id() );
+    BOOST_CHECK_EQUAL( other.Find( conn ), NET_NAME_TABLE::NONE );
+
+    uint64_t oldId = table.Id();
+    table.Clear();
+
+    BOOST_CHECK_NE( table.Id(), oldId );
+    BOOST_CHECK_EQUAL( table.Size(), 0 );
+    BOOST_CHECK_EQUAL( table.Find( conn ), NET_NAME_TABLE::NONE );
+}
+
+
+/**
+ * Renaming a net over and over through incremental updates must not grow the graph's name
+ * table without limit, and the nets must still come out as a full rebuild makes them.
+ */
+BOOST_FIXTURE_TEST_CASE( NetNameTableStaysBounded, INCREMENTAL_NETLIST_TEST_FIXTURE )
+{
+    LOCALE_IO dummy;
+
+    KI_TEST::LoadSchematic( m_settingsManager, "netlists/video/video", m_schematic );
+
+    SCH_SHEET_LIST sheets = m_schematic->BuildSheetListSortedByPageNumbers();
+    SCH_SHEET_PATH labelPath;
+    SCH_LABEL*     label = nullptr;
+
+    for( const SCH_SHEET_PATH& path : sheets )
+    {
+        for( SCH_ITEM* item : path.LastScreen()->Items().OfType( SCH_LABEL_T ) )
+        {
+            labelPath = path;
+            label = static_cast<SCH_LABEL*>( item );
+            break;
+        }
+
+        if( label )
+            break;
+    }
+
+    BOOST_REQUIRE( label );
+
+    CONNECTION_GRAPH* graph = m_schematic->ConnectionGraph();
+    size_t            baseline = graph->GetNetNameCount();
+
+    BOOST_REQUIRE( baseline > 0 );
+
+    for( int round = 0; round < 200; ++round )
+    {
+        label->SetText( wxString::Format( wxS( "RENAMED_%d" ), round ) );
+
+        std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> all_items =
+                graph->ExtractAffectedItems( { label } );
+
+        all_items.insert( { labelPath, label } );
+
+        CONNECTION_GRAPH new_graph( m_schematic.get() );
+
+        new_graph.SetLastCodes( graph );
+
+        for( auto& [path, item] : all_items )
+            item->SetConnectivityDirty();
+
+        new_graph.Recalculate( sheets, false );
+
+        // Renaming a local label can't rename a global net
+        BOOST_REQUIRE( mergeOrRecalculate( graph, new_graph, sheets ) );
+
+        // Each edit adds a few names; once most are unused the table is rebuilt
+        BOOST_CHECK_LE( graph->GetNetNameCount(), 2 * baseline + 64 );
+    }
+
+    wxString incremental = label->Connection( &labelPath )->Name();
+
+    graph->Recalculate( sheets, true );
+
+    BOOST_CHECK_EQUAL( incremental, label->Connection( &labelPath )->Name() );
+}
@@ -0,0 +1,215 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <set>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <qa_utils/advanced_config_override.h>
+#include "eeschema_test_utils.h"
+
+#include <locale_io.h>
+#include <richio.h>
+#include <sch_io/kicad_sexpr/sch_io_kicad_sexpr_parser.h>
+#include <sch_screen.h>
+#include <sch_sheet.h>
+#include <sch_sheet_path.h>
+#include <schematic.h>
+#include <wildcards_and_files_ext.h>
+
+
+class PARALLEL_SCHEMATIC_LOAD_FIXTURE : public KI_TEST::SCHEMATIC_TEST_FIXTURE
+{
+protected:
+    wxFileName GetSchematicPath( const wxString& aRelativePath ) override
+    {
+        wxFileName fn( KI_TEST::GetEeschemaTestDataDir() );
+        fn.AppendDir( "netlists" );
+
+        wxString path = fn.GetFullPath();
+        path += aRelativePath + wxT( "." ) + FILEEXT::KiCadSchematicFileExtension;
+
+        return wxFileName( path );
+    }
+};
+
+
+static std::vector<KIID> uuids( SCH_SCREEN* aScreen )
+{
+    std::vector<KIID> ids;
+
+    for( SCH_ITEM* item : aScreen->Items() )
+        ids.push_back( item->m_Uuid );
+
+    std::sort( ids.begin(), ids.end() );
+    return ids;
+}
+
+
+/**
+ * Describe every item of the loaded hierarchy, sheet by sheet, with what it is parented to.
+ *
+ * Parents are only compared against the sheets and screens of the hierarchy (never followed),
+ * so an item left pointing at a deleted sheet shows up as a difference rather than a crash.
+ * Schematic() is still called on each item, so that a build with KICAD_SANITIZE_ADDRESS
+ * reports such an item directly.
+ */
+static std::vector<wxString> describeHierarchy( SCHEMATIC& aSchematic )
+{
+    std::vector<wxString> lines;
+    SCH_SHEET_LIST        sheets = aSchematic.BuildSheetListSortedByPageNumbers();
+    std::set<EDA_ITEM*>   sheetItems;
+
+    for( const SCH_SHEET_PATH& path : sheets )
+        sheetItems.insert( path.Last() );
+
+    for( const SCH_SHEET_PATH& path : sheets )
+    {
+        SCH_SCREEN*            screen = path.LastScreen();
+        std::vector<SCH_ITEM*> items;
+
+        for( SCH_ITEM* item : screen->Items() )
+            items.push_back( item );
+
+        std::sort( items.begin(), items.end(),
+                   []( const SCH_ITEM* a, const SCH_ITEM* b )
+                   {
+                       return a->m_Uuid < b->m_Uuid;
+                   } );
+
+        for( SCH_ITEM* item : items )
+        {
+            EDA_ITEM* parent = item->GetParent();
+            wxString  parentDesc;
+
+            if( parent == screen )
+                parentDesc = wxS( "screen" );
+            else if( sheetItems.count( parent ) )
+                parentDesc = parent->m_Uuid.AsString();
+            else
+                parentDesc = wxS( "unknown" );
+
+            BOOST_CHECK_MESSAGE( parentDesc != wxS( "unknown" ),
+                                 "Item " << item->m_Uuid.AsString() << " on "
+                                         << path.PathHumanReadable() << " has a stray parent" );
+
+            if( parentDesc != wxS( "unknown" ) )
+                BOOST_CHECK( item->Schematic() == &aSchematic );
+
+            lines.push_back( wxString::Format( wxS( "%s %s %d %s" ), path.PathAsString(),
+                                               item->m_Uuid.AsString(), (int) item->Type(),
+                                               parentDesc ) );
+        }
+    }
+
+    return lines;
+}
+
+
+BOOST_FIXTURE_TEST_SUITE( ParallelSchematicLoad, PARALLEL_SCHEMATIC_LOAD_FIXTURE )
+
+
+/**
+ * Sheet files parsed ahead of the hierarchy walk are parsed with the schematic-wide steps
+ * deferred to FinishSchematic().  Doing those afterwards must give the same screen as a
+ * normal parse.
+ */
+BOOST_AUTO_TEST_CASE( DeferredFinishMatchesParse )
+{
+    for( const wxString& name : { wxString( "complex_hierarchy/complex_hierarchy" ),
+                                  wxString( "complex_hierarchy_shared/complex_hierarchy" ) } )
+    {
+        BOOST_TEST_CONTEXT( name )
+        {
+            LoadSchematic( name );
+
+            SCH_SCREENS screens( m_schematic.Root() );
+            int         count = 0;
+
+            for( SCH_SCREEN* screen = screens.GetFirst(); screen; screen = screens.GetNext() )
+            {
+                LOCALE_IO               toggle;
+                MAPPED_FILE_LINE_READER reader( screen->GetFileName() );
+                SCH_SHEET               sheet( &m_schematic );
+
+                sheet.SetScreen( new SCH_SCREEN( &m_schematic ) );
+                sheet.GetScreen()->SetFileName( screen->GetFileName() );
+
+                SCH_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, 0, &m_schematic.Root() );
+
+                parser.SetDeferFinish( true );
+                parser.ParseSchematic( &sheet );
+                parser.FinishSchematic( &sheet );
+
+                BOOST_CHECK( uuids( screen ) == uuids( sheet.GetScreen() ) );
+                BOOST_CHECK_EQUAL( screen->GetLibSymbols().size(),
+                                   sheet.GetScreen()->GetLibSymbols().size() );
+                BOOST_CHECK_EQUAL( screen->GetFileFormatVersionAtLoad(),
+                                   sheet.GetScreen()->GetFileFormatVersionAtLoad() );
+                count++;
+            }
+
+            BOOST_CHECK_GT( count, 1 );
+        }
+    }
+}
+
+
+/**
+ * Loading with the sheet files parsed ahead must give the same hierarchy as a serial load,
+ * with every item parented to a sheet or screen of that hierarchy.
+ */
+BOOST_AUTO_TEST_CASE( PrefetchedLoadMatchesSerial )
+{
+    for( const wxString& name : { wxString( "complex_hierarchy/complex_hierarchy" ),
+                                  wxString( "complex_hierarchy_shared/complex_hierarchy" ),
+                                  wxString( "hierarchy_aliases/hierarchy_aliases" ),
+                                  wxString( "test_hier_renaming/test_hier_renaming" ),
+                                  wxString( "video/video" ) } )
+    {
+        BOOST_TEST_CONTEXT( name )
+        {
+            std::vector<wxString> serial;
+            std::vector<wxString> prefetched;
+
+            {
+                KI_TEST::ADVANCED_CFG_OVERRIDE<bool> parallel(
+                        &ADVANCED_CFG::m_ParallelSchematicLoad, false );
+
+                LoadSchematic( name );
+                serial = describeHierarchy( m_schematic );
+            }
+
+            {
+                KI_TEST::ADVANCED_CFG_OVERRIDE<bool> parallel(
+                        &ADVANCED_CFG::m_ParallelSchematicLoad, true );
+
+                LoadSchematic( name );
+                prefetched = describeHierarchy( m_schematic );
+            }
+
+            BOOST_CHECK_GT( serial.size(), 0 );
+            BOOST_CHECK_EQUAL_COLLECTIONS( serial.begin(), serial.end(), prefetched.begin(),
+                                           prefetched.end() );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
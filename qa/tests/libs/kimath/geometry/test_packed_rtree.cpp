@@ -0,0 +1,142 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <geometry/packed_rtree.h>
+
+#include <array>
+#include <climits>
+#include <random>
+#include <set>
+
+
+BOOST_AUTO_TEST_SUITE( PackedRTree )
+
+
+/**
+ * Check search results against a brute-force search, for a range of sizes around the node
+ * boundaries (to exercise the padding of partial nodes).
+ */
+BOOST_AUTO_TEST_CASE( SearchMatchesBruteForce )
+{
+    std::mt19937                       rng( 1234 );
+    std::uniform_int_distribution<int> position( -1000000, 1000000 );
+    std::uniform_int_distribution<int> size( 0, 20000 );
+
+    for( int count : { 0, 1, 15, 16, 17, 255, 256, 257, 5000 } )
+    {
+        BOOST_TEST_CONTEXT( "Item count: " << count )
+        {
+            PACKED_RTREE<int>              tree;
+            std::vector<std::array<int, 4>> boxes;
+
+            for( int ii = 0; ii < count; ++ii )
+            {
+                int x = position( rng );
+                int y = position( rng );
+                int mmin[2] = { x, y };
+                int mmax[2] = { x + size( rng ), y + size( rng ) };
+
+                boxes.push_back( { mmin[0], mmin[1], mmax[0], mmax[1] } );
+                tree.Add( mmin, mmax, ii );
+            }
+
+            tree.Build();
+
+            BOOST_CHECK_EQUAL( tree.size(), (size_t) count );
+
+            for( int query = 0; query < 100; ++query )
+            {
+                int x = position( rng );
+                int y = position( rng );
+                int mmin[2] = { x, y };
+                int mmax[2] = { x + 5 * size( rng ), y + 5 * size( rng ) };
+
+                // Make sure the padding never matches an unbounded query
+                if( query == 0 )
+                {
+                    mmin[0] = mmin[1] = INT_MIN;
+                    mmax[0] = mmax[1] = INT_MAX;
+                }
+
+                std::set<int> expected;
+                std::set<int> found;
+
+                for( int ii = 0; ii < count; ++ii )
+                {
+                    const std::array<int, 4>& box = boxes[ii];
+
+                    if( box[0] <= mmax[0] && box[2] >= mmin[0]
+                            && box[1] <= mmax[1] && box[3] >= mmin[1] )
+                    {
+                        expected.insert( ii );
+                    }
+                }
+
+                auto visitor =
+                        [&]( int aItem ) -> bool
+                        {
+                            found.insert( aItem );
+                            return true;
+                        };
+
+                int visited = tree.Search( mmin, mmax, visitor );
+
+                BOOST_CHECK_EQUAL( visited, (int) expected.size() );
+                BOOST_CHECK( found == expected );
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( SearchStopsEarly )
+{
+    PACKED_RTREE<int> tree;
+
+    for( int ii = 0; ii < 100; ++ii )
+    {
+        int mmin[2] = { ii * 10, 0 };
+        int mmax[2] = { ii * 10 + 5, 5 };
+
+        tree.Add( mmin, mmax, ii );
+    }
+
+    tree.Build();
+
+    int  mmin[2] = { 0, 0 };
+    int  mmax[2] = { 1000, 5 };
+    int  calls = 0;
+    auto visitor =
+            [&]( int aItem ) -> bool
+            {
+                return ++calls < 3;
+            };
+
+    BOOST_CHECK_EQUAL( tree.Search( mmin, mmax, visitor ), 3 );
+    BOOST_CHECK_EQUAL( calls, 3 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
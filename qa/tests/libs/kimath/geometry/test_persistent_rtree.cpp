@@ -0,0 +1,181 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <geometry/persistent_rtree.h>
+
+#include <array>
+#include <map>
+#include <random>
+#include <set>
+
+
+BOOST_AUTO_TEST_SUITE( PersistentRTree )
+
+
+typedef std::map<int, std::array<int, 4>> BOXES;
+
+
+static std::set<int> bruteForce( const BOXES& aBoxes, const int aMin[2], const int aMax[2] )
+{
+    std::set<int> expected;
+
+    for( const auto& [item, box] : aBoxes )
+    {
+        if( box[0] <= aMax[0] && box[2] >= aMin[0] && box[1] <= aMax[1] && box[3] >= aMin[1] )
+            expected.insert( item );
+    }
+
+    return expected;
+}
+
+
+static void checkSearches( const PERSISTENT_RTREE<int>& aTree, const BOXES& aBoxes,
+                           std::mt19937& aRng )
+{
+    std::uniform_int_distribution<int> position( -1000000, 1000000 );
+    std::uniform_int_distribution<int> size( 0, 100000 );
+
+    BOOST_CHECK_EQUAL( aTree.size(), aBoxes.size() );
+
+    for( int query = 0; query < 20; ++query )
+    {
+        int x = position( aRng );
+        int y = position( aRng );
+        int mmin[2] = { x, y };
+        int mmax[2] = { x + size( aRng ), y + size( aRng ) };
+
+        std::set<int> expected = bruteForce( aBoxes, mmin, mmax );
+        std::set<int> found;
+
+        auto visitor =
+                [&]( int aItem ) -> bool
+                {
+                    found.insert( aItem );
+                    return true;
+                };
+
+        int visited = aTree.Search( mmin, mmax, visitor );
+
+        BOOST_CHECK_EQUAL( visited, (int) expected.size() );
+        BOOST_CHECK( found == expected );
+    }
+}
+
+
+/**
+ * Apply random insertions and removals to a chain of copies, checking that each copy still
+ * matches a brute-force search after its descendants have been changed.
+ */
+BOOST_AUTO_TEST_CASE( CopiesAreIndependent )
+{
+    std::mt19937                       rng( 1234 );
+    std::uniform_int_distribution<int> position( -1000000, 1000000 );
+    std::uniform_int_distribution<int> size( 0, 20000 );
+
+    std::vector<PERSISTENT_RTREE<int>> trees( 1 );
+    std::vector<BOXES>                 boxes( 1 );
+    int                                nextItem = 0;
+
+    for( int generation = 0; generation < 20; ++generation )
+    {
+        PERSISTENT_RTREE<int> tree = trees.back();
+        BOXES                 treeBoxes = boxes.back();
+
+        for( int change = 0; change < 200; ++change )
+        {
+            if( !treeBoxes.empty() && rng() % 3 == 0 )
+            {
+                auto it = treeBoxes.begin();
+                std::advance( it, rng() % treeBoxes.size() );
+
+                int mmin[2] = { it->second[0], it->second[1] };
+                int mmax[2] = { it->second[2], it->second[3] };
+
+                BOOST_CHECK( tree.Remove( mmin, mmax, it->first ) );
+                BOOST_CHECK( !tree.Remove( mmin, mmax, it->first ) );
+                treeBoxes.erase( it );
+            }
+            else
+            {
+                int x = position( rng );
+                int y = position( rng );
+                int mmin[2] = { x, y };
+                int mmax[2] = { x + size( rng ), y + size( rng ) };
+
+                tree.Insert( mmin, mmax, nextItem );
+                treeBoxes[nextItem++] = { mmin[0], mmin[1], mmax[0], mmax[1] };
+            }
+        }
+
+        trees.push_back( tree );
+        boxes.push_back( treeBoxes );
+    }
+
+    for( size_t ii = 0; ii < trees.size(); ++ii )
+    {
+        BOOST_TEST_CONTEXT( "Generation " << ii )
+        {
+            checkSearches( trees[ii], boxes[ii], rng );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( RemoveAll )
+{
+    std::mt19937          rng( 1234 );
+    PERSISTENT_RTREE<int> tree;
+    BOXES                 treeBoxes;
+
+    for( int ii = 0; ii < 1000; ++ii )
+    {
+        int mmin[2] = { ii * 10, ( ii % 37 ) * 10 };
+        int mmax[2] = { ii * 10 + 5, ( ii % 37 ) * 10 + 5 };
+
+        tree.Insert( mmin, mmax, ii );
+        treeBoxes[ii] = { mmin[0], mmin[1], mmax[0], mmax[1] };
+    }
+
+    PERSISTENT_RTREE<int> copy = tree;
+
+    // Empty the tree one item at a time, which collapses it back to nothing
+    for( const auto& [item, box] : treeBoxes )
+    {
+        int mmin[2] = { box[0], box[1] };
+        int mmax[2] = { box[2], box[3] };
+
+        BOOST_CHECK( tree.Remove( mmin, mmax, item ) );
+    }
+
+    BOOST_CHECK( tree.empty() );
+    checkSearches( copy, treeBoxes, rng );
+
+    copy.RemoveAll();
+    BOOST_CHECK( copy.empty() );
+    checkSearches( copy, BOXES(), rng );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,188 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <geometry/seg_batch.h>
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include <cmath>
+#include <random>
+
+
+BOOST_AUTO_TEST_SUITE( SegBatch )
+
+
+/**
+ * Build something shaped like a filled zone: a wavy outline with many small round holes,
+ * all approximated with short segments as a fill would be.
+ */
+static SHAPE_POLY_SET makeZoneLikePolygon( int aOutlinePoints, int aHolesPerSide )
+{
+    const int radius = 50000000;
+
+    SHAPE_LINE_CHAIN outline;
+
+    for( int ii = 0; ii < aOutlinePoints; ++ii )
+    {
+        double angle = 2.0 * M_PI * ii / aOutlinePoints;
+        double r = radius * ( 1.0 + 0.05 * std::sin( 40.0 * angle ) );
+
+        outline.Append( KiROUND( r * std::cos( angle ) ), KiROUND( r * std::sin( angle ) ) );
+    }
+
+    outline.SetClosed( true );
+
+    SHAPE_POLY_SET poly;
+    poly.AddOutline( outline );
+
+    const int pitch = radius / aHolesPerSide;
+    const int holeRadius = pitch / 4;
+
+    for( int ix = -aHolesPerSide / 2; ix < aHolesPerSide / 2; ++ix )
+    {
+        for( int iy = -aHolesPerSide / 2; iy < aHolesPerSide / 2; ++iy )
+        {
+            SHAPE_LINE_CHAIN hole;
+            VECTOR2I         centre( ix * pitch, iy * pitch );
+
+            for( int ii = 0; ii < 64; ++ii )
+            {
+                double angle = 2.0 * M_PI * ii / 64;
+
+                hole.Append( centre + VECTOR2I( KiROUND( holeRadius * std::cos( angle ) ),
+                                                KiROUND( holeRadius * std::sin( angle ) ) ) );
+            }
+
+            hole.SetClosed( true );
+            poly.AddHole( hole );
+        }
+    }
+
+    return poly;
+}
+
+
+static SEG::ecoord bruteForceDistance( const SHAPE_POLY_SET& aPoly, const VECTOR2I& aPoint )
+{
+    SEG::ecoord minDistance = VECTOR2I::ECOORD_MAX;
+
+    for( auto it = aPoly.CIterateSegmentsWithHoles( 0 ); it; it++ )
+        minDistance = std::min( minDistance, ( *it ).SquaredDistance( aPoint ) );
+
+    return minDistance;
+}
+
+
+static SEG::ecoord bruteForceDistance( const SHAPE_LINE_CHAIN& aChain, const VECTOR2I& aPoint )
+{
+    SEG::ecoord minDistance = VECTOR2I::ECOORD_MAX;
+
+    for( int ii = 0; ii < aChain.SegmentCount(); ++ii )
+    {
+        VECTOR2I pn = aChain.CSegment( ii ).NearestPoint( aPoint );
+        minDistance = std::min( minDistance, ( pn - aPoint ).SquaredEuclideanNorm() );
+    }
+
+    return minDistance;
+}
+
+
+/**
+ * Segments left out by the filter must really be further away than the limit.
+ */
+BOOST_AUTO_TEST_CASE( FilterIsConservative )
+{
+    std::mt19937 rng( 1234 );
+
+    for( int scale : { 1000, 1000000, 500000000 } )
+    {
+        std::uniform_int_distribution<int> position( -scale, scale );
+        std::uniform_int_distribution<int> step( -scale / 100, scale / 100 );
+
+        for( int run = 0; run < 200; ++run )
+        {
+            std::vector<VECTOR2I> points( 33 );
+
+            points[0] = VECTOR2I( position( rng ), position( rng ) );
+
+            for( size_t ii = 1; ii < points.size(); ++ii )
+                points[ii] = points[ii - 1] + VECTOR2I( step( rng ), step( rng ) );
+
+            VECTOR2I    query( points[rng() % 33] + VECTOR2I( step( rng ), step( rng ) ) );
+            SEG::ecoord limit = SEG::Square( std::abs( step( rng ) ) );
+            uint32_t    mask = SegmentsNearBox( points.data(), 32, query, query, limit );
+
+            for( int ii = 0; ii < 32; ++ii )
+            {
+                SEG      seg( points[ii], points[ii + 1] );
+                VECTOR2I pn = seg.NearestPoint( query );
+
+                if( !( mask & ( 1u << ii ) ) )
+                {
+                    BOOST_CHECK_GT( seg.SquaredDistance( query ), limit );
+                    BOOST_CHECK_GT( ( pn - query ).SquaredEuclideanNorm(), limit );
+                }
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( MatchesBruteForce )
+{
+    std::mt19937                       rng( 1234 );
+    std::uniform_int_distribution<int> position( -60000000, 60000000 );
+    std::uniform_int_distribution<int> clearance( 0, 2000000 );
+
+    SHAPE_POLY_SET   poly = makeZoneLikePolygon( 4000, 6 );
+    SHAPE_LINE_CHAIN outline = poly.COutline( 0 );
+
+    // Open, so that Collide() measures the distance to the outline rather than the area
+    outline.SetClosed( false );
+
+    for( int query = 0; query < 2000; ++query )
+    {
+        VECTOR2I p( position( rng ), position( rng ) );
+        int      clr = clearance( rng );
+
+        BOOST_TEST_CONTEXT( "Query " << query )
+        {
+            SEG::ecoord expected = bruteForceDistance( outline, p );
+            int         actual = -1;
+            bool        collide = outline.Collide( p, clr, &actual );
+
+            BOOST_CHECK_EQUAL( collide, expected < SEG::Square( clr ) );
+
+            if( collide )
+                BOOST_CHECK_EQUAL( actual, (int) std::sqrt( expected ) );
+
+            BOOST_CHECK_EQUAL( poly.SquaredDistanceToPolygon( p, 0, nullptr ),
+                               poly.Contains( p ) ? 0 : bruteForceDistance( poly, p ) );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
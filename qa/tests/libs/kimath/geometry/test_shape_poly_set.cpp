@@ -16,8 +16,14 @@
  */
 
 #include <geometry/shape_poly_set.h>
+#include <geometry/shape_poly_set_cache.h>
+#include <core/thread_pool.h>
 #include <trigo.h>
 
+#include <future>
+#include <random>
+
+#include <qa_utils/advanced_config_override.h>
 #include <qa_utils/geometry/geometry.h>
 #include <qa_utils/numeric.h>
 #include <qa_utils/wx_utils/unit_test_utils.h>
@@ -64,4 +70,283 @@ BOOST_AUTO_TEST_CASE( RemoveNullSegments )
 
 }
 
+
+/**
+ * Merging many overlapping knockouts through the batched union tree gives the same copper as
+ * a plain Simplify() (rectangles, so that every intersection is exact).
+ *
+ * The tree's shape depends on the size of the thread pool, so the results are compared by
+ * their difference (which must be empty) rather than by vertex order or summed area.
+ */
+BOOST_AUTO_TEST_CASE( BatchedUnion )
+{
+    // The raw engine output is fixed by the standard, unlike std::uniform_int_distribution
+    std::mt19937 rng( 1234 );
+
+    auto random =
+            [&]( int aMin, int aMax )
+            {
+                return aMin + static_cast<int>( rng() % static_cast<uint32_t>( aMax - aMin ) );
+            };
+
+    SHAPE_POLY_SET              knockouts;
+    std::vector<SHAPE_POLY_SET> operands;
+
+    for( int ii = 0; ii < 2000; ++ii )
+    {
+        VECTOR2I       pos( random( 0, 10000000 ), random( 0, 10000000 ) );
+        VECTOR2I       end = pos + VECTOR2I( random( 10000, 500000 ), random( 10000, 500000 ) );
+        SHAPE_POLY_SET rect;
+
+        rect.NewOutline();
+        rect.Append( pos );
+        rect.Append( end.x, pos.y );
+        rect.Append( end );
+        rect.Append( pos.x, end.y );
+
+        knockouts.Append( rect );
+        operands.push_back( rect );
+    }
+
+    auto checkSame =
+            [&]( const SHAPE_POLY_SET& aResult, const SHAPE_POLY_SET& aExpected )
+            {
+                SHAPE_POLY_SET diff;
+                diff.BooleanXor( aResult, aExpected, SHAPE_POLY_SET::PM_FAST );
+
+                BOOST_CHECK_EQUAL( diff.OutlineCount(), 0 );
+            };
+
+    SHAPE_POLY_SET expected = knockouts;
+    expected.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+    // Well over the size below which the tree is skipped
+    BOOST_REQUIRE_GT( expected.OutlineCount(), 100 );
+
+    SHAPE_POLY_SET batched = knockouts;
+    batched.SimplifyBatched( SHAPE_POLY_SET::PM_FAST );
+    checkSame( batched, expected );
+
+    SHAPE_POLY_SET added;
+    added.BooleanAdd( operands, SHAPE_POLY_SET::PM_FAST );
+    checkSame( added, expected );
+
+    SHAPE_POLY_SET board;
+    board.NewOutline();
+    board.Append( 0, 0 );
+    board.Append( 10000000, 0 );
+    board.Append( 10000000, 10000000 );
+    board.Append( 0, 10000000 );
+
+    SHAPE_POLY_SET fill = board;
+    fill.BooleanSubtract( operands, SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET expectedFill = board;
+    expectedFill.BooleanSubtract( knockouts, SHAPE_POLY_SET::PM_FAST );
+
+    checkSame( fill, expectedFill );
+}
+
+
+/**
+ * Copies of a polygon set should share their fracture and triangulation results through the
+ * cache, and get the same results as without it.
+ */
+BOOST_AUTO_TEST_CASE( SharedCache )
+{
+    SHAPE_POLY_SET_CACHE& cache = SHAPE_POLY_SET_CACHE::Instance();
+
+    cache.Clear();
+    cache.SetBudget( 64 * 1024 * 1024 );
+
+    // A disc with a ring of round holes, well over the cache's size threshold
+    SHAPE_POLY_SET poly;
+    poly.NewOutline();
+
+    for( int ii = 0; ii < 720; ++ii )
+    {
+        EDA_ANGLE angle( ii / 2.0, DEGREES_T );
+        poly.Append( KiROUND( 50000000 * angle.Cos() ), KiROUND( 50000000 * angle.Sin() ) );
+    }
+
+    for( int hole = 0; hole < 8; ++hole )
+    {
+        EDA_ANGLE        at( hole * 45.0, DEGREES_T );
+        VECTOR2I         centre( KiROUND( 25000000 * at.Cos() ), KiROUND( 25000000 * at.Sin() ) );
+        SHAPE_LINE_CHAIN chain;
+
+        for( int ii = 0; ii < 64; ++ii )
+        {
+            EDA_ANGLE angle( ii * 360.0 / 64, DEGREES_T );
+            chain.Append( centre + VECTOR2I( KiROUND( 5000000 * angle.Cos() ),
+                                             KiROUND( 5000000 * angle.Sin() ) ) );
+        }
+
+        chain.SetClosed( true );
+        poly.AddHole( chain );
+    }
+
+    SHAPE_POLY_SET first = poly;
+    SHAPE_POLY_SET second = poly;
+
+    first.Fracture( SHAPE_POLY_SET::PM_FAST );
+    second.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET_CACHE::STATS stats = cache.GetStats();
+
+    BOOST_CHECK_EQUAL( stats.m_hits, 1 );
+    BOOST_CHECK_EQUAL( stats.m_entries, 1 );
+    BOOST_CHECK( first.GetHash() == second.GetHash() );
+
+    // A different mode is a different result
+    SHAPE_POLY_SET strict = poly;
+    strict.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+    BOOST_CHECK_EQUAL( cache.GetStats().m_entries, 2 );
+
+    SHAPE_POLY_SET triFirst = poly;
+    SHAPE_POLY_SET triSecond = poly;
+
+    // The first triangulation fractures the set on the way, which itself may be a hit
+    triFirst.CacheTriangulation();
+
+    uint64_t hits = cache.GetStats().m_hits;
+
+    triSecond.CacheTriangulation();
+
+    BOOST_CHECK_EQUAL( cache.GetStats().m_hits, hits + 1 );
+    BOOST_CHECK( triSecond.IsTriangulationUpToDate() );
+    BOOST_REQUIRE_EQUAL( triFirst.TriangulatedPolyCount(), triSecond.TriangulatedPolyCount() );
+
+    double areaFirst = 0.0;
+    double areaSecond = 0.0;
+
+    for( unsigned ii = 0; ii < triFirst.TriangulatedPolyCount(); ++ii )
+    {
+        for( const auto& tri : triFirst.TriangulatedPolygon( ii )->Triangles() )
+            areaFirst += tri.Area();
+
+        for( const auto& tri : triSecond.TriangulatedPolygon( ii )->Triangles() )
+            areaSecond += tri.Area();
+    }
+
+    BOOST_CHECK_EQUAL( areaFirst, areaSecond );
+
+    // The triangles of the copy must refer to its own vertices
+    const SHAPE_POLY_SET::TRIANGULATED_POLYGON* tri = triSecond.TriangulatedPolygon( 0 );
+    BOOST_CHECK( tri->Triangles().front().parent == tri );
+
+    // Shrinking the budget drops the least recently used entries first
+    stats = cache.GetStats();
+    cache.SetBudget( stats.m_bytes - 1 );
+
+    SHAPE_POLY_SET_CACHE::STATS shrunk = cache.GetStats();
+
+    BOOST_CHECK_LT( shrunk.m_bytes, stats.m_bytes );
+    BOOST_CHECK_GT( shrunk.m_evictions, 0 );
+
+    SHAPE_POLY_SET third = poly;
+    third.CacheTriangulation();
+    BOOST_CHECK_EQUAL( cache.GetStats().m_hits, hits + 2 );
+
+    cache.SetBudget( 0 );
+    cache.Clear();
+}
+
+/**
+ * Boolean operations through the pooled Clipper2 buffers give the same results as with fresh
+ * buffers each time, whether the pool is cold, warm or on another thread.
+ */
+BOOST_AUTO_TEST_CASE( PooledBooleans )
+{
+    std::mt19937                       rng( 4321 );
+    std::uniform_int_distribution<int> position( 0, 10000000 );
+    std::uniform_int_distribution<int> size( 10000, 2000000 );
+
+    auto randomSet =
+            [&]( int aCount )
+            {
+                SHAPE_POLY_SET set;
+
+                for( int ii = 0; ii < aCount; ++ii )
+                {
+                    VECTOR2I pos( position( rng ), position( rng ) );
+                    VECTOR2I end = pos + VECTOR2I( size( rng ), size( rng ) );
+
+                    set.NewOutline();
+                    set.Append( pos );
+                    set.Append( end.x, pos.y );
+                    set.Append( end );
+                    set.Append( pos.x, end.y );
+                }
+
+                return set;
+            };
+
+    std::vector<std::pair<SHAPE_POLY_SET, SHAPE_POLY_SET>> operands;
+
+    for( int ii = 0; ii < 20; ++ii )
+        operands.emplace_back( randomSet( 50 ), randomSet( 50 ) );
+
+    auto runAll =
+            [&]()
+            {
+                std::vector<HASH_128> hashes;
+
+                for( const auto& [a, b] : operands )
+                {
+                    SHAPE_POLY_SET added = a;
+                    added.BooleanAdd( b, SHAPE_POLY_SET::PM_FAST );
+
+                    SHAPE_POLY_SET subtracted = a;
+                    subtracted.BooleanSubtract( b, SHAPE_POLY_SET::PM_FAST );
+
+                    SHAPE_POLY_SET intersected = a;
+                    intersected.BooleanIntersection( b, SHAPE_POLY_SET::PM_FAST );
+
+                    hashes.push_back( added.GetHash() );
+                    hashes.push_back( subtracted.GetHash() );
+                    hashes.push_back( intersected.GetHash() );
+                }
+
+                return hashes;
+            };
+
+    POLY_BOOLEAN_COUNTERS& counters = PolyBooleanCounters();
+    std::vector<HASH_128>  expected;
+
+    {
+        KI_TEST::ADVANCED_CFG_OVERRIDE<bool> pool( &ADVANCED_CFG::m_PooledPolygonBooleans,
+                                                   false );
+
+        counters.Reset();
+        expected = runAll();
+
+        BOOST_CHECK_EQUAL( counters.m_operations.Count(), 0 );
+        BOOST_CHECK_EQUAL( counters.m_pooledOperations.Count(), 0 );
+        BOOST_CHECK_EQUAL( counters.m_bufferAllocations.Count(), 0 );
+    }
+
+    KI_TEST::ADVANCED_CFG_OVERRIDE<bool> pool( &ADVANCED_CFG::m_PooledPolygonBooleans, true );
+
+    counters.Reset();
+
+    std::vector<HASH_128> cold = runAll();
+    std::vector<HASH_128> warm = runAll();
+
+    BOOST_CHECK( cold == expected );
+    BOOST_CHECK( warm == expected );
+    BOOST_CHECK_EQUAL( counters.m_operations.Count(), 2 * expected.size() );
+    BOOST_CHECK_EQUAL( counters.m_pooledOperations.Count(), 2 * expected.size() );
+
+    std::vector<std::future<std::vector<HASH_128>>> results;
+
+    for( int ii = 0; ii < 4; ++ii )
+        results.push_back( GetKiCadThreadPool().submit( runAll ) );
+
+    for( std::future<std::vector<HASH_128>>& result : results )
+        BOOST_CHECK( result.get() == expected );
+
+    BOOST_CHECK_EQUAL( counters.m_pooledOperations.Count(), 6 * expected.size() );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -23,6 +23,12 @@
 
 #include "drc_test_utils.h"
 
+#include <algorithm>
+
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_track.h>
+
 
 std::ostream& boost_test_print_type( std::ostream& os, const PCB_MARKER& aMarker )
 {
@@ -43,4 +49,31 @@ bool IsDrcMarkerOfType( const PCB_MARKER& aMarker, int aErrorCode )
     return aMarker.GetRCItem()->GetErrorCode() == aErrorCode;
 }
 
-} // namespace KI_TEST
\ No newline at end of file
+} // namespace KI_TEST
+
+
+std::vector<BOARD_ITEM*> DRC_BOARD_TEST_FIXTURE::SampleItems( size_t aCount,
+                                                              bool aIncludeFootprints ) const
+{
+    std::vector<BOARD_ITEM*> items;
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+        items.push_back( track );
+
+    for( FOOTPRINT* fp : m_board->Footprints() )
+    {
+        if( aIncludeFootprints )
+            items.push_back( fp );
+
+        for( PAD* pad : fp->Pads() )
+            items.push_back( pad );
+    }
+
+    std::vector<BOARD_ITEM*> sample;
+    size_t                   step = std::max<size_t>( 1, items.size() / aCount );
+
+    for( size_t ii = 0; ii < items.size(); ii += step )
+        sample.push_back( items[ii] );
+
+    return sample;
+}
@@ -30,8 +30,12 @@
 #define QA_PCBNEW_DRC_TEST_UTILS__H
 
 #include <iostream>
+#include <memory>
+#include <vector>
 
+#include <board.h>
 #include <pcb_marker.h>
+#include <settings/settings_manager.h>
 
 /**
  * Define a stream function for logging #PCB_MARKER test assertions.
@@ -53,4 +57,25 @@ bool IsDrcMarkerOfType( const PCB_MARKER& aMarker, int aErrorCode );
 
 } // namespace KI_TEST
 
+
+/**
+ * A board loaded into a headless settings manager, for tests which evaluate the DRC rules of
+ * a single board.
+ */
+struct DRC_BOARD_TEST_FIXTURE
+{
+    DRC_BOARD_TEST_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    /**
+     * Pick about \a aCount items (tracks, pads and optionally footprints) spread evenly over
+     * the board, so that tests of every pair of them stay quick.
+     */
+    std::vector<BOARD_ITEM*> SampleItems( size_t aCount, bool aIncludeFootprints ) const;
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
 #endif // QA_PCBNEW_DRC_TEST_UTILS__H
\ No newline at end of file
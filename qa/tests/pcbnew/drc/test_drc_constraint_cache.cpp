@@ -0,0 +1,71 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <board_design_settings.h>
+#include <reporter.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_item.h>
+
+#include "drc_test_utils.h"
+
+
+BOOST_FIXTURE_TEST_CASE( DRCConstraintCache, DRC_BOARD_TEST_FIXTURE )
+{
+    // The implicit netclass clearance rules ("A.NetClass == 'x'") are class-level only
+    KI_TEST::LoadBoard( m_settingsManager, "issue7325", m_board );
+
+    BOARD_DESIGN_SETTINGS&      bds = m_board->GetDesignSettings();
+    std::shared_ptr<DRC_ENGINE> drcEngine = bds.m_DRCEngine;
+
+    bds.m_DRCSeverities[ DRCE_COPPER_SLIVER ] = SEVERITY::RPT_SEVERITY_IGNORE;
+    bds.m_DRCSeverities[ DRCE_LIB_FOOTPRINT_ISSUES ] = SEVERITY::RPT_SEVERITY_IGNORE;
+    bds.m_DRCSeverities[ DRCE_LIB_FOOTPRINT_MISMATCH ] = SEVERITY::RPT_SEVERITY_IGNORE;
+
+    drcEngine->SetViolationHandler(
+            []( const std::shared_ptr<DRC_ITEM>& aItem, VECTOR2I aPos, int aLayer )
+            {
+            } );
+
+    drcEngine->RunTests( EDA_UNITS::MILLIMETRES, true, false );
+
+    BOOST_CHECK_GT( drcEngine->GetConstraintCacheHits(), 0u );
+    BOOST_CHECK_GT( drcEngine->GetConstraintCacheMisses(), 0u );
+
+    // Memoized results must match a full evaluation (passing a reporter bypasses the cache)
+    std::vector<BOARD_ITEM*> sample = SampleItems( 60, false );
+
+    for( BOARD_ITEM* a : sample )
+    {
+        for( BOARD_ITEM* b : sample )
+        {
+            DRC_CONSTRAINT cached = drcEngine->EvalRules( CLEARANCE_CONSTRAINT, a, b, F_Cu );
+            DRC_CONSTRAINT evaluated = drcEngine->EvalRules( CLEARANCE_CONSTRAINT, a, b, F_Cu,
+                                                             &NULL_REPORTER::GetInstance() );
+
+            BOOST_REQUIRE_EQUAL( cached.GetValue().Min(), evaluated.GetValue().Min() );
+            BOOST_REQUIRE( cached.GetParentRule() == evaluated.GetParentRule() );
+        }
+    }
+}
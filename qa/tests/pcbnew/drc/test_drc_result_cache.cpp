@@ -0,0 +1,244 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <board.h>
+#include <board_design_settings.h>
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_item.h>
+#include <drc/drc_result_cache.h>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+#include "drc_test_utils.h"
+
+
+BOOST_FIXTURE_TEST_CASE( DRCResultCache, DRC_BOARD_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "issue7325", m_board );
+
+    BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+    int                    violationCount = 0;
+
+    bds.m_DRCSeverities[ DRCE_COPPER_SLIVER ] = SEVERITY::RPT_SEVERITY_IGNORE;
+    bds.m_DRCSeverities[ DRCE_LIB_FOOTPRINT_ISSUES ] = SEVERITY::RPT_SEVERITY_IGNORE;
+    bds.m_DRCSeverities[ DRCE_LIB_FOOTPRINT_MISMATCH ] = SEVERITY::RPT_SEVERITY_IGNORE;
+
+    bds.m_DRCEngine->SetViolationHandler(
+            [&]( const std::shared_ptr<DRC_ITEM>& aItem, VECTOR2I aPos, int aLayer )
+            {
+                violationCount++;
+            } );
+
+    bds.m_DRCEngine->RunTests( EDA_UNITS::MILLIMETRES, true, false );
+
+    int      expectedViolations = violationCount;
+    wxString cacheFile = wxFileName::CreateTempFileName( wxT( "drc-cache" ) );
+
+    // First run with an empty cache: nothing can be skipped
+    {
+        DRC_RESULT_CACHE cache;
+
+        bds.m_DRCEngine->SetResultCache( &cache );
+        violationCount = 0;
+        bds.m_DRCEngine->RunTests( EDA_UNITS::MILLIMETRES, true, false );
+        bds.m_DRCEngine->SetResultCache( nullptr );
+
+        BOOST_CHECK_EQUAL( violationCount, expectedViolations );
+        BOOST_CHECK_EQUAL( cache.GetHits(), 0u );
+        BOOST_CHECK_GT( cache.GetMisses(), 0u );
+        BOOST_REQUIRE( cache.Save( cacheFile ) );
+    }
+
+    // Second run from the saved cache: clean pairs are skipped but all violations are still
+    // reported
+    {
+        DRC_RESULT_CACHE cache;
+
+        BOOST_REQUIRE( cache.Load( cacheFile ) );
+
+        bds.m_DRCEngine->SetResultCache( &cache );
+        violationCount = 0;
+        bds.m_DRCEngine->RunTests( EDA_UNITS::MILLIMETRES, true, false );
+
+        BOOST_CHECK_EQUAL( violationCount, expectedViolations );
+        BOOST_CHECK_GT( cache.GetHits(), 0u );
+
+        // Moving a track must invalidate its results
+        size_t hits = cache.GetHits();
+
+        for( PCB_TRACK* track : m_board->Tracks() )
+            track->Move( VECTOR2I( pcbIUScale.mmToIU( 0.01 ), 0 ) );
+
+        violationCount = 0;
+        bds.m_DRCEngine->RunTests( EDA_UNITS::MILLIMETRES, true, false );
+        bds.m_DRCEngine->SetResultCache( nullptr );
+
+        BOOST_CHECK_LT( cache.GetHits(), hits );
+    }
+
+    wxRemoveFile( cacheFile );
+}
+
+
+BOOST_AUTO_TEST_CASE( DRCResultCacheConditions )
+{
+    // Conditions which only read properties in the items' hashes
+    std::vector<wxString> cacheable = {
+        wxS( "A.NetClass == 'Power'" ),
+        wxS( "A.Type == 'Via' && B.NetName == 'GND'" ),
+        wxS( "A.NetClass == 'HS' && AB.isCoupledDiffPair()" ),
+        wxS( "A.Via_Type != 'Micro'" ),
+        wxS( "A.Width > 0.2mm && A.existsOnLayer('F.Cu')" ),
+        wxS( "A.hasNetclass('Parent.Value')" )
+    };
+
+    // Conditions which read the parent footprint, other items, or anything else on the board
+    std::vector<wxString> uncacheable = {
+        wxS( "A.Parent == 'U1'" ),
+        wxS( "A.memberOfFootprint('U*')" ),
+        wxS( "A.getField('Value') == '10k'" ),
+        wxS( "A.intersectsCourtyard('U1')" ),
+        wxS( "A.insideArea('HV')" ),
+        wxS( "A.inDiffPair('USB')" ),
+        wxS( "A.Pin_Type == 'power_in'" ),
+        wxS( "A.NetClass == 'x' || B.fromTo('U1-1', 'U2-1')" )
+    };
+
+    for( const wxString& condition : cacheable )
+    {
+        BOOST_TEST_CONTEXT( condition.ToStdString() )
+        {
+            BOOST_CHECK( DRC_RESULT_CACHE::IsConditionCacheable( condition ) );
+        }
+    }
+
+    for( const wxString& condition : uncacheable )
+    {
+        BOOST_TEST_CONTEXT( condition.ToStdString() )
+        {
+            BOOST_CHECK( !DRC_RESULT_CACHE::IsConditionCacheable( condition ) );
+        }
+    }
+}
+
+
+/**
+ * Edits to a parent footprint must never hide a violation: neither those read by a rule
+ * condition (which turns the cache off) nor those inherited by its pads (which are in the key).
+ */
+BOOST_FIXTURE_TEST_CASE( DRCResultCacheParentFootprintEdits, DRC_BOARD_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "issue7325", m_board );
+
+    BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+    int                    violationCount = 0;
+
+    bds.m_DRCSeverities[ DRCE_COPPER_SLIVER ] = SEVERITY::RPT_SEVERITY_IGNORE;
+    bds.m_DRCSeverities[ DRCE_LIB_FOOTPRINT_ISSUES ] = SEVERITY::RPT_SEVERITY_IGNORE;
+    bds.m_DRCSeverities[ DRCE_LIB_FOOTPRINT_MISMATCH ] = SEVERITY::RPT_SEVERITY_IGNORE;
+
+    bds.m_DRCEngine->SetViolationHandler(
+            [&]( const std::shared_ptr<DRC_ITEM>& aItem, VECTOR2I aPos, int aLayer )
+            {
+                violationCount++;
+            } );
+
+    auto runDRC =
+            [&]( DRC_RESULT_CACHE* aCache ) -> int
+            {
+                violationCount = 0;
+                bds.m_DRCEngine->SetResultCache( aCache );
+                bds.m_DRCEngine->RunTests( EDA_UNITS::MILLIMETRES, true, false );
+                bds.m_DRCEngine->SetResultCache( nullptr );
+                return violationCount;
+            };
+
+    FOOTPRINT* footprint = nullptr;
+
+    for( FOOTPRINT* candidate : m_board->Footprints() )
+    {
+        if( !footprint || candidate->Pads().size() > footprint->Pads().size() )
+            footprint = candidate;
+    }
+
+    BOOST_REQUIRE( footprint && footprint->Pads().size() > 1 );
+
+    wxString reference = footprint->GetReference();
+
+    // A rule condition reading the parent footprint
+    {
+        wxString rulesFile = wxFileName::CreateTempFileName( wxT( "drc-rules" ) );
+        wxFFile  file( rulesFile, wxS( "w" ) );
+
+        file.Write( wxS( "(version 1)\n"
+                         "(rule \"parent\"\n"
+                         "    (constraint clearance (min 5mm))\n"
+                         "    (condition \"A.memberOfFootprint('CACHE_TEST')\"))\n" ) );
+        file.Close();
+
+        bds.m_DRCEngine->InitEngine( wxFileName( rulesFile ) );
+
+        DRC_RESULT_CACHE cache;
+        int              before = runDRC( &cache );
+
+        BOOST_CHECK( !cache.IsEnabled() );
+        BOOST_CHECK_EQUAL( before, runDRC( nullptr ) );
+
+        footprint->SetReference( wxS( "CACHE_TEST" ) );
+
+        int expected = runDRC( nullptr );
+
+        BOOST_CHECK_GT( expected, before );
+        BOOST_CHECK_EQUAL( runDRC( &cache ), expected );
+        BOOST_CHECK_EQUAL( cache.GetHits(), 0u );
+
+        footprint->SetReference( reference );
+        wxRemoveFile( rulesFile );
+    }
+
+    // The parent footprint's clearance and value, without any custom rules
+    {
+        bds.m_DRCEngine->InitEngine( wxFileName() );
+
+        DRC_RESULT_CACHE cache;
+        int              before = runDRC( &cache );
+
+        BOOST_CHECK( cache.IsEnabled() );
+        BOOST_CHECK_EQUAL( runDRC( &cache ), before );
+        BOOST_CHECK_GT( cache.GetHits(), 0u );
+
+        footprint->SetValue( wxS( "CHANGED" ) );
+        footprint->SetLocalClearance( pcbIUScale.mmToIU( 5 ) );
+
+        int expected = runDRC( nullptr );
+
+        BOOST_CHECK_GT( expected, before );
+        BOOST_CHECK_EQUAL( runDRC( &cache ), expected );
+    }
+}
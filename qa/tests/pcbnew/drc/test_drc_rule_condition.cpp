@@ -0,0 +1,89 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <reporter.h>
+#include <drc/drc_rule_condition.h>
+
+#include "drc_test_utils.h"
+
+
+/**
+ * Conditions lowered to native predicates must evaluate exactly as the LIBEVAL interpreter
+ * does.  (Passing a reporter to EvaluateFor() forces the interpreter.)
+ */
+BOOST_FIXTURE_TEST_CASE( DRCRuleConditionNativePredicates, DRC_BOARD_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "issue7325", m_board );
+
+    std::vector<std::pair<wxString, bool>> conditions =
+    {
+        { "A.NetClass == 'Default'",                         true },
+        { "A.NetClass != 'Def*'",                            true },
+        { "A.NetName == 'GND'",                              true },
+        { "B.NetName != '/*'",                               true },
+        { "A.Type == 'Via'",                                 true },
+        { "A.Type == 'Pad' || B.Type == 'Track'",            true },
+        { "A.isPlated() && B.Type == 'Via'",                 true },
+        { "!A.isPlated()",                                   true },
+        { "A.intersectsCourtyard('C1*')",                    true },
+        { "A.intersectsCourtyard('B') && A.Type != 'Pad'",   true },
+        { "A.NetClass == B.NetClass",                        false },
+        { "A.Type == 'Via' && B.isPlated() || A.NetName == 'GND'", false },
+        { "A.Track_Width > 0.2mm",                           false }
+    };
+
+    // Keep the pair count manageable
+    std::vector<BOARD_ITEM*> sample = SampleItems( 60, true );
+
+    for( const auto& [expression, expectNative] : conditions )
+    {
+        BOOST_TEST_CONTEXT( expression )
+        {
+            DRC_RULE_CONDITION condition( expression );
+
+            BOOST_REQUIRE( condition.Compile( nullptr ) );
+            BOOST_CHECK_EQUAL( condition.HasNativePredicate(), expectNative );
+
+            for( BOARD_ITEM* a : sample )
+            {
+                for( BOARD_ITEM* b : sample )
+                {
+                    for( PCB_LAYER_ID layer : { F_Cu, B_Cu } )
+                    {
+                        bool native = condition.EvaluateFor( a, b, 0, layer, nullptr );
+                        bool interpreted = condition.EvaluateFor( a, b, 0, layer,
+                                                                  &NULL_REPORTER::GetInstance() );
+
+                        BOOST_REQUIRE_EQUAL( native, interpreted );
+                    }
+                }
+
+                BOOST_REQUIRE_EQUAL( condition.EvaluateFor( a, nullptr, 0, F_Cu, nullptr ),
+                                     condition.EvaluateFor( a, nullptr, 0, F_Cu,
+                                                            &NULL_REPORTER::GetInstance() ) );
+            }
+        }
+    }
+}
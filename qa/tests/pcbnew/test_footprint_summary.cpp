@@ -0,0 +1,150 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <filesystem>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_file_utils.h>
+#include <footprint.h>
+#include <richio.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_parser.h>
+
+
+static std::vector<std::filesystem::path> testLibraries()
+{
+    std::filesystem::path plugins = std::filesystem::path( KI_TEST::GetPcbnewTestDataDir() )
+                                            / "plugins";
+
+    return { plugins / "eagle" / "lbr" / "SparkFun-GPS.pretty",
+             plugins / "cadstar" / "lib" / "footprint-with-thermal-pad.pretty",
+             plugins / "altium" / "pcblib" / "Espressif ESP32-WROOM-32.pretty",
+             plugins / "altium" / "pcblib" / "Tracks.pretty" };
+}
+
+
+BOOST_AUTO_TEST_SUITE( FootprintSummary )
+
+
+/**
+ * The summary parser must agree with the fully loaded footprint
+ */
+BOOST_AUTO_TEST_CASE( MatchesFullParse )
+{
+    int count = 0;
+
+    for( const std::filesystem::path& libPath : testLibraries() )
+    {
+        for( const auto& dirEntry : std::filesystem::directory_iterator( libPath ) )
+        {
+            if( dirEntry.path().extension() != ".kicad_mod" )
+                continue;
+
+            BOOST_TEST_CONTEXT( dirEntry.path().string() )
+            {
+                FILE_LINE_READER          fullReader( dirEntry.path().string() );
+                PCB_IO_KICAD_SEXPR_PARSER fullParser( &fullReader, nullptr, nullptr );
+
+                std::unique_ptr<FOOTPRINT> footprint(
+                        dynamic_cast<FOOTPRINT*>( fullParser.Parse() ) );
+
+                BOOST_REQUIRE( footprint );
+
+                FILE_LINE_READER          reader( dirEntry.path().string() );
+                PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, nullptr );
+                FOOTPRINT_SUMMARY         summary;
+
+                BOOST_REQUIRE( parser.ParseFootprintSummary( summary ) );
+
+                BOOST_CHECK_EQUAL( summary.m_description, footprint->GetLibDescription() );
+                BOOST_CHECK_EQUAL( summary.m_keywords, footprint->GetKeywords() );
+                BOOST_CHECK_EQUAL( summary.m_padCount,
+                                   footprint->GetPadCount( DO_NOT_INCLUDE_NPTH ) );
+                BOOST_CHECK_EQUAL( summary.m_uniquePadCount,
+                                   footprint->GetUniquePadCount( DO_NOT_INCLUDE_NPTH ) );
+                count++;
+            }
+        }
+    }
+
+    BOOST_CHECK_GT( count, 0 );
+}
+
+
+BOOST_AUTO_TEST_CASE( NotAFootprint )
+{
+    STRING_LINE_READER        reader( "(kicad_pcb (version 20240108))", "test" );
+    PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, nullptr );
+    FOOTPRINT_SUMMARY         summary;
+
+    BOOST_CHECK( !parser.ParseFootprintSummary( summary ) );
+}
+
+
+/**
+ * Reading the summaries of a library should list the same footprints as enumerating it
+ */
+BOOST_AUTO_TEST_CASE( PluginEnumeration )
+{
+    for( const std::filesystem::path& libPath : testLibraries() )
+    {
+        BOOST_TEST_CONTEXT( libPath.string() )
+        {
+            PCB_IO_KICAD_SEXPR             summaryPlugin;
+            std::vector<FOOTPRINT_SUMMARY> summaries;
+
+            summaryPlugin.FootprintEnumerateSummaries( summaries, libPath.string(), false );
+
+            PCB_IO_KICAD_SEXPR plugin;
+            wxArrayString      names;
+
+            plugin.FootprintEnumerate( names, libPath.string(), false );
+
+            BOOST_REQUIRE_EQUAL( summaries.size(), names.size() );
+
+            for( const FOOTPRINT_SUMMARY& summary : summaries )
+            {
+                BOOST_CHECK( names.Index( summary.m_name ) != wxNOT_FOUND );
+
+                const FOOTPRINT* footprint = plugin.GetEnumeratedFootprint( libPath.string(),
+                                                                            summary.m_name );
+
+                BOOST_REQUIRE( footprint );
+                BOOST_CHECK_EQUAL( summary.m_padCount,
+                                   footprint->GetPadCount( DO_NOT_INCLUDE_NPTH ) );
+            }
+
+            // Previews load just the one footprint
+            if( !summaries.empty() )
+            {
+                PCB_IO_KICAD_SEXPR previewPlugin;
+
+                BOOST_CHECK( previewPlugin.GetEnumeratedFootprint( libPath.string(),
+                                                                   summaries[0].m_name ) );
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
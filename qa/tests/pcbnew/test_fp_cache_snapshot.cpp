@@ -0,0 +1,149 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include <wx/filename.h>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_file_utils.h>
+#include <footprint.h>
+#include <richio.h>
+#include <pcb_io/kicad_sexpr/fp_cache_snapshot.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_parser.h>
+
+
+static std::string readFile( const std::filesystem::path& aPath )
+{
+    std::ifstream     file( aPath, std::ios::binary );
+    std::stringstream buffer;
+
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+
+BOOST_AUTO_TEST_SUITE( FpCacheSnapshot )
+
+
+BOOST_AUTO_TEST_CASE( RoundTrip )
+{
+    std::filesystem::path libPath = std::filesystem::path( KI_TEST::GetPcbnewTestDataDir() )
+                                            / "plugins" / "eagle" / "lbr" / "SparkFun-GPS.pretty";
+    wxString              snapshotFile = ( std::filesystem::temp_directory_path()
+                                           / "fp_cache_snapshot_test.fpcache" ).string();
+
+    std::map<std::string, std::string> files;
+
+    for( const auto& dirEntry : std::filesystem::directory_iterator( libPath ) )
+        files[dirEntry.path().filename().string()] = readFile( dirEntry.path() );
+
+    BOOST_REQUIRE( !files.empty() );
+
+    {
+        FP_CACHE_SNAPSHOT::WRITER writer( snapshotFile, libPath.string() );
+        long long                 timestamp = 0;
+
+        BOOST_REQUIRE( writer.IsOk() );
+
+        for( const auto& [name, text] : files )
+            writer.Add( name, ++timestamp, text.size(), text );
+
+        BOOST_REQUIRE( writer.Commit( 1234 ) );
+    }
+
+    {
+        FP_CACHE_SNAPSHOT snapshot;
+
+        BOOST_REQUIRE( snapshot.Open( snapshotFile, libPath.string() ) );
+        BOOST_CHECK_EQUAL( snapshot.GetLibraryTimestamp(), 1234 );
+        BOOST_CHECK_EQUAL( snapshot.GetCount(), files.size() );
+        BOOST_CHECK( snapshot.Find( "no_such_footprint.kicad_mod" ) == nullptr );
+
+        long long timestamp = 0;
+
+        for( const auto& [name, text] : files )
+        {
+            BOOST_TEST_CONTEXT( name )
+            {
+                const FP_CACHE_SNAPSHOT::ENTRY* entry = snapshot.Find( name );
+
+                BOOST_REQUIRE( entry );
+                BOOST_CHECK_EQUAL( entry->m_timestamp, ++timestamp );
+                BOOST_CHECK_EQUAL( entry->m_size, text.size() );
+                BOOST_CHECK( entry->m_text == text );
+
+                // Footprints can be parsed straight out of the snapshot
+                STRING_VIEW_LINE_READER     reader( entry->m_text, name );
+                PCB_IO_KICAD_SEXPR_PARSER   parser( &reader, nullptr, nullptr );
+                std::unique_ptr<BOARD_ITEM> item( parser.Parse() );
+
+                BOOST_CHECK( dynamic_cast<FOOTPRINT*>( item.get() ) );
+            }
+        }
+    }
+
+    // A snapshot of a different library mustn't be used, even if the names collide
+    {
+        FP_CACHE_SNAPSHOT snapshot;
+
+        BOOST_CHECK( !snapshot.Open( snapshotFile, wxS( "/some/other/library.pretty" ) ) );
+        BOOST_CHECK_EQUAL( snapshot.GetCount(), 0 );
+    }
+
+    // Nor a truncated one
+    std::filesystem::resize_file( snapshotFile.ToStdString(),
+                                  std::filesystem::file_size( snapshotFile.ToStdString() ) - 1 );
+
+    {
+        FP_CACHE_SNAPSHOT snapshot;
+
+        BOOST_CHECK( !snapshot.Open( snapshotFile, libPath.string() ) );
+    }
+
+    wxRemoveFile( snapshotFile );
+}
+
+
+BOOST_AUTO_TEST_CASE( UncommittedWriterLeavesNoSnapshot )
+{
+    wxString snapshotFile = ( std::filesystem::temp_directory_path()
+                              / "fp_cache_snapshot_uncommitted.fpcache" ).string();
+
+    wxRemoveFile( snapshotFile );
+
+    {
+        FP_CACHE_SNAPSHOT::WRITER writer( snapshotFile, wxS( "lib.pretty" ) );
+
+        BOOST_REQUIRE( writer.IsOk() );
+        writer.Add( "a.kicad_mod", 1, 1, "(" );
+    }
+
+    BOOST_CHECK( !wxFileName::FileExists( snapshotFile ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
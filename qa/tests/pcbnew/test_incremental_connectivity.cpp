@@ -0,0 +1,311 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <tuple>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <board.h>
+#include <pcb_track.h>
+#include <connectivity/connectivity_algo.h>
+#include <connectivity/connectivity_data.h>
+#include <ratsnest/ratsnest_data.h>
+#include <settings/settings_manager.h>
+
+
+struct INCREMENTAL_CONNECTIVITY_FIXTURE
+{
+    INCREMENTAL_CONNECTIVITY_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+// Connectivity items are identified by their board item, and for zones by the outline
+using CN_KEY = std::tuple<const BOARD_CONNECTED_ITEM*, int, int>;
+
+struct CLUSTER_INFO
+{
+    bool m_orphaned;
+    int  m_net;
+
+    bool operator==( const CLUSTER_INFO& aOther ) const
+    {
+        return m_orphaned == aOther.m_orphaned && m_net == aOther.m_net;
+    }
+};
+
+
+/**
+ * Reduce clusters to something which doesn't depend on the CN_ITEMs or the order they were
+ * searched in.
+ */
+static std::map<std::vector<CN_KEY>, CLUSTER_INFO>
+describeClusters( const CN_CONNECTIVITY_ALGO::CLUSTERS& aClusters, bool aWithNets )
+{
+    std::map<std::vector<CN_KEY>, CLUSTER_INFO> result;
+
+    for( const std::shared_ptr<CN_CLUSTER>& cluster : aClusters )
+    {
+        std::vector<CN_KEY> keys;
+
+        for( CN_ITEM* item : *cluster )
+        {
+            if( CN_ZONE_LAYER* zoneLayer = dynamic_cast<CN_ZONE_LAYER*>( item ) )
+            {
+                keys.emplace_back( item->Parent(), zoneLayer->GetLayer(),
+                                   zoneLayer->SubpolyIndex() );
+            }
+            else
+            {
+                keys.emplace_back( item->Parent(), -1, -1 );
+            }
+        }
+
+        std::sort( keys.begin(), keys.end() );
+
+        // Where nets are mixed the origin net depends on the search order
+        result[keys] = { cluster->IsOrphaned(), aWithNets ? cluster->OriginNet() : 0 };
+    }
+
+    return result;
+}
+
+
+static void checkAgainstFullBuild( BOARD* aBoard, CN_CONNECTIVITY_ALGO* aAlgo )
+{
+    static const std::vector<KICAD_T> withoutZones = { PCB_TRACE_T, PCB_ARC_T, PCB_PAD_T,
+                                                       PCB_VIA_T, PCB_FOOTPRINT_T, PCB_SHAPE_T };
+    static const std::vector<KICAD_T> withZones = { PCB_TRACE_T, PCB_ARC_T, PCB_PAD_T, PCB_VIA_T,
+                                                    PCB_ZONE_T, PCB_FOOTPRINT_T, PCB_SHAPE_T };
+
+    CONNECTIVITY_DATA    referenceData;
+    CN_CONNECTIVITY_ALGO reference( &referenceData );
+
+    reference.Build( aBoard );
+
+    auto check =
+            [&]( CN_CONNECTIVITY_ALGO::CLUSTER_SEARCH_MODE aMode,
+                 const std::vector<KICAD_T>& aTypes, bool aWithNets )
+            {
+                auto incremental = describeClusters( aAlgo->SearchClusters( aMode ), aWithNets );
+                auto full = describeClusters( reference.SearchClusters( aMode, aTypes, -1 ),
+                                              aWithNets );
+
+                BOOST_REQUIRE_EQUAL( incremental.size(), full.size() );
+                BOOST_CHECK( incremental == full );
+            };
+
+    check( CN_CONNECTIVITY_ALGO::CSM_PROPAGATE, withoutZones, false );
+    check( CN_CONNECTIVITY_ALGO::CSM_RATSNEST, withZones, true );
+}
+
+
+/**
+ * Apply random edits to the board, checking the incrementally updated clusters against
+ * clusters found from scratch after each one.
+ */
+BOOST_FIXTURE_TEST_CASE( IncrementalClustersMatchFullBuild, INCREMENTAL_CONNECTIVITY_FIXTURE )
+{
+    for( const wxString& file : { "issue8883", "intersectingzones", "issue5093" } )
+    {
+        KI_TEST::LoadBoard( m_settingsManager, file, m_board );
+
+        BOARD*                  board = m_board.get();
+        CN_CONNECTIVITY_ALGO*   algo = board->GetConnectivity()->GetConnectivityAlgo().get();
+        std::vector<PCB_TRACK*> removed;
+        std::vector<PAD*>       pads = board->GetPads();
+        std::mt19937            rng( 1234 );
+
+        BOOST_TEST_CONTEXT( file )
+        {
+            checkAgainstFullBuild( board, algo );
+
+            for( int ii = 0; ii < 100; ++ii )
+            {
+                std::vector<PCB_TRACK*> tracks( board->Tracks().begin(), board->Tracks().end() );
+
+                if( tracks.empty() )
+                    break;
+
+                PCB_TRACK* track = tracks[rng() % tracks.size()];
+
+                switch( rng() % 5 )
+                {
+                case 0:     // delete a track
+                    board->Remove( track );
+                    algo->Remove( track );
+                    removed.push_back( track );
+                    break;
+
+                case 1:     // put one back
+                    if( !removed.empty() )
+                    {
+                        board->Add( removed.back() );
+                        removed.pop_back();
+                    }
+
+                    break;
+
+                case 2:     // move a track
+                    algo->Remove( track );
+                    track->Move( VECTOR2I( (int) ( rng() % 2000000 ) - 1000000,
+                                           (int) ( rng() % 2000000 ) - 1000000 ) );
+                    algo->Add( track );
+                    break;
+
+                case 3:     // change a track's net behind the connectivity's back, as net
+                            // propagation does
+                    track->SetNetCode( rng() % std::max( 1, (int) board->GetNetCount() ) );
+                    break;
+
+                case 4:     // re-add a pad
+                    if( !pads.empty() )
+                    {
+                        PAD* pad = pads[rng() % pads.size()];
+
+                        algo->Remove( pad );
+                        algo->Add( pad );
+                    }
+
+                    break;
+                }
+
+                BOOST_TEST_CONTEXT( "edit " << ii )
+                {
+                    checkAgainstFullBuild( board, algo );
+                }
+            }
+        }
+
+        for( PCB_TRACK* track : removed )
+            board->Add( track );
+    }
+}
+
+
+/**
+ * Reduce each net's ratsnest to the sorted weights of its edges.  All minimum spanning trees of
+ * a net share these, whichever of several equally short edges they picked.
+ */
+static std::map<int, std::vector<unsigned>> describeRatsnest( CONNECTIVITY_DATA* aData )
+{
+    std::map<int, std::vector<unsigned>> result;
+
+    for( int net = 1; net < aData->GetNetCount(); ++net )
+    {
+        RN_NET* rnNet = aData->GetRatsnestForNet( net );
+
+        if( !rnNet )
+            continue;
+
+        std::vector<unsigned>& weights = result[net];
+
+        for( const CN_EDGE& edge : rnNet->GetEdges() )
+            weights.push_back( edge.GetWeight() );
+
+        std::sort( weights.begin(), weights.end() );
+    }
+
+    return result;
+}
+
+
+/**
+ * Nets keep their previous triangulation and only rebuild their spanning tree when no anchors
+ * have moved.  After each edit the ratsnest must match one computed from scratch.
+ */
+BOOST_FIXTURE_TEST_CASE( IncrementalRatsnestMatchesFullBuild, INCREMENTAL_CONNECTIVITY_FIXTURE )
+{
+    for( const wxString& file : { "issue8883", "intersectingzones", "issue5093", "issue7325" } )
+    {
+        KI_TEST::LoadBoard( m_settingsManager, file, m_board );
+
+        BOARD*                  board = m_board.get();
+        CONNECTIVITY_DATA*      connectivity = board->GetConnectivity().get();
+        std::vector<PCB_TRACK*> removed;
+        std::mt19937            rng( 1234 );
+
+        BOOST_TEST_CONTEXT( file )
+        {
+            for( int ii = 0; ii < 50; ++ii )
+            {
+                std::vector<PCB_TRACK*> tracks( board->Tracks().begin(), board->Tracks().end() );
+
+                if( tracks.empty() )
+                    break;
+
+                PCB_TRACK* track = tracks[rng() % tracks.size()];
+
+                switch( rng() % 4 )
+                {
+                case 0:     // change a track's width, which leaves the anchors where they are
+                    track->SetWidth( rng() % 2 ? track->GetWidth() * 4 : track->GetWidth() / 4 );
+                    connectivity->Update( track );
+                    break;
+
+                case 1:     // delete a track
+                    board->Remove( track );
+                    removed.push_back( track );
+                    break;
+
+                case 2:     // put one back
+                    if( !removed.empty() )
+                    {
+                        board->Add( removed.back() );
+                        removed.pop_back();
+                    }
+
+                    break;
+
+                case 3:     // move a track
+                    connectivity->Remove( track );
+                    track->Move( VECTOR2I( (int) ( rng() % 2000000 ) - 1000000,
+                                           (int) ( rng() % 2000000 ) - 1000000 ) );
+                    connectivity->Add( track );
+                    break;
+                }
+
+                connectivity->RecalculateRatsnest();
+
+                CONNECTIVITY_DATA reference;
+                reference.Build( board );
+
+                BOOST_TEST_CONTEXT( "edit " << ii )
+                {
+                    BOOST_CHECK( describeRatsnest( connectivity ) == describeRatsnest( &reference ) );
+                    BOOST_CHECK_EQUAL( connectivity->GetUnconnectedCount( false ),
+                                       reference.GetUnconnectedCount( false ) );
+                }
+            }
+        }
+
+        for( PCB_TRACK* track : removed )
+            board->Add( track );
+    }
+}
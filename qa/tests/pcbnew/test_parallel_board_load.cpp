@@ -0,0 +1,164 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_file_utils.h>
+#include <board.h>
+#include <footprint.h>
+#include <pcb_track.h>
+#include <zone.h>
+#include <richio.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_parser.h>
+
+
+static std::string readFile( const std::string& aPath )
+{
+    std::ifstream     file( aPath, std::ios::binary );
+    std::stringstream buffer;
+
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+
+template <class CONTAINER>
+static std::vector<KIID> uuids( const CONTAINER& aItems )
+{
+    std::vector<KIID> ids;
+
+    for( const BOARD_ITEM* item : aItems )
+        ids.push_back( item->m_Uuid );
+
+    return ids;
+}
+
+
+BOOST_AUTO_TEST_SUITE( ParallelBoardLoad )
+
+
+BOOST_AUTO_TEST_CASE( SplitKeepsLineNumbers )
+{
+    std::string text = readFile( KI_TEST::GetPcbnewTestDataDir() + "issue5313.kicad_pcb" );
+
+    PCB_BULK_ITEMS bulkItems;
+
+    BOOST_REQUIRE( bulkItems.Split( text ) );
+    BOOST_CHECK_EQUAL( std::count( text.begin(), text.end(), '\n' ),
+                       std::count( bulkItems.m_skeleton.begin(), bulkItems.m_skeleton.end(),
+                                   '\n' ) );
+
+    for( const PCB_BULK_ITEMS::RANGE& range : bulkItems.m_ranges )
+    {
+        BOOST_CHECK_EQUAL( text[range.m_offset], '(' );
+        BOOST_CHECK_EQUAL( text[range.m_offset + range.m_length - 1], ')' );
+        BOOST_CHECK_EQUAL( range.m_line, 1 + std::count( text.begin(),
+                                                         text.begin() + range.m_offset,
+                                                         '\n' ) );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( SplitRejectsUnexpectedLayout )
+{
+    PCB_BULK_ITEMS bulkItems;
+
+    // A net following the first track
+    BOOST_CHECK( !bulkItems.Split( "(kicad_pcb (version 20240108)\n"
+                                   "  (segment (start 0 0) (end 1 1) (width 0.2) (layer \"F.Cu\") (net 1))\n"
+                                   "  (net 1 \"GND\")\n"
+                                   ")\n" ) );
+
+    // Nothing to parse in parallel
+    BOOST_CHECK( !bulkItems.Split( "(kicad_pcb (version 20240108)\n"
+                                   "  (net 0 \"\")\n"
+                                   ")\n" ) );
+
+    // Unbalanced
+    BOOST_CHECK( !bulkItems.Split( "(kicad_pcb (version 20240108)\n"
+                                   "  (segment (start 0 0) (end 1 1) (layer \"F.Cu\")\n" ) );
+
+    // Parentheses in strings
+    BOOST_CHECK( bulkItems.Split( "(kicad_pcb (version 20240108)\n"
+                                  "  (net 1 \"a)b\\\")\")\n"
+                                  "  (segment (start 0 0) (end 1 1) (layer \"F.Cu\") (net 1))\n"
+                                  ")\n" ) );
+    BOOST_CHECK_EQUAL( bulkItems.m_ranges.size(), 1 );
+}
+
+
+BOOST_AUTO_TEST_CASE( MatchesSerialLoad )
+{
+    std::vector<std::string> tests = { "issue5313",
+                                       "issue12609",
+                                       "issue16566",
+                                       "api_kitchen_sink",
+                                       "footprints_load_save",
+                                       "intersectingzones" };
+
+    std::filesystem::path serialPath = std::filesystem::temp_directory_path()
+                                                / "parallel_load_serial.kicad_pcb";
+    std::filesystem::path parallelPath = std::filesystem::temp_directory_path()
+                                                / "parallel_load_parallel.kicad_pcb";
+
+    for( const std::string& name : tests )
+    {
+        BOOST_TEST_CONTEXT( name )
+        {
+            std::string path = KI_TEST::GetPcbnewTestDataDir() + name + ".kicad_pcb";
+            std::string text = readFile( path );
+
+            PCB_BULK_ITEMS bulkItems;
+
+            BOOST_REQUIRE( bulkItems.Split( text ) );
+
+            PCB_IO_KICAD_SEXPR     io;
+            STRING_LINE_READER     serialReader( text, path );
+            STRING_LINE_READER     skeletonReader( bulkItems.m_skeleton, path );
+            std::unique_ptr<BOARD> serial( io.DoLoad( serialReader, nullptr, nullptr, nullptr,
+                                                      0 ) );
+            std::unique_ptr<BOARD> parallel( io.DoLoad( skeletonReader, nullptr, nullptr,
+                                                        nullptr, 0, &bulkItems ) );
+
+            BOOST_REQUIRE( serial && parallel );
+
+            BOOST_CHECK( uuids( serial->Footprints() ) == uuids( parallel->Footprints() ) );
+            BOOST_CHECK( uuids( serial->Tracks() ) == uuids( parallel->Tracks() ) );
+            BOOST_CHECK( uuids( serial->Zones() ) == uuids( parallel->Zones() ) );
+            BOOST_CHECK_EQUAL( serial->GetNetCount(), parallel->GetNetCount() );
+
+            KI_TEST::DumpBoardToFile( *serial, serialPath.string() );
+            KI_TEST::DumpBoardToFile( *parallel, parallelPath.string() );
+
+            BOOST_CHECK( readFile( serialPath.string() ) == readFile( parallelPath.string() ) );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -22,6 +22,7 @@
  */
 
 #include <qa_utils/wx_utils/unit_test_utils.h>
+#include <qa_utils/advanced_config_override.h>
 #include <settings/settings_manager.h>
 
 #include <pcbnew/pad.h>
@@ -30,6 +31,8 @@
 #include <router/pns_node.h>
 #include <router/pns_router.h>
 #include <router/pns_item.h>
+#include <router/pns_line.h>
+#include <router/pns_shove.h>
 #include <router/pns_via.h>
 #include <router/pns_kicad_iface.h>
 
@@ -410,3 +413,177 @@ BOOST_FIXTURE_TEST_CASE( PNSHoleCollisions, PNS_TEST_FIXTURE )
     }
 }
 
+
+
+/**
+ * Branches share their parent's index and joints until they change them.  Build a chain of
+ * branches, each removing some of its ancestors' vias and adding one of its own, and check
+ * that every branch still sees exactly its own version of the world.
+ */
+BOOST_FIXTURE_TEST_CASE( PNSBranchesAreIndependent, PNS_TEST_FIXTURE )
+{
+    const int depth = 12;
+
+    std::unique_ptr<PNS::NODE> world( new PNS::NODE );
+
+    world->SetMaxClearance( 10000000 );
+    world->SetRuleResolver( &m_ruleResolver );
+
+    auto rootPos =
+            []( int aIndex )
+            {
+                return VECTOR2I( aIndex * 1000000, 0 );
+            };
+
+    auto branchPos =
+            []( int aIndex )
+            {
+                return VECTOR2I( aIndex * 1000000, 5000000 );
+            };
+
+    auto hasVia =
+            []( PNS::NODE* aNode, const VECTOR2I& aPos )
+            {
+                bool hit = aNode->HitTest( aPos ).Count( PNS::ITEM::VIA_T ) > 0;
+
+                const PNS::JOINT* jt = aNode->FindJoint( aPos, F_Cu, nullptr );
+                bool linked = jt && jt->LinkCount( PNS::ITEM::VIA_T ) > 0;
+
+                BOOST_CHECK_EQUAL( hit, linked );
+                return hit;
+            };
+
+    std::vector<PNS::VIA*> rootVias;
+
+    for( int ii = 0; ii < depth; ++ii )
+    {
+        rootVias.push_back( new PNS::VIA( rootPos( ii ), LAYER_RANGE( F_Cu, B_Cu ), 50000,
+                                          10000 ) );
+        world->AddRaw( rootVias.back() );
+    }
+
+    // Branch ii removes root via ii and, if ii is odd, the via added by its parent
+    std::vector<PNS::NODE*> branches;
+    PNS::NODE*              node = world.get();
+
+    for( int ii = 0; ii < depth; ++ii )
+    {
+        PNS::VIA* parentVia = nullptr;
+
+        if( ii > 0 )
+        {
+            for( PNS::ITEM* item : node->HitTest( branchPos( ii - 1 ) ).CItems() )
+            {
+                if( item->OfKind( PNS::ITEM::VIA_T ) )
+                    parentVia = static_cast<PNS::VIA*>( item );
+            }
+        }
+
+        node = node->Branch();
+        branches.push_back( node );
+
+        node->Remove( rootVias[ii] );
+
+        if( ii % 2 == 1 )
+            node->Remove( parentVia );
+
+        node->Add( std::make_unique<PNS::VIA>( branchPos( ii ), LAYER_RANGE( F_Cu, B_Cu ), 50000,
+                                               10000 ) );
+    }
+
+    auto checkNode =
+            [&]( PNS::NODE* aNode, int aLastBranch )
+            {
+                for( int ii = 0; ii < depth; ++ii )
+                {
+                    BOOST_TEST_CONTEXT( "Branch " << aLastBranch << ", via " << ii )
+                    {
+                        bool branchViaRemoved = ii % 2 == 0 && ii + 1 <= aLastBranch;
+
+                        BOOST_CHECK_EQUAL( hasVia( aNode, rootPos( ii ) ), ii > aLastBranch );
+                        BOOST_CHECK_EQUAL( hasVia( aNode, branchPos( ii ) ),
+                                           ii <= aLastBranch && !branchViaRemoved );
+                    }
+                }
+            };
+
+    checkNode( world.get(), -1 );
+
+    for( int ii = 0; ii < depth; ++ii )
+    {
+        BOOST_CHECK_EQUAL( branches[ii]->Depth(), ii + 1 );
+        checkNode( branches[ii], ii );
+    }
+
+    world->Commit( branches.back() );
+    checkNode( world.get(), depth - 1 );
+}
+
+
+/**
+ * Shoving a line around a long head line tries its walkarounds on the thread pool when
+ * ParallelShove is on.  Whatever the outcome, it must be the one the sequential attempts give.
+ */
+BOOST_FIXTURE_TEST_CASE( PNSParallelShoveMatchesSerial, PNS_TEST_FIXTURE )
+{
+    std::unique_ptr<PNS::NODE> world( new PNS::NODE );
+
+    world->SetMaxClearance( 10000000 );
+    world->SetRuleResolver( &m_ruleResolver );
+
+    // Enough head segments for the walkarounds to be worth handing out
+    SHAPE_LINE_CHAIN head;
+
+    for( int ii = 0; ii <= 40; ++ii )
+        head.Append( ii * 1000000, ( ii % 2 ) * 200000 );
+
+    PNS::LINE curLine;
+    curLine.SetLayer( F_Cu );
+    curLine.SetWidth( 100000 );
+    curLine.SetShape( head );
+
+    int shoved = 0;
+
+    for( int offset = -1500000; offset <= 1500000; offset += 100000 )
+    {
+        SHAPE_LINE_CHAIN obstacle;
+
+        for( int ii = 0; ii <= 10; ++ii )
+            obstacle.Append( -5000000 + ii * 5000000, offset + ( ii % 3 ) * 150000 );
+
+        PNS::LINE obstacleLine;
+        obstacleLine.SetLayer( F_Cu );
+        obstacleLine.SetWidth( 100000 );
+        obstacleLine.SetShape( obstacle );
+
+        auto shove =
+                [&]( bool aParallel, PNS::LINE& aResult )
+                {
+                    KI_TEST::ADVANCED_CFG_OVERRIDE<bool> parallel( &ADVANCED_CFG::m_ParallelShove,
+                                                                   aParallel );
+
+                    PNS::SHOVE shove( world.get(), m_router );
+                    return shove.ShoveObstacleLine( curLine, obstacleLine, aResult );
+                };
+
+        PNS::LINE serialResult;
+        PNS::LINE parallelResult;
+
+        PNS::SHOVE::SHOVE_STATUS serial = shove( false, serialResult );
+
+        BOOST_TEST_CONTEXT( "Obstacle offset " << offset )
+        {
+            // Repeat, so that the attempts finish in different orders
+            for( int ii = 0; ii < 10; ++ii )
+            {
+                BOOST_CHECK_EQUAL( shove( true, parallelResult ), serial );
+                BOOST_CHECK( parallelResult.CLine().CompareGeometry( serialResult.CLine() ) );
+            }
+        }
+
+        if( serial == PNS::SHOVE::SH_OK )
+            shoved++;
+    }
+
+    BOOST_CHECK_GT( shoved, 0 );
+}
@@ -22,6 +22,7 @@
  */
 
 #include <qa_utils/wx_utils/unit_test_utils.h>
+#include <qa_utils/advanced_config_override.h>
 #include <pcbnew_utils/board_test_utils.h>
 #include <board.h>
 #include <board_design_settings.h>
@@ -29,6 +30,10 @@
 #include <pcb_track.h>
 #include <footprint.h>
 #include <zone.h>
+#include <zone_filler.h>
+#include <board_commit.h>
+#include <tool/tool_manager.h>
+#include <core/thread_pool.h>
 #include <drc/drc_item.h>
 #include <settings/settings_manager.h>
 
@@ -135,6 +140,82 @@ BOOST_FIXTURE_TEST_CASE( BasicZoneFills, ZONE_FILL_TEST_FIXTURE )
 }
 
 
+/**
+ * Removing islands and counting thermal spokes through the index of fill outlines must give
+ * exactly the fills and markers of testing every outline.
+ */
+BOOST_FIXTURE_TEST_CASE( ZoneAdjacencyIndexMatches, ZONE_FILL_TEST_FIXTURE )
+{
+    for( const wxString& relPath : { wxString( wxS( "zone_filler" ) ),
+                                     wxString( wxS( "notched_zones" ) ),
+                                     wxString( wxS( "issue5313" ) ),
+                                     wxString( wxS( "issue6260" ) ),
+                                     wxString( wxS( "issue7086" ) ) } )
+    {
+        KI_TEST::LoadBoard( m_settingsManager, relPath, m_board );
+
+        BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+        std::vector<wxString>  fills;
+        std::vector<wxString>  markers;
+
+        bds.m_DRCEngine->SetViolationHandler(
+                [&]( const std::shared_ptr<DRC_ITEM>& aItem, VECTOR2I aPos, int aLayer )
+                {
+                    markers.push_back( wxString::Format( wxS( "%d %d %d,%d %s %s" ),
+                                                         aItem->GetErrorCode(), aLayer,
+                                                         aPos.x, aPos.y,
+                                                         aItem->GetMainItemID().AsString(),
+                                                         aItem->GetErrorMessage() ) );
+                } );
+
+        auto fillAndRunDRC =
+                [&]( bool aUseIndex )
+                {
+                    KI_TEST::ADVANCED_CFG_OVERRIDE<bool> index( &ADVANCED_CFG::m_ZoneAdjacencyIndex,
+                                                                aUseIndex );
+
+                    KI_TEST::FillZones( m_board.get() );
+
+                    fills.clear();
+
+                    for( ZONE* zone : m_board->Zones() )
+                    {
+                        zone->GetLayerSet().RunOnLayers(
+                                [&]( PCB_LAYER_ID aLayer )
+                                {
+                                    if( !zone->HasFilledPolysForLayer( aLayer ) )
+                                        return;
+
+                                    HASH_128 hash = zone->GetFilledPolysList( aLayer )->GetHash();
+
+                                    fills.push_back( wxString::Format( wxS( "%s %d %s" ),
+                                                                       zone->m_Uuid.AsString(),
+                                                                       aLayer, hash.ToString() ) );
+                                } );
+                    }
+
+                    markers.clear();
+                    bds.m_DRCEngine->RunTests( EDA_UNITS::MILLIMETRES, true, false );
+                    std::sort( markers.begin(), markers.end() );
+                };
+
+        fillAndRunDRC( false );
+        std::vector<wxString> expectedFills = fills;
+        std::vector<wxString> expectedMarkers = markers;
+
+        fillAndRunDRC( true );
+
+        BOOST_TEST_CONTEXT( relPath.ToStdString() )
+        {
+            BOOST_CHECK_EQUAL_COLLECTIONS( fills.begin(), fills.end(), expectedFills.begin(),
+                                           expectedFills.end() );
+            BOOST_CHECK_EQUAL_COLLECTIONS( markers.begin(), markers.end(),
+                                           expectedMarkers.begin(), expectedMarkers.end() );
+        }
+    }
+}
+
+
 BOOST_FIXTURE_TEST_CASE( NotchedZones, ZONE_FILL_TEST_FIXTURE )
 {
     KI_TEST::LoadBoard( m_settingsManager, "notched_zones", m_board );
@@ -299,3 +380,230 @@ BOOST_FIXTURE_TEST_CASE( RegressionTeardropFill, ZONE_FILL_TEST_FIXTURE )
     }
 }
 
+
+
+/**
+ * Nudging a short track and refilling only around it must take the incremental path, and give
+ * (up to round-off along the splices) the copper of a full refill.
+ */
+BOOST_FIXTURE_TEST_CASE( IncrementalZoneFill, ZONE_FILL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+
+    TOOL_MANAGER toolMgr;
+    toolMgr.SetEnvironment( m_board.get(), nullptr, nullptr, nullptr, nullptr );
+
+    KI_TEST::DUMMY_TOOL* dummyTool = new KI_TEST::DUMMY_TOOL();
+    toolMgr.RegisterTool( dummyTool );
+
+    ZONE_FILL_CACHE cache;
+
+    // Returns the number of zone layers which were refilled incrementally
+    auto fillZones =
+            [&]( ZONE_FILL_CACHE* aCache, const std::map<ZONE*, ZONE_DIRTY_AREAS>& aDirtyAreas )
+            {
+                BOARD_COMMIT       commit( dummyTool );
+                ZONE_FILLER        filler( m_board.get(), &commit );
+                std::vector<ZONE*> toFill;
+
+                for( ZONE* zone : m_board->Zones() )
+                    toFill.push_back( zone );
+
+                filler.SetIncrementalFill( aCache, aDirtyAreas );
+
+                if( filler.Fill( toFill, false, nullptr ) )
+                {
+                    commit.Push( _( "Fill Zone(s)" ),
+                                 SKIP_UNDO | SKIP_SET_DIRTY | ZONE_FILL_OP | SKIP_CONNECTIVITY );
+                }
+
+                return filler.GetIncrementalRefillCount();
+            };
+
+    // The shortest tracks which lie within a copper zone, so the dirty areas are only a small
+    // part of the zones around them
+    std::vector<PCB_TRACK*> candidates;
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        if( track->Type() != PCB_TRACE_T )
+            continue;
+
+        for( ZONE* zone : m_board->Zones() )
+        {
+            if( zone->IsOnLayer( track->GetLayer() )
+                    && zone->GetBoundingBox().Contains( track->GetBoundingBox() ) )
+            {
+                candidates.push_back( track );
+                break;
+            }
+        }
+    }
+
+    std::sort( candidates.begin(), candidates.end(),
+               []( PCB_TRACK* a, PCB_TRACK* b )
+               {
+                   return a->GetLength() < b->GetLength();
+               } );
+
+    BOOST_REQUIRE( !candidates.empty() );
+
+    candidates.resize( std::min<size_t>( candidates.size(), 3 ) );
+
+    double tolerance = (double) pcbIUScale.mmToIU( 0.1 ) * pcbIUScale.mmToIU( 0.1 );
+
+    for( PCB_TRACK* nudged : candidates )
+    {
+        // Prime the cache; the full refill at the end of the last round has invalidated it
+        BOOST_CHECK_EQUAL( fillZones( &cache, {} ), 0 );
+
+        BOX2I dirtyArea = nudged->GetBoundingBox();
+        nudged->Move( VECTOR2I( pcbIUScale.mmToIU( 0.05 ), pcbIUScale.mmToIU( 0.05 ) ) );
+        dirtyArea.Merge( nudged->GetBoundingBox() );
+
+        std::map<ZONE*, ZONE_DIRTY_AREAS> dirtyAreas;
+
+        for( ZONE* zone : m_board->Zones() )
+        {
+            BOX2I zoneBox = zone->GetBoundingBox();
+
+            if( zoneBox.Intersects( dirtyArea ) )
+            {
+                BOOST_CHECK_LT( (double) dirtyArea.GetArea(), zoneBox.GetArea() / 10.0 );
+                dirtyAreas[ zone ].emplace_back( dirtyArea, nudged->GetLayerSet() );
+            }
+        }
+
+        BOOST_CHECK_GT( fillZones( &cache, dirtyAreas ), 0 );
+
+        std::map<std::pair<ZONE*, PCB_LAYER_ID>, SHAPE_POLY_SET> incrementalFills;
+
+        for( ZONE* zone : m_board->Zones() )
+        {
+            for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+            {
+                if( zone->HasFilledPolysForLayer( layer ) )
+                    incrementalFills[ { zone, layer } ] = *zone->GetFilledPolysList( layer );
+            }
+        }
+
+        BOOST_CHECK_EQUAL( fillZones( nullptr, {} ), 0 );
+
+        for( auto& [ item, incremental ] : incrementalFills )
+        {
+            auto&          [ zone, layer ] = item;
+            SHAPE_POLY_SET full = zone->GetFilledPolysList( layer )->CloneDropTriangulation();
+            SHAPE_POLY_SET missing = full.CloneDropTriangulation();
+            SHAPE_POLY_SET extra = incremental.CloneDropTriangulation();
+
+            missing.BooleanSubtract( incremental, SHAPE_POLY_SET::PM_FAST );
+            extra.BooleanSubtract( full, SHAPE_POLY_SET::PM_FAST );
+
+            BOOST_CHECK_MESSAGE( missing.Area() + extra.Area() < tolerance,
+                                 "Incremental fill of " << zone->GetNetname().ToStdString()
+                                         << " on " << LayerName( layer ).ToStdString()
+                                         << " differs from full fill" );
+        }
+    }
+}
+
+
+/**
+ * Filling a zone in tiles and stitching them back together must give the copper of filling it
+ * in one go, up to the rounding of the points where the tile edges cut the fill.  Those can
+ * each move by a unit, so the difference is bounded by a couple of units along the seams.
+ */
+BOOST_FIXTURE_TEST_CASE( TiledZoneFill, ZONE_FILL_TEST_FIXTURE )
+{
+    // Zones are only tiled when there are spare threads, so make sure a small machine has some
+    thread_pool&      tp = GetKiCadThreadPool();
+    BS::concurrency_t threads = tp.get_thread_count();
+
+    if( threads < 8 )
+        tp.reset( 8 );
+
+    int tiledZones = 0;
+
+    for( const wxString& relPath : { wxString( wxS( "zone_filler" ) ),
+                                     wxString( wxS( "notched_zones" ) ),
+                                     wxString( wxS( "issue5313" ) ),
+                                     wxString( wxS( "issue7086" ) ) } )
+    {
+        KI_TEST::LoadBoard( m_settingsManager, relPath, m_board );
+        KI_TEST::FillZones( m_board.get() );
+
+        TOOL_MANAGER toolMgr;
+        toolMgr.SetEnvironment( m_board.get(), nullptr, nullptr, nullptr, nullptr );
+
+        KI_TEST::DUMMY_TOOL* dummyTool = new KI_TEST::DUMMY_TOOL();
+        toolMgr.RegisterTool( dummyTool );
+
+        // Zones are filled one at a time, so that there are spare threads to fill tiles with
+        auto fillZone =
+                [&]( ZONE* aZone, bool aTiled )
+                {
+                    KI_TEST::ADVANCED_CFG_OVERRIDE<bool> tiled( &ADVANCED_CFG::m_ZoneFillTiling,
+                                                                aTiled );
+
+                    BOARD_COMMIT commit( dummyTool );
+                    ZONE_FILLER  filler( m_board.get(), &commit );
+
+                    if( filler.Fill( { aZone }, false, nullptr ) )
+                    {
+                        commit.Push( _( "Fill Zone(s)" ), SKIP_UNDO | SKIP_SET_DIRTY | ZONE_FILL_OP
+                                                                  | SKIP_CONNECTIVITY );
+                    }
+
+                    if( !aTiled )
+                        BOOST_CHECK_EQUAL( filler.GetTiledZoneCount(), 0 );
+
+                    tiledZones += filler.GetTiledZoneCount();
+
+                    std::map<PCB_LAYER_ID, SHAPE_POLY_SET> fills;
+
+                    for( PCB_LAYER_ID layer : aZone->GetLayerSet().Seq() )
+                    {
+                        if( aZone->HasFilledPolysForLayer( layer ) )
+                            fills[layer] = aZone->GetFilledPolysList( layer )->CloneDropTriangulation();
+                    }
+
+                    return fills;
+                };
+
+        for( ZONE* zone : m_board->Zones() )
+        {
+            std::map<PCB_LAYER_ID, SHAPE_POLY_SET> untiled = fillZone( zone, false );
+            std::map<PCB_LAYER_ID, SHAPE_POLY_SET> tiled = fillZone( zone, true );
+
+            // There are at most two tiles per thread, and the seams between them are no longer
+            // in all than the tiles' perimeters
+            BOX2I  bbox = zone->GetBoundingBox();
+            double seams = 2.0 * tp.get_thread_count() * ( (double) bbox.GetWidth()
+                                                           + bbox.GetHeight() );
+            double tolerance = 2.0 * seams;
+
+            BOOST_REQUIRE_EQUAL( tiled.size(), untiled.size() );
+
+            for( auto& [ layer, full ] : untiled )
+            {
+                BOOST_TEST_CONTEXT( relPath.ToStdString() << ": " << zone->GetNetname().ToStdString()
+                                                          << " on " << LayerName( layer ).ToStdString() )
+                {
+                    SHAPE_POLY_SET missing = full.CloneDropTriangulation();
+                    SHAPE_POLY_SET extra = tiled[layer].CloneDropTriangulation();
+
+                    missing.BooleanSubtract( tiled[layer], SHAPE_POLY_SET::PM_FAST );
+                    extra.BooleanSubtract( full, SHAPE_POLY_SET::PM_FAST );
+
+                    BOOST_CHECK_LT( std::abs( tiled[layer].Area() - full.Area() ), tolerance );
+                    BOOST_CHECK_LT( missing.Area() + extra.Area(), tolerance );
+                }
+            }
+        }
+    }
+
+    tp.reset( threads );
+
+    // Otherwise the comparisons above prove nothing
+    BOOST_REQUIRE_GT( tiledZones, 0 );
+}
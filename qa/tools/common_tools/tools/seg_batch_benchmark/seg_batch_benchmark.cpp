@@ -0,0 +1,186 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/*
+ * Times the batched segment distance queries of SHAPE_LINE_CHAIN::Collide() and
+ * SHAPE_POLY_SET::SquaredDistanceToPolygon() against the plain scalar loops they replaced.
+ *
+ * Usage: qa_common_tools seg_batch_benchmark [queries]
+ */
+
+#include <core/profile.h>
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+
+/**
+ * Build something shaped like a filled zone: a wavy outline with many small round holes,
+ * all approximated with short segments as a fill would be.
+ */
+static SHAPE_POLY_SET makeZoneLikePolygon( int aOutlinePoints, int aHolesPerSide )
+{
+    const int radius = 50000000;
+
+    SHAPE_LINE_CHAIN outline;
+
+    for( int ii = 0; ii < aOutlinePoints; ++ii )
+    {
+        double angle = 2.0 * M_PI * ii / aOutlinePoints;
+        double r = radius * ( 1.0 + 0.05 * std::sin( 40.0 * angle ) );
+
+        outline.Append( KiROUND( r * std::cos( angle ) ), KiROUND( r * std::sin( angle ) ) );
+    }
+
+    outline.SetClosed( true );
+
+    SHAPE_POLY_SET poly;
+    poly.AddOutline( outline );
+
+    const int pitch = radius / aHolesPerSide;
+    const int holeRadius = pitch / 4;
+
+    for( int ix = -aHolesPerSide / 2; ix < aHolesPerSide / 2; ++ix )
+    {
+        for( int iy = -aHolesPerSide / 2; iy < aHolesPerSide / 2; ++iy )
+        {
+            SHAPE_LINE_CHAIN hole;
+            VECTOR2I         centre( ix * pitch, iy * pitch );
+
+            for( int ii = 0; ii < 64; ++ii )
+            {
+                double angle = 2.0 * M_PI * ii / 64;
+
+                hole.Append( centre + VECTOR2I( KiROUND( holeRadius * std::cos( angle ) ),
+                                                KiROUND( holeRadius * std::sin( angle ) ) ) );
+            }
+
+            hole.SetClosed( true );
+            poly.AddHole( hole );
+        }
+    }
+
+    return poly;
+}
+
+
+static SEG::ecoord scalarDistance( const SHAPE_POLY_SET& aPoly, const VECTOR2I& aPoint )
+{
+    SEG::ecoord minDistance = VECTOR2I::ECOORD_MAX;
+
+    for( auto it = aPoly.CIterateSegmentsWithHoles( 0 ); it; it++ )
+        minDistance = std::min( minDistance, ( *it ).SquaredDistance( aPoint ) );
+
+    return minDistance;
+}
+
+
+static SEG::ecoord scalarDistance( const SHAPE_LINE_CHAIN& aChain, const VECTOR2I& aPoint )
+{
+    SEG::ecoord minDistance = VECTOR2I::ECOORD_MAX;
+
+    for( int ii = 0; ii < aChain.SegmentCount(); ++ii )
+    {
+        VECTOR2I pn = aChain.CSegment( ii ).NearestPoint( aPoint );
+        minDistance = std::min( minDistance, ( pn - aPoint ).SquaredEuclideanNorm() );
+    }
+
+    return minDistance;
+}
+
+
+int seg_batch_benchmark_func( int argc, char* argv[] )
+{
+    size_t queryCount = argc > 1 ? std::max( 1, atoi( argv[1] ) ) : 500;
+
+    std::mt19937                       rng( 1234 );
+    std::uniform_int_distribution<int> position( -60000000, 60000000 );
+
+    SHAPE_POLY_SET        poly = makeZoneLikePolygon( 40000, 12 );
+    SHAPE_LINE_CHAIN      outline = poly.COutline( 0 );
+    std::vector<VECTOR2I> queries;
+
+    outline.SetClosed( false );
+
+    // Points inside the fill are short-cut by SquaredDistanceToPolygon(), so only time the
+    // ones outside it (including those in the holes)
+    while( queries.size() < queryCount )
+    {
+        VECTOR2I p( position( rng ), position( rng ) );
+
+        if( !poly.Contains( p ) )
+            queries.push_back( p );
+    }
+
+    int64_t checksumScalar = 0;
+    int64_t checksumBatched = 0;
+
+    PROF_TIMER scalarTimer;
+
+    for( const VECTOR2I& p : queries )
+    {
+        checksumScalar += scalarDistance( outline, p ) < SEG::Square( 100000 );
+
+        // SquaredDistanceToPolygon() tests for containment first, so time that here too
+        checksumScalar += poly.Contains( p ) ? 0 : scalarDistance( poly, p );
+    }
+
+    scalarTimer.Stop();
+
+    PROF_TIMER batchedTimer;
+
+    for( const VECTOR2I& p : queries )
+    {
+        checksumBatched += outline.Collide( p, 100000 );
+        checksumBatched += poly.SquaredDistanceToPolygon( p, 0, nullptr );
+    }
+
+    batchedTimer.Stop();
+
+    std::cout << "Scalar:  " << scalarTimer.msecs() << " ms" << std::endl;
+    std::cout << "Batched: " << batchedTimer.msecs() << " ms" << std::endl;
+    std::cout << "Speedup: " << scalarTimer.msecs() / std::max( batchedTimer.msecs(), 1e-3 )
+              << std::endl;
+
+    if( checksumScalar != checksumBatched )
+    {
+        std::cerr << "Results differ (" << checksumScalar << " vs " << checksumBatched << ")"
+                  << std::endl;
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "seg_batch_benchmark",
+        "Benchmark the batched segment distance queries",
+        seg_batch_benchmark_func,
+} );
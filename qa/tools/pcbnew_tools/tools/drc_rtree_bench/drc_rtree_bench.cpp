@@ -0,0 +1,142 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <core/profile.h>
+#include <drc/drc_rtree.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+
+enum DRC_RTREE_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    RESULTS_DIFFER
+};
+
+
+/**
+ * Time the DRC copper-item queries against both the dynamic and the packed form of a
+ * DRC_RTREE, and check that both give the same answers.
+ */
+int drc_rtree_bench_main( int argc, char* argv[] )
+{
+    std::string filename;
+    int         repeats = 5;
+
+    if( argc > 1 )
+        filename = argv[1];
+
+    if( argc > 2 )
+        repeats = std::max( 1, atoi( argv[2] ) );
+
+    std::unique_ptr<BOARD> brd = KI_TEST::ReadBoardFromFileOrStream( filename );
+
+    if( !brd )
+        return DRC_RTREE_BENCH_RET_CODES::LOAD_FAILED;
+
+    std::vector<std::pair<BOARD_ITEM*, PCB_LAYER_ID>> items;
+
+    auto addItem =
+            [&]( BOARD_ITEM* aItem )
+            {
+                for( PCB_LAYER_ID layer : ( aItem->GetLayerSet() & LSET::AllCuMask() ).Seq() )
+                    items.emplace_back( aItem, layer );
+            };
+
+    for( PCB_TRACK* track : brd->Tracks() )
+        addItem( track );
+
+    for( FOOTPRINT* footprint : brd->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+            addItem( pad );
+    }
+
+    int       clearance = brd->GetDesignSettings().GetBiggestClearanceValue();
+    DRC_RTREE tree;
+
+    for( const auto& [ item, layer ] : items )
+        tree.Insert( item, layer, clearance );
+
+    auto runQueries =
+            [&]( const char* aName, std::vector<int>& aCounts )
+            {
+                PROF_TIMER timer( aName );
+
+                for( int ii = 0; ii < repeats; ++ii )
+                {
+                    aCounts.clear();
+
+                    for( const auto& [ item, layer ] : items )
+                        aCounts.push_back( tree.QueryColliding( item, layer, layer, nullptr,
+                                                                nullptr, clearance ) );
+                }
+
+                timer.Stop();
+                return timer.msecs();
+            };
+
+    std::vector<int> dynamicCounts;
+    std::vector<int> packedCounts;
+
+    double dynamicTime = runQueries( "dynamic", dynamicCounts );
+
+    PROF_TIMER packTimer( "pack" );
+    tree.Pack();
+    packTimer.Stop();
+
+    double packedTime = runQueries( "packed", packedCounts );
+
+    printf( "%zu items, %d repeats\n", items.size(), repeats );
+    printf( "dynamic: %.3f ms\n", dynamicTime );
+    printf( "pack:    %.3f ms\n", packTimer.msecs() );
+    printf( "packed:  %.3f ms (%.2fx)\n", packedTime,
+            packedTime > 0.0 ? dynamicTime / packedTime : 0.0 );
+
+    if( dynamicCounts != packedCounts )
+    {
+        printf( "ERROR: packed tree results differ from dynamic tree results\n" );
+        return DRC_RTREE_BENCH_RET_CODES::RESULTS_DIFFER;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "drc_rtree_bench",
+        "Benchmark DRC_RTREE queries with and without a packed index",
+        drc_rtree_bench_main,
+} );
@@ -0,0 +1,276 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/*
+ * Headless router benchmark: replays recorded router sessions (see m_EnableRouterDump)
+ * without any frames, and writes the cost of each kind of event as JSON so that runs of
+ * different builds can be diffed.
+ *
+ * Usage: pns_benchmark [-r repeats] [-o output.json] <tests.lst | log base name> ...
+ *
+ * A .lst file names one session directory per line, as used by qa_pns_regressions.
+ */
+
+#include <wx/filename.h>
+#include <wx/textfile.h>
+
+#include <reporter.h>
+#include <router/pns_perf_counters.h>
+
+#include "pns_log_file.h"
+#include "pns_log_player.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+
+struct BENCHMARK_CASE
+{
+    std::string m_name;
+    wxString    m_logPath;
+};
+
+
+static const char* eventTypeName( PNS::LOGGER::EVENT_TYPE aType )
+{
+    switch( aType )
+    {
+    case PNS::LOGGER::EVT_START_ROUTE: return "route-start";
+    case PNS::LOGGER::EVT_START_DRAG:  return "drag-start";
+    case PNS::LOGGER::EVT_FIX:         return "fix";
+    case PNS::LOGGER::EVT_MOVE:        return "move";
+    case PNS::LOGGER::EVT_ABORT:       return "abort";
+    case PNS::LOGGER::EVT_TOGGLE_VIA:  return "toggle-via";
+    case PNS::LOGGER::EVT_UNFIX:       return "unfix";
+    default:                           return "unknown";
+    }
+}
+
+
+/**
+ * Accumulates the cost of a set of events.  Latencies are kept for every replay, the counters
+ * (which don't change from one replay to the next) for the first one only.
+ */
+struct EVENT_SUMMARY
+{
+    std::vector<int64_t> m_latenciesUs;
+    int                  m_events = 0;
+    unsigned long long   m_shoveIterations = 0;
+    unsigned long long   m_queryColliding = 0;
+    unsigned long long   m_nodeAllocations = 0;
+
+    void Add( const PNS_LOG_PLAYER::EVENT_STATS& aStats, bool aCount )
+    {
+        m_latenciesUs.push_back( aStats.m_timeUs );
+
+        if( aCount )
+        {
+            m_events++;
+            m_shoveIterations += aStats.m_shoveIterations;
+            m_queryColliding += aStats.m_queryColliding;
+            m_nodeAllocations += aStats.m_nodeAllocations;
+        }
+    }
+
+    nlohmann::json ToJson()
+    {
+        std::sort( m_latenciesUs.begin(), m_latenciesUs.end() );
+
+        auto percentile =
+                [&]( int aPercent ) -> int64_t
+                {
+                    if( m_latenciesUs.empty() )
+                        return 0;
+
+                    // Nearest-rank percentile
+                    size_t rank = ( m_latenciesUs.size() * aPercent + 99 ) / 100;
+                    return m_latenciesUs[std::max<size_t>( rank, 1 ) - 1];
+                };
+
+        int64_t total = 0;
+
+        for( int64_t latency : m_latenciesUs )
+            total += latency;
+
+        nlohmann::json j;
+
+        j["events"] = m_events;
+        j["shove_iterations"] = m_shoveIterations;
+        j["query_colliding_calls"] = m_queryColliding;
+        j["node_allocations"] = m_nodeAllocations;
+        j["latency_us"] = { { "p50", percentile( 50 ) },
+                            { "p90", percentile( 90 ) },
+                            { "p99", percentile( 99 ) },
+                            { "max", m_latenciesUs.empty() ? 0 : m_latenciesUs.back() },
+                            { "total", total } };
+        return j;
+    }
+};
+
+
+static bool readCaseList( const wxString& aListFile, std::vector<BENCHMARK_CASE>& aCases )
+{
+    wxFileName fnameList( aListFile );
+    wxTextFile fp( fnameList.GetFullPath() );
+
+    if( !fp.Open() )
+        return false;
+
+    for( size_t ii = 0; ii < fp.GetLineCount(); ++ii )
+    {
+        wxString line = fp.GetLine( ii );
+        line.Trim().Trim( false );
+
+        if( line.IsEmpty() )
+            continue;
+
+        aCases.push_back( { line.ToStdString(),
+                            fnameList.GetPathWithSep() + line + wxT( "/pns" ) } );
+    }
+
+    return true;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    std::vector<BENCHMARK_CASE> cases;
+    std::string                 outputFile;
+    int                         repeats = 3;
+
+    for( int ii = 1; ii < argc; ++ii )
+    {
+        std::string arg = argv[ii];
+
+        if( arg == "-r" && ii + 1 < argc )
+        {
+            repeats = std::max( 1, atoi( argv[++ii] ) );
+        }
+        else if( arg == "-o" && ii + 1 < argc )
+        {
+            outputFile = argv[++ii];
+        }
+        else if( wxFileName( arg ).GetExt() == wxT( "lst" ) )
+        {
+            if( !readCaseList( arg, cases ) )
+            {
+                fprintf( stderr, "Failed to load test list from '%s'.\n", arg.c_str() );
+                return 1;
+            }
+        }
+        else
+        {
+            cases.push_back( { arg, wxString( arg ) } );
+        }
+    }
+
+    if( cases.empty() )
+    {
+        fprintf( stderr, "Usage: %s [-r repeats] [-o output.json] <tests.lst | log> ...\n",
+                 argv[0] );
+        return 1;
+    }
+
+    nlohmann::json                       results;
+    EVENT_SUMMARY                        total;
+    std::map<std::string, EVENT_SUMMARY> totalByType;
+    int                                  failed = 0;
+
+    results["repeats"] = repeats;
+    results["cases"] = nlohmann::json::array();
+
+    for( const BENCHMARK_CASE& benchCase : cases )
+    {
+        fprintf( stderr, "Replaying '%s'...\n", benchCase.m_name.c_str() );
+
+        PNS_LOG_FILE logFile;
+
+        if( !logFile.Load( wxFileName( benchCase.m_logPath ), &NULL_REPORTER::GetInstance() ) )
+        {
+            fprintf( stderr, "Failed to load '%s'.\n", benchCase.m_name.c_str() );
+            failed++;
+            continue;
+        }
+
+        EVENT_SUMMARY                        summary;
+        std::map<std::string, EVENT_SUMMARY> byType;
+
+        for( int repeat = 0; repeat < repeats; ++repeat )
+        {
+            PNS_LOG_PLAYER player;
+
+            player.SetDebugEnabled( false );
+            player.ReplayLog( &logFile, 0 );
+
+            for( const PNS_LOG_PLAYER::EVENT_STATS& stats : player.GetEventStats() )
+            {
+                std::string type = eventTypeName( stats.m_type );
+
+                summary.Add( stats, repeat == 0 );
+                byType[type].Add( stats, repeat == 0 );
+                total.Add( stats, repeat == 0 );
+                totalByType[type].Add( stats, repeat == 0 );
+            }
+        }
+
+        nlohmann::json caseResult = summary.ToJson();
+
+        caseResult["name"] = benchCase.m_name;
+
+        for( auto& [type, typeSummary] : byType )
+            caseResult["by_event"][type] = typeSummary.ToJson();
+
+        results["cases"].push_back( caseResult );
+    }
+
+    results["total"] = total.ToJson();
+
+    for( auto& [type, typeSummary] : totalByType )
+        results["total"]["by_event"][type] = typeSummary.ToJson();
+
+    if( outputFile.empty() )
+    {
+        std::cout << results.dump( 2 ) << std::endl;
+    }
+    else
+    {
+        std::ofstream out( outputFile );
+        out << results.dump( 2 ) << std::endl;
+
+        if( !out )
+        {
+            fprintf( stderr, "Failed to write '%s'.\n", outputFile.c_str() );
+            return 1;
+        }
+    }
+
+    return failed ? 1 : 0;
+}
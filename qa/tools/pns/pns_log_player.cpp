@@ -26,12 +26,14 @@
 #include "pns_log_player.h"
 
 #include <pcbnew_utils/board_test_utils.h>
+#include <router/pns_perf_counters.h>
 
 #define PNSLOGINFO PNS::DEBUG_DECORATOR::SRC_LOCATION_INFO( __FILE__, __FUNCTION__, __LINE__ )
 
 using namespace PNS;
 
-PNS_LOG_PLAYER::PNS_LOG_PLAYER()
+PNS_LOG_PLAYER::PNS_LOG_PLAYER() :
+        m_debugEnabled( true )
 {
     SetReporter( &NULL_REPORTER::GetInstance() );
 }
@@ -58,6 +60,7 @@ void PNS_LOG_PLAYER::createRouter()
 
     m_debugDecorator = new PNS_TEST_DEBUG_DECORATOR( m_reporter );
     m_debugDecorator->Clear();
+    m_debugDecorator->SetDebugEnabled( m_debugEnabled );
     m_iface->SetDebugDecorator( m_debugDecorator );
 }
 
@@ -102,6 +105,8 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
     int eventIdx = 0;
     int totalEvents = aLog->Events().size();
 
+    m_eventStats.clear();
+
     for( auto evt : aLog->Events() )
     {
         if( eventIdx < aFrom || ( aTo >= 0 && eventIdx > aTo ) )
@@ -113,6 +118,11 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
 
         eventIdx++;
 
+        PNS::PERF_COUNTERS& counters = PNS::PerfCounters();
+        counters.Reset();
+
+        int64_t startTime = GetRunningMicroSecs();
+
         switch( evt.type )
         {
         case LOGGER::EVT_START_ROUTE:
@@ -161,7 +171,8 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
             m_viewTracker->SetStage( m_debugDecorator->GetStageCount() - 1 );
             m_debugDecorator->Message( wxString::Format( "fix (%d, %d)", evt.p.x, evt.p.y ) );
             bool rv = m_router->FixRoute( evt.p, ritem, false, false );
-            printf( "  fix -> (%d, %d) ret %d\n", evt.p.x, evt.p.y, rv ? 1 : 0 );
+            m_reporter->Report( wxString::Format( "  fix -> (%d, %d) ret %d", evt.p.x, evt.p.y,
+                                                  rv ? 1 : 0 ) );
             break;
         }
 
@@ -170,7 +181,7 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
             m_debugDecorator->NewStage( "unfix", 0, PNSLOGINFO );
             m_viewTracker->SetStage( m_debugDecorator->GetStageCount() - 1 );
             m_debugDecorator->Message( wxString::Format( "unfix (%d, %d)", evt.p.x, evt.p.y ) );
-            printf( "  unfix\n" );
+            m_reporter->Report( wxT( "  unfix" ) );
             m_router->UndoLastSegment();
             break;
         }
@@ -207,6 +218,11 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
         default: break;
         }
 
+        m_eventStats.push_back( { evt.type, GetRunningMicroSecs() - startTime,
+                                  counters.m_shoveIterations.Count(),
+                                  counters.m_queryColliding.Count(),
+                                  counters.m_nodeAllocations.Count() } );
+
         PNS::NODE* node = nullptr;
 
 #if 0
@@ -29,6 +29,7 @@
 #include <router/pns_routing_settings.h>
 #include <router/pns_kicad_iface.h>
 #include <router/pns_router.h>
+#include <router/pns_logger.h>
 
 
 class PNS_TEST_DEBUG_DECORATOR;
@@ -93,6 +94,16 @@ private:
 class PNS_LOG_PLAYER
 {
 public:
+    ///< Cost of replaying a single logged event.
+    struct EVENT_STATS
+    {
+        PNS::LOGGER::EVENT_TYPE m_type;
+        int64_t                 m_timeUs;
+        unsigned long long      m_shoveIterations;
+        unsigned long long      m_queryColliding;
+        unsigned long long      m_nodeAllocations;
+    };
+
     PNS_LOG_PLAYER();
     ~PNS_LOG_PLAYER();
 
@@ -106,6 +117,15 @@ public:
 
     void SetTimeLimit( uint64_t microseconds ) { m_timeLimitUs = microseconds; }
 
+    /**
+     * Record the router's debug graphics while replaying (the default).  Turn this off when
+     * timing the replay.
+     */
+    void SetDebugEnabled( bool aEnabled ) { m_debugEnabled = aEnabled; }
+
+    ///< @return the cost of each event replayed by the last ReplayLog() call.
+    const std::vector<EVENT_STATS>& GetEventStats() const { return m_eventStats; }
+
     bool CompareResults( PNS_LOG_FILE* aLog );
     const PNS_LOG_FILE::COMMIT_STATE GetRouterUpdatedItems();
 
@@ -120,6 +140,8 @@ private:
     std::unique_ptr<PNS::ROUTING_SETTINGS>      m_routingSettings;
     uint64_t m_timeLimitUs;
     REPORTER* m_reporter;
+    bool      m_debugEnabled;
+    std::vector<EVENT_STATS> m_eventStats;
 };
 
 #endif